@@ -11,6 +11,8 @@ const int32 Application::windowHeight = 900;
 
 const std::string Application::closeApplicationActionName = "closeApplication";
 
+const std::string Application::skippedMipmapLevelsArgument = "--skipped-mipmap-levels";
+
 std::shared_ptr<Application> Application::application;
 
 Application::Application(std::shared_ptr<Input> input, std::shared_ptr<Timer> timer,
@@ -25,6 +27,8 @@ Application::Application(std::shared_ptr<Input> input, std::shared_ptr<Timer> ti
 
     instanceHandle = nullptr;
 
+    textureBudgetSettings = getDefaultTextureBudgetSettings();
+
     comInitializationResult = E_UNEXPECTED;
 
     shouldShutdown = false;
@@ -63,7 +67,7 @@ void Application::setReleased()
 
 bool Application::initialize(HINSTANCE instanceHandle, std::wstring name,
                              std::shared_ptr<Application> application, int32
-                             showCmd)
+                             showCmd, std::string commandLine)
 {
     if (isInitialized())
     {
@@ -73,7 +77,13 @@ bool Application::initialize(HINSTANCE instanceHandle, std::wstring name,
     this->instanceHandle = instanceHandle;
     this->name = std::move(name);
 
-    bool result = initializeWindow(showCmd);
+    bool result = readCommandLine(commandLine);
+    if (!result)
+    {
+        return false;
+    }
+
+    result = initializeWindow(showCmd);
     if (!result)
     {
         return false;
@@ -172,6 +182,30 @@ void Application::release()
     setReleased();
 }
 
+bool Application::readCommandLine(std::string commandLine)
+{
+    textureBudgetSettings = getDefaultTextureBudgetSettings();
+
+    std::istringstream commandLineStream(commandLine);
+
+    std::string argument;
+    while (commandLineStream >> argument)
+    {
+        if (argument == skippedMipmapLevelsArgument)
+        {
+            uint32 skippedMipmapLevels = 0;
+            if (!(commandLineStream >> skippedMipmapLevels))
+            {
+                return false;
+            }
+
+            textureBudgetSettings.skippedMipmapLevels = skippedMipmapLevels;
+        }
+    }
+
+    return true;
+}
+
 bool Application::initializeWindow(int32 showCmd)
 {
     WNDCLASSEX windowClassDesc = {};
@@ -202,7 +236,7 @@ bool Application::initializeWindow(int32 showCmd)
 bool Application::initializeRenderer()
 {
     renderer = createSharedPointer<Renderer>(window, input, timer);
-    bool result = renderer->initialize(vsyncEnabled);
+    bool result = renderer->initialize(vsyncEnabled, textureBudgetSettings);
     if (!result)
     {
         return false;
@@ -4,6 +4,7 @@
 #include <memory>
 
 #include <string>
+#include <sstream>
 
 #include "Input.h"
 #include "Timer.h"
@@ -13,6 +14,7 @@
 #include "Renderer.h"
 
 #include "MemoryUtility.h"
+#include "ImageFileParserUtility.h"
 
 class Application
 {
@@ -34,6 +36,8 @@ class Application
 
     static const std::string closeApplicationActionName;
 
+    static const std::string skippedMipmapLevelsArgument;
+
     static std::shared_ptr<Application> application;
 
     HINSTANCE instanceHandle;
@@ -42,6 +46,9 @@ class Application
     std::shared_ptr<Window> window;
     std::shared_ptr<Renderer> renderer;
 
+    // Read from the command line, every texture the renderer reads from a file follows it
+    TextureBudgetSettings textureBudgetSettings;
+
     HRESULT comInitializationResult;
 
     bool shouldShutdown;
@@ -59,13 +66,16 @@ private:
     void setReleased();
 
 public:
+    // "--skipped-mipmap-levels <count>" in the command line leaves the largest mipmap levels of
+    // the textures in their files, for nodes with less memory
     bool initialize(HINSTANCE instanceHandle, std::wstring name,
                     std::shared_ptr<Application> application, int32
-                    showCmd = SW_SHOW);
+                    showCmd = SW_SHOW, std::string commandLine = "");
     void run();
     void release();
 
 private:
+    bool readCommandLine(std::string commandLine);
     bool initializeWindow(int32 showCmd);
     bool initializeRenderer();
     bool bindActions();
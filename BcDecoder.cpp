@@ -0,0 +1,906 @@
+#include "BcDecoder.h"
+
+BcDecoder::BcDecoder() : settings{}, statistics{}
+{
+    settings.instructionSet = CpuInstructionSet::Undefined;
+    settings.threadCount = 1;
+}
+
+BcDecoderSettings BcDecoder::getSettings()
+{
+    return settings;
+}
+
+void BcDecoder::setSettings(BcDecoderSettings settings)
+{
+    this->settings = settings;
+}
+
+BcDecoderStatistics BcDecoder::getStatistics()
+{
+    return statistics;
+}
+
+bool BcDecoder::decodeImage(const ImageData& imageData, ImageData& decodedImageData)
+{
+    statistics = {};
+
+    DXGI_FORMAT decodedFormat = getBcDecodedFormat(imageData.format);
+    if (decodedFormat == DXGI_FORMAT_UNKNOWN)
+    {
+        return false;
+    }
+
+    uint64 subresourceCount = static_cast<uint64>(imageData.mipmapLevels) * imageData.arraySize;
+    if (subresourceCount == 0 || imageData.subresourceDataItems.size() != subresourceCount)
+    {
+        return false;
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    decodedImageData = {};
+    decodedImageData.width = imageData.width;
+    decodedImageData.height = imageData.height;
+    decodedImageData.depth = imageData.depth;
+    decodedImageData.format = decodedFormat;
+    decodedImageData.mipmapLevels = imageData.mipmapLevels;
+    decodedImageData.arraySize = imageData.arraySize;
+    decodedImageData.isCubemap = imageData.isCubemap;
+
+    // Blocks of every subresource before it, so a range of blocks can be found in the image
+    std::vector<uint64> subresourceBlockBegins(subresourceCount + 1);
+
+    uint64 payloadSize = 0;
+    decodedImageData.subresourceDataItems.resize(subresourceCount);
+    for (uint64 i = 0; i < subresourceCount; i++)
+    {
+        uint32 mipmapLevel = static_cast<uint32>(i % imageData.mipmapLevels);
+        uint32 width = getImageMipmapSize(imageData.width, mipmapLevel);
+        uint32 height = getImageMipmapSize(imageData.height, mipmapLevel);
+
+        ImageSubresourceData& subresourceData = decodedImageData.subresourceDataItems[i];
+        subresourceData.offset = payloadSize;
+        subresourceData.rowPitch = width * BcDecodedPixelSize;
+        subresourceData.depthPitch = subresourceData.rowPitch * height;
+        payloadSize += subresourceData.depthPitch;
+
+        subresourceBlockBegins[i + 1] = subresourceBlockBegins[i] + static_cast<uint64>(
+            getBcBlockCount(width)) * getBcBlockCount(height);
+    }
+    decodedImageData.data.resize(payloadSize);
+
+    CpuInstructionSet instructionSet = getCpuInstructionSet(settings.instructionSet);
+
+    const unsigned char* payload = getImagePayload(imageData);
+    unsigned char* decodedPayload = decodedImageData.data.data();
+
+    uint64 blockCount = subresourceBlockBegins.back();
+    uint32 threadCount = forEachBlockRange(blockCount, [&](uint64 beginBlock, uint64 endBlock)
+    {
+        // Block rows cut by the image edge are decoded here first, then only the pixels inside
+        // the image are copied
+        std::vector<unsigned char> strip;
+
+        uint64 subresourceIndex = std::upper_bound(subresourceBlockBegins.begin(),
+                                                   subresourceBlockBegins.end(), beginBlock) -
+            subresourceBlockBegins.begin() - 1;
+
+        uint64 blockIndex = beginBlock;
+        while (blockIndex < endBlock)
+        {
+            while (blockIndex >= subresourceBlockBegins[subresourceIndex + 1])
+            {
+                subresourceIndex++;
+            }
+
+            uint32 mipmapLevel = static_cast<uint32>(subresourceIndex % imageData.mipmapLevels);
+            uint32 width = getImageMipmapSize(imageData.width, mipmapLevel);
+            uint32 height = getImageMipmapSize(imageData.height, mipmapLevel);
+            uint64 rowBlockCount = getBcBlockCount(width);
+
+            uint64 subresourceBlockIndex = blockIndex - subresourceBlockBegins[subresourceIndex];
+            uint64 blockRow = subresourceBlockIndex / rowBlockCount;
+            uint64 blockColumn = subresourceBlockIndex % rowBlockCount;
+
+            uint64 segmentBlockCount = rowBlockCount - blockColumn;
+            if (segmentBlockCount > endBlock - blockIndex)
+            {
+                segmentBlockCount = endBlock - blockIndex;
+            }
+
+            const ImageSubresourceData& sourceData = imageData.subresourceDataItems[
+                subresourceIndex];
+            const unsigned char* blocks = payload + sourceData.offset + blockRow * sourceData.
+                rowPitch + blockColumn * getImageFormatBlockSize(imageData.format);
+
+            const ImageSubresourceData& destinationData = decodedImageData.subresourceDataItems[
+                subresourceIndex];
+            uint64 rowPitch = destinationData.rowPitch;
+            unsigned char* pixels = decodedPayload + destinationData.offset + blockRow *
+                BcBlockWidth * rowPitch + blockColumn * BcBlockWidth * BcDecodedPixelSize;
+
+            uint64 segmentWidth = segmentBlockCount * BcBlockWidth;
+            uint64 pixelColumn = blockColumn * BcBlockWidth;
+            uint64 pixelRow = blockRow * BcBlockWidth;
+            if (pixelColumn + segmentWidth <= width && pixelRow + BcBlockWidth <= height)
+            {
+                decodeBlocks(imageData.format, instructionSet, blocks, segmentBlockCount, pixels,
+                             rowPitch);
+            }
+            else
+            {
+                uint64 stripRowPitch = segmentWidth * BcDecodedPixelSize;
+                strip.resize(stripRowPitch * BcBlockWidth);
+                decodeBlocks(imageData.format, instructionSet, blocks, segmentBlockCount,
+                             strip.data(), stripRowPitch);
+
+                uint64 copyWidth = width - pixelColumn;
+                if (copyWidth > segmentWidth)
+                {
+                    copyWidth = segmentWidth;
+                }
+                uint64 copyHeight = height - pixelRow;
+                if (copyHeight > BcBlockWidth)
+                {
+                    copyHeight = BcBlockWidth;
+                }
+
+                for (uint64 i = 0; i < copyHeight; i++)
+                {
+                    std::memcpy(pixels + i * rowPitch, strip.data() + i * stripRowPitch,
+                                copyWidth * BcDecodedPixelSize);
+                }
+            }
+
+            blockIndex += segmentBlockCount;
+        }
+    });
+
+    std::chrono::duration<double> decodingTime = std::chrono::steady_clock::now() - startTime;
+
+    statistics.instructionSet = instructionSet;
+    statistics.threadCount = threadCount;
+    statistics.blockCount = blockCount;
+    statistics.size = payloadSize;
+    statistics.decodingTime = decodingTime.count();
+    if (statistics.decodingTime > 0.0)
+    {
+        statistics.blockThroughput = statistics.blockCount / (statistics.decodingTime * 1000.0);
+        statistics.throughput = statistics.size / (1024.0 * 1024.0 * 1024.0) / statistics.
+            decodingTime;
+    }
+
+    return true;
+}
+
+bool BcDecoder::decodeBlockRow(DXGI_FORMAT format, const unsigned char* blocks, uint64 blockCount,
+                               unsigned char* pixels, uint64 rowPitch)
+{
+    statistics = {};
+
+    if (getBcDecodedFormat(format) == DXGI_FORMAT_UNKNOWN)
+    {
+        return false;
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    CpuInstructionSet instructionSet = getCpuInstructionSet(settings.instructionSet);
+    decodeBlocks(format, instructionSet, blocks, blockCount, pixels, rowPitch);
+
+    std::chrono::duration<double> decodingTime = std::chrono::steady_clock::now() - startTime;
+
+    statistics.instructionSet = instructionSet;
+    statistics.threadCount = 1;
+    statistics.blockCount = blockCount;
+    statistics.size = blockCount * BcBlockPixelCount * BcDecodedPixelSize;
+    statistics.decodingTime = decodingTime.count();
+    if (statistics.decodingTime > 0.0)
+    {
+        statistics.blockThroughput = statistics.blockCount / (statistics.decodingTime * 1000.0);
+        statistics.throughput = statistics.size / (1024.0 * 1024.0 * 1024.0) / statistics.
+            decodingTime;
+    }
+
+    return true;
+}
+
+void BcDecoder::decodeBlocks(DXGI_FORMAT format, CpuInstructionSet instructionSet,
+                             const unsigned char* blocks, uint64 blockCount, unsigned char* pixels,
+                             uint64 rowPitch)
+{
+    switch (format)
+    {
+    case DXGI_FORMAT_BC1_TYPELESS:
+    case DXGI_FORMAT_BC1_UNORM:
+    case DXGI_FORMAT_BC1_UNORM_SRGB:
+    {
+        decodeColorBlocks(blocks, DdsBc1BlockSize, blockCount, true, instructionSet, pixels,
+                          rowPitch);
+
+        break;
+    }
+    case DXGI_FORMAT_BC2_TYPELESS:
+    case DXGI_FORMAT_BC2_UNORM:
+    case DXGI_FORMAT_BC2_UNORM_SRGB:
+    {
+        decodeColorBlocks(blocks + DdsBc1BlockSize, DdsBc2BlockSize, blockCount, false,
+                          instructionSet, pixels, rowPitch);
+        decodeExplicitAlphaBlocks(blocks, DdsBc2BlockSize, blockCount, instructionSet, pixels,
+                                  rowPitch);
+
+        break;
+    }
+    case DXGI_FORMAT_BC3_TYPELESS:
+    case DXGI_FORMAT_BC3_UNORM:
+    case DXGI_FORMAT_BC3_UNORM_SRGB:
+    {
+        decodeColorBlocks(blocks + DdsBc1BlockSize, DdsBc2BlockSize, blockCount, false,
+                          instructionSet, pixels, rowPitch);
+        decodeChannelBlocks(blocks, DdsBc2BlockSize, blockCount, false, 3, instructionSet,
+                            pixels, rowPitch);
+
+        break;
+    }
+    case DXGI_FORMAT_BC4_TYPELESS:
+    case DXGI_FORMAT_BC4_UNORM:
+    case DXGI_FORMAT_BC4_SNORM:
+    {
+        bool isSigned = format == DXGI_FORMAT_BC4_SNORM;
+
+        fillPixels(isSigned ? 0x7f000000 : 0xff000000, blockCount, pixels, rowPitch);
+        decodeChannelBlocks(blocks, DdsBc1BlockSize, blockCount, isSigned, 0, instructionSet,
+                            pixels, rowPitch);
+
+        break;
+    }
+    case DXGI_FORMAT_BC5_TYPELESS:
+    case DXGI_FORMAT_BC5_UNORM:
+    case DXGI_FORMAT_BC5_SNORM:
+    {
+        bool isSigned = format == DXGI_FORMAT_BC5_SNORM;
+
+        fillPixels(isSigned ? 0x7f000000 : 0xff000000, blockCount, pixels, rowPitch);
+        decodeChannelBlocks(blocks, DdsBc2BlockSize, blockCount, isSigned, 0, instructionSet,
+                            pixels, rowPitch);
+        decodeChannelBlocks(blocks + DdsBc1BlockSize, DdsBc2BlockSize, blockCount, isSigned, 1,
+                            instructionSet, pixels, rowPitch);
+
+        break;
+    }
+    case DXGI_FORMAT_BC7_TYPELESS:
+    case DXGI_FORMAT_BC7_UNORM:
+    case DXGI_FORMAT_BC7_UNORM_SRGB:
+    {
+        for (uint64 i = 0; i < blockCount; i++)
+        {
+            decodeBc7Block(blocks + i * DdsBc2BlockSize, pixels + i * BcBlockWidth *
+                           BcDecodedPixelSize, rowPitch);
+        }
+
+        break;
+    }
+    default:
+    {
+        break;
+    }
+    }
+}
+
+void BcDecoder::fillPixels(uint32 pixel, uint64 blockCount, unsigned char* pixels,
+                           uint64 rowPitch)
+{
+    for (uint32 i = 0; i < BcBlockWidth; i++)
+    {
+        unsigned char* row = pixels + i * rowPitch;
+        for (uint64 j = 0; j < blockCount * BcBlockWidth; j++)
+        {
+            std::memcpy(row + j * BcDecodedPixelSize, &pixel, BcDecodedPixelSize);
+        }
+    }
+}
+
+void BcDecoder::decodeColorBlocks(const unsigned char* blocks, uint64 blockSize,
+                                  uint64 blockCount, bool hasThreeColorMode,
+                                  CpuInstructionSet instructionSet, unsigned char* pixels,
+                                  uint64 rowPitch)
+{
+    uint64 blockIndex = 0;
+    if (instructionSet == CpuInstructionSet::Avx2)
+    {
+        blockIndex = decodeColorBlocksAvx2(blocks, blockSize, blockCount, hasThreeColorMode,
+                                           pixels, rowPitch);
+    }
+
+    for (; blockIndex < blockCount; blockIndex++)
+    {
+        decodeColorBlock(blocks + blockIndex * blockSize, hasThreeColorMode, pixels + blockIndex *
+                         BcBlockWidth * BcDecodedPixelSize, rowPitch);
+    }
+}
+
+void BcDecoder::decodeExplicitAlphaBlocks(const unsigned char* blocks, uint64 blockSize,
+                                          uint64 blockCount, CpuInstructionSet instructionSet,
+                                          unsigned char* pixels, uint64 rowPitch)
+{
+    if (instructionSet == CpuInstructionSet::Avx2)
+    {
+        decodeExplicitAlphaBlocksAvx2(blocks, blockSize, blockCount, pixels, rowPitch);
+
+        return;
+    }
+
+    for (uint64 i = 0; i < blockCount; i++)
+    {
+        decodeExplicitAlphaBlock(blocks + i * blockSize, pixels + i * BcBlockWidth *
+                                 BcDecodedPixelSize, rowPitch);
+    }
+}
+
+void BcDecoder::decodeChannelBlocks(const unsigned char* blocks, uint64 blockSize,
+                                    uint64 blockCount, bool isSigned, uint32 channelIndex,
+                                    CpuInstructionSet instructionSet, unsigned char* pixels,
+                                    uint64 rowPitch)
+{
+    if (instructionSet == CpuInstructionSet::Avx2)
+    {
+        decodeChannelBlocksAvx2(blocks, blockSize, blockCount, isSigned, channelIndex, pixels,
+                                rowPitch);
+
+        return;
+    }
+
+    for (uint64 i = 0; i < blockCount; i++)
+    {
+        decodeChannelBlock(blocks + i * blockSize, isSigned, channelIndex, pixels + i *
+                           BcBlockWidth * BcDecodedPixelSize, rowPitch);
+    }
+}
+
+void BcDecoder::decodeColorBlock(const unsigned char* block, bool hasThreeColorMode,
+                                 unsigned char* pixels, uint64 rowPitch)
+{
+    uint32 color0 = block[0] | block[1] << 8;
+    uint32 color1 = block[2] | block[3] << 8;
+    uint32 indexes = block[4] | block[5] << 8 | block[6] << 16 | static_cast<uint32>(block[7]) <<
+        24;
+
+    unsigned char palette[4][BcDecodedPixelSize] = {
+        {
+            static_cast<unsigned char>(expandBcChannel(color0 >> 11 & 0x1f, 5)),
+            static_cast<unsigned char>(expandBcChannel(color0 >> 5 & 0x3f, 6)),
+            static_cast<unsigned char>(expandBcChannel(color0 & 0x1f, 5)), 0xff
+        },
+        {
+            static_cast<unsigned char>(expandBcChannel(color1 >> 11 & 0x1f, 5)),
+            static_cast<unsigned char>(expandBcChannel(color1 >> 5 & 0x3f, 6)),
+            static_cast<unsigned char>(expandBcChannel(color1 & 0x1f, 5)), 0xff
+        },
+    };
+
+    // Interpolated colors are rounded to the nearest value, like a float interpolation would be
+    if (!hasThreeColorMode || color0 > color1)
+    {
+        for (int32 i = 0; i < 3; i++)
+        {
+            palette[2][i] = static_cast<unsigned char>((2 * palette[0][i] + palette[1][i] + 1) /
+                3);
+            palette[3][i] = static_cast<unsigned char>((palette[0][i] + 2 * palette[1][i] + 1) /
+                3);
+        }
+        palette[2][3] = 0xff;
+        palette[3][3] = 0xff;
+    }
+    else
+    {
+        for (int32 i = 0; i < 3; i++)
+        {
+            palette[2][i] = static_cast<unsigned char>((palette[0][i] + palette[1][i] + 1) / 2);
+        }
+        palette[2][3] = 0xff;
+    }
+
+    for (uint32 i = 0; i < BcBlockPixelCount; i++)
+    {
+        std::memcpy(pixels + i / BcBlockWidth * rowPitch + i % BcBlockWidth * BcDecodedPixelSize,
+                    palette[indexes >> i * 2 & 0x3], BcDecodedPixelSize);
+    }
+}
+
+void BcDecoder::decodeExplicitAlphaBlock(const unsigned char* block, unsigned char* pixels,
+                                         uint64 rowPitch)
+{
+    for (uint32 i = 0; i < BcBlockPixelCount; i++)
+    {
+        uint32 alpha = block[i / 2] >> (i % 2) * 4 & 0xf;
+
+        pixels[i / BcBlockWidth * rowPitch + i % BcBlockWidth * BcDecodedPixelSize + 3] =
+            static_cast<unsigned char>(alpha * 17);
+    }
+}
+
+void BcDecoder::decodeChannelBlock(const unsigned char* block, bool isSigned,
+                                   uint32 channelIndex, unsigned char* pixels, uint64 rowPitch)
+{
+    // Signed endpoints are offset by 127 so both kinds are interpolated the same way, -128 is
+    // read as -127 like D3D does
+    uint32 palette[8] = {};
+    uint32 maxValue = 0xff;
+    if (isSigned)
+    {
+        for (int32 i = 0; i < 2; i++)
+        {
+            int32 endpoint = static_cast<int8>(block[i]);
+            if (endpoint < -127)
+            {
+                endpoint = -127;
+            }
+
+            palette[i] = static_cast<uint32>(endpoint + 127);
+        }
+        maxValue = 254;
+    }
+    else
+    {
+        palette[0] = block[0];
+        palette[1] = block[1];
+    }
+
+    if (palette[0] > palette[1])
+    {
+        for (uint32 i = 1; i < 7; i++)
+        {
+            palette[i + 1] = ((7 - i) * palette[0] + i * palette[1] + 3) / 7;
+        }
+    }
+    else
+    {
+        for (uint32 i = 1; i < 5; i++)
+        {
+            palette[i + 1] = ((5 - i) * palette[0] + i * palette[1] + 2) / 5;
+        }
+        palette[6] = 0;
+        palette[7] = maxValue;
+    }
+
+    uint64 indexes = 0;
+    for (int32 i = 0; i < 6; i++)
+    {
+        indexes |= static_cast<uint64>(block[2 + i]) << i * 8;
+    }
+
+    for (uint32 i = 0; i < BcBlockPixelCount; i++)
+    {
+        uint32 value = palette[indexes >> i * 3 & 0x7];
+        if (isSigned)
+        {
+            value -= 127;
+        }
+
+        pixels[i / BcBlockWidth * rowPitch + i % BcBlockWidth * BcDecodedPixelSize +
+            channelIndex] = static_cast<unsigned char>(value);
+    }
+}
+
+void BcDecoder::decodeBc7Block(const unsigned char* block, unsigned char* pixels, uint64 rowPitch)
+{
+    uint32 mode = 0;
+    while (mode < Bc7ModeCount && !(block[0] & 1 << mode))
+    {
+        mode++;
+    }
+
+    // The reserved mode decodes to transparent black
+    if (mode == Bc7ModeCount)
+    {
+        for (uint32 i = 0; i < BcBlockWidth; i++)
+        {
+            std::memset(pixels + i * rowPitch, 0, BcBlockWidth * BcDecodedPixelSize);
+        }
+
+        return;
+    }
+
+    const Bc7ModeInfo& modeInfo = Bc7ModeInfos[mode];
+
+    uint64 bits[2] = {};
+    std::memcpy(bits, block, sizeof(bits));
+    uint32 bitIndex = mode + 1;
+
+    uint32 partition = readBc7Bits(bits, bitIndex, modeInfo.partitionBitCount);
+    uint32 rotation = readBc7Bits(bits, bitIndex, modeInfo.rotationBitCount);
+    uint32 indexSelection = readBc7Bits(bits, bitIndex, modeInfo.indexSelectionBitCount);
+
+    // Every channel of every endpoint, red of all the endpoints first
+    uint32 endpoints[Bc7MaxSubsetCount * 2][BcDecodedPixelSize] = {};
+    uint32 endpointCount = modeInfo.subsetCount * 2;
+    for (uint32 i = 0; i < 3; i++)
+    {
+        for (uint32 j = 0; j < endpointCount; j++)
+        {
+            endpoints[j][i] = readBc7Bits(bits, bitIndex, modeInfo.colorBitCount);
+        }
+    }
+    for (uint32 j = 0; j < endpointCount && modeInfo.alphaBitCount > 0; j++)
+    {
+        endpoints[j][3] = readBc7Bits(bits, bitIndex, modeInfo.alphaBitCount);
+    }
+
+    uint32 colorBitCount = modeInfo.colorBitCount;
+    uint32 alphaBitCount = modeInfo.alphaBitCount;
+    if (modeInfo.endpointPBitCount > 0 || modeInfo.sharedPBitCount > 0)
+    {
+        for (uint32 j = 0; j < endpointCount; j++)
+        {
+            // A shared P-bit is read once for both endpoints of a subset
+            if (modeInfo.endpointPBitCount > 0 || j % 2 == 0)
+            {
+                uint32 pBit = readBc7Bits(bits, bitIndex, 1);
+                for (uint32 k = j; k < j + 1 + (modeInfo.sharedPBitCount > 0); k++)
+                {
+                    for (uint32 i = 0; i < BcDecodedPixelSize; i++)
+                    {
+                        endpoints[k][i] = endpoints[k][i] << 1 | pBit;
+                    }
+                }
+            }
+        }
+
+        colorBitCount++;
+        if (alphaBitCount > 0)
+        {
+            alphaBitCount++;
+        }
+    }
+
+    for (uint32 j = 0; j < endpointCount; j++)
+    {
+        for (uint32 i = 0; i < 3; i++)
+        {
+            endpoints[j][i] = expandBcChannel(endpoints[j][i], colorBitCount);
+        }
+
+        if (alphaBitCount > 0)
+        {
+            endpoints[j][3] = expandBcChannel(endpoints[j][3], alphaBitCount);
+        }
+        else
+        {
+            endpoints[j][3] = 0xff;
+        }
+    }
+
+    uint32 indexes[BcBlockPixelCount] = {};
+    for (uint32 i = 0; i < BcBlockPixelCount; i++)
+    {
+        bool isAnchor = isBc7AnchorPixel(modeInfo.subsetCount, partition, i);
+        indexes[i] = readBc7Bits(bits, bitIndex, modeInfo.indexBitCount - isAnchor);
+    }
+
+    // Modes 4 and 5 have separate alpha indexes, or color ones when the index selection is set
+    uint32 secondaryIndexes[BcBlockPixelCount] = {};
+    uint32 colorIndexBitCount = modeInfo.indexBitCount;
+    uint32 alphaIndexBitCount = modeInfo.indexBitCount;
+    const uint32* colorIndexes = indexes;
+    const uint32* alphaIndexes = indexes;
+    if (modeInfo.secondaryIndexBitCount > 0)
+    {
+        for (uint32 i = 0; i < BcBlockPixelCount; i++)
+        {
+            secondaryIndexes[i] = readBc7Bits(bits, bitIndex, modeInfo.secondaryIndexBitCount -
+                                              (i == 0));
+        }
+
+        alphaIndexBitCount = modeInfo.secondaryIndexBitCount;
+        alphaIndexes = secondaryIndexes;
+        if (indexSelection)
+        {
+            colorIndexBitCount = modeInfo.secondaryIndexBitCount;
+            alphaIndexBitCount = modeInfo.indexBitCount;
+            colorIndexes = secondaryIndexes;
+            alphaIndexes = indexes;
+        }
+    }
+
+    for (uint32 i = 0; i < BcBlockPixelCount; i++)
+    {
+        uint32 subset = getBc7Subset(modeInfo.subsetCount, partition, i);
+        const uint32* endpoint0 = endpoints[subset * 2];
+        const uint32* endpoint1 = endpoints[subset * 2 + 1];
+
+        uint32 colorWeight = getBc7Weight(colorIndexBitCount, colorIndexes[i]);
+        uint32 alphaWeight = getBc7Weight(alphaIndexBitCount, alphaIndexes[i]);
+
+        unsigned char pixel[BcDecodedPixelSize] = {};
+        for (uint32 j = 0; j < 3; j++)
+        {
+            pixel[j] = static_cast<unsigned char>(((64 - colorWeight) * endpoint0[j] +
+                colorWeight * endpoint1[j] + 32) >> 6);
+        }
+        pixel[3] = static_cast<unsigned char>(((64 - alphaWeight) * endpoint0[3] + alphaWeight *
+            endpoint1[3] + 32) >> 6);
+
+        // Rotations swap alpha with red, green or blue after the interpolation
+        if (rotation > 0)
+        {
+            unsigned char alpha = pixel[3];
+            pixel[3] = pixel[rotation - 1];
+            pixel[rotation - 1] = alpha;
+        }
+
+        std::memcpy(pixels + i / BcBlockWidth * rowPitch + i % BcBlockWidth * BcDecodedPixelSize,
+                    pixel, BcDecodedPixelSize);
+    }
+}
+
+// The palettes of 8 blocks are computed with a channel per 32-bit lane, transposed to a palette
+// per 128-bit lane, and then looked up with a byte shuffle for 4 pixels of 2 blocks at a time
+uint64 BcDecoder::decodeColorBlocksAvx2(const unsigned char* blocks, uint64 blockSize,
+                                        uint64 blockCount, bool hasThreeColorMode,
+                                        unsigned char* pixels, uint64 rowPitch)
+{
+    __m256i blockOffsets = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                                              _mm256_set1_epi32(static_cast<int32>(blockSize)));
+
+    __m256i lowMask5 = _mm256_set1_epi32(0x1f);
+    __m256i lowMask6 = _mm256_set1_epi32(0x3f);
+    __m256i opaqueAlpha = _mm256_set1_epi32(static_cast<int32>(0xff000000));
+    __m256i one = _mm256_set1_epi32(1);
+    __m256i third = _mm256_set1_epi32(21846); // x / 3 == x * 21846 >> 16 for x < 767
+
+    __m256i blockSelections[4];
+    for (int32 i = 0; i < 4; i++)
+    {
+        blockSelections[i] = _mm256_setr_epi32(i, i, i, i, i + 4, i + 4, i + 4, i + 4);
+    }
+
+    __m256i indexShifts[BcBlockWidth];
+    for (int32 i = 0; i < static_cast<int32>(BcBlockWidth); i++)
+    {
+        indexShifts[i] = _mm256_setr_epi32(i * 8, i * 8 + 2, i * 8 + 4, i * 8 + 6, i * 8,
+                                           i * 8 + 2, i * 8 + 4, i * 8 + 6);
+    }
+
+    uint64 blockIndex = 0;
+    for (; blockIndex + 8 <= blockCount; blockIndex += 8)
+    {
+        const int32* blockData = reinterpret_cast<const int32*>(blocks + blockIndex * blockSize);
+        __m256i colors = _mm256_i32gather_epi32(blockData, blockOffsets, 1);
+        __m256i indexes = _mm256_i32gather_epi32(blockData + 1, blockOffsets, 1);
+
+        __m256i color0 = _mm256_and_si256(colors, _mm256_set1_epi32(0xffff));
+        __m256i color1 = _mm256_srli_epi32(colors, 16);
+
+        // Red, green and blue of both endpoints, expanded to 8 bits
+        __m256i channels[2][3];
+        __m256i endpointColors[2] = { color0, color1 };
+        for (int32 i = 0; i < 2; i++)
+        {
+            __m256i red = _mm256_and_si256(_mm256_srli_epi32(endpointColors[i], 11), lowMask5);
+            __m256i green = _mm256_and_si256(_mm256_srli_epi32(endpointColors[i], 5), lowMask6);
+            __m256i blue = _mm256_and_si256(endpointColors[i], lowMask5);
+
+            channels[i][0] = _mm256_or_si256(_mm256_slli_epi32(red, 3), _mm256_srli_epi32(red, 2));
+            channels[i][1] = _mm256_or_si256(_mm256_slli_epi32(green, 2),
+                                             _mm256_srli_epi32(green, 4));
+            channels[i][2] = _mm256_or_si256(_mm256_slli_epi32(blue, 3),
+                                             _mm256_srli_epi32(blue, 2));
+        }
+
+        __m256i palette[4] = { opaqueAlpha, opaqueAlpha, opaqueAlpha, opaqueAlpha };
+        __m256i halfColor = opaqueAlpha;
+        for (int32 i = 0; i < 3; i++)
+        {
+            __m256i channel0 = channels[0][i];
+            __m256i channel1 = channels[1][i];
+
+            __m256i channel2 = _mm256_mulhi_epu16(_mm256_add_epi32(_mm256_add_epi32(
+                _mm256_add_epi32(channel0, channel0), channel1), one), third);
+            __m256i channel3 = _mm256_mulhi_epu16(_mm256_add_epi32(_mm256_add_epi32(
+                _mm256_add_epi32(channel1, channel1), channel0), one), third);
+            __m256i halfChannel = _mm256_srli_epi32(_mm256_add_epi32(_mm256_add_epi32(channel0,
+                channel1), one), 1);
+
+            palette[0] = _mm256_or_si256(palette[0], _mm256_slli_epi32(channel0, i * 8));
+            palette[1] = _mm256_or_si256(palette[1], _mm256_slli_epi32(channel1, i * 8));
+            palette[2] = _mm256_or_si256(palette[2], _mm256_slli_epi32(channel2, i * 8));
+            palette[3] = _mm256_or_si256(palette[3], _mm256_slli_epi32(channel3, i * 8));
+            halfColor = _mm256_or_si256(halfColor, _mm256_slli_epi32(halfChannel, i * 8));
+        }
+
+        if (hasThreeColorMode)
+        {
+            __m256i isFourColor = _mm256_cmpgt_epi32(color0, color1);
+            palette[2] = _mm256_blendv_epi8(halfColor, palette[2], isFourColor);
+            palette[3] = _mm256_and_si256(palette[3], isFourColor);
+        }
+
+        __m256i low01 = _mm256_unpacklo_epi32(palette[0], palette[1]);
+        __m256i low23 = _mm256_unpacklo_epi32(palette[2], palette[3]);
+        __m256i high01 = _mm256_unpackhi_epi32(palette[0], palette[1]);
+        __m256i high23 = _mm256_unpackhi_epi32(palette[2], palette[3]);
+
+        // Blocks i and i + 4 in the low and high lanes
+        __m256i blockPalettes[4] = {
+            _mm256_unpacklo_epi64(low01, low23),
+            _mm256_unpackhi_epi64(low01, low23),
+            _mm256_unpacklo_epi64(high01, high23),
+            _mm256_unpackhi_epi64(high01, high23),
+        };
+
+        for (int32 i = 0; i < 4; i++)
+        {
+            __m256i blockIndexes = _mm256_permutevar8x32_epi32(indexes, blockSelections[i]);
+
+            unsigned char* lowPixels = pixels + (blockIndex + i) * BcBlockWidth *
+                BcDecodedPixelSize;
+            unsigned char* highPixels = lowPixels + 4 * BcBlockWidth * BcDecodedPixelSize;
+            for (uint32 j = 0; j < BcBlockWidth; j++)
+            {
+                __m256i pixelIndexes = _mm256_and_si256(_mm256_srlv_epi32(blockIndexes,
+                    indexShifts[j]), _mm256_set1_epi32(0x3));
+                __m256i shuffle = _mm256_add_epi32(_mm256_mullo_epi32(pixelIndexes,
+                    _mm256_set1_epi32(0x04040404)), _mm256_set1_epi32(0x03020100));
+                __m256i row = _mm256_shuffle_epi8(blockPalettes[i], shuffle);
+
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(lowPixels + j * rowPitch),
+                                 _mm256_castsi256_si128(row));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(highPixels + j * rowPitch),
+                                 _mm256_extracti128_si256(row, 1));
+            }
+        }
+    }
+
+    return blockIndex;
+}
+
+void BcDecoder::decodeExplicitAlphaBlocksAvx2(const unsigned char* blocks, uint64 blockSize,
+                                              uint64 blockCount, unsigned char* pixels,
+                                              uint64 rowPitch)
+{
+    __m128i spreadMasks[BcBlockWidth];
+    __m128i blendMask;
+    getChannelMasksAvx2(3, spreadMasks, blendMask);
+
+    __m128i lowMask = _mm_set1_epi8(0xf);
+    for (uint64 i = 0; i < blockCount; i++)
+    {
+        __m128i alphas = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(blocks + i *
+            blockSize));
+
+        // The low nibble of every byte is the first of its two pixels, a * 17 repeats it
+        alphas = _mm_unpacklo_epi8(_mm_and_si128(alphas, lowMask),
+                                   _mm_and_si128(_mm_srli_epi16(alphas, 4), lowMask));
+        alphas = _mm_or_si128(alphas, _mm_slli_epi16(alphas, 4));
+
+        storeChannelAvx2(alphas, spreadMasks, blendMask, pixels + i * BcBlockWidth *
+                         BcDecodedPixelSize, rowPitch);
+    }
+}
+
+// Every pixel is a 16-bit lane that gathers the two bytes holding its 3-bit index, and the
+// palette value is computed from the index instead of looked up
+void BcDecoder::decodeChannelBlocksAvx2(const unsigned char* blocks, uint64 blockSize,
+                                        uint64 blockCount, bool isSigned, uint32 channelIndex,
+                                        unsigned char* pixels, uint64 rowPitch)
+{
+    alignas(32) int8 gatherItems[BcBlockPixelCount * 2];
+    alignas(32) int16 multiplierItems[BcBlockPixelCount];
+    for (uint32 i = 0; i < BcBlockPixelCount; i++)
+    {
+        // The indexes follow the 2 endpoint bytes
+        uint32 bitOffset = 16 + i * 3;
+        uint32 byteIndex = bitOffset / 8;
+
+        // Shifts the index to the top 3 bits of the lane
+        gatherItems[i * 2] = static_cast<int8>(byteIndex);
+        gatherItems[i * 2 + 1] = byteIndex + 1 < 8 ? static_cast<int8>(byteIndex + 1) :
+            static_cast<int8>(0x80);
+        multiplierItems[i] = static_cast<int16>(1 << (13 - bitOffset % 8));
+    }
+    __m256i gather = _mm256_load_si256(reinterpret_cast<const __m256i*>(gatherItems));
+    __m256i multipliers = _mm256_load_si256(reinterpret_cast<const __m256i*>(multiplierItems));
+
+    // Weight of the second endpoint per index, out of 7 and out of 5. Index 0 maps to 0, which
+    // also clears the high byte of every lane
+    __m256i weights7 = _mm256_setr_epi8(0, 7, 1, 2, 3, 4, 5, 6, 0, 0, 0, 0, 0, 0, 0, 0, 0, 7, 1, 2,
+                                        3, 4, 5, 6, 0, 0, 0, 0, 0, 0, 0, 0);
+    __m256i weights5 = _mm256_setr_epi8(0, 5, 1, 2, 3, 4, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 5, 1, 2,
+                                        3, 4, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    __m256i seventh = _mm256_set1_epi16(9363); // x / 7 == x * 9363 >> 16 for x < 1789
+    __m256i fifth = _mm256_set1_epi16(13108); // x / 5 == x * 13108 >> 16 for x < 1278
+
+    __m128i spreadMasks[BcBlockWidth];
+    __m128i blendMask;
+    getChannelMasksAvx2(channelIndex, spreadMasks, blendMask);
+
+    int16 maxValue = isSigned ? 254 : 255;
+    for (uint64 i = 0; i < blockCount; i++)
+    {
+        const unsigned char* block = blocks + i * blockSize;
+
+        int16 endpoint0 = block[0];
+        int16 endpoint1 = block[1];
+        if (isSigned)
+        {
+            endpoint0 = static_cast<int8>(block[0]) < -127 ? 0 : static_cast<int8>(block[0]) + 127;
+            endpoint1 = static_cast<int8>(block[1]) < -127 ? 0 : static_cast<int8>(block[1]) + 127;
+        }
+
+        __m256i source = _mm256_broadcastsi128_si256(_mm_loadl_epi64(reinterpret_cast<const
+            __m128i*>(block)));
+        __m256i indexes = _mm256_srli_epi16(_mm256_mullo_epi16(_mm256_shuffle_epi8(source,
+            gather), multipliers), 13);
+
+        __m256i values;
+        if (endpoint0 > endpoint1)
+        {
+            __m256i weights = _mm256_shuffle_epi8(weights7, indexes);
+            values = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_sub_epi16(_mm256_set1_epi16(7),
+                weights), _mm256_set1_epi16(endpoint0)), _mm256_mullo_epi16(weights,
+                _mm256_set1_epi16(endpoint1)));
+            values = _mm256_mulhi_epu16(_mm256_add_epi16(values, _mm256_set1_epi16(3)), seventh);
+        }
+        else
+        {
+            __m256i weights = _mm256_shuffle_epi8(weights5, indexes);
+            values = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_sub_epi16(_mm256_set1_epi16(5),
+                weights), _mm256_set1_epi16(endpoint0)), _mm256_mullo_epi16(weights,
+                _mm256_set1_epi16(endpoint1)));
+            values = _mm256_mulhi_epu16(_mm256_add_epi16(values, _mm256_set1_epi16(2)), fifth);
+
+            // Indexes 6 and 7 are the minimum and the maximum
+            values = _mm256_andnot_si256(_mm256_cmpeq_epi16(indexes, _mm256_set1_epi16(6)), values);
+            values = _mm256_blendv_epi8(values, _mm256_set1_epi16(maxValue), _mm256_cmpeq_epi16(
+                indexes, _mm256_set1_epi16(7)));
+        }
+
+        if (isSigned)
+        {
+            values = _mm256_and_si256(_mm256_add_epi16(values, _mm256_set1_epi16(129)),
+                                      _mm256_set1_epi16(0xff));
+        }
+
+        __m128i channel = _mm256_castsi256_si128(_mm256_permute4x64_epi64(_mm256_packus_epi16(
+            values, values), 0x08));
+
+        storeChannelAvx2(channel, spreadMasks, blendMask, pixels + i * BcBlockWidth *
+                         BcDecodedPixelSize, rowPitch);
+    }
+}
+
+void BcDecoder::getChannelMasksAvx2(uint32 channelIndex, __m128i spreadMasks[BcBlockWidth],
+                                    __m128i& blendMask)
+{
+    alignas(16) int8 spreadItems[BcBlockWidth][16];
+    alignas(16) int8 blendItems[16];
+    for (uint32 i = 0; i < 16; i++)
+    {
+        bool isChannel = i % BcDecodedPixelSize == channelIndex;
+        for (uint32 j = 0; j < BcBlockWidth; j++)
+        {
+            spreadItems[j][i] = isChannel ? static_cast<int8>(j * BcBlockWidth + i /
+                BcDecodedPixelSize) : static_cast<int8>(0x80);
+        }
+        blendItems[i] = isChannel ? -1 : 0;
+    }
+
+    for (uint32 i = 0; i < BcBlockWidth; i++)
+    {
+        spreadMasks[i] = _mm_load_si128(reinterpret_cast<const __m128i*>(spreadItems[i]));
+    }
+    blendMask = _mm_load_si128(reinterpret_cast<const __m128i*>(blendItems));
+}
+
+// Replaces one byte of every pixel of a block with the 16 values of a channel
+void BcDecoder::storeChannelAvx2(__m128i channel, const __m128i spreadMasks[BcBlockWidth],
+                                 __m128i blendMask, unsigned char* pixels, uint64 rowPitch)
+{
+    for (uint32 i = 0; i < BcBlockWidth; i++)
+    {
+        __m128i* row = reinterpret_cast<__m128i*>(pixels + i * rowPitch);
+        _mm_storeu_si128(row, _mm_blendv_epi8(_mm_loadu_si128(row), _mm_shuffle_epi8(channel,
+                                              spreadMasks[i]), blendMask));
+    }
+}
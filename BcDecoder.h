@@ -0,0 +1,121 @@
+#pragma once
+#include <d3d11.h>
+#include <immintrin.h>
+
+#include <cstring>
+
+#include <vector>
+
+#include <algorithm>
+
+#include <chrono>
+#include <thread>
+
+#include "BcDecoderUtility.h"
+#include "CpuUtility.h"
+#include "DdsUtility.h"
+#include "ImageFileParserUtility.h"
+#include "IntUtility.h"
+
+// Decodes BC1 to BC5 and BC7 blocks to R8G8B8A8 on the CPU. With AVX2, BC1 to BC3 colors are
+// decoded 8 blocks per iteration and the BC3 to BC5 channels 16 pixels per instruction; BC7, whose
+// layout changes from block to block, is decoded one block at a time. Images are split between
+// threads in ranges of blocks
+class BcDecoder
+{
+    BcDecoderSettings settings;
+
+    BcDecoderStatistics statistics;
+
+public:
+    BcDecoder();
+
+    BcDecoderSettings getSettings();
+    void setSettings(BcDecoderSettings settings);
+
+    BcDecoderStatistics getStatistics();
+
+    // Decodes every subresource to the format getBcDecodedFormat gives, with the rows of pixels
+    // tightly packed and the subresources back to back in the same order
+    bool decodeImage(const ImageData& imageData, ImageData& decodedImageData);
+    // Decodes consecutive blocks of a block row into 4 rows of blockCount * 4 pixels
+    bool decodeBlockRow(DXGI_FORMAT format, const unsigned char* blocks, uint64 blockCount,
+                        unsigned char* pixels, uint64 rowPitch);
+
+private:
+    template <typename Function>
+    uint32 forEachBlockRange(uint64 blockCount, Function function);
+
+    void decodeBlocks(DXGI_FORMAT format, CpuInstructionSet instructionSet,
+                      const unsigned char* blocks, uint64 blockCount, unsigned char* pixels,
+                      uint64 rowPitch);
+    void fillPixels(uint32 pixel, uint64 blockCount, unsigned char* pixels, uint64 rowPitch);
+
+    // BC1 blocks have a 3-color mode with transparent black, the color blocks of BC2 and BC3
+    // always have 4 colors
+    void decodeColorBlocks(const unsigned char* blocks, uint64 blockSize, uint64 blockCount,
+                           bool hasThreeColorMode, CpuInstructionSet instructionSet,
+                           unsigned char* pixels, uint64 rowPitch);
+    void decodeExplicitAlphaBlocks(const unsigned char* blocks, uint64 blockSize,
+                                   uint64 blockCount, CpuInstructionSet instructionSet,
+                                   unsigned char* pixels, uint64 rowPitch);
+    // Writes one byte of every pixel from the BC4-style blocks of the alpha of BC3, the red of
+    // BC4 and the red and green of BC5
+    void decodeChannelBlocks(const unsigned char* blocks, uint64 blockSize, uint64 blockCount,
+                             bool isSigned, uint32 channelIndex,
+                             CpuInstructionSet instructionSet, unsigned char* pixels,
+                             uint64 rowPitch);
+
+    void decodeColorBlock(const unsigned char* block, bool hasThreeColorMode,
+                          unsigned char* pixels, uint64 rowPitch);
+    void decodeExplicitAlphaBlock(const unsigned char* block, unsigned char* pixels,
+                                  uint64 rowPitch);
+    void decodeChannelBlock(const unsigned char* block, bool isSigned, uint32 channelIndex,
+                            unsigned char* pixels, uint64 rowPitch);
+    void decodeBc7Block(const unsigned char* block, unsigned char* pixels, uint64 rowPitch);
+
+    // Decode whole groups of 8 blocks and return how many blocks they decoded
+    uint64 decodeColorBlocksAvx2(const unsigned char* blocks, uint64 blockSize, uint64 blockCount,
+                                 bool hasThreeColorMode, unsigned char* pixels, uint64 rowPitch);
+    void decodeExplicitAlphaBlocksAvx2(const unsigned char* blocks, uint64 blockSize,
+                                       uint64 blockCount, unsigned char* pixels, uint64 rowPitch);
+    void decodeChannelBlocksAvx2(const unsigned char* blocks, uint64 blockSize, uint64 blockCount,
+                                 bool isSigned, uint32 channelIndex, unsigned char* pixels,
+                                 uint64 rowPitch);
+
+    void getChannelMasksAvx2(uint32 channelIndex, __m128i spreadMasks[BcBlockWidth],
+                             __m128i& blendMask);
+    void storeChannelAvx2(__m128i channel, const __m128i spreadMasks[BcBlockWidth],
+                          __m128i blendMask, unsigned char* pixels, uint64 rowPitch);
+};
+
+template <typename Function>
+uint32 BcDecoder::forEachBlockRange(uint64 blockCount, Function function)
+{
+    uint64 rangeCount = blockCount / BcDecoderMinBlockRangeSize;
+    if (rangeCount > settings.threadCount)
+    {
+        rangeCount = settings.threadCount;
+    }
+    if (rangeCount == 0)
+    {
+        rangeCount = 1;
+    }
+
+    std::vector<std::thread> threads;
+    threads.reserve(rangeCount - 1);
+    for (uint64 i = 1; i < rangeCount; i++)
+    {
+        threads.emplace_back(function, blockCount * i / rangeCount,
+                             blockCount * (i + 1) / rangeCount);
+    }
+
+    function(0, blockCount / rangeCount);
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    return static_cast<uint32>(rangeCount);
+}
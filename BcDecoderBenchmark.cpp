@@ -0,0 +1,147 @@
+#include "BcDecoderBenchmark.h"
+
+BcDecoderBenchmark::BcDecoderBenchmark() : settings{}
+{
+    settings.repeatCount = 1;
+}
+
+BenchmarkSettings BcDecoderBenchmark::getSettings()
+{
+    return settings;
+}
+
+void BcDecoderBenchmark::setSettings(BenchmarkSettings settings)
+{
+    this->settings = settings;
+}
+
+bool BcDecoderBenchmark::run()
+{
+    struct Format
+    {
+        const char* name;
+        DXGI_FORMAT format;
+    };
+    const Format formats[] = {
+        { "BC1", DXGI_FORMAT_BC1_UNORM },
+        { "BC2", DXGI_FORMAT_BC2_UNORM },
+        { "BC3", DXGI_FORMAT_BC3_UNORM },
+        { "BC4", DXGI_FORMAT_BC4_UNORM },
+        { "BC4 signed", DXGI_FORMAT_BC4_SNORM },
+        { "BC5", DXGI_FORMAT_BC5_UNORM },
+        { "BC5 signed", DXGI_FORMAT_BC5_SNORM },
+        { "BC7", DXGI_FORMAT_BC7_UNORM },
+    };
+    const CpuInstructionSet instructionSets[] = {
+        CpuInstructionSet::Scalar,
+        CpuInstructionSet::Avx2,
+    };
+
+    std::printf("BC decoding: %ux%u pixels, %u threads\n", BcDecoderBenchmarkImageSize,
+                BcDecoderBenchmarkImageSize, settings.threadCount);
+
+    for (const Format& format : formats)
+    {
+        ImageData imageData = {};
+        getImage(format.format, imageData);
+
+        std::printf("  %s:", format.name);
+
+        const char* separator = " ";
+        ImageData scalarImageData = {};
+        for (CpuInstructionSet instructionSet : instructionSets)
+        {
+            if (getCpuInstructionSet(instructionSet) != instructionSet)
+            {
+                continue;
+            }
+
+            BcDecoderStatistics statistics = {};
+            ImageData decodedImageData = {};
+            bool result = decodeImage(imageData, instructionSet, statistics, decodedImageData);
+            if (!result)
+            {
+                std::printf("\nFailed to decode the %s blocks\n", format.name);
+
+                return false;
+            }
+
+            std::printf("%s%s %.0f blocks/ms %.2f GB/s", separator,
+                        getCpuInstructionSetName(instructionSet), statistics.blockThroughput,
+                        statistics.throughput);
+            separator = ", ";
+
+            if (instructionSet == CpuInstructionSet::Scalar)
+            {
+                scalarImageData = std::move(decodedImageData);
+            }
+            else if (decodedImageData.data != scalarImageData.data)
+            {
+                std::printf("\n  %s differs from scalar\n",
+                            getCpuInstructionSetName(instructionSet));
+
+                return false;
+            }
+        }
+
+        std::printf("\n");
+    }
+
+    return true;
+}
+
+void BcDecoderBenchmark::getImage(DXGI_FORMAT format, ImageData& imageData)
+{
+    imageData = {};
+    imageData.width = BcDecoderBenchmarkImageSize;
+    imageData.height = BcDecoderBenchmarkImageSize;
+    imageData.depth = 1;
+    imageData.format = format;
+    imageData.mipmapLevels = 1;
+    imageData.arraySize = 1;
+
+    uint64 blockRowCount = getBcBlockCount(BcDecoderBenchmarkImageSize);
+
+    ImageSubresourceData subresourceData = {};
+    subresourceData.rowPitch = blockRowCount * getImageFormatBlockSize(format);
+    subresourceData.depthPitch = subresourceData.rowPitch * blockRowCount;
+    imageData.subresourceDataItems.push_back(subresourceData);
+
+    // Random blocks use every mode and both endpoint orders
+    imageData.data.resize(subresourceData.depthPitch);
+    uint32 state = 1;
+    for (unsigned char& value : imageData.data)
+    {
+        state = state * 1664525u + 1013904223u;
+        value = static_cast<unsigned char>(state >> 24);
+    }
+}
+
+bool BcDecoderBenchmark::decodeImage(const ImageData& imageData,
+                                     CpuInstructionSet instructionSet,
+                                     BcDecoderStatistics& statistics,
+                                     ImageData& decodedImageData)
+{
+    BcDecoder bcDecoder;
+    BcDecoderSettings decoderSettings = bcDecoder.getSettings();
+    decoderSettings.instructionSet = instructionSet;
+    decoderSettings.threadCount = settings.threadCount;
+    bcDecoder.setSettings(decoderSettings);
+
+    for (uint32 i = 0; i < settings.repeatCount; i++)
+    {
+        bool result = bcDecoder.decodeImage(imageData, decodedImageData);
+        if (!result)
+        {
+            return false;
+        }
+
+        BcDecoderStatistics runStatistics = bcDecoder.getStatistics();
+        if (i == 0 || runStatistics.decodingTime < statistics.decodingTime)
+        {
+            statistics = runStatistics;
+        }
+    }
+
+    return true;
+}
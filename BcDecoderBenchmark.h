@@ -0,0 +1,38 @@
+#pragma once
+#include <d3d11.h>
+
+#include <cstdio>
+#include <cstring>
+
+#include <vector>
+
+#include "BcDecoder.h"
+
+#include "BcDecoderUtility.h"
+#include "BenchmarkUtility.h"
+#include "CpuUtility.h"
+#include "ImageFileParserUtility.h"
+#include "IntUtility.h"
+
+// Decodes a generated image of random blocks of every BC format with the scalar and AVX2 code,
+// checks that AVX2 gives the scalar result and prints the blocks per millisecond and GB/s written
+// of both. BC7 has no AVX2 code, both of its columns measure the scalar decoder
+class BcDecoderBenchmark
+{
+    BenchmarkSettings settings;
+
+public:
+    BcDecoderBenchmark();
+
+    BenchmarkSettings getSettings();
+    void setSettings(BenchmarkSettings settings);
+
+    bool run();
+
+private:
+    void getImage(DXGI_FORMAT format, ImageData& imageData);
+
+    // Of the fastest run
+    bool decodeImage(const ImageData& imageData, CpuInstructionSet instructionSet,
+                     BcDecoderStatistics& statistics, ImageData& decodedImageData);
+};
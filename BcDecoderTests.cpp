@@ -0,0 +1,419 @@
+#include "BcDecoderTests.h"
+
+struct BcReferenceBlock
+{
+    const char* name;
+    DXGI_FORMAT format;
+    unsigned char block[DdsBc2BlockSize]; // BC1 and BC4 blocks use the first half
+    unsigned char pixels[BcBlockPixelCount * BcDecodedPixelSize]; // R8G8B8A8, row by row
+};
+
+// BC1 to BC5 pixels follow the D3D rules, interpolated values rounded to the nearest, BC7 ones
+// follow the BC7 specification
+static const BcReferenceBlock BcReferenceBlocks[] = {
+    {
+        // Color0 > color1, 4 colors
+        "Bc1FourColor", DXGI_FORMAT_BC1_UNORM,
+        {
+            0x1f, 0xf8, 0xe0, 0x07, 0xe4, 0xe4, 0xff, 0xff
+        },
+        {
+            0xff, 0x00, 0xff, 0xff, 0x00, 0xff, 0x00, 0xff,
+            0xaa, 0x55, 0xaa, 0xff, 0x55, 0xaa, 0x55, 0xff,
+            0xff, 0x00, 0xff, 0xff, 0x00, 0xff, 0x00, 0xff,
+            0xaa, 0x55, 0xaa, 0xff, 0x55, 0xaa, 0x55, 0xff,
+            0x55, 0xaa, 0x55, 0xff, 0x55, 0xaa, 0x55, 0xff,
+            0x55, 0xaa, 0x55, 0xff, 0x55, 0xaa, 0x55, 0xff,
+            0x55, 0xaa, 0x55, 0xff, 0x55, 0xaa, 0x55, 0xff,
+            0x55, 0xaa, 0x55, 0xff, 0x55, 0xaa, 0x55, 0xff
+        },
+    },
+    {
+        // Color0 <= color1, 3 colors and transparent black
+        "Bc1ThreeColor", DXGI_FORMAT_BC1_UNORM,
+        {
+            0x08, 0x42, 0x18, 0xc6, 0x1b, 0x55, 0xaa, 0xff
+        },
+        {
+            0x00, 0x00, 0x00, 0x00, 0x84, 0x82, 0x84, 0xff,
+            0xc6, 0xc3, 0xc6, 0xff, 0x42, 0x41, 0x42, 0xff,
+            0xc6, 0xc3, 0xc6, 0xff, 0xc6, 0xc3, 0xc6, 0xff,
+            0xc6, 0xc3, 0xc6, 0xff, 0xc6, 0xc3, 0xc6, 0xff,
+            0x84, 0x82, 0x84, 0xff, 0x84, 0x82, 0x84, 0xff,
+            0x84, 0x82, 0x84, 0xff, 0x84, 0x82, 0x84, 0xff,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+        },
+    },
+    {
+        // Every explicit alpha value
+        "Bc2", DXGI_FORMAT_BC2_UNORM,
+        {
+            0x10, 0x32, 0x54, 0x76, 0x98, 0xba, 0xdc, 0xfe,
+            0x20, 0xfd, 0x41, 0x08, 0x1b, 0xe4, 0xc6, 0x39
+        },
+        {
+            0x5a, 0x3d, 0x05, 0x00, 0xad, 0x71, 0x03, 0x11,
+            0x08, 0x08, 0x08, 0x22, 0xff, 0xa6, 0x00, 0x33,
+            0xff, 0xa6, 0x00, 0x44, 0x08, 0x08, 0x08, 0x55,
+            0xad, 0x71, 0x03, 0x66, 0x5a, 0x3d, 0x05, 0x77,
+            0xad, 0x71, 0x03, 0x88, 0x08, 0x08, 0x08, 0x99,
+            0xff, 0xa6, 0x00, 0xaa, 0x5a, 0x3d, 0x05, 0xbb,
+            0x08, 0x08, 0x08, 0xcc, 0xad, 0x71, 0x03, 0xdd,
+            0x5a, 0x3d, 0x05, 0xee, 0xff, 0xa6, 0x00, 0xff
+        },
+    },
+    {
+        // Alpha0 > alpha1, 8 alpha values
+        "Bc3EightAlpha", DXGI_FORMAT_BC3_UNORM,
+        {
+            0xf0, 0x10, 0x88, 0xc6, 0xfa, 0x11, 0x53, 0x97,
+            0xff, 0x07, 0x00, 0xf8, 0x1b, 0xe4, 0x72, 0x8d
+        },
+        {
+            0xaa, 0x55, 0x55, 0xf0, 0x55, 0xaa, 0xaa, 0x10,
+            0xff, 0x00, 0x00, 0xd0, 0x00, 0xff, 0xff, 0xb0,
+            0x00, 0xff, 0xff, 0x90, 0xff, 0x00, 0x00, 0x70,
+            0x55, 0xaa, 0xaa, 0x50, 0xaa, 0x55, 0x55, 0x30,
+            0x55, 0xaa, 0xaa, 0x10, 0x00, 0xff, 0xff, 0xd0,
+            0xaa, 0x55, 0x55, 0x90, 0xff, 0x00, 0x00, 0x10,
+            0xff, 0x00, 0x00, 0x70, 0xaa, 0x55, 0x55, 0x50,
+            0x00, 0xff, 0xff, 0x70, 0x55, 0xaa, 0xaa, 0x90
+        },
+    },
+    {
+        // Alpha0 <= alpha1, 6 alpha values, 0 and 255
+        "Bc3SixAlpha", DXGI_FORMAT_BC3_UNORM,
+        {
+            0x20, 0xe0, 0x88, 0xc6, 0xfa, 0x11, 0x53, 0x97,
+            0xff, 0x07, 0x00, 0xf8, 0x1b, 0xe4, 0x72, 0x8d
+        },
+        {
+            0xaa, 0x55, 0x55, 0x20, 0x55, 0xaa, 0xaa, 0xe0,
+            0xff, 0x00, 0x00, 0x46, 0x00, 0xff, 0xff, 0x6d,
+            0x00, 0xff, 0xff, 0x93, 0xff, 0x00, 0x00, 0xba,
+            0x55, 0xaa, 0xaa, 0x00, 0xaa, 0x55, 0x55, 0xff,
+            0x55, 0xaa, 0xaa, 0xe0, 0x00, 0xff, 0xff, 0x46,
+            0xaa, 0x55, 0x55, 0x93, 0xff, 0x00, 0x00, 0xe0,
+            0xff, 0x00, 0x00, 0xba, 0xaa, 0x55, 0x55, 0x00,
+            0x00, 0xff, 0xff, 0xba, 0x55, 0xaa, 0xaa, 0x93
+        },
+    },
+    {
+        "Bc4Unorm", DXGI_FORMAT_BC4_UNORM,
+        {
+            0xc8, 0x18, 0x88, 0xc6, 0xfa, 0x11, 0x53, 0x97
+        },
+        {
+            0xc8, 0x00, 0x00, 0xff, 0x18, 0x00, 0x00, 0xff,
+            0xaf, 0x00, 0x00, 0xff, 0x96, 0x00, 0x00, 0xff,
+            0x7d, 0x00, 0x00, 0xff, 0x63, 0x00, 0x00, 0xff,
+            0x4a, 0x00, 0x00, 0xff, 0x31, 0x00, 0x00, 0xff,
+            0x18, 0x00, 0x00, 0xff, 0xaf, 0x00, 0x00, 0xff,
+            0x7d, 0x00, 0x00, 0xff, 0x18, 0x00, 0x00, 0xff,
+            0x63, 0x00, 0x00, 0xff, 0x4a, 0x00, 0x00, 0xff,
+            0x63, 0x00, 0x00, 0xff, 0x7d, 0x00, 0x00, 0xff
+        },
+    },
+    {
+        // -128 is read as -127, 6 values, -127 and 127
+        "Bc4SnormSixValue", DXGI_FORMAT_BC4_SNORM,
+        {
+            0x80, 0x60, 0x88, 0xc6, 0xfa, 0x11, 0x53, 0x97
+        },
+        {
+            0x81, 0x00, 0x00, 0x7f, 0x60, 0x00, 0x00, 0x7f,
+            0xae, 0x00, 0x00, 0x7f, 0xda, 0x00, 0x00, 0x7f,
+            0x07, 0x00, 0x00, 0x7f, 0x33, 0x00, 0x00, 0x7f,
+            0x81, 0x00, 0x00, 0x7f, 0x7f, 0x00, 0x00, 0x7f,
+            0x60, 0x00, 0x00, 0x7f, 0xae, 0x00, 0x00, 0x7f,
+            0x07, 0x00, 0x00, 0x7f, 0x60, 0x00, 0x00, 0x7f,
+            0x33, 0x00, 0x00, 0x7f, 0x81, 0x00, 0x00, 0x7f,
+            0x33, 0x00, 0x00, 0x7f, 0x07, 0x00, 0x00, 0x7f
+        },
+    },
+    {
+        // Red with 8 values, green with 6
+        "Bc5Unorm", DXGI_FORMAT_BC5_UNORM,
+        {
+            0x40, 0xf8, 0x05, 0x39, 0x77, 0xae, 0xf1, 0x2c,
+            0xff, 0x00, 0xd1, 0x58, 0x2b, 0x6e, 0x90, 0x4a
+        },
+        {
+            0xd3, 0x00, 0x00, 0xff, 0x40, 0xdb, 0x00, 0xff,
+            0xae, 0xb6, 0x00, 0xff, 0xae, 0x92, 0x00, 0xff,
+            0x8a, 0x6d, 0x00, 0xff, 0x00, 0x49, 0x00, 0xff,
+            0xd3, 0xdb, 0x00, 0xff, 0x8a, 0x00, 0x00, 0xff,
+            0x00, 0x49, 0x00, 0xff, 0xd3, 0x6d, 0x00, 0xff,
+            0x00, 0x00, 0x00, 0xff, 0x40, 0xff, 0x00, 0xff,
+            0xff, 0x00, 0x00, 0xff, 0xf8, 0x6d, 0x00, 0xff,
+            0x8a, 0xdb, 0x00, 0xff, 0xf8, 0xdb, 0x00, 0xff
+        },
+    },
+    {
+        "Bc7Mode0", DXGI_FORMAT_BC7_UNORM,
+        {
+            0x53, 0xf2, 0x26, 0x65, 0xa6, 0x0c, 0x12, 0xd2,
+            0x89, 0x18, 0x5d, 0x95, 0x0e, 0xe8, 0x81, 0x36
+        },
+        {
+            0x52, 0x31, 0x3e, 0xff, 0x41, 0x31, 0x2a, 0xff,
+            0x74, 0x31, 0x6a, 0xff, 0x41, 0x31, 0x2a, 0xff,
+            0x63, 0x59, 0xbb, 0xff, 0x39, 0x6b, 0x4a, 0xff,
+            0x73, 0x52, 0xe7, 0xff, 0x73, 0x52, 0xe7, 0xff,
+            0x63, 0x59, 0xbb, 0xff, 0x41, 0x67, 0x60, 0xff,
+            0x5b, 0x5d, 0xa5, 0xff, 0x73, 0x52, 0xe7, 0xff,
+            0x56, 0x5a, 0x93, 0xff, 0x38, 0x86, 0xba, 0xff,
+            0x38, 0x86, 0xba, 0xff, 0x94, 0x00, 0x42, 0xff
+        },
+    },
+    {
+        "Bc7Mode1", DXGI_FORMAT_BC7_UNORM,
+        {
+            0x0a, 0x16, 0x6f, 0x6b, 0x11, 0x3d, 0x17, 0x8d,
+            0x6c, 0x0f, 0xd3, 0x90, 0x1f, 0xf2, 0x39, 0xa1
+        },
+        {
+            0x5a, 0x46, 0x36, 0xff, 0x8a, 0x4a, 0x48, 0xff,
+            0xcb, 0xb5, 0xbe, 0xff, 0x9a, 0x64, 0x64, 0xff,
+            0xb2, 0x98, 0x8c, 0xff, 0x6a, 0x16, 0x0e, 0xff,
+            0xab, 0x81, 0x85, 0xff, 0xdb, 0xcf, 0xdb, 0xff,
+            0x70, 0x5a, 0x4b, 0xff, 0x6a, 0x16, 0x0e, 0xff,
+            0xab, 0x81, 0x85, 0xff, 0x7a, 0x30, 0x2b, 0xff,
+            0x70, 0x5a, 0x4b, 0xff, 0xcb, 0xb5, 0xbe, 0xff,
+            0x9a, 0x64, 0x64, 0xff, 0xbb, 0x9b, 0xa1, 0xff
+        },
+    },
+    {
+        "Bc7Mode2", DXGI_FORMAT_BC7_UNORM,
+        {
+            0xa4, 0x95, 0xf2, 0x0f, 0x93, 0x95, 0x65, 0x0c,
+            0xf9, 0x38, 0x0b, 0x8e, 0xdb, 0x22, 0x4a, 0x6b
+        },
+        {
+            0x52, 0x80, 0x4c, 0xff, 0x90, 0x49, 0x4c, 0xff,
+            0x21, 0xce, 0x73, 0xff, 0x57, 0x8d, 0x60, 0xff,
+            0x52, 0x5a, 0x39, 0xff, 0xf7, 0x94, 0xb5, 0xff,
+            0xce, 0x91, 0x7a, 0xff, 0xf7, 0x94, 0xb5, 0xff,
+            0x52, 0x80, 0x4c, 0xff, 0xce, 0x91, 0x7a, 0xff,
+            0xa4, 0x8f, 0x3b, 0xff, 0xa4, 0x8f, 0x3b, 0xff,
+            0x52, 0x80, 0x4c, 0xff, 0x90, 0x49, 0x4c, 0xff,
+            0x21, 0xce, 0x73, 0xff, 0xc6, 0x08, 0x39, 0xff
+        },
+    },
+    {
+        "Bc7Mode3", DXGI_FORMAT_BC7_UNORM,
+        {
+            0x28, 0x8a, 0x1e, 0x92, 0x4e, 0x8f, 0xd0, 0xae,
+            0x2e, 0x1a, 0x94, 0x92, 0xa3, 0x30, 0x5f, 0x18
+        },
+        {
+            0x44, 0x7a, 0x16, 0xff, 0x25, 0xdb, 0x29, 0xff,
+            0x38, 0x55, 0x18, 0xff, 0x2c, 0xcb, 0x34, 0xff,
+            0x25, 0xdb, 0x29, 0xff, 0x2b, 0x2e, 0x19, 0xff,
+            0x2c, 0xcb, 0x34, 0xff, 0x44, 0x7a, 0x16, 0xff,
+            0x1f, 0x09, 0x1b, 0xff, 0x3b, 0xab, 0x4b, 0xff,
+            0x38, 0x55, 0x18, 0xff, 0x2c, 0xcb, 0x34, 0xff,
+            0x25, 0xdb, 0x29, 0xff, 0x2b, 0x2e, 0x19, 0xff,
+            0x2c, 0xcb, 0x34, 0xff, 0x44, 0x7a, 0x16, 0xff
+        },
+    },
+    {
+        "Bc7Mode4", DXGI_FORMAT_BC7_UNORM,
+        {
+            0x90, 0xb6, 0x10, 0x90, 0x0f, 0x9e, 0x34, 0x7f,
+            0xae, 0x88, 0x6d, 0xc6, 0x50, 0x77, 0x95, 0xec
+        },
+        {
+            0x8e, 0x18, 0xa4, 0xa4, 0x50, 0x09, 0x63, 0x63,
+            0xa1, 0x1c, 0xb9, 0xa4, 0x7a, 0x13, 0x8f, 0x63,
+            0x64, 0x0e, 0x78, 0x24, 0xa1, 0x1c, 0xb9, 0x24,
+            0x64, 0x0e, 0x78, 0x24, 0x8e, 0x18, 0xa4, 0xe3,
+            0x29, 0x00, 0x39, 0x24, 0x3d, 0x05, 0x4e, 0xa4,
+            0x50, 0x09, 0x63, 0xa4, 0x8e, 0x18, 0xa4, 0xa4,
+            0xa1, 0x1c, 0xb9, 0xe3, 0xa1, 0x1c, 0xb9, 0xa4,
+            0x7a, 0x13, 0x8f, 0xe3, 0x29, 0x00, 0x39, 0x24
+        },
+    },
+    {
+        "Bc7Mode5", DXGI_FORMAT_BC7_UNORM,
+        {
+            0x60, 0x5c, 0x4c, 0x3f, 0xcb, 0x2e, 0xb2, 0xc7,
+            0x3e, 0x14, 0x93, 0x4c, 0x86, 0x7e, 0xe0, 0x57
+        },
+        {
+            0xd9, 0xe3, 0xbf, 0x8c, 0xd9, 0xb3, 0x8b, 0x30,
+            0xec, 0xe3, 0xbf, 0x8c, 0xc4, 0xfb, 0xd9, 0xb9,
+            0xc4, 0xcb, 0xa5, 0x5d, 0xb1, 0xcb, 0xa5, 0x5d,
+            0xb1, 0xfb, 0xd9, 0xb9, 0xd9, 0xcb, 0xa5, 0x5d,
+            0xec, 0xe3, 0xbf, 0x8c, 0xec, 0xcb, 0xa5, 0x5d,
+            0xc4, 0xfb, 0xd9, 0xb9, 0xb1, 0xe3, 0xbf, 0x8c,
+            0xb1, 0xcb, 0xa5, 0x5d, 0xd9, 0xe3, 0xbf, 0x8c,
+            0xd9, 0xcb, 0xa5, 0x5d, 0xd9, 0xfb, 0xd9, 0xb9
+        },
+    },
+    {
+        "Bc7Mode6", DXGI_FORMAT_BC7_UNORM,
+        {
+            0xc0, 0x72, 0x49, 0x9b, 0xfa, 0x12, 0x1e, 0x83,
+            0x6b, 0x2a, 0xc1, 0x57, 0x26, 0xee, 0x7d, 0x6b
+        },
+        {
+            0xa1, 0x95, 0x83, 0x17, 0x97, 0x8d, 0x75, 0x15,
+            0x75, 0x73, 0x45, 0x0f, 0xb9, 0xa7, 0xa5, 0x1c,
+            0xc3, 0xaf, 0xb4, 0x1e, 0x65, 0x67, 0x2e, 0x0c,
+            0x8f, 0x87, 0x6a, 0x14, 0xa1, 0x95, 0x83, 0x17,
+            0x97, 0x8d, 0x75, 0x15, 0xb9, 0xa7, 0xa5, 0x1c,
+            0x53, 0x59, 0x14, 0x09, 0x53, 0x59, 0x14, 0x09,
+            0x5d, 0x61, 0x23, 0x0a, 0x8f, 0x87, 0x6a, 0x14,
+            0x6d, 0x6d, 0x39, 0x0d, 0x97, 0x8d, 0x75, 0x15
+        },
+    },
+    {
+        "Bc7Mode7", DXGI_FORMAT_BC7_UNORM,
+        {
+            0x80, 0xf6, 0xab, 0x13, 0xc3, 0x8e, 0x92, 0xca,
+            0xe0, 0xd1, 0x50, 0x57, 0xb1, 0x59, 0x98, 0x7f
+        },
+        {
+            0x7d, 0x86, 0x55, 0xa6, 0xb7, 0x48, 0x53, 0x75,
+            0xaa, 0x46, 0x2a, 0x92, 0x9b, 0xca, 0xa4, 0x3c,
+            0x8c, 0xa7, 0x7c, 0x72, 0x9b, 0xca, 0xa4, 0x3c,
+            0xaa, 0x46, 0x2a, 0x92, 0xaa, 0x46, 0x2a, 0x92,
+            0x9e, 0x45, 0x04, 0xae, 0x9b, 0xca, 0xa4, 0x3c,
+            0x8c, 0xa7, 0x7c, 0x72, 0xb7, 0x48, 0x53, 0x75,
+            0xc3, 0x49, 0x79, 0x59, 0xc3, 0x49, 0x79, 0x59,
+            0xaa, 0xeb, 0xcb, 0x08, 0x8c, 0xa7, 0x7c, 0x72
+        },
+    },
+    {
+        // Alpha swapped with green, color indexes from the 3-bit ones
+        "Bc7Mode4RotatedSwapped", DXGI_FORMAT_BC7_UNORM,
+        {
+            0xd0, 0xcc, 0x74, 0x11, 0xd7, 0x17, 0xf1, 0x45,
+            0x79, 0xb2, 0xaa, 0x10, 0x0f, 0xbb, 0xb3, 0x4f
+        },
+        {
+            0x5c, 0x7d, 0x85, 0xd0, 0x3f, 0x57, 0x68, 0x4f,
+            0x55, 0x45, 0x7e, 0xb0, 0x63, 0x45, 0x8c, 0xef,
+            0x5c, 0x57, 0x85, 0xd0, 0x38, 0x7d, 0x61, 0x2f,
+            0x4e, 0x57, 0x77, 0x91, 0x63, 0x57, 0x8c, 0xef,
+            0x4e, 0x7d, 0x77, 0x91, 0x31, 0x45, 0x5a, 0x10,
+            0x38, 0x45, 0x61, 0x2f, 0x5c, 0x7d, 0x85, 0xd0,
+            0x4e, 0x6b, 0x77, 0x91, 0x31, 0x57, 0x5a, 0x10,
+            0x4e, 0x6b, 0x77, 0x91, 0x55, 0x6b, 0x7e, 0xb0
+        },
+    },
+    {
+        // Alpha swapped with blue
+        "Bc7Mode5Rotated", DXGI_FORMAT_BC7_UNORM,
+        {
+            0xe0, 0x93, 0xfe, 0xae, 0xd2, 0x72, 0x48, 0xb7,
+            0x62, 0xe3, 0xab, 0x58, 0x05, 0xf0, 0x76, 0x5a
+        },
+        {
+            0x26, 0x76, 0xd2, 0x5a, 0x26, 0x76, 0xc6, 0x5a,
+            0xfb, 0x2a, 0xd2, 0x1c, 0xb5, 0x43, 0xd2, 0x30,
+            0x6c, 0x5d, 0xd2, 0x46, 0x26, 0x76, 0xd2, 0x5a,
+            0xfb, 0x2a, 0xad, 0x1c, 0xfb, 0x2a, 0xad, 0x1c,
+            0x6c, 0x5d, 0xb9, 0x46, 0x6c, 0x5d, 0xc6, 0x46,
+            0x6c, 0x5d, 0xad, 0x46, 0x6c, 0x5d, 0xc6, 0x46,
+            0x26, 0x76, 0xb9, 0x5a, 0xfb, 0x2a, 0xb9, 0x1c,
+            0xb5, 0x43, 0xc6, 0x30, 0xb5, 0x43, 0xc6, 0x30
+        },
+    },
+    {
+        // Transparent black
+        "Bc7Reserved", DXGI_FORMAT_BC7_UNORM,
+        {
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+        },
+        {
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+        },
+    },
+};
+
+BcDecoderTests::BcDecoderTests() : statistics{}
+{
+}
+
+TestStatistics BcDecoderTests::getStatistics()
+{
+    return statistics;
+}
+
+void BcDecoderTests::run()
+{
+    statistics = {};
+
+    const CpuInstructionSet instructionSets[] = {
+        CpuInstructionSet::Scalar,
+        CpuInstructionSet::Avx2,
+    };
+    for (CpuInstructionSet instructionSet : instructionSets)
+    {
+        // Instruction sets the CPU doesn't have would only test a narrower one again
+        if (getCpuInstructionSet(instructionSet) != instructionSet)
+        {
+            continue;
+        }
+
+        for (uint32 i = 0; i < sizeof(BcReferenceBlocks) / sizeof(BcReferenceBlocks[0]); i++)
+        {
+            testReferenceBlock(i, instructionSet);
+        }
+    }
+}
+
+void BcDecoderTests::testReferenceBlock(uint32 referenceBlockIndex,
+                                        CpuInstructionSet instructionSet)
+{
+    const BcReferenceBlock& referenceBlock = BcReferenceBlocks[referenceBlockIndex];
+
+    const uint64 blockCount = 8;
+    uint64 blockSize = getImageFormatBlockSize(referenceBlock.format);
+    uint64 rowPitch = blockCount * BcBlockWidth * BcDecodedPixelSize;
+
+    unsigned char blocks[blockCount * DdsBc2BlockSize] = {};
+    for (uint64 i = 0; i < blockCount; i++)
+    {
+        std::memcpy(blocks + i * blockSize, referenceBlock.block, blockSize);
+    }
+
+    unsigned char pixels[BcBlockWidth * blockCount * BcBlockWidth * BcDecodedPixelSize] = {};
+
+    BcDecoder bcDecoder;
+    BcDecoderSettings settings = bcDecoder.getSettings();
+    settings.instructionSet = instructionSet;
+    bcDecoder.setSettings(settings);
+
+    bool result = bcDecoder.decodeBlockRow(referenceBlock.format, blocks, blockCount, pixels,
+                                           rowPitch);
+
+    for (uint64 i = 0; i < blockCount && result; i++)
+    {
+        for (uint32 j = 0; j < BcBlockWidth; j++)
+        {
+            const unsigned char* row = pixels + j * rowPitch + i * BcBlockWidth *
+                BcDecodedPixelSize;
+            const unsigned char* referenceRow = referenceBlock.pixels + j * BcBlockWidth *
+                BcDecodedPixelSize;
+            if (std::memcmp(row, referenceRow, BcBlockWidth * BcDecodedPixelSize) != 0)
+            {
+                result = false;
+            }
+        }
+    }
+
+    checkTest(result, std::string("BcDecoder ") + referenceBlock.name + " (" +
+              getCpuInstructionSetName(instructionSet) + ")", statistics);
+}
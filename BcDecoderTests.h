@@ -0,0 +1,33 @@
+#pragma once
+#include <d3d11.h>
+
+#include <cstring>
+
+#include <string>
+
+#include "BcDecoder.h"
+
+#include "BcDecoderUtility.h"
+#include "CpuUtility.h"
+#include "DdsUtility.h"
+#include "ImageFileParserUtility.h"
+#include "IntUtility.h"
+#include "TestUtility.h"
+
+// Decodes reference blocks of BC1 to BC5 and of every BC7 mode and compares them with the pixels
+// D3D decodes them to. Every block is decoded in a row of 8 copies, so the AVX2 functions, which
+// decode 8 blocks at a time, are tested as well as the scalar ones
+class BcDecoderTests
+{
+    TestStatistics statistics;
+
+public:
+    BcDecoderTests();
+
+    TestStatistics getStatistics();
+
+    void run();
+
+private:
+    void testReferenceBlock(uint32 referenceBlockIndex, CpuInstructionSet instructionSet);
+};
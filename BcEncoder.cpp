@@ -0,0 +1,1024 @@
+#include "BcEncoder.h"
+
+BcEncoder::BcEncoder() : settings{}, statistics{}
+{
+    settings.instructionSet = CpuInstructionSet::Undefined;
+    settings.quality = BcEncoderQuality::Fast;
+    settings.threadCount = 1;
+}
+
+BcEncoderSettings BcEncoder::getSettings()
+{
+    return settings;
+}
+
+void BcEncoder::setSettings(BcEncoderSettings settings)
+{
+    this->settings = settings;
+}
+
+BcEncoderStatistics BcEncoder::getStatistics()
+{
+    return statistics;
+}
+
+bool BcEncoder::encodeImage(const ImageData& imageData, DXGI_FORMAT format,
+                            ImageData& encodedImageData)
+{
+    statistics = {};
+
+    if (imageData.format != DXGI_FORMAT_R8G8B8A8_UNORM
+        && imageData.format != DXGI_FORMAT_R8G8B8A8_UNORM_SRGB)
+    {
+        return false;
+    }
+    if (!isBcEncoderFormat(format))
+    {
+        return false;
+    }
+
+    uint64 subresourceCount = static_cast<uint64>(imageData.mipmapLevels) * imageData.arraySize;
+    if (subresourceCount == 0 || imageData.subresourceDataItems.size() != subresourceCount)
+    {
+        return false;
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    uint32 blockSize = getImageFormatBlockSize(format);
+
+    encodedImageData = {};
+    encodedImageData.width = imageData.width;
+    encodedImageData.height = imageData.height;
+    encodedImageData.depth = imageData.depth;
+    encodedImageData.format = format;
+    encodedImageData.mipmapLevels = imageData.mipmapLevels;
+    encodedImageData.arraySize = imageData.arraySize;
+    encodedImageData.isCubemap = imageData.isCubemap;
+
+    // Blocks of every subresource before it, so a range of blocks can be found in the image
+    std::vector<uint64> subresourceBlockBegins(subresourceCount + 1);
+
+    uint64 payloadSize = 0;
+    encodedImageData.subresourceDataItems.resize(subresourceCount);
+    for (uint64 i = 0; i < subresourceCount; i++)
+    {
+        uint32 mipmapLevel = static_cast<uint32>(i % imageData.mipmapLevels);
+        uint32 rowBlockCount = getBcBlockCount(getImageMipmapSize(imageData.width, mipmapLevel));
+        uint32 columnBlockCount = getBcBlockCount(getImageMipmapSize(imageData.height,
+                                                                     mipmapLevel));
+
+        ImageSubresourceData& subresourceData = encodedImageData.subresourceDataItems[i];
+        subresourceData.offset = payloadSize;
+        subresourceData.rowPitch = rowBlockCount * blockSize;
+        subresourceData.depthPitch = subresourceData.rowPitch * columnBlockCount;
+        payloadSize += subresourceData.depthPitch;
+
+        subresourceBlockBegins[i + 1] = subresourceBlockBegins[i] + static_cast<uint64>(
+            rowBlockCount) * columnBlockCount;
+    }
+    encodedImageData.data.resize(payloadSize);
+
+    CpuInstructionSet instructionSet = getCpuInstructionSet(settings.instructionSet);
+
+    const unsigned char* payload = getImagePayload(imageData);
+    unsigned char* encodedPayload = encodedImageData.data.data();
+
+    uint64 blockCount = subresourceBlockBegins.back();
+    uint32 threadCount = forEachBlockRange(blockCount, [&](uint64 beginBlock, uint64 endBlock)
+    {
+        uint64 subresourceIndex = std::upper_bound(subresourceBlockBegins.begin(),
+                                                   subresourceBlockBegins.end(), beginBlock) -
+            subresourceBlockBegins.begin() - 1;
+
+        for (uint64 blockIndex = beginBlock; blockIndex < endBlock; blockIndex++)
+        {
+            while (blockIndex >= subresourceBlockBegins[subresourceIndex + 1])
+            {
+                subresourceIndex++;
+            }
+
+            uint32 mipmapLevel = static_cast<uint32>(subresourceIndex % imageData.mipmapLevels);
+            uint32 width = getImageMipmapSize(imageData.width, mipmapLevel);
+            uint32 height = getImageMipmapSize(imageData.height, mipmapLevel);
+            uint64 rowBlockCount = getBcBlockCount(width);
+
+            uint64 subresourceBlockIndex = blockIndex - subresourceBlockBegins[subresourceIndex];
+            uint32 pixelRow = static_cast<uint32>(subresourceBlockIndex / rowBlockCount *
+                                                  BcBlockWidth);
+            uint32 pixelColumn = static_cast<uint32>(subresourceBlockIndex % rowBlockCount *
+                                                     BcBlockWidth);
+
+            const ImageSubresourceData& sourceData = imageData.subresourceDataItems[
+                subresourceIndex];
+            const unsigned char* pixels = payload + sourceData.offset + pixelRow * static_cast<
+                uint64>(sourceData.rowPitch) + pixelColumn * BcDecodedPixelSize;
+
+            unsigned char block[BcBlockPixelCount][BcDecodedPixelSize];
+            loadBlock(pixels, sourceData.rowPitch, width - pixelColumn, height - pixelRow, block);
+
+            const ImageSubresourceData& destinationData = encodedImageData.subresourceDataItems[
+                subresourceIndex];
+            unsigned char* encodedBlock = encodedPayload + destinationData.offset +
+                subresourceBlockIndex * blockSize;
+
+            switch (format)
+            {
+            case DXGI_FORMAT_BC1_UNORM:
+            case DXGI_FORMAT_BC1_UNORM_SRGB:
+            {
+                encodeColorBlock(block, instructionSet, encodedBlock);
+
+                break;
+            }
+            case DXGI_FORMAT_BC3_UNORM:
+            case DXGI_FORMAT_BC3_UNORM_SRGB:
+            {
+                encodeAlphaBlock(block, instructionSet, encodedBlock);
+                encodeColorBlock(block, instructionSet, encodedBlock + DdsBc1BlockSize);
+
+                break;
+            }
+            default:
+            {
+                encodeBc7Block(block, instructionSet, encodedBlock);
+
+                break;
+            }
+            }
+        }
+    });
+
+    std::chrono::duration<double> encodingTime = std::chrono::steady_clock::now() - startTime;
+
+    statistics.instructionSet = instructionSet;
+    statistics.threadCount = threadCount;
+    statistics.blockCount = blockCount;
+    statistics.size = payloadSize;
+    statistics.encodingTime = encodingTime.count();
+    if (statistics.encodingTime > 0.0)
+    {
+        statistics.blockThroughput = statistics.blockCount / statistics.encodingTime;
+    }
+
+    return true;
+}
+
+void BcEncoder::loadBlock(const unsigned char* pixels, uint64 rowPitch, uint32 width,
+                          uint32 height, unsigned char block[BcBlockPixelCount][BcDecodedPixelSize])
+{
+    for (uint32 i = 0; i < BcBlockPixelCount; i++)
+    {
+        uint32 row = i / BcBlockWidth;
+        if (row >= height)
+        {
+            row = height - 1;
+        }
+        uint32 column = i % BcBlockWidth;
+        if (column >= width)
+        {
+            column = width - 1;
+        }
+
+        std::memcpy(block[i], pixels + row * rowPitch + column * BcDecodedPixelSize,
+                    BcDecodedPixelSize);
+    }
+}
+
+void BcEncoder::encodeColorBlock(const unsigned char block[BcBlockPixelCount][BcDecodedPixelSize],
+                                 CpuInstructionSet instructionSet, unsigned char* encodedBlock)
+{
+    BcEncoderBlockPixels pixels = {};
+    for (uint32 i = 0; i < BcBlockPixelCount; i++)
+    {
+        for (uint32 j = 0; j < 3; j++)
+        {
+            pixels.channels[i][j] = block[i][j];
+        }
+    }
+
+    float endpoints[2][BcDecodedPixelSize] = {};
+    if (settings.quality == BcEncoderQuality::High)
+    {
+        fitEndpoints(pixels, 3, endpoints);
+    }
+    else
+    {
+        // The corners of the bounding box, inset a little because the ends of the palette are
+        // rarely hit, on the diagonal the colors run along
+        float minColor[3] = { 255.0f, 255.0f, 255.0f };
+        float maxColor[3] = {};
+        float meanColor[3] = {};
+        for (uint32 i = 0; i < BcBlockPixelCount; i++)
+        {
+            for (uint32 j = 0; j < 3; j++)
+            {
+                float value = pixels.channels[i][j];
+                if (value < minColor[j])
+                {
+                    minColor[j] = value;
+                }
+                if (value > maxColor[j])
+                {
+                    maxColor[j] = value;
+                }
+                meanColor[j] += value;
+            }
+        }
+
+        float covariances[3] = {}; // of red and green, of green and green, of blue and green
+        for (uint32 i = 0; i < BcBlockPixelCount; i++)
+        {
+            float green = pixels.channels[i][1] - meanColor[1] / BcBlockPixelCount;
+            for (uint32 j = 0; j < 3; j++)
+            {
+                covariances[j] += (pixels.channels[i][j] - meanColor[j] / BcBlockPixelCount) *
+                    green;
+            }
+        }
+
+        for (uint32 j = 0; j < 3; j++)
+        {
+            float inset = (maxColor[j] - minColor[j]) / 16.0f;
+            endpoints[0][j] = maxColor[j] - inset;
+            endpoints[1][j] = minColor[j] + inset;
+            if (covariances[j] < 0.0f)
+            {
+                std::swap(endpoints[0][j], endpoints[1][j]);
+            }
+        }
+    }
+
+    uint32 colors[2] = {};
+    uint8 indexes[BcBlockPixelCount] = {};
+    uint32 error = evaluateColorEndpoints(pixels, endpoints, instructionSet, colors, indexes);
+
+    if (settings.quality == BcEncoderQuality::High)
+    {
+        for (uint32 i = 0; i < BcEncoderRefinementCount && error > 0; i++)
+        {
+            if (!refineEndpoints(pixels, 3, indexes, BcColorWeights, endpoints))
+            {
+                break;
+            }
+
+            uint32 refinedColors[2] = {};
+            uint8 refinedIndexes[BcBlockPixelCount] = {};
+            uint32 refinedError = evaluateColorEndpoints(pixels, endpoints, instructionSet,
+                                                         refinedColors, refinedIndexes);
+            if (refinedError >= error)
+            {
+                break;
+            }
+
+            error = refinedError;
+            std::memcpy(colors, refinedColors, sizeof(colors));
+            std::memcpy(indexes, refinedIndexes, sizeof(indexes));
+        }
+    }
+
+    uint32 packedIndexes = 0;
+    for (uint32 i = 0; i < BcBlockPixelCount; i++)
+    {
+        packedIndexes |= static_cast<uint32>(indexes[i]) << i * 2;
+    }
+
+    for (uint32 i = 0; i < 2; i++)
+    {
+        encodedBlock[i * 2] = static_cast<unsigned char>(colors[i]);
+        encodedBlock[i * 2 + 1] = static_cast<unsigned char>(colors[i] >> 8);
+    }
+    for (uint32 i = 0; i < 4; i++)
+    {
+        encodedBlock[4 + i] = static_cast<unsigned char>(packedIndexes >> i * 8);
+    }
+}
+
+void BcEncoder::encodeAlphaBlock(const unsigned char block[BcBlockPixelCount][BcDecodedPixelSize],
+                                 CpuInstructionSet instructionSet, unsigned char* encodedBlock)
+{
+    BcEncoderBlockPixels pixels = {};
+    uint32 minAlpha = 0xff;
+    uint32 maxAlpha = 0;
+    // Of the alphas the 6-value mode has to interpolate, every one but 0 and 255
+    uint32 minInnerAlpha = 0xff;
+    uint32 maxInnerAlpha = 0;
+    for (uint32 i = 0; i < BcBlockPixelCount; i++)
+    {
+        uint32 alpha = block[i][3];
+        pixels.channels[i][0] = static_cast<int16>(alpha);
+
+        if (alpha < minAlpha)
+        {
+            minAlpha = alpha;
+        }
+        if (alpha > maxAlpha)
+        {
+            maxAlpha = alpha;
+        }
+        if (alpha > 0 && alpha < 0xff)
+        {
+            if (alpha < minInnerAlpha)
+            {
+                minInnerAlpha = alpha;
+            }
+            if (alpha > maxInnerAlpha)
+            {
+                maxInnerAlpha = alpha;
+            }
+        }
+    }
+
+    // The first alpha above the second selects the 8-value mode
+    uint32 alphas[2] = { maxAlpha, minAlpha };
+    uint8 indexes[BcBlockPixelCount] = {};
+    uint32 error = evaluateAlphaEndpoints(pixels, alphas[0], alphas[1], instructionSet, indexes);
+
+    if (settings.quality == BcEncoderQuality::High && error > 0)
+    {
+        float endpoints[2][BcDecodedPixelSize] = {};
+        if (refineEndpoints(pixels, 1, indexes, BcAlphaWeights, endpoints))
+        {
+            uint32 refinedAlphas[2] = {
+                quantizeBcChannel(endpoints[0][0], 0xff), quantizeBcChannel(endpoints[1][0], 0xff)
+            };
+            if (refinedAlphas[0] < refinedAlphas[1])
+            {
+                std::swap(refinedAlphas[0], refinedAlphas[1]);
+            }
+
+            uint8 refinedIndexes[BcBlockPixelCount] = {};
+            uint32 refinedError = refinedAlphas[0] == refinedAlphas[1] ? UINT32_MAX :
+                evaluateAlphaEndpoints(pixels, refinedAlphas[0], refinedAlphas[1],
+                                       instructionSet, refinedIndexes);
+            if (refinedError < error)
+            {
+                error = refinedError;
+                std::memcpy(alphas, refinedAlphas, sizeof(alphas));
+                std::memcpy(indexes, refinedIndexes, sizeof(indexes));
+            }
+        }
+
+        // The 6-value mode has exact 0 and 255, which blocks with cut-outs need
+        if (minInnerAlpha <= maxInnerAlpha)
+        {
+            uint8 innerIndexes[BcBlockPixelCount] = {};
+            uint32 innerError = evaluateAlphaEndpoints(pixels, minInnerAlpha, maxInnerAlpha,
+                                                       instructionSet, innerIndexes);
+            if (innerError < error)
+            {
+                alphas[0] = minInnerAlpha;
+                alphas[1] = maxInnerAlpha;
+                std::memcpy(indexes, innerIndexes, sizeof(indexes));
+            }
+        }
+    }
+
+    uint64 packedIndexes = 0;
+    for (uint32 i = 0; i < BcBlockPixelCount; i++)
+    {
+        packedIndexes |= static_cast<uint64>(indexes[i]) << i * 3;
+    }
+
+    encodedBlock[0] = static_cast<unsigned char>(alphas[0]);
+    encodedBlock[1] = static_cast<unsigned char>(alphas[1]);
+    for (uint32 i = 0; i < 6; i++)
+    {
+        encodedBlock[2 + i] = static_cast<unsigned char>(packedIndexes >> i * 8);
+    }
+}
+
+void BcEncoder::encodeBc7Block(const unsigned char block[BcBlockPixelCount][BcDecodedPixelSize],
+                               CpuInstructionSet instructionSet, unsigned char* encodedBlock)
+{
+    BcEncoderBlockPixels pixels = {};
+    bool isOpaque = true;
+    for (uint32 i = 0; i < BcBlockPixelCount; i++)
+    {
+        for (uint32 j = 0; j < BcDecodedPixelSize; j++)
+        {
+            pixels.channels[i][j] = block[i][j];
+        }
+        isOpaque = isOpaque && block[i][3] == 0xff;
+    }
+
+    uint64 bits[2] = {};
+    uint32 error = encodeBc7Mode6Block(pixels, instructionSet, bits);
+    if (!isOpaque && error > 0)
+    {
+        uint64 mode5Bits[2] = {};
+        uint32 mode5Error = encodeBc7Mode5Block(pixels, instructionSet, mode5Bits);
+        if (mode5Error < error)
+        {
+            std::memcpy(bits, mode5Bits, sizeof(bits));
+        }
+    }
+
+    std::memcpy(encodedBlock, bits, sizeof(bits));
+}
+
+uint32 BcEncoder::encodeBc7Mode5Block(const BcEncoderBlockPixels& pixels,
+                                      CpuInstructionSet instructionSet, uint64 bits[2])
+{
+    const Bc7ModeInfo& modeInfo = Bc7ModeInfos[Bc7Mode5];
+
+    // The colors, then the alphas moved to the first channel
+    BcEncoderBlockPixels partPixels[2] = {};
+    for (uint32 i = 0; i < BcBlockPixelCount; i++)
+    {
+        std::memcpy(partPixels[0].channels[i], pixels.channels[i], 3 * sizeof(int16));
+        partPixels[1].channels[i][0] = pixels.channels[i][3];
+    }
+    uint32 channelCounts[2] = { 3, 1 };
+    uint32 bitCounts[2] = { modeInfo.colorBitCount, modeInfo.alphaBitCount };
+
+    float weights[Bc7Mode5IndexCount] = {};
+    for (uint32 i = 0; i < Bc7Mode5IndexCount; i++)
+    {
+        weights[i] = Bc7Weights2[i] / 64.0f;
+    }
+
+    uint32 quantizedEndpoints[2][2][BcDecodedPixelSize] = {};
+    uint8 indexes[2][BcBlockPixelCount] = {};
+    uint32 error = 0;
+    for (uint32 i = 0; i < 2; i++)
+    {
+        float endpoints[2][BcDecodedPixelSize] = {};
+        fitEndpoints(partPixels[i], channelCounts[i], endpoints);
+
+        uint32 partError = evaluateBc7Mode5Endpoints(partPixels[i], endpoints, channelCounts[i],
+                                                     bitCounts[i], instructionSet,
+                                                     quantizedEndpoints[i], indexes[i]);
+
+        if (settings.quality == BcEncoderQuality::High)
+        {
+            for (uint32 j = 0; j < BcEncoderRefinementCount && partError > 0; j++)
+            {
+                if (!refineEndpoints(partPixels[i], channelCounts[i], indexes[i], weights,
+                                     endpoints))
+                {
+                    break;
+                }
+
+                uint32 refinedEndpoints[2][BcDecodedPixelSize] = {};
+                uint8 refinedIndexes[BcBlockPixelCount] = {};
+                uint32 refinedError = evaluateBc7Mode5Endpoints(partPixels[i], endpoints,
+                                                                channelCounts[i], bitCounts[i],
+                                                                instructionSet, refinedEndpoints,
+                                                                refinedIndexes);
+                if (refinedError >= partError)
+                {
+                    break;
+                }
+
+                partError = refinedError;
+                std::memcpy(quantizedEndpoints[i], refinedEndpoints, sizeof(refinedEndpoints));
+                std::memcpy(indexes[i], refinedIndexes, sizeof(refinedIndexes));
+            }
+        }
+
+        // Like in mode 6, the top index bit of the first pixel is implied 0
+        if (indexes[i][0] >= Bc7Mode5IndexCount / 2)
+        {
+            for (uint32 j = 0; j < BcDecodedPixelSize; j++)
+            {
+                std::swap(quantizedEndpoints[i][0][j], quantizedEndpoints[i][1][j]);
+            }
+            for (uint32 j = 0; j < BcBlockPixelCount; j++)
+            {
+                indexes[i][j] = static_cast<uint8>(Bc7Mode5IndexCount - 1 - indexes[i][j]);
+            }
+        }
+
+        error += partError;
+    }
+
+    uint32 bitIndex = 0;
+    writeBc7Bits(bits, bitIndex, 1 << Bc7Mode5, Bc7Mode5 + 1);
+    writeBc7Bits(bits, bitIndex, 0, modeInfo.rotationBitCount);
+    for (uint32 i = 0; i < 3; i++)
+    {
+        for (uint32 j = 0; j < 2; j++)
+        {
+            writeBc7Bits(bits, bitIndex, quantizedEndpoints[0][j][i], modeInfo.colorBitCount);
+        }
+    }
+    for (uint32 j = 0; j < 2; j++)
+    {
+        writeBc7Bits(bits, bitIndex, quantizedEndpoints[1][j][0], modeInfo.alphaBitCount);
+    }
+    for (uint32 i = 0; i < 2; i++)
+    {
+        for (uint32 j = 0; j < BcBlockPixelCount; j++)
+        {
+            writeBc7Bits(bits, bitIndex, indexes[i][j], modeInfo.indexBitCount - (j == 0));
+        }
+    }
+
+    return error;
+}
+
+uint32 BcEncoder::encodeBc7Mode6Block(const BcEncoderBlockPixels& pixels,
+                                      CpuInstructionSet instructionSet, uint64 bits[2])
+{
+    const Bc7ModeInfo& modeInfo = Bc7ModeInfos[Bc7Mode6];
+
+    float endpoints[2][BcDecodedPixelSize] = {};
+    fitEndpoints(pixels, BcDecodedPixelSize, endpoints);
+
+    uint32 pBits[2] = {};
+    uint32 quantizedEndpoints[2][BcDecodedPixelSize] = {};
+    uint8 indexes[BcBlockPixelCount] = {};
+    uint32 error = UINT32_MAX;
+
+    // The fast preset takes the P-bit that brings each endpoint nearest, the high quality one
+    // tries every combination, also for the refined endpoints
+    auto evaluateEndpoints = [&]()
+    {
+        uint32 candidatePBits[4][2] = {};
+        uint32 candidateCount = 4;
+        if (settings.quality == BcEncoderQuality::High)
+        {
+            for (uint32 i = 0; i < 4; i++)
+            {
+                candidatePBits[i][0] = i & 1;
+                candidatePBits[i][1] = i >> 1;
+            }
+        }
+        else
+        {
+            for (uint32 i = 0; i < 2; i++)
+            {
+                float errors[2] = {};
+                for (uint32 pBit = 0; pBit < 2; pBit++)
+                {
+                    for (uint32 j = 0; j < BcDecodedPixelSize; j++)
+                    {
+                        float difference = endpoints[i][j] - (quantizeBc7Channel(endpoints[i][j],
+                                                                                 pBit) << 1 | pBit);
+                        errors[pBit] += difference * difference;
+                    }
+                }
+
+                candidatePBits[0][i] = errors[1] < errors[0];
+            }
+            candidateCount = 1;
+        }
+
+        for (uint32 i = 0; i < candidateCount; i++)
+        {
+            uint32 candidateEndpoints[2][BcDecodedPixelSize] = {};
+            uint8 candidateIndexes[BcBlockPixelCount] = {};
+            uint32 candidateError = evaluateBc7Mode6Endpoints(pixels, endpoints,
+                                                              candidatePBits[i], instructionSet,
+                                                              candidateEndpoints,
+                                                              candidateIndexes);
+            if (candidateError < error)
+            {
+                error = candidateError;
+                std::memcpy(pBits, candidatePBits[i], sizeof(pBits));
+                std::memcpy(quantizedEndpoints, candidateEndpoints, sizeof(quantizedEndpoints));
+                std::memcpy(indexes, candidateIndexes, sizeof(indexes));
+            }
+        }
+    };
+
+    evaluateEndpoints();
+
+    if (settings.quality == BcEncoderQuality::High)
+    {
+        float weights[Bc7Mode6IndexCount] = {};
+        for (uint32 i = 0; i < Bc7Mode6IndexCount; i++)
+        {
+            weights[i] = Bc7Weights4[i] / 64.0f;
+        }
+
+        for (uint32 i = 0; i < BcEncoderRefinementCount && error > 0; i++)
+        {
+            uint32 previousError = error;
+            if (!refineEndpoints(pixels, BcDecodedPixelSize, indexes, weights, endpoints))
+            {
+                break;
+            }
+
+            evaluateEndpoints();
+            if (error == previousError)
+            {
+                break;
+            }
+        }
+    }
+
+    // The top index bit of the first pixel is implied 0, the weights are symmetric, so swapping
+    // the endpoints and inverting the indexes keeps the colors
+    if (indexes[0] >= Bc7Mode6IndexCount / 2)
+    {
+        std::swap(pBits[0], pBits[1]);
+        for (uint32 i = 0; i < BcDecodedPixelSize; i++)
+        {
+            std::swap(quantizedEndpoints[0][i], quantizedEndpoints[1][i]);
+        }
+        for (uint32 i = 0; i < BcBlockPixelCount; i++)
+        {
+            indexes[i] = static_cast<uint8>(Bc7Mode6IndexCount - 1 - indexes[i]);
+        }
+    }
+
+    uint32 bitIndex = 0;
+    writeBc7Bits(bits, bitIndex, 1 << Bc7Mode6, Bc7Mode6 + 1);
+    for (uint32 i = 0; i < BcDecodedPixelSize; i++)
+    {
+        for (uint32 j = 0; j < 2; j++)
+        {
+            writeBc7Bits(bits, bitIndex, quantizedEndpoints[j][i], modeInfo.colorBitCount);
+        }
+    }
+    for (uint32 i = 0; i < 2; i++)
+    {
+        writeBc7Bits(bits, bitIndex, pBits[i], 1);
+    }
+    for (uint32 i = 0; i < BcBlockPixelCount; i++)
+    {
+        writeBc7Bits(bits, bitIndex, indexes[i], modeInfo.indexBitCount - (i == 0));
+    }
+
+    return error;
+}
+
+void BcEncoder::fitEndpoints(const BcEncoderBlockPixels& pixels, uint32 channelCount,
+                             float endpoints[2][BcDecodedPixelSize])
+{
+    float mean[BcDecodedPixelSize] = {};
+    for (uint32 i = 0; i < BcBlockPixelCount; i++)
+    {
+        for (uint32 j = 0; j < channelCount; j++)
+        {
+            mean[j] += pixels.channels[i][j];
+        }
+    }
+    for (uint32 j = 0; j < channelCount; j++)
+    {
+        mean[j] /= BcBlockPixelCount;
+    }
+
+    float covariance[BcDecodedPixelSize][BcDecodedPixelSize] = {};
+    for (uint32 i = 0; i < BcBlockPixelCount; i++)
+    {
+        for (uint32 j = 0; j < channelCount; j++)
+        {
+            for (uint32 k = 0; k < channelCount; k++)
+            {
+                covariance[j][k] += (pixels.channels[i][j] - mean[j]) * (pixels.channels[i][k] -
+                    mean[k]);
+            }
+        }
+    }
+
+    // The power iteration starts from the row of the channel that varies the most, which can't
+    // be orthogonal to the principal axis unless the block has a single color
+    uint32 maxChannel = 0;
+    for (uint32 j = 1; j < channelCount; j++)
+    {
+        if (covariance[j][j] > covariance[maxChannel][maxChannel])
+        {
+            maxChannel = j;
+        }
+    }
+
+    float axis[BcDecodedPixelSize] = {};
+    std::memcpy(axis, covariance[maxChannel], sizeof(axis));
+    for (uint32 i = 0; i < BcEncoderPowerIterationCount; i++)
+    {
+        float nextAxis[BcDecodedPixelSize] = {};
+        float maxComponent = 0.0f;
+        for (uint32 j = 0; j < channelCount; j++)
+        {
+            for (uint32 k = 0; k < channelCount; k++)
+            {
+                nextAxis[j] += covariance[j][k] * axis[k];
+            }
+
+            float component = nextAxis[j] < 0.0f ? -nextAxis[j] : nextAxis[j];
+            if (component > maxComponent)
+            {
+                maxComponent = component;
+            }
+        }
+        if (maxComponent == 0.0f)
+        {
+            break;
+        }
+
+        for (uint32 j = 0; j < channelCount; j++)
+        {
+            axis[j] = nextAxis[j] / maxComponent;
+        }
+    }
+
+    float axisLengthSquared = 0.0f;
+    for (uint32 j = 0; j < channelCount; j++)
+    {
+        axisLengthSquared += axis[j] * axis[j];
+    }
+
+    float minProjection = 0.0f;
+    float maxProjection = 0.0f;
+    if (axisLengthSquared > 0.0f)
+    {
+        for (uint32 i = 0; i < BcBlockPixelCount; i++)
+        {
+            float projection = 0.0f;
+            for (uint32 j = 0; j < channelCount; j++)
+            {
+                projection += (pixels.channels[i][j] - mean[j]) * axis[j];
+            }
+            projection /= axisLengthSquared;
+
+            if (projection < minProjection)
+            {
+                minProjection = projection;
+            }
+            if (projection > maxProjection)
+            {
+                maxProjection = projection;
+            }
+        }
+    }
+
+    for (uint32 j = 0; j < channelCount; j++)
+    {
+        endpoints[0][j] = mean[j] + minProjection * axis[j];
+        endpoints[1][j] = mean[j] + maxProjection * axis[j];
+    }
+}
+
+bool BcEncoder::refineEndpoints(const BcEncoderBlockPixels& pixels, uint32 channelCount,
+                                const uint8 indexes[BcBlockPixelCount], const float* weights,
+                                float endpoints[2][BcDecodedPixelSize])
+{
+    // Least squares of pixel = (1 - weight) * endpoint0 + weight * endpoint1 for every channel
+    float weight00 = 0.0f;
+    float weight01 = 0.0f;
+    float weight11 = 0.0f;
+    float pixelWeights0[BcDecodedPixelSize] = {};
+    float pixelWeights1[BcDecodedPixelSize] = {};
+    for (uint32 i = 0; i < BcBlockPixelCount; i++)
+    {
+        float weight1 = weights[indexes[i]];
+        float weight0 = 1.0f - weight1;
+
+        weight00 += weight0 * weight0;
+        weight01 += weight0 * weight1;
+        weight11 += weight1 * weight1;
+        for (uint32 j = 0; j < channelCount; j++)
+        {
+            pixelWeights0[j] += weight0 * pixels.channels[i][j];
+            pixelWeights1[j] += weight1 * pixels.channels[i][j];
+        }
+    }
+
+    float determinant = weight00 * weight11 - weight01 * weight01;
+    if (determinant < 1e-6f)
+    {
+        return false;
+    }
+
+    for (uint32 j = 0; j < channelCount; j++)
+    {
+        endpoints[0][j] = (pixelWeights0[j] * weight11 - pixelWeights1[j] * weight01) /
+            determinant;
+        endpoints[1][j] = (pixelWeights1[j] * weight00 - pixelWeights0[j] * weight01) /
+            determinant;
+    }
+
+    return true;
+}
+
+uint32 BcEncoder::evaluateColorEndpoints(const BcEncoderBlockPixels& pixels,
+                                         const float endpoints[2][BcDecodedPixelSize],
+                                         CpuInstructionSet instructionSet, uint32 colors[2],
+                                         uint8 indexes[BcBlockPixelCount])
+{
+    for (uint32 i = 0; i < 2; i++)
+    {
+        colors[i] = quantizeBcChannel(endpoints[i][0], 0x1f) << 11 | quantizeBcChannel(
+            endpoints[i][1], 0x3f) << 5 | quantizeBcChannel(endpoints[i][2], 0x1f);
+    }
+    // The first color above the second selects the 4-color mode of BC1
+    if (colors[0] < colors[1])
+    {
+        std::swap(colors[0], colors[1]);
+    }
+
+    BcEncoderPalette palette = {};
+    for (uint32 i = 0; i < 2; i++)
+    {
+        palette.channels[i][0] = static_cast<int16>(expandBcChannel(colors[i] >> 11 & 0x1f, 5));
+        palette.channels[i][1] = static_cast<int16>(expandBcChannel(colors[i] >> 5 & 0x3f, 6));
+        palette.channels[i][2] = static_cast<int16>(expandBcChannel(colors[i] & 0x1f, 5));
+    }
+    for (uint32 i = 0; i < 3; i++)
+    {
+        palette.channels[2][i] = static_cast<int16>((2 * palette.channels[0][i] +
+            palette.channels[1][i] + 1) / 3);
+        palette.channels[3][i] = static_cast<int16>((palette.channels[0][i] + 2 *
+            palette.channels[1][i] + 1) / 3);
+    }
+    // Equal colors would be the 3-color mode of BC1, where only the first entries are the color
+    palette.size = colors[0] == colors[1] ? 1 : 4;
+
+    return findIndexes(pixels, palette, instructionSet, indexes);
+}
+
+uint32 BcEncoder::evaluateAlphaEndpoints(const BcEncoderBlockPixels& pixels, uint32 alpha0,
+                                         uint32 alpha1, CpuInstructionSet instructionSet,
+                                         uint8 indexes[BcBlockPixelCount])
+{
+    uint32 alphas[8] = { alpha0, alpha1 };
+    if (alpha0 > alpha1)
+    {
+        for (uint32 i = 1; i < 7; i++)
+        {
+            alphas[i + 1] = ((7 - i) * alpha0 + i * alpha1 + 3) / 7;
+        }
+    }
+    else
+    {
+        for (uint32 i = 1; i < 5; i++)
+        {
+            alphas[i + 1] = ((5 - i) * alpha0 + i * alpha1 + 2) / 5;
+        }
+        alphas[6] = 0;
+        alphas[7] = 0xff;
+    }
+
+    BcEncoderPalette palette = {};
+    for (uint32 i = 0; i < 8; i++)
+    {
+        palette.channels[i][0] = static_cast<int16>(alphas[i]);
+    }
+    palette.size = 8;
+
+    return findIndexes(pixels, palette, instructionSet, indexes);
+}
+
+uint32 BcEncoder::evaluateBc7Mode5Endpoints(const BcEncoderBlockPixels& pixels,
+                                            const float endpoints[2][BcDecodedPixelSize],
+                                            uint32 channelCount, uint32 bitCount,
+                                            CpuInstructionSet instructionSet,
+                                            uint32 quantizedEndpoints[2][BcDecodedPixelSize],
+                                            uint8 indexes[BcBlockPixelCount])
+{
+    uint32 expandedEndpoints[2][BcDecodedPixelSize] = {};
+    for (uint32 i = 0; i < 2; i++)
+    {
+        for (uint32 j = 0; j < channelCount; j++)
+        {
+            quantizedEndpoints[i][j] = quantizeBcChannel(endpoints[i][j], (1 << bitCount) - 1);
+            expandedEndpoints[i][j] = expandBcChannel(quantizedEndpoints[i][j], bitCount);
+        }
+    }
+
+    BcEncoderPalette palette = {};
+    for (uint32 i = 0; i < Bc7Mode5IndexCount; i++)
+    {
+        uint32 weight = Bc7Weights2[i];
+        for (uint32 j = 0; j < channelCount; j++)
+        {
+            palette.channels[i][j] = static_cast<int16>(((64 - weight) * expandedEndpoints[0][j] +
+                weight * expandedEndpoints[1][j] + 32) >> 6);
+        }
+    }
+    palette.size = Bc7Mode5IndexCount;
+
+    return findIndexes(pixels, palette, instructionSet, indexes);
+}
+
+uint32 BcEncoder::evaluateBc7Mode6Endpoints(const BcEncoderBlockPixels& pixels,
+                                            const float endpoints[2][BcDecodedPixelSize],
+                                            const uint32 pBits[2],
+                                            CpuInstructionSet instructionSet,
+                                            uint32 quantizedEndpoints[2][BcDecodedPixelSize],
+                                            uint8 indexes[BcBlockPixelCount])
+{
+    uint32 expandedEndpoints[2][BcDecodedPixelSize] = {};
+    for (uint32 i = 0; i < 2; i++)
+    {
+        for (uint32 j = 0; j < BcDecodedPixelSize; j++)
+        {
+            quantizedEndpoints[i][j] = quantizeBc7Channel(endpoints[i][j], pBits[i]);
+            expandedEndpoints[i][j] = quantizedEndpoints[i][j] << 1 | pBits[i];
+        }
+    }
+
+    BcEncoderPalette palette = {};
+    for (uint32 i = 0; i < Bc7Mode6IndexCount; i++)
+    {
+        uint32 weight = Bc7Weights4[i];
+        for (uint32 j = 0; j < BcDecodedPixelSize; j++)
+        {
+            palette.channels[i][j] = static_cast<int16>(((64 - weight) * expandedEndpoints[0][j] +
+                weight * expandedEndpoints[1][j] + 32) >> 6);
+        }
+    }
+    palette.size = Bc7Mode6IndexCount;
+
+    return findIndexes(pixels, palette, instructionSet, indexes);
+}
+
+uint32 BcEncoder::findIndexes(const BcEncoderBlockPixels& pixels, const BcEncoderPalette& palette,
+                              CpuInstructionSet instructionSet, uint8 indexes[BcBlockPixelCount])
+{
+    if (instructionSet == CpuInstructionSet::Avx2)
+    {
+        return findIndexesAvx2(pixels, palette, indexes);
+    }
+
+    uint32 error = 0;
+    for (uint32 i = 0; i < BcBlockPixelCount; i++)
+    {
+        uint32 bestError = UINT32_MAX;
+        uint32 bestIndex = 0;
+        for (uint32 j = 0; j < palette.size; j++)
+        {
+            uint32 entryError = 0;
+            for (uint32 k = 0; k < BcDecodedPixelSize; k++)
+            {
+                int32 difference = pixels.channels[i][k] - palette.channels[j][k];
+                entryError += difference * difference;
+            }
+
+            if (entryError < bestError)
+            {
+                bestError = entryError;
+                bestIndex = j;
+            }
+        }
+
+        indexes[i] = static_cast<uint8>(bestIndex);
+        error += bestError;
+    }
+
+    return error;
+}
+
+// Every 256-bit register holds 4 pixels, the squared differences of their channels are summed in
+// pairs by a multiply-add, then horizontally into an error per 32-bit lane for 8 pixels, which
+// hadd leaves as 0 1 4 5 2 3 6 7 until a permutation restores the order
+uint32 BcEncoder::findIndexesAvx2(const BcEncoderBlockPixels& pixels,
+                                  const BcEncoderPalette& palette,
+                                  uint8 indexes[BcBlockPixelCount])
+{
+    __m256i pixelVectors[4];
+    for (int32 i = 0; i < 4; i++)
+    {
+        pixelVectors[i] = _mm256_load_si256(reinterpret_cast<const __m256i*>(pixels.channels[i *
+            4]));
+    }
+
+    __m256i orderPermutation = _mm256_setr_epi32(0, 1, 4, 5, 2, 3, 6, 7);
+
+    __m256i bestErrors[2] = { _mm256_set1_epi32(INT32_MAX), _mm256_set1_epi32(INT32_MAX) };
+    __m256i bestIndexes[2] = { _mm256_setzero_si256(), _mm256_setzero_si256() };
+    for (uint32 i = 0; i < palette.size; i++)
+    {
+        int64 entry = 0;
+        std::memcpy(&entry, palette.channels[i], sizeof(entry));
+        __m256i entryVector = _mm256_set1_epi64x(entry);
+        __m256i indexVector = _mm256_set1_epi32(static_cast<int32>(i));
+
+        __m256i pairErrors[4];
+        for (int32 j = 0; j < 4; j++)
+        {
+            __m256i differences = _mm256_sub_epi16(pixelVectors[j], entryVector);
+            pairErrors[j] = _mm256_madd_epi16(differences, differences);
+        }
+
+        for (int32 j = 0; j < 2; j++)
+        {
+            __m256i errors = _mm256_permutevar8x32_epi32(_mm256_hadd_epi32(pairErrors[j * 2],
+                pairErrors[j * 2 + 1]), orderPermutation);
+
+            __m256i isBetter = _mm256_cmpgt_epi32(bestErrors[j], errors);
+            bestErrors[j] = _mm256_min_epi32(bestErrors[j], errors);
+            bestIndexes[j] = _mm256_blendv_epi8(bestIndexes[j], indexVector, isBetter);
+        }
+    }
+
+    alignas(32) int32 errors[BcBlockPixelCount];
+    alignas(32) int32 pixelIndexes[BcBlockPixelCount];
+    for (int32 j = 0; j < 2; j++)
+    {
+        _mm256_store_si256(reinterpret_cast<__m256i*>(errors + j * 8), bestErrors[j]);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(pixelIndexes + j * 8), bestIndexes[j]);
+    }
+
+    uint32 error = 0;
+    for (uint32 i = 0; i < BcBlockPixelCount; i++)
+    {
+        indexes[i] = static_cast<uint8>(pixelIndexes[i]);
+        error += errors[i];
+    }
+
+    return error;
+}
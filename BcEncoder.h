@@ -0,0 +1,136 @@
+#pragma once
+#include <d3d11.h>
+#include <immintrin.h>
+
+#include <cstring>
+
+#include <vector>
+
+#include <algorithm>
+
+#include <chrono>
+#include <thread>
+
+#include "BcDecoderUtility.h"
+#include "BcEncoderUtility.h"
+#include "CpuUtility.h"
+#include "DdsUtility.h"
+#include "ImageFileParserUtility.h"
+#include "IntUtility.h"
+
+// Encodes R8G8B8A8 images to BC1, BC3 and BC7 on the CPU. Endpoints come from the bounding box or
+// the principal axis of a block, depending on the format and quality, and the nearest palette
+// entry of every pixel, where most of the time goes, is searched for 16 pixels at a time with
+// AVX2. BC7 blocks use mode 6, one subset of RGBA with 4-bit indexes, or mode 5 with separate
+// alpha. Images are split between threads in ranges of blocks
+class BcEncoder
+{
+    BcEncoderSettings settings;
+
+    BcEncoderStatistics statistics;
+
+public:
+    BcEncoder();
+
+    BcEncoderSettings getSettings();
+    void setSettings(BcEncoderSettings settings);
+
+    BcEncoderStatistics getStatistics();
+
+    // Encodes every subresource of an R8G8B8A8 image, with the rows of blocks tightly packed and
+    // the subresources back to back in the same order. Blocks cut by the image edge repeat its
+    // last row and column of pixels
+    bool encodeImage(const ImageData& imageData, DXGI_FORMAT format, ImageData& encodedImageData);
+
+private:
+    template <typename Function>
+    uint32 forEachBlockRange(uint64 blockCount, Function function);
+
+    void loadBlock(const unsigned char* pixels, uint64 rowPitch, uint32 width, uint32 height,
+                   unsigned char block[BcBlockPixelCount][BcDecodedPixelSize]);
+
+    void encodeColorBlock(const unsigned char block[BcBlockPixelCount][BcDecodedPixelSize],
+                          CpuInstructionSet instructionSet, unsigned char* encodedBlock);
+    void encodeAlphaBlock(const unsigned char block[BcBlockPixelCount][BcDecodedPixelSize],
+                          CpuInstructionSet instructionSet, unsigned char* encodedBlock);
+    // Blocks with transparent pixels also try mode 5, whose separate alpha endpoints and indexes
+    // suit alpha that doesn't follow the colors
+    void encodeBc7Block(const unsigned char block[BcBlockPixelCount][BcDecodedPixelSize],
+                        CpuInstructionSet instructionSet, unsigned char* encodedBlock);
+    // Encode a BC7 block in one mode and return its squared error
+    uint32 encodeBc7Mode5Block(const BcEncoderBlockPixels& pixels,
+                               CpuInstructionSet instructionSet, uint64 bits[2]);
+    uint32 encodeBc7Mode6Block(const BcEncoderBlockPixels& pixels,
+                               CpuInstructionSet instructionSet, uint64 bits[2]);
+
+    // Endpoints at the ends of the projection of the pixels on their principal axis, for every
+    // block but the BC1 and BC3 colors of the fast quality
+    void fitEndpoints(const BcEncoderBlockPixels& pixels, uint32 channelCount,
+                      float endpoints[2][BcDecodedPixelSize]);
+    // Endpoints that best reproduce the pixels with the weights of the indexes they got, false
+    // when every pixel got the same weight
+    bool refineEndpoints(const BcEncoderBlockPixels& pixels, uint32 channelCount,
+                         const uint8 indexes[BcBlockPixelCount], const float* weights,
+                         float endpoints[2][BcDecodedPixelSize]);
+
+    // Quantize the endpoints, build the palette the decoder will and find the best indexes,
+    // returning the squared error of the block
+    uint32 evaluateColorEndpoints(const BcEncoderBlockPixels& pixels,
+                                  const float endpoints[2][BcDecodedPixelSize],
+                                  CpuInstructionSet instructionSet, uint32 colors[2],
+                                  uint8 indexes[BcBlockPixelCount]);
+    uint32 evaluateAlphaEndpoints(const BcEncoderBlockPixels& pixels, uint32 alpha0,
+                                  uint32 alpha1, CpuInstructionSet instructionSet,
+                                  uint8 indexes[BcBlockPixelCount]);
+    // Of the color endpoints, in the first 3 channels, or the alpha ones, in the first channel, of
+    // mode 5
+    uint32 evaluateBc7Mode5Endpoints(const BcEncoderBlockPixels& pixels,
+                                     const float endpoints[2][BcDecodedPixelSize],
+                                     uint32 channelCount, uint32 bitCount,
+                                     CpuInstructionSet instructionSet,
+                                     uint32 quantizedEndpoints[2][BcDecodedPixelSize],
+                                     uint8 indexes[BcBlockPixelCount]);
+    uint32 evaluateBc7Mode6Endpoints(const BcEncoderBlockPixels& pixels,
+                                     const float endpoints[2][BcDecodedPixelSize],
+                                     const uint32 pBits[2], CpuInstructionSet instructionSet,
+                                     uint32 quantizedEndpoints[2][BcDecodedPixelSize],
+                                     uint8 indexes[BcBlockPixelCount]);
+
+    // Nearest palette entry of every pixel, the lowest index on ties, and the squared error of
+    // the block
+    uint32 findIndexes(const BcEncoderBlockPixels& pixels, const BcEncoderPalette& palette,
+                       CpuInstructionSet instructionSet, uint8 indexes[BcBlockPixelCount]);
+    uint32 findIndexesAvx2(const BcEncoderBlockPixels& pixels, const BcEncoderPalette& palette,
+                           uint8 indexes[BcBlockPixelCount]);
+};
+
+template <typename Function>
+uint32 BcEncoder::forEachBlockRange(uint64 blockCount, Function function)
+{
+    uint64 rangeCount = blockCount / BcEncoderMinBlockRangeSize;
+    if (rangeCount > settings.threadCount)
+    {
+        rangeCount = settings.threadCount;
+    }
+    if (rangeCount == 0)
+    {
+        rangeCount = 1;
+    }
+
+    std::vector<std::thread> threads;
+    threads.reserve(rangeCount - 1);
+    for (uint64 i = 1; i < rangeCount; i++)
+    {
+        threads.emplace_back(function, blockCount * i / rangeCount,
+                             blockCount * (i + 1) / rangeCount);
+    }
+
+    function(0, blockCount / rangeCount);
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    return static_cast<uint32>(rangeCount);
+}
@@ -0,0 +1,135 @@
+#pragma once
+#include <d3d11.h>
+
+#include "BcDecoderUtility.h"
+#include "CpuUtility.h"
+#include "IntUtility.h"
+
+// Blocks are split between threads in ranges of at least this many
+constexpr uint64 BcEncoderMinBlockRangeSize = 1024;
+
+// Refinements of the endpoints from the indexes they produced, by the high quality preset
+constexpr uint32 BcEncoderRefinementCount = 2;
+// Iterations that converge on the principal axis of the colors of a block
+constexpr uint32 BcEncoderPowerIterationCount = 8;
+
+constexpr uint32 Bc7Mode5 = 5;
+constexpr uint32 Bc7Mode5IndexCount = 4;
+constexpr uint32 Bc7Mode6 = 6;
+constexpr uint32 Bc7Mode6IndexCount = 16;
+
+// Part of the second endpoint in the palette entry of every index, of the 4-color blocks of BC1
+// and BC3 and of the 8-value alpha blocks of BC3
+constexpr float BcColorWeights[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+constexpr float BcAlphaWeights[8] = {
+    0.0f, 1.0f, 1.0f / 7.0f, 2.0f / 7.0f, 3.0f / 7.0f, 4.0f / 7.0f, 5.0f / 7.0f, 6.0f / 7.0f
+};
+
+// Fast: BC1 and BC3 colors take the inset corners of their bounding box and BC3 alpha its range,
+// in the 8-value mode. BC7 takes the ends of the principal axis with the nearest P-bits
+// High: BC1 and BC3 colors take the ends of the principal axis and BC3 alpha its range, refined by
+// least squares, BC3 alpha also tries the 6-value mode. BC7 refines the principal axis endpoints
+// by least squares and tries every P-bit
+enum class BcEncoderQuality : uint8
+{
+    Undefined,
+
+    Fast,
+    High,
+};
+
+struct BcEncoderSettings
+{
+    CpuInstructionSet instructionSet;
+    BcEncoderQuality quality;
+
+    uint32 threadCount;
+};
+
+struct BcEncoderStatistics
+{
+    CpuInstructionSet instructionSet;
+    uint32 threadCount;
+
+    uint64 blockCount;
+    uint64 size; // B, written
+    double encodingTime; // s
+    double blockThroughput; // blocks/s
+};
+
+// The 16 pixels of a block as signed channels, so differences can be squared with a multiply-add.
+// Channels a format doesn't encode are 0 in the pixels and in the palette
+struct BcEncoderBlockPixels
+{
+    alignas(32) int16 channels[BcBlockPixelCount][BcDecodedPixelSize];
+};
+
+struct BcEncoderPalette
+{
+    alignas(32) int16 channels[Bc7Mode6IndexCount][BcDecodedPixelSize];
+    uint32 size;
+};
+
+inline bool isBcEncoderFormat(DXGI_FORMAT format)
+{
+    switch (format)
+    {
+    case DXGI_FORMAT_BC1_UNORM:
+    case DXGI_FORMAT_BC1_UNORM_SRGB:
+    case DXGI_FORMAT_BC3_UNORM:
+    case DXGI_FORMAT_BC3_UNORM_SRGB:
+    case DXGI_FORMAT_BC7_UNORM:
+    case DXGI_FORMAT_BC7_UNORM_SRGB:
+    {
+        return true;
+    }
+    default:
+    {
+        return false;
+    }
+    }
+}
+
+// Writes the lowest bitCount bits of the value after the bits already written, like
+// readBc7Bits reads them
+inline void writeBc7Bits(uint64 bits[2], uint32& bitIndex, uint32 value, uint32 bitCount)
+{
+    for (uint32 i = 0; i < bitCount; i++)
+    {
+        uint64 bit = value >> i & 1;
+        bits[(bitIndex + i) / 64] |= bit << (bitIndex + i) % 64;
+    }
+    bitIndex += bitCount;
+}
+
+// n-bit value of an endpoint channel nearest the 8-bit one
+inline uint32 quantizeBcChannel(float value, uint32 maxValue)
+{
+    float quantizedValue = value * maxValue / 255.0f + 0.5f;
+    if (quantizedValue <= 0.0f)
+    {
+        return 0;
+    }
+    if (quantizedValue >= static_cast<float>(maxValue))
+    {
+        return maxValue;
+    }
+
+    return static_cast<uint32>(quantizedValue);
+}
+
+// 7 bits of a BC7 mode 6 endpoint channel that, followed by the P-bit, come nearest the value
+inline uint32 quantizeBc7Channel(float value, uint32 pBit)
+{
+    float quantizedValue = (value - pBit) / 2.0f + 0.5f;
+    if (quantizedValue <= 0.0f)
+    {
+        return 0;
+    }
+    if (quantizedValue >= 127.0f)
+    {
+        return 127;
+    }
+
+    return static_cast<uint32>(quantizedValue);
+}
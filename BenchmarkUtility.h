@@ -0,0 +1,53 @@
+#pragma once
+#include "IntUtility.h"
+
+constexpr const char* GSPBenchmarkUsage =
+    "Usage: GSPBenchmark [options] command [files]\n"
+    "  obj model.obj                OBJ parsing in the stream and mapped file modes, each in\n"
+    "                               a process of its own\n"
+    "  obj-stream model.obj         one mode of obj, as the process obj starts for it\n"
+    "  obj-mapped model.obj\n"
+    "  meshlets model.obj           meshlet building and culling from views around the model\n"
+    "  images image.dds...          DDS loading in the stream and mapped file modes, with the\n"
+    "                               mipmap generation of single level images\n"
+    "  pixels                       conversion of generated pixels of several mask layouts to\n"
+    "                               RGBA8 with every instruction set the CPU has\n"
+    "  atlas [image.dds...]         atlas packing and building of the images, or of generated\n"
+    "                               sprites without any\n"
+    "  bc                           BC1 to BC5 and BC7 decoding of generated blocks with the\n"
+    "                               scalar and AVX2 code\n"
+    "  tangents                     normal and tangent generation of a generated grid of 1M\n"
+    "                               triangles with 1, 2, 4... threads up to --threads\n"
+    "Options:\n"
+    "  --repeats N                  runs of every measurement, the fastest is printed, 5 by\n"
+    "                               default\n"
+    "  --threads N                  worker threads, every core by default\n";
+
+// Commands obj runs the benchmark again with, so every mode has a peak working set of its own
+constexpr const char* ModelFileParserBenchmarkStreamCommand = "obj-stream";
+constexpr const char* ModelFileParserBenchmarkMappedCommand = "obj-mapped";
+
+// Views the meshlets are culled from, on a circle around the model looking at its center, close
+// enough for the frustum to cut through it
+constexpr uint32 MeshletBenchmarkViewCount = 8;
+constexpr float MeshletBenchmarkViewDistance = 1.5f; // model radiuses from the center
+constexpr float MeshletBenchmarkFieldOfView = 1.0471976f; // rad, 60 degrees
+constexpr float MeshletBenchmarkAspectRatio = 16.0f / 9.0f;
+
+constexpr uint64 PixelConverterBenchmarkPixelCount = 4096 * 4096;
+
+// Generated RGBA8 sprites of random sizes, for an atlas benchmark without image files
+constexpr uint32 TextureAtlasBenchmarkImageCount = 1000;
+constexpr uint32 TextureAtlasBenchmarkMinImageSize = 16; // pixels
+constexpr uint32 TextureAtlasBenchmarkMaxImageSize = 128; // pixels
+
+constexpr uint32 BcDecoderBenchmarkImageSize = 2048; // pixels, of both sides
+
+// Quads per side of the generated grid, about 1M triangles
+constexpr uint32 TangentFrameBenchmarkGridSize = 724;
+
+struct BenchmarkSettings
+{
+    uint32 repeatCount; // at least 1, runs of every measurement, the fastest is reported
+    uint32 threadCount;
+};
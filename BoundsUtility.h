@@ -0,0 +1,163 @@
+#pragma once
+#include <DirectXMath.h>
+
+#include <vector>
+
+#include <cmath>
+#include <cfloat>
+
+#include "Vertex.h"
+
+#include "IntUtility.h"
+
+// Axis-aligned box and a sphere around its center. Empty bounds have a negative radius
+struct Bounds
+{
+    DirectX::XMFLOAT3 minPosition;
+    DirectX::XMFLOAT3 maxPosition;
+
+    DirectX::XMFLOAT3 center;
+    float radius;
+};
+
+inline Bounds getEmptyBounds()
+{
+    Bounds bounds = {};
+    bounds.minPosition = DirectX::XMFLOAT3(FLT_MAX, FLT_MAX, FLT_MAX);
+    bounds.maxPosition = DirectX::XMFLOAT3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+    bounds.radius = -1.0f;
+
+    return bounds;
+}
+
+inline bool isBoundsEmpty(const Bounds& bounds)
+{
+    return bounds.radius < 0.0f;
+}
+
+inline void setBoundsBox(DirectX::XMVECTOR minPosition, DirectX::XMVECTOR maxPosition,
+                         Bounds& bounds)
+{
+    DirectX::XMStoreFloat3(&bounds.minPosition, minPosition);
+    DirectX::XMStoreFloat3(&bounds.maxPosition, maxPosition);
+
+    DirectX::XMStoreFloat3(&bounds.center, DirectX::XMVectorScale(
+                               DirectX::XMVectorAdd(minPosition, maxPosition), 0.5f));
+    bounds.radius = 0.0f;
+}
+
+// Bounds of the vertexes an index list uses, or of all vertexes without one
+inline Bounds getBounds(const std::vector<Vertex>& vertexes, const uint32* indexes,
+                        uint64 indexCount)
+{
+    uint64 count = indexes ? indexCount : vertexes.size();
+    if (count == 0)
+    {
+        return getEmptyBounds();
+    }
+
+    DirectX::XMVECTOR minPosition = DirectX::XMVectorReplicate(FLT_MAX);
+    DirectX::XMVECTOR maxPosition = DirectX::XMVectorReplicate(-FLT_MAX);
+    for (uint64 i = 0; i < count; i++)
+    {
+        const Vertex& vertex = vertexes[indexes ? indexes[i] : i];
+        DirectX::XMVECTOR position = DirectX::XMLoadFloat3(&vertex.position);
+
+        minPosition = DirectX::XMVectorMin(minPosition, position);
+        maxPosition = DirectX::XMVectorMax(maxPosition, position);
+    }
+
+    Bounds bounds = {};
+    setBoundsBox(minPosition, maxPosition, bounds);
+
+    // The sphere is centered on the box, its radius reaches the furthest vertex
+    DirectX::XMVECTOR center = DirectX::XMLoadFloat3(&bounds.center);
+    DirectX::XMVECTOR maxDistanceSquared = DirectX::XMVectorZero();
+    for (uint64 i = 0; i < count; i++)
+    {
+        const Vertex& vertex = vertexes[indexes ? indexes[i] : i];
+        DirectX::XMVECTOR offset = DirectX::XMVectorSubtract(
+            DirectX::XMLoadFloat3(&vertex.position), center);
+
+        maxDistanceSquared = DirectX::XMVectorMax(maxDistanceSquared,
+                                                  DirectX::XMVector3LengthSq(offset));
+    }
+
+    bounds.radius = std::sqrt(DirectX::XMVectorGetX(maxDistanceSquared));
+
+    return bounds;
+}
+
+inline Bounds mergeBounds(const Bounds& lhs, const Bounds& rhs)
+{
+    if (isBoundsEmpty(lhs))
+    {
+        return rhs;
+    }
+    if (isBoundsEmpty(rhs))
+    {
+        return lhs;
+    }
+
+    Bounds bounds = {};
+    setBoundsBox(DirectX::XMVectorMin(DirectX::XMLoadFloat3(&lhs.minPosition),
+                                      DirectX::XMLoadFloat3(&rhs.minPosition)),
+                 DirectX::XMVectorMax(DirectX::XMLoadFloat3(&lhs.maxPosition),
+                                      DirectX::XMLoadFloat3(&rhs.maxPosition)), bounds);
+
+    // Smallest sphere around the new box center that still holds both spheres
+    DirectX::XMVECTOR center = DirectX::XMLoadFloat3(&bounds.center);
+    float lhsDistance = DirectX::XMVectorGetX(DirectX::XMVector3Length(DirectX::XMVectorSubtract(
+        DirectX::XMLoadFloat3(&lhs.center), center)));
+    float rhsDistance = DirectX::XMVectorGetX(DirectX::XMVector3Length(DirectX::XMVectorSubtract(
+        DirectX::XMLoadFloat3(&rhs.center), center)));
+
+    bounds.radius = lhsDistance + lhs.radius;
+    if (rhsDistance + rhs.radius > bounds.radius)
+    {
+        bounds.radius = rhsDistance + rhs.radius;
+    }
+
+    return bounds;
+}
+
+// The box is refitted around the transformed box, the sphere grows with the largest axis scale
+inline Bounds transformBounds(const Bounds& bounds, DirectX::XMMATRIX matrix)
+{
+    if (isBoundsEmpty(bounds))
+    {
+        return bounds;
+    }
+
+    DirectX::XMVECTOR minPosition = DirectX::XMLoadFloat3(&bounds.minPosition);
+    DirectX::XMVECTOR maxPosition = DirectX::XMLoadFloat3(&bounds.maxPosition);
+
+    DirectX::XMVECTOR boxCenter = DirectX::XMVector3TransformCoord(
+        DirectX::XMVectorScale(DirectX::XMVectorAdd(minPosition, maxPosition), 0.5f), matrix);
+    DirectX::XMVECTOR extents = DirectX::XMVectorScale(
+        DirectX::XMVectorSubtract(maxPosition, minPosition), 0.5f);
+
+    DirectX::XMVECTOR transformedExtents = DirectX::XMVectorZero();
+    float maxScaleSquared = 0.0f;
+    for (int32 i = 0; i < 3; i++)
+    {
+        DirectX::XMVECTOR extent = i == 0 ? DirectX::XMVectorSplatX(extents) :
+            i == 1 ? DirectX::XMVectorSplatY(extents) : DirectX::XMVectorSplatZ(extents);
+
+        transformedExtents = DirectX::XMVectorMultiplyAdd(DirectX::XMVectorAbs(matrix.r[i]),
+                                                          extent, transformedExtents);
+
+        float scaleSquared = DirectX::XMVectorGetX(DirectX::XMVector3LengthSq(matrix.r[i]));
+        if (scaleSquared > maxScaleSquared)
+        {
+            maxScaleSquared = scaleSquared;
+        }
+    }
+
+    Bounds transformedBounds = {};
+    setBoundsBox(DirectX::XMVectorSubtract(boxCenter, transformedExtents),
+                 DirectX::XMVectorAdd(boxCenter, transformedExtents), transformedBounds);
+    transformedBounds.radius = bounds.radius * std::sqrt(maxScaleSquared);
+
+    return transformedBounds;
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include <intrin.h>
+
+#include "IntUtility.h"
+
+enum class CpuInstructionSet : uint8
+{
+    Undefined, // the widest one the CPU supports
+
+    Scalar,
+    Ssse3,
+    Avx2,
+};
+
+// Widest instruction set both the CPU and the OS support, narrowed to the requested one. A
+// requested instruction set is never widened past what the CPU has
+inline CpuInstructionSet getCpuInstructionSet(CpuInstructionSet requestedInstructionSet)
+{
+    int32 cpuInfo[4] = {};
+    __cpuid(cpuInfo, 0);
+    int32 maxFunction = cpuInfo[0];
+
+    __cpuid(cpuInfo, 1);
+    bool hasSsse3 = (cpuInfo[2] & 1 << 9) != 0;
+    bool hasOsAvx = (cpuInfo[2] & 1 << 27) != 0 && (cpuInfo[2] & 1 << 28) != 0
+        && (_xgetbv(0) & 0x6) == 0x6;
+
+    bool hasAvx2 = false;
+    if (maxFunction >= 7)
+    {
+        __cpuidex(cpuInfo, 7, 0);
+        hasAvx2 = hasOsAvx && (cpuInfo[1] & 1 << 5) != 0;
+    }
+
+    CpuInstructionSet instructionSet = CpuInstructionSet::Scalar;
+    if (hasAvx2)
+    {
+        instructionSet = CpuInstructionSet::Avx2;
+    }
+    else if (hasSsse3)
+    {
+        instructionSet = CpuInstructionSet::Ssse3;
+    }
+
+    if (requestedInstructionSet != CpuInstructionSet::Undefined
+        && requestedInstructionSet < instructionSet)
+    {
+        instructionSet = requestedInstructionSet;
+    }
+
+    return instructionSet;
+}
+
+inline const char* getCpuInstructionSetName(CpuInstructionSet instructionSet)
+{
+    switch (instructionSet)
+    {
+    case CpuInstructionSet::Scalar:
+    {
+        return "scalar";
+    }
+    case CpuInstructionSet::Ssse3:
+    {
+        return "SSSE3";
+    }
+    case CpuInstructionSet::Avx2:
+    {
+        return "AVX2";
+    }
+    default:
+    {
+        return "undefined";
+    }
+    }
+}
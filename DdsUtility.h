@@ -13,7 +13,18 @@ union DdsMagicNumber
 };
 
 constexpr DdsMagicNumber DdsMagicNumberDds = {0x20534444}; // 'DDS '
+constexpr DdsMagicNumber DdsMagicNumberDxt1 = {0x31545844}; // 'DXT1'
+constexpr DdsMagicNumber DdsMagicNumberDxt2 = {0x32545844}; // 'DXT2'
+constexpr DdsMagicNumber DdsMagicNumberDxt3 = {0x33545844}; // 'DXT3'
+constexpr DdsMagicNumber DdsMagicNumberDxt4 = {0x34545844}; // 'DXT4'
 constexpr DdsMagicNumber DdsMagicNumberDxt5 = {0x35545844}; // 'DTX5'
+constexpr DdsMagicNumber DdsMagicNumberAti1 = {0x31495441}; // 'ATI1'
+constexpr DdsMagicNumber DdsMagicNumberBc4u = {0x55344342}; // 'BC4U'
+constexpr DdsMagicNumber DdsMagicNumberBc4s = {0x53344342}; // 'BC4S'
+constexpr DdsMagicNumber DdsMagicNumberAti2 = {0x32495441}; // 'ATI2'
+constexpr DdsMagicNumber DdsMagicNumberBc5u = {0x55354342}; // 'BC5U'
+constexpr DdsMagicNumber DdsMagicNumberBc5s = {0x53354342}; // 'BC5S'
+constexpr DdsMagicNumber DdsMagicNumberDx10 = {0x30315844}; // 'DX10', a DdsHeaderDxt10 follows
 
 constexpr uint32 Dds32BitMaskFirst8Bit = {0x000000ff};
 constexpr uint32 Dds32BitMaskSecond8Bit = {0x0000ff00};
@@ -51,6 +62,27 @@ enum class DdsCaps2 : uint32
     Volume = 0x200000,
 };
 
+enum class DdsResourceDimension : uint32
+{
+    Unknown = 0,
+    Buffer = 1,
+    Texture1d = 2,
+    Texture2d = 3,
+    Texture3d = 4,
+};
+
+enum class DdsResourceMisc : uint32
+{
+    TextureCube = 0x4,
+};
+
+constexpr uint32 DdsCaps2AllFaces = static_cast<uint32>(DdsCaps2::CubemapPositiveX)
+    | static_cast<uint32>(DdsCaps2::CubemapNegativeX)
+    | static_cast<uint32>(DdsCaps2::CubemapPositiveY)
+    | static_cast<uint32>(DdsCaps2::CubemapNegativeY)
+    | static_cast<uint32>(DdsCaps2::CubemapPositiveZ)
+    | static_cast<uint32>(DdsCaps2::CubemapNegativeZ);
+
 enum class Ddsd : uint32
 {
     Caps = 0x1,
@@ -91,6 +123,15 @@ struct DdsHeader
     uint32 reserved2;
 };
 
+struct DdsHeaderDxt10
+{
+    uint32 dxgiFormat; // DXGI_FORMAT
+    uint32 resourceDimension; // DdsResourceDimension
+    uint32 miscFlag; // DdsResourceMisc
+    uint32 arraySize; // cubes, not faces, for cubemaps
+    uint32 miscFlags2;
+};
+
 inline bool operator==(const DdsMagicNumber& lhs, const DdsMagicNumber& rhs)
 {
     return lhs.number == rhs.number;
@@ -100,3 +141,9 @@ inline bool operator!=(const DdsMagicNumber& lhs, const DdsMagicNumber& rhs)
 {
     return !(lhs == rhs);
 }
+
+inline bool isDdsHeaderDxt10(const DdsHeader& header)
+{
+    return header.pixelFormat.flags & static_cast<uint32>(Ddpf::FourCc)
+        && header.pixelFormat.fourCc == DdsMagicNumberDx10.number;
+}
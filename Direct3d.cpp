@@ -419,19 +419,23 @@ bool Direct3d::setVertexBufferToInputAssembler(Microsoft::WRL::ComPtr<ID3D11Buff
 }
 
 bool Direct3d::createIndexBuffer(Microsoft::WRL::ComPtr<ID3D11Buffer>& indexBuffer,
-                                 const uint32* indexes, uint32 indexCount)
+                                 const void* indexes, uint32 indexSize, uint32 indexCount)
 {
     if (!indexes)
     {
         return false;
     }
+    if (indexSize != sizeof(uint16) && indexSize != sizeof(uint32))
+    {
+        return false;
+    }
     if (indexCount <= 0)
     {
         return false;
     }
 
     D3D11_BUFFER_DESC indexBufferDesc = {};
-    indexBufferDesc.ByteWidth = sizeof(uint32) * indexCount;
+    indexBufferDesc.ByteWidth = indexSize * indexCount;
     indexBufferDesc.Usage = D3D11_USAGE_DEFAULT;
     indexBufferDesc.BindFlags = D3D11_BIND_INDEX_BUFFER;
     indexBufferDesc.CPUAccessFlags = 0;
@@ -453,29 +457,16 @@ bool Direct3d::createIndexBuffer(Microsoft::WRL::ComPtr<ID3D11Buffer>& indexBuff
     return true;
 }
 
-bool Direct3d::setIndexBufferToInputAssembler(Microsoft::WRL::ComPtr<ID3D11Buffer> indexBuffer)
-{
-    deviceContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-    deviceContext->IASetIndexBuffer(indexBuffer.Get(), DXGI_FORMAT_R32_UINT, 0);
-
-    return true;
-}
-
-bool Direct3d::canMipmapBeGenerated(DXGI_FORMAT format)
+bool Direct3d::setIndexBufferToInputAssembler(Microsoft::WRL::ComPtr<ID3D11Buffer> indexBuffer,
+                                              DXGI_FORMAT indexFormat)
 {
-    uint32 formatSupport = 0;
-
-    HRESULT result = device->CheckFormatSupport(format, &formatSupport);
-    if (FAILED(result))
+    if (indexFormat != DXGI_FORMAT_R16_UINT && indexFormat != DXGI_FORMAT_R32_UINT)
     {
         return false;
     }
 
-    if (!(formatSupport & (D3D11_FORMAT_SUPPORT_MIP_AUTOGEN |
-        D3D11_FORMAT_SUPPORT_RENDER_TARGET)))
-    {
-        return false;
-    }
+    deviceContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+    deviceContext->IASetIndexBuffer(indexBuffer.Get(), indexFormat, 0);
 
     return true;
 }
@@ -496,8 +487,7 @@ bool Direct3d::createTexture2d(Microsoft::WRL::ComPtr<ID3D11Texture2D>& texture2
 bool Direct3d::createShaderResourceView(
     Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>& shaderResourceView,
     D3D11_SHADER_RESOURCE_VIEW_DESC shaderResourceViewDesc,
-    Microsoft::WRL::ComPtr<ID3D11Texture2D> texture2d,
-    bool shouldGenerateMipmaps)
+    Microsoft::WRL::ComPtr<ID3D11Texture2D> texture2d)
 {
     HRESULT result = device->CreateShaderResourceView(texture2d.Get(),
                                                       &shaderResourceViewDesc,
@@ -507,11 +497,6 @@ bool Direct3d::createShaderResourceView(
         return false;
     }
 
-    if (shouldGenerateMipmaps)
-    {
-        deviceContext->GenerateMips(shaderResourceView.Get());
-    }
-
     return true;
 }
 
@@ -523,9 +508,9 @@ bool Direct3d::setShaderResourceViewToPixelShader(
     return true;
 }
 
-bool Direct3d::drawIndexed(uint32 indexCount)
+bool Direct3d::drawIndexed(uint32 indexCount, uint32 baseVertex)
 {
-    deviceContext->DrawIndexed(indexCount, 0, 0);
+    deviceContext->DrawIndexed(indexCount, 0, static_cast<int32>(baseVertex));
 
     return true;
 }
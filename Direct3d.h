@@ -101,12 +101,11 @@ public:
     bool setVertexBufferToInputAssembler(Microsoft::WRL::ComPtr<ID3D11Buffer> vertexBuffer,
                                          uint32 vertexStride);
 
-    bool createIndexBuffer(Microsoft::WRL::ComPtr<ID3D11Buffer>& indexBuffer, const uint32* indexes,
-                           uint32
-                           indexCount);
-    bool setIndexBufferToInputAssembler(Microsoft::WRL::ComPtr<ID3D11Buffer> indexBuffer);
+    bool createIndexBuffer(Microsoft::WRL::ComPtr<ID3D11Buffer>& indexBuffer, const void* indexes,
+                           uint32 indexSize, uint32 indexCount);
+    bool setIndexBufferToInputAssembler(Microsoft::WRL::ComPtr<ID3D11Buffer> indexBuffer,
+                                        DXGI_FORMAT indexFormat);
 
-    bool canMipmapBeGenerated(DXGI_FORMAT format);
     bool createTexture2d(Microsoft::WRL::ComPtr<ID3D11Texture2D>& texture2d,
                          D3D11_TEXTURE2D_DESC texture2dDesc,
                          const D3D11_SUBRESOURCE_DATA* initialData);
@@ -114,11 +113,11 @@ public:
     bool createShaderResourceView(
         Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>& shaderResourceView,
         D3D11_SHADER_RESOURCE_VIEW_DESC shaderResourceViewDesc,
-        Microsoft::WRL::ComPtr<ID3D11Texture2D> texture2d, bool shouldGenerateMipmaps = false);
+        Microsoft::WRL::ComPtr<ID3D11Texture2D> texture2d);
     bool setShaderResourceViewToPixelShader(
         Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> shaderResourceView, uint32 slotIndex);
 
-    bool drawIndexed(uint32 indexCount);
+    bool drawIndexed(uint32 indexCount, uint32 baseVertex = 0);
 
     void setBackBufferRenderTarget();
     void resetViewport();
@@ -1,8 +1,20 @@
 #pragma once
+#define NOMINMAX
+
+#include <Windows.h>
+
+#include <fstream>
+
 #include <string>
 
 #include "IntUtility.h"
 
+struct FileStamp
+{
+    uint64 size; // B
+    uint64 writeTime; // 100 ns since 1601
+};
+
 inline std::string getFileFormat(std::string filename)
 {
     uint64 index = filename.find_last_of('.');
@@ -13,3 +25,41 @@ inline std::string getFileFormat(std::string filename)
 
     return filename.substr(index + 1);
 }
+
+inline uint64 getFileSize(std::string filename)
+{
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+    {
+        return 0;
+    }
+
+    return static_cast<uint64>(file.tellg());
+}
+
+inline bool getFileStamp(std::string filename, FileStamp& fileStamp)
+{
+    WIN32_FILE_ATTRIBUTE_DATA fileAttributeData = {};
+    if (!GetFileAttributesExA(filename.c_str(), GetFileExInfoStandard, &fileAttributeData))
+    {
+        return false;
+    }
+
+    fileStamp.size = static_cast<uint64>(fileAttributeData.nFileSizeHigh) << 32 |
+        fileAttributeData.nFileSizeLow;
+    fileStamp.writeTime = static_cast<uint64>(fileAttributeData.ftLastWriteTime.dwHighDateTime) <<
+        32 | fileAttributeData.ftLastWriteTime.dwLowDateTime;
+
+    return true;
+}
+
+inline std::string replaceFileFormat(std::string filename, std::string format)
+{
+    uint64 index = filename.find_last_of('.');
+    if (index == std::string::npos)
+    {
+        return filename + "." + format;
+    }
+
+    return filename.substr(0, index + 1) + format;
+}
@@ -0,0 +1,132 @@
+#include <cstdio>
+#include <cstdlib>
+
+#include <string>
+#include <vector>
+
+#include <thread>
+
+#include "BcDecoderBenchmark.h"
+#include "ImageFileParserBenchmark.h"
+#include "MeshletBenchmark.h"
+#include "ModelFileParserBenchmark.h"
+#include "PixelConverterBenchmark.h"
+#include "TangentFrameGeneratorBenchmark.h"
+#include "TextureAtlasBuilderBenchmark.h"
+
+#include "BenchmarkUtility.h"
+#include "IntUtility.h"
+#include "ModelFileParserUtility.h"
+
+int32 main(int32 argumentCount, char* arguments[])
+{
+    BenchmarkSettings settings = {};
+    settings.repeatCount = 5;
+    settings.threadCount = std::thread::hardware_concurrency();
+    if (settings.threadCount == 0)
+    {
+        settings.threadCount = 1;
+    }
+
+    std::string command;
+    std::vector<std::string> filenames;
+    for (int32 i = 1; i < argumentCount; i++)
+    {
+        std::string argument = arguments[i];
+        bool hasValue = i + 1 < argumentCount;
+        if (argument == "--repeats" && hasValue)
+        {
+            settings.repeatCount = static_cast<uint32>(std::strtoul(arguments[++i], nullptr, 10));
+            if (settings.repeatCount == 0)
+            {
+                settings.repeatCount = 1;
+            }
+        }
+        else if (argument == "--threads" && hasValue)
+        {
+            settings.threadCount = static_cast<uint32>(std::strtoul(arguments[++i], nullptr, 10));
+            if (settings.threadCount == 0)
+            {
+                settings.threadCount = 1;
+            }
+        }
+        else if (command.empty())
+        {
+            command = argument;
+        }
+        else
+        {
+            filenames.push_back(argument);
+        }
+    }
+
+    bool result = false;
+    if (command == "obj" && filenames.size() == 1)
+    {
+        ModelFileParserBenchmark modelFileParserBenchmark;
+        modelFileParserBenchmark.setSettings(settings);
+        result = modelFileParserBenchmark.run(filenames[0]);
+    }
+    else if ((command == ModelFileParserBenchmarkStreamCommand
+              || command == ModelFileParserBenchmarkMappedCommand) && filenames.size() == 1)
+    {
+        ModelFileParserMode mode = ModelFileParserMode::Stream;
+        if (command == ModelFileParserBenchmarkMappedCommand)
+        {
+            mode = ModelFileParserMode::MappedFile;
+        }
+
+        ModelFileParserBenchmark modelFileParserBenchmark;
+        modelFileParserBenchmark.setSettings(settings);
+        result = modelFileParserBenchmark.runMode(filenames[0], mode);
+    }
+    else if (command == "meshlets" && filenames.size() == 1)
+    {
+        MeshletBenchmark meshletBenchmark;
+        meshletBenchmark.setSettings(settings);
+        result = meshletBenchmark.run(filenames[0]);
+    }
+    else if (command == "images" && !filenames.empty())
+    {
+        ImageFileParserBenchmark imageFileParserBenchmark;
+        imageFileParserBenchmark.setSettings(settings);
+        result = imageFileParserBenchmark.run(filenames);
+    }
+    else if (command == "pixels" && filenames.empty())
+    {
+        PixelConverterBenchmark pixelConverterBenchmark;
+        pixelConverterBenchmark.setSettings(settings);
+        result = pixelConverterBenchmark.run();
+    }
+    else if (command == "atlas")
+    {
+        TextureAtlasBuilderBenchmark textureAtlasBuilderBenchmark;
+        textureAtlasBuilderBenchmark.setSettings(settings);
+        result = textureAtlasBuilderBenchmark.run(filenames);
+    }
+    else if (command == "bc" && filenames.empty())
+    {
+        BcDecoderBenchmark bcDecoderBenchmark;
+        bcDecoderBenchmark.setSettings(settings);
+        result = bcDecoderBenchmark.run();
+    }
+    else if (command == "tangents" && filenames.empty())
+    {
+        TangentFrameGeneratorBenchmark tangentFrameGeneratorBenchmark;
+        tangentFrameGeneratorBenchmark.setSettings(settings);
+        result = tangentFrameGeneratorBenchmark.run();
+    }
+    else
+    {
+        std::printf("%s", GSPBenchmarkUsage);
+
+        return 1;
+    }
+
+    if (!result)
+    {
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,60 @@
+#include <cstdio>
+
+#include "BcDecoderTests.h"
+#include "ImageFileParserTests.h"
+#include "IndexBufferTests.h"
+#include "MeshOptimizerTests.h"
+#include "MeshSimplifierTests.h"
+#include "ModelFileParserTests.h"
+#include "TextureResidencyManagerTests.h"
+#include "VertexEncoderTests.h"
+
+#include "IntUtility.h"
+#include "TestUtility.h"
+
+int32 main(int32 argumentCount, char* arguments[])
+{
+    TestStatistics statistics = {};
+
+    BcDecoderTests bcDecoderTests;
+    bcDecoderTests.run();
+    addTestStatistics(bcDecoderTests.getStatistics(), statistics);
+
+    ImageFileParserTests imageFileParserTests;
+    imageFileParserTests.run();
+    addTestStatistics(imageFileParserTests.getStatistics(), statistics);
+
+    IndexBufferTests indexBufferTests;
+    indexBufferTests.run();
+    addTestStatistics(indexBufferTests.getStatistics(), statistics);
+
+    MeshOptimizerTests meshOptimizerTests;
+    meshOptimizerTests.run();
+    addTestStatistics(meshOptimizerTests.getStatistics(), statistics);
+
+    MeshSimplifierTests meshSimplifierTests;
+    meshSimplifierTests.run();
+    addTestStatistics(meshSimplifierTests.getStatistics(), statistics);
+
+    ModelFileParserTests modelFileParserTests;
+    modelFileParserTests.run();
+    addTestStatistics(modelFileParserTests.getStatistics(), statistics);
+
+    TextureResidencyManagerTests textureResidencyManagerTests;
+    textureResidencyManagerTests.run();
+    addTestStatistics(textureResidencyManagerTests.getStatistics(), statistics);
+
+    VertexEncoderTests vertexEncoderTests;
+    vertexEncoderTests.run();
+    addTestStatistics(vertexEncoderTests.getStatistics(), statistics);
+
+    std::printf("%u of %u tests passed\n", statistics.testCount - statistics.failedTestCount,
+                statistics.testCount);
+
+    if (statistics.failedTestCount > 0)
+    {
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,132 @@
+#pragma once
+#include <DirectXMath.h>
+
+#include <cstring>
+
+#include "IntUtility.h"
+
+constexpr int32 GspMeshMagicNumberSize = 4;
+
+union GspMeshMagicNumber
+{
+    uint32 number;
+    unsigned char chars[GspMeshMagicNumberSize];
+};
+
+constexpr GspMeshMagicNumber GspMeshMagicNumberGspm = {0x4d505347}; // 'GSPM'
+
+constexpr uint32 GspMeshVersion = 6;
+
+// Pipeline stages the cached model went through, a cache built with other stages is a miss
+enum class GspMeshFlags : uint32
+{
+    Optimized = 0x1,
+    Simplified = 0x2,
+    Meshlets = 0x4,
+    Merged = 0x8,
+    ObjectRanges = 0x10,
+    Welded = 0x20,
+    Tangents = 0x40, // one XMFLOAT4 per vertex after the vertexes
+};
+
+// File layout: header, dependencies, vertexes, meshes, materials. Strings, indexes, LOD levels,
+// meshlets and objects follow the record that owns them, strings are not null-terminated
+struct GspMeshHeader
+{
+    GspMeshMagicNumber magicNumber;
+    uint32 version;
+
+    uint32 vertexSize; // B
+    uint32 dependencyCount;
+
+    uint64 vertexCount;
+
+    uint32 meshCount;
+    uint32 materialCount;
+
+    uint32 flags; // GspMeshFlags
+    uint32 settingsHash; // of the pipeline stage settings
+};
+
+struct GspMeshDependency
+{
+    uint64 fileSize; // B
+    uint64 fileWriteTime; // 100 ns since 1601
+
+    uint32 filenameSize;
+    uint32 reserved;
+};
+
+struct GspMeshMesh
+{
+    uint64 indexCount;
+
+    uint32 nameSize;
+    uint32 materialNameSize;
+
+    uint32 lodCount;
+
+    // MeshletData records, then the meshlet vertexes and triangles, after the LOD levels
+    uint32 meshletCount;
+    uint32 meshletVertexCount;
+    uint32 meshletTriangleCount;
+
+    uint32 objectCount; // GspMeshObject records after the meshlets
+    uint32 reserved;
+};
+
+struct GspMeshLod
+{
+    uint64 indexCount;
+
+    float error; // model units
+    uint32 reserved;
+};
+
+struct GspMeshObject
+{
+    uint64 indexOffset;
+    uint64 indexCount;
+
+    uint32 nameSize;
+    uint32 reserved;
+};
+
+struct GspMeshMaterial
+{
+    DirectX::XMFLOAT3 diffuseColor;
+    float opacity;
+
+    uint32 hasDiffuseColorImage;
+
+    uint32 nameSize;
+    uint32 diffuseColorImageFilenameSize;
+    uint32 reserved;
+};
+
+inline bool operator==(const GspMeshMagicNumber& lhs, const GspMeshMagicNumber& rhs)
+{
+    return lhs.number == rhs.number;
+}
+
+inline bool operator!=(const GspMeshMagicNumber& lhs, const GspMeshMagicNumber& rhs)
+{
+    return !(lhs == rhs);
+}
+
+inline bool readGspMeshData(const unsigned char*& cursor, const unsigned char* end, void* data,
+                            uint64 size)
+{
+    if (static_cast<uint64>(end - cursor) < size)
+    {
+        return false;
+    }
+
+    if (size > 0)
+    {
+        std::memcpy(data, cursor, size);
+    }
+    cursor += size;
+
+    return true;
+}
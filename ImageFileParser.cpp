@@ -1,17 +1,230 @@
 #include "ImageFileParser.h"
 
-bool ImageFileParser::parseFile(std::string filename, ImageData& imageData)
+ImageFileParser::ImageFileParser() : pixelConverter(), mipmapGenerator(), settings{}, statistics{}
 {
+    settings.mode = ImageFileParserMode::MappedFile;
+    settings.isMipmapGenerationEnabled = true;
+    settings.textureBudgetSettings = getDefaultTextureBudgetSettings();
+    settings.pixelConverterSettings = pixelConverter.getSettings();
+    settings.mipmapGeneratorSettings = mipmapGenerator.getSettings();
+}
+
+ImageFileParserSettings ImageFileParser::getSettings()
+{
+    return settings;
+}
+
+void ImageFileParser::setSettings(ImageFileParserSettings settings)
+{
+    this->settings = settings;
+}
+
+ImageFileParserStatistics ImageFileParser::getStatistics()
+{
+    return statistics;
+}
+
+bool ImageFileParser::parseFile(std::string filename, ImageData& imageData,
+                                TextureClass textureClass)
+{
+    statistics = {};
+
     std::string format = getFileFormat(filename);
-    if (format == "dds")
+    if (format != "dds")
     {
-        return parseDdsFile(filename, imageData);
+        return false;
     }
 
-    return false;
+    auto startTime = std::chrono::steady_clock::now();
+
+    bool result = false;
+    if (settings.mode == ImageFileParserMode::Stream)
+    {
+        result = parseDdsFile(filename, imageData, textureClass);
+    }
+    else
+    {
+        result = parseMappedDdsFile(filename, imageData, textureClass);
+    }
+    if (!result)
+    {
+        return false;
+    }
+
+    bool hasMipmapLevels = imageData.mipmapLevels > 1 || (imageData.width == 1
+        && imageData.height == 1);
+    if (settings.isMipmapGenerationEnabled && !hasMipmapLevels && imageData.depth == 1
+        && isMipmapGeneratorFormat(imageData.format))
+    {
+        mipmapGenerator.setSettings(settings.mipmapGeneratorSettings);
+
+        // The generated levels come in a payload of their own, the file is unmapped
+        ImageData mipmappedImageData = {};
+        result = mipmapGenerator.generateMipmaps(imageData, mipmappedImageData);
+        if (!result)
+        {
+            return false;
+        }
+        imageData = std::move(mipmappedImageData);
+
+        statistics.mipmapGeneratorStatistics = mipmapGenerator.getStatistics();
+
+        skipGeneratedMipmapLevels(imageData, textureClass);
+    }
+
+    std::chrono::duration<double> parsingTime = std::chrono::steady_clock::now() - startTime;
+
+    statistics.fileCount = 1;
+    statistics.fileSize = getFileSize(filename);
+    statistics.parsingTime = parsingTime.count();
+    statistics.fileStatisticsItems.back().parsingTime = statistics.parsingTime;
+    if (statistics.parsingTime > 0.0)
+    {
+        statistics.throughput = statistics.fileSize / (1024.0 * 1024.0) / statistics.parsingTime;
+    }
+
+    return true;
 }
 
-bool ImageFileParser::parseDdsFile(std::string filename, ImageData& imageData)
+bool ImageFileParser::parseFiles(const std::vector<std::string>& filenames, uint32 threadCount,
+                                 std::vector<std::shared_ptr<ImageData>>& imageDataItems,
+                                 TextureClass textureClass)
+{
+    statistics = {};
+
+    imageDataItems = std::vector<std::shared_ptr<ImageData>>(filenames.size());
+    if (filenames.empty())
+    {
+        return true;
+    }
+
+    if (threadCount > filenames.size())
+    {
+        threadCount = static_cast<uint32>(filenames.size());
+    }
+    if (threadCount == 0)
+    {
+        threadCount = 1;
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    std::vector<uint8> parsedItems(filenames.size());
+    std::vector<uint64> fileSizes(filenames.size()); // B
+    std::vector<ImageFileStatistics> fileStatisticsItems(filenames.size());
+    std::vector<PixelConverterStatistics> pixelConverterStatisticsItems(filenames.size());
+    std::vector<MipmapGeneratorStatistics> mipmapGeneratorStatisticsItems(filenames.size());
+
+    // Every thread takes every threadCount-th file with a parser of its own, so the statistics
+    // of one file aren't overwritten by another thread
+    auto parseFileRange = [&](uint32 threadIndex)
+    {
+        ImageFileParser fileParser;
+        fileParser.setSettings(settings);
+
+        for (uint64 i = threadIndex; i < filenames.size(); i += threadCount)
+        {
+            std::shared_ptr<ImageData> imageData = std::make_shared<ImageData>();
+            parsedItems[i] = fileParser.parseFile(filenames[i], *imageData, textureClass);
+            ImageFileParserStatistics fileStatistics = fileParser.getStatistics();
+            fileSizes[i] = fileStatistics.fileSize;
+            if (!fileStatistics.fileStatisticsItems.empty())
+            {
+                fileStatisticsItems[i] = fileStatistics.fileStatisticsItems.back();
+            }
+            pixelConverterStatisticsItems[i] = fileStatistics.pixelConverterStatistics;
+            mipmapGeneratorStatisticsItems[i] = fileStatistics.mipmapGeneratorStatistics;
+
+            imageDataItems[i] = imageData;
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount - 1);
+    for (uint32 i = 1; i < threadCount; i++)
+    {
+        threads.emplace_back(parseFileRange, i);
+    }
+
+    parseFileRange(0);
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (uint8 isParsed : parsedItems)
+    {
+        if (!isParsed)
+        {
+            return false;
+        }
+    }
+
+    std::chrono::duration<double> parsingTime = std::chrono::steady_clock::now() - startTime;
+
+    statistics.fileCount = static_cast<uint32>(filenames.size());
+    for (uint64 fileSize : fileSizes)
+    {
+        statistics.fileSize += fileSize;
+    }
+    for (const auto& fileStatistics : fileStatisticsItems)
+    {
+        statistics.skippedSize += fileStatistics.skippedSize;
+    }
+    statistics.fileStatisticsItems = std::move(fileStatisticsItems);
+    statistics.parsingTime = parsingTime.count();
+    if (statistics.parsingTime > 0.0)
+    {
+        statistics.throughput = statistics.fileSize / (1024.0 * 1024.0) / statistics.parsingTime;
+    }
+
+    PixelConverterStatistics& pixelConverterStatistics = statistics.pixelConverterStatistics;
+    for (const auto& fileConverterStatistics : pixelConverterStatisticsItems)
+    {
+        if (fileConverterStatistics.instructionSet > pixelConverterStatistics.instructionSet)
+        {
+            pixelConverterStatistics.instructionSet = fileConverterStatistics.instructionSet;
+        }
+
+        pixelConverterStatistics.pixelCount += fileConverterStatistics.pixelCount;
+        pixelConverterStatistics.size += fileConverterStatistics.size;
+        pixelConverterStatistics.conversionTime += fileConverterStatistics.conversionTime;
+    }
+    if (pixelConverterStatistics.conversionTime > 0.0)
+    {
+        pixelConverterStatistics.throughput = pixelConverterStatistics.size / (1024.0 * 1024.0 *
+            1024.0) / pixelConverterStatistics.conversionTime;
+    }
+
+    MipmapGeneratorStatistics& mipmapGeneratorStatistics = statistics.mipmapGeneratorStatistics;
+    for (const auto& fileGeneratorStatistics : mipmapGeneratorStatisticsItems)
+    {
+        if (fileGeneratorStatistics.instructionSet > mipmapGeneratorStatistics.instructionSet)
+        {
+            mipmapGeneratorStatistics.instructionSet = fileGeneratorStatistics.instructionSet;
+        }
+        if (fileGeneratorStatistics.threadCount > mipmapGeneratorStatistics.threadCount)
+        {
+            mipmapGeneratorStatistics.threadCount = fileGeneratorStatistics.threadCount;
+        }
+
+        mipmapGeneratorStatistics.imageCount += fileGeneratorStatistics.imageCount;
+        mipmapGeneratorStatistics.pixelCount += fileGeneratorStatistics.pixelCount;
+        mipmapGeneratorStatistics.size += fileGeneratorStatistics.size;
+        mipmapGeneratorStatistics.generationTime += fileGeneratorStatistics.generationTime;
+    }
+    if (mipmapGeneratorStatistics.generationTime > 0.0)
+    {
+        mipmapGeneratorStatistics.throughput = mipmapGeneratorStatistics.size / (1024.0 * 1024.0 *
+            1024.0) / mipmapGeneratorStatistics.generationTime;
+    }
+
+    return true;
+}
+
+bool ImageFileParser::parseDdsFile(std::string filename, ImageData& imageData,
+                                   TextureClass textureClass)
 {
     std::ifstream file(filename, std::ios::binary);
     if (!file.is_open())
@@ -36,12 +249,183 @@ bool ImageFileParser::parseDdsFile(std::string filename, ImageData& imageData)
     {
         return false;
     }
+
+    DdsHeaderDxt10 headerDxt10 = {};
+    if (isDdsHeaderDxt10(header))
+    {
+        file.read(reinterpret_cast<char*>(&headerDxt10), sizeof(DdsHeaderDxt10));
+        if (!file || file.gcount() != sizeof(DdsHeaderDxt10))
+        {
+            return false;
+        }
+    }
+
+    PixelMasks sourceMasks = {};
+    bool result = parseDdsHeader(header, headerDxt10, imageData, sourceMasks);
+    if (!result)
+    {
+        return false;
+    }
+
+    uint64 payloadSize = 0;
+    result = initializeSubresourceDataItems(imageData, payloadSize);
+    if (!result)
+    {
+        return false;
+    }
+
+    std::vector<ImagePayloadRun> payloadRuns;
+    skipMipmapLevels(imageData, textureClass, payloadRuns, payloadSize);
+
+    // Kept subresources are read straight into the blob, or into the source payload of the ones
+    // expanded to RGBA8, and only those are allocated
+    std::vector<unsigned char> sourcePayload;
+    unsigned char* destination = nullptr;
+    if (sourceMasks.bitCount > 0)
+    {
+        sourcePayload.resize(getDdsSourcePayloadSize(sourceMasks, payloadSize));
+        destination = sourcePayload.data();
+    }
+    else
+    {
+        imageData.data.resize(payloadSize);
+        destination = imageData.data.data();
+    }
+
+    // The levels of a slice are one run in the file, the skipped ones before it are seeked over
+    std::streamoff payloadPosition = file.tellg();
+    for (const auto& payloadRun : payloadRuns)
+    {
+        uint64 runSize = getDdsSourcePayloadSize(sourceMasks, payloadRun.size);
+
+        file.seekg(payloadPosition + static_cast<std::streamoff>(getDdsSourcePayloadSize(
+            sourceMasks, payloadRun.fileOffset)));
+        file.read(reinterpret_cast<char*>(destination + getDdsSourcePayloadSize(sourceMasks,
+            payloadRun.offset)), runSize);
+        if (!file || static_cast<uint64>(file.gcount()) != runSize)
+        {
+            return false;
+        }
+    }
+
+    if (sourceMasks.bitCount > 0)
+    {
+        // The runs were read back to back
+        ImagePayloadRun sourcePayloadRun = {};
+        sourcePayloadRun.size = payloadSize;
+
+        result = convertPayload(sourcePayload.data(), sourceMasks, {sourcePayloadRun}, payloadSize,
+                                imageData);
+        if (!result)
+        {
+            return false;
+        }
+    }
+
+    file.close();
+
+    return true;
+}
+
+bool ImageFileParser::parseMappedDdsFile(std::string filename, ImageData& imageData,
+                                         TextureClass textureClass)
+{
+    std::shared_ptr<MappedFile> file = createSharedPointer<MappedFile>();
+    bool result = file->initialize(filename);
+    if (!result)
+    {
+        return false;
+    }
+
+    const unsigned char* cursor = file->getData();
+    const unsigned char* end = cursor + file->getSize();
+    if (static_cast<uint64>(end - cursor) < DdsMagicNumberSize + sizeof(DdsHeader))
+    {
+        return false;
+    }
+
+    DdsMagicNumber magicNumber = {};
+    std::memcpy(&magicNumber, cursor, DdsMagicNumberSize);
+    cursor += DdsMagicNumberSize;
+    if (magicNumber != DdsMagicNumberDds)
+    {
+        return false;
+    }
+
+    DdsHeader header = {};
+    std::memcpy(&header, cursor, sizeof(DdsHeader));
+    cursor += sizeof(DdsHeader);
+
+    DdsHeaderDxt10 headerDxt10 = {};
+    if (isDdsHeaderDxt10(header))
+    {
+        if (static_cast<uint64>(end - cursor) < sizeof(DdsHeaderDxt10))
+        {
+            return false;
+        }
+
+        std::memcpy(&headerDxt10, cursor, sizeof(DdsHeaderDxt10));
+        cursor += sizeof(DdsHeaderDxt10);
+    }
+
+    PixelMasks sourceMasks = {};
+    result = parseDdsHeader(header, headerDxt10, imageData, sourceMasks);
+    if (!result)
+    {
+        return false;
+    }
+
+    uint64 payloadSize = 0;
+    result = initializeSubresourceDataItems(imageData, payloadSize);
+    if (!result)
+    {
+        return false;
+    }
+    if (static_cast<uint64>(end - cursor) < getDdsSourcePayloadSize(sourceMasks, payloadSize))
+    {
+        return false;
+    }
+
+    std::vector<ImagePayloadRun> payloadRuns;
+    skipMipmapLevels(imageData, textureClass, payloadRuns, payloadSize);
+
+    // Converted pixels can't stay in the mapping, they are expanded into the blob
+    if (sourceMasks.bitCount > 0)
+    {
+        return convertPayload(cursor, sourceMasks, payloadRuns, payloadSize, imageData);
+    }
+
+    // The levels kept are used where the file has them, the skipped ones are never paged in
+    for (uint32 i = 0; i < imageData.arraySize; i++)
+    {
+        for (uint32 j = 0; j < imageData.mipmapLevels; j++)
+        {
+            imageData.subresourceDataItems[getImageSubresourceIndex(imageData, j, i)].offset +=
+                payloadRuns[i].fileOffset - payloadRuns[i].offset;
+        }
+    }
+
+    // Nothing is read, the texture upload pages the payload in straight from the page cache
+    imageData.data.clear();
+    imageData.mappedFile = file;
+    imageData.mappedDataOffset = cursor - file->getData();
+
+    return true;
+}
+
+bool ImageFileParser::parseDdsHeader(const DdsHeader& header, const DdsHeaderDxt10& headerDxt10,
+                                     ImageData& imageData, PixelMasks& sourceMasks)
+{
+    sourceMasks = {};
+
     if (header.size != sizeof(DdsHeader))
     {
         return false;
     }
-    if (!(header.flags & (static_cast<uint32>(Ddsd::Width) | static_cast<uint32>(Ddsd::Height) |
-        static_cast<uint32>(Ddsd::PixelFormat))))
+    // Both sizes are required, DDSD_PIXELFORMAT isn't since many writers leave it out, the pixel
+    // format is checked on its own below
+    uint32 requiredFlags = static_cast<uint32>(Ddsd::Width) | static_cast<uint32>(Ddsd::Height);
+    if ((header.flags & requiredFlags) != requiredFlags)
     {
         return false;
     }
@@ -53,7 +437,7 @@ bool ImageFileParser::parseDdsFile(std::string filename, ImageData& imageData)
     imageData.width = header.width;
     imageData.height = header.height;
 
-    if (header.flags & static_cast<uint32>(Ddsd::MipmapCount))
+    if (header.flags & static_cast<uint32>(Ddsd::MipmapCount) && header.mipMapCount > 0)
     {
         imageData.mipmapLevels = header.mipMapCount;
     }
@@ -62,141 +446,372 @@ bool ImageFileParser::parseDdsFile(std::string filename, ImageData& imageData)
         imageData.mipmapLevels = 1;
     }
 
-    imageData.mipmapDataItems = std::vector<MipmapData>(imageData.mipmapLevels);
-
-    if (header.flags & static_cast<uint32>(Ddsd::Depth))
+    // Volume textures aren't supported by Texture, their slices would be laid out differently
+    if (header.flags & static_cast<uint32>(Ddsd::Depth) && header.depth > 1)
     {
-        if (header.width == 0)
-        {
-            return false;
-        }
-        imageData.depth = header.depth;
+        return false;
     }
-    else
+    if (header.caps2 & static_cast<uint32>(DdsCaps2::Volume))
     {
-        imageData.depth = 1;
+        return false;
     }
+    imageData.depth = 1;
 
-    DdsPixelFormat& pixelFormat = header.pixelFormat;
+    const DdsPixelFormat& pixelFormat = header.pixelFormat;
     if (pixelFormat.size != sizeof(DdsPixelFormat))
     {
         return false;
     }
+
+    if (isDdsHeaderDxt10(header))
+    {
+        return parseDdsHeaderDxt10(headerDxt10, imageData);
+    }
+
+    imageData.arraySize = 1;
+    imageData.isCubemap = false;
+    if (header.caps2 & static_cast<uint32>(DdsCaps2::Cubemap))
+    {
+        // Cubemaps with missing faces can't be created as a cube texture
+        if ((header.caps2 & DdsCaps2AllFaces) != DdsCaps2AllFaces)
+        {
+            return false;
+        }
+
+        imageData.arraySize = 6;
+        imageData.isCubemap = true;
+    }
+
     if (pixelFormat.flags & (static_cast<uint32>(Ddpf::Rgb) | static_cast<uint32>(Ddpf::Alpha)))
     {
-        if (pixelFormat.rgbBitCount == 32)
+        PixelMasks masks = {};
+        masks.bitCount = pixelFormat.rgbBitCount;
+        if (pixelFormat.flags & static_cast<uint32>(Ddpf::Rgb))
         {
-            if (pixelFormat.rBitMask & Dds32BitMaskFirst8Bit && pixelFormat.gBitMask
-                & Dds32BitMaskSecond8Bit
-                && pixelFormat.bBitMask & Dds32BitMaskThird8Bit && pixelFormat.
-                aBitMask & Dds32BitMaskFourth8Bit)
-            {
-                imageData.format = DXGI_FORMAT_R8G8B8A8_UNORM;
+            masks.redMask = pixelFormat.rBitMask;
+            masks.greenMask = pixelFormat.gBitMask;
+            masks.blueMask = pixelFormat.bBitMask;
+        }
+        if (pixelFormat.flags & (static_cast<uint32>(Ddpf::Alphapixels) | static_cast<uint32>(
+            Ddpf::Alpha)))
+        {
+            masks.alphaMask = pixelFormat.aBitMask;
+        }
 
-                for (uint32 i = 0, width = imageData.width, height = imageData.height; i < imageData
-                     .mipmapLevels; i++, width /= 2, height /= 2)
-                {
-                    MipmapData& mipmapData = imageData.mipmapDataItems[i];
-                    mipmapData.rowPitch = (width * pixelFormat.rgbBitCount + 7) / 8;
-                    mipmapData.depthPitch = mipmapData.rowPitch * height;
-
-                    mipmapData.data = std::vector<unsigned char>(mipmapData.depthPitch);
-                    for (uint32 j = 0; j < height; j++)
-                    {
-                        file.read(
-                            reinterpret_cast<char*>(mipmapData.data.data() + j * mipmapData.
-                                rowPitch),
-                            mipmapData.rowPitch);
-                        if (!file || file.gcount() != mipmapData.rowPitch)
-                        {
-                            return false;
-                        }
-                    }
-
-                    imageData.mipmapDataItems.push_back(mipmapData);
-
-                    if (width == 1 || height == 1)
-                    {
-                        break;
-                    }
-                }
-            }
-            else
+        // Layouts D3D has a format for are used as they are, the rest is expanded to RGBA8
+        imageData.format = getDdsPixelMasksFormat(masks);
+        if (imageData.format == DXGI_FORMAT_UNKNOWN)
+        {
+            if (masks.bitCount != 8 && masks.bitCount != 16 && masks.bitCount != 24
+                && masks.bitCount != 32)
             {
                 return false;
             }
+
+            imageData.format = DXGI_FORMAT_R8G8B8A8_UNORM;
+            sourceMasks = masks;
+        }
+    }
+    else if (pixelFormat.flags & static_cast<uint32>(Ddpf::FourCc))
+    {
+        DdsMagicNumber magicNumber1 = {pixelFormat.fourCc};
+        if (magicNumber1 == DdsMagicNumberDxt1)
+        {
+            imageData.format = DXGI_FORMAT_BC1_UNORM;
+        }
+        else if (magicNumber1 == DdsMagicNumberDxt2 || magicNumber1 == DdsMagicNumberDxt3)
+        {
+            imageData.format = DXGI_FORMAT_BC2_UNORM;
+        }
+        else if (magicNumber1 == DdsMagicNumberDxt4 || magicNumber1 == DdsMagicNumberDxt5)
+        {
+            imageData.format = DXGI_FORMAT_BC3_UNORM;
+        }
+        else if (magicNumber1 == DdsMagicNumberAti1 || magicNumber1 == DdsMagicNumberBc4u)
+        {
+            imageData.format = DXGI_FORMAT_BC4_UNORM;
+        }
+        else if (magicNumber1 == DdsMagicNumberBc4s)
+        {
+            imageData.format = DXGI_FORMAT_BC4_SNORM;
+        }
+        else if (magicNumber1 == DdsMagicNumberAti2 || magicNumber1 == DdsMagicNumberBc5u)
+        {
+            imageData.format = DXGI_FORMAT_BC5_UNORM;
+        }
+        else if (magicNumber1 == DdsMagicNumberBc5s)
+        {
+            imageData.format = DXGI_FORMAT_BC5_SNORM;
         }
         else
         {
             return false;
         }
     }
-    else if (pixelFormat.flags & static_cast<uint32>(Ddpf::FourCc))
+    else
+    {
+        return false;
+    }
+
+    return true;
+}
+
+bool ImageFileParser::parseDdsHeaderDxt10(const DdsHeaderDxt10& headerDxt10,
+                                          ImageData& imageData)
+{
+    if (headerDxt10.resourceDimension != static_cast<uint32>(DdsResourceDimension::Texture2d))
+    {
+        return false;
+    }
+
+    imageData.format = static_cast<DXGI_FORMAT>(headerDxt10.dxgiFormat);
+    if (getImageFormatBlockSize(imageData.format) == 0 && getImageFormatPixelSize(
+        imageData.format) == 0)
+    {
+        return false;
+    }
+
+    if (headerDxt10.arraySize == 0)
+    {
+        return false;
+    }
+    imageData.arraySize = headerDxt10.arraySize;
+
+    imageData.isCubemap = (headerDxt10.miscFlag & static_cast<uint32>(DdsResourceMisc::
+        TextureCube)) != 0;
+    if (imageData.isCubemap)
     {
-        if (header.pitchOrLinearSize == 0)
+        if (imageData.arraySize > UINT32_MAX / 6)
         {
             return false;
         }
 
-        DdsMagicNumber magicNumber1 = {pixelFormat.fourCc};
-        if (magicNumber1 == DdsMagicNumberDxt5)
-        {
-            imageData.format = DXGI_FORMAT_BC3_UNORM;
+        imageData.arraySize *= 6;
+    }
 
-            bool isBlockHeightInitialized = false;
-            for (uint32 i = 0, width = imageData.width, blockHeight = 0; i < imageData.mipmapLevels;
-                 i++, width /= 2, blockHeight /= 2)
-            {
-                MipmapData& mipmapData = imageData.mipmapDataItems[i];
-                mipmapData.rowPitch = (width + 3) / 4 * DdsBc2BlockSize;
+    return true;
+}
 
-                if (isBlockHeightInitialized)
-                {
-                    if (blockHeight == 0)
-                    {
-                        blockHeight = 1;
-                    }
+void ImageFileParser::skipGeneratedMipmapLevels(ImageData& imageData, TextureClass textureClass)
+{
+    uint32 skippedMipmapLevels = getSkippedMipmapLevels(imageData, textureClass);
+    if (skippedMipmapLevels == 0)
+    {
+        return;
+    }
 
-                    mipmapData.depthPitch = mipmapData.rowPitch * blockHeight;
-                }
-                else
-                {
-                    mipmapData.depthPitch = header.pitchOrLinearSize;
+    uint64 generatedPayloadSize = 0;
+    for (const auto& subresourceData : imageData.subresourceDataItems)
+    {
+        generatedPayloadSize += subresourceData.depthPitch;
+    }
 
-                    blockHeight = mipmapData.depthPitch / mipmapData.rowPitch;
-                    isBlockHeightInitialized = true;
-                }
+    // The generated levels are in a payload of their own, the kept ones are copied so the skipped
+    // ones are freed
+    imageData = getImageMipmapLevels(imageData, skippedMipmapLevels);
 
-                mipmapData.data = std::vector<unsigned char>(mipmapData.depthPitch);
-                for (uint32 j = 0; j < blockHeight; j++)
-                {
-                    file.read(
-                        reinterpret_cast<char*>(mipmapData.data.data() + j * mipmapData.rowPitch),
-                        mipmapData.rowPitch);
-                    if (!file || file.gcount() != mipmapData.rowPitch)
-                    {
-                        return false;
-                    }
-                }
+    uint64 payloadSize = imageData.data.size();
 
-                imageData.mipmapDataItems.push_back(mipmapData);
+    // The file statistics were started with the single level the file has
+    ImageFileStatistics& fileStatistics = statistics.fileStatisticsItems.back();
+    fileStatistics.width = imageData.width;
+    fileStatistics.height = imageData.height;
+    fileStatistics.skippedMipmapLevels = skippedMipmapLevels;
+    fileStatistics.size = payloadSize;
+    fileStatistics.skippedSize += generatedPayloadSize - payloadSize;
 
-                if (width == 1)
-                {
-                    break;
-                }
-            }
+    statistics.skippedSize = fileStatistics.skippedSize;
+}
+
+uint32 ImageFileParser::getSkippedMipmapLevels(const ImageData& imageData,
+                                               TextureClass textureClass)
+{
+    const TextureBudgetSettings& textureBudgetSettings = settings.textureBudgetSettings;
+
+    uint32 budgetMipmapLevels = textureBudgetSettings.skippedMipmapLevels;
+    uint32 classIndex = static_cast<uint32>(textureClass);
+    if (classIndex < TextureClassCount
+        && textureBudgetSettings.classSkippedMipmapLevels[classIndex] != TextureBudgetNoOverride)
+    {
+        budgetMipmapLevels = textureBudgetSettings.classSkippedMipmapLevels[classIndex];
+    }
+
+    // D3D11 only creates block-compressed textures whose top level is made of whole blocks
+    uint32 blockSize = getImageFormatBlockSize(imageData.format);
+    uint32 skippedMipmapLevels = 0;
+    while (skippedMipmapLevels < budgetMipmapLevels
+        && skippedMipmapLevels + 1 < imageData.mipmapLevels)
+    {
+        uint32 width = getImageMipmapSize(imageData.width, skippedMipmapLevels + 1);
+        uint32 height = getImageMipmapSize(imageData.height, skippedMipmapLevels + 1);
+        if (blockSize > 0 && (width % 4 != 0 || height % 4 != 0))
+        {
+            break;
         }
-        else
+
+        skippedMipmapLevels++;
+    }
+
+    return skippedMipmapLevels;
+}
+
+uint64 ImageFileParser::getDdsSourcePayloadSize(const PixelMasks& sourceMasks,
+                                                uint64 payloadSize)
+{
+    // Payloads that aren't expanded are stored as they are
+    if (sourceMasks.bitCount == 0)
+    {
+        return payloadSize;
+    }
+
+    return payloadSize / PixelConverterRgba8PixelSize * (sourceMasks.bitCount / 8);
+}
+
+bool ImageFileParser::convertPayload(const unsigned char* source, const PixelMasks& sourceMasks,
+                                     const std::vector<ImagePayloadRun>& payloadRuns,
+                                     uint64 payloadSize, ImageData& imageData)
+{
+    imageData.data.resize(payloadSize);
+
+    pixelConverter.setSettings(settings.pixelConverterSettings);
+
+    PixelConverterStatistics& pixelConverterStatistics = statistics.pixelConverterStatistics;
+    pixelConverterStatistics = {};
+    for (const auto& payloadRun : payloadRuns)
+    {
+        bool result = pixelConverter.convertToRgba8(source + getDdsSourcePayloadSize(sourceMasks,
+            payloadRun.fileOffset), sourceMasks, payloadRun.size / PixelConverterRgba8PixelSize,
+            imageData.data.data() + payloadRun.offset);
+        if (!result)
         {
             return false;
         }
+
+        PixelConverterStatistics runStatistics = pixelConverter.getStatistics();
+        pixelConverterStatistics.instructionSet = runStatistics.instructionSet;
+        pixelConverterStatistics.pixelCount += runStatistics.pixelCount;
+        pixelConverterStatistics.size += runStatistics.size;
+        pixelConverterStatistics.conversionTime += runStatistics.conversionTime;
     }
-    else
+    if (pixelConverterStatistics.conversionTime > 0.0)
+    {
+        pixelConverterStatistics.throughput = pixelConverterStatistics.size / (1024.0 * 1024.0 *
+            1024.0) / pixelConverterStatistics.conversionTime;
+    }
+
+    return true;
+}
+
+bool ImageFileParser::initializeSubresourceDataItems(ImageData& imageData, uint64& payloadSize)
+{
+    uint32 maxMipmapLevels = 1;
+    while (getImageMipmapSize(imageData.width, maxMipmapLevels - 1) > 1
+        || getImageMipmapSize(imageData.height, maxMipmapLevels - 1) > 1)
+    {
+        maxMipmapLevels++;
+    }
+    if (imageData.mipmapLevels > maxMipmapLevels)
     {
         return false;
     }
-    file.close();
+
+    imageData.subresourceDataItems = std::vector<ImageSubresourceData>(
+        imageData.mipmapLevels * imageData.arraySize);
+
+    payloadSize = 0;
+    for (uint32 i = 0; i < imageData.arraySize; i++)
+    {
+        for (uint32 j = 0; j < imageData.mipmapLevels; j++)
+        {
+            uint32 width = getImageMipmapSize(imageData.width, j);
+            uint32 height = getImageMipmapSize(imageData.height, j);
+
+            // Block-compressed rows hold 4 pixel rows, partial blocks at the edges are stored
+            // whole
+            uint64 rowPitch = 0;
+            uint64 rowCount = 0;
+            uint32 blockSize = getImageFormatBlockSize(imageData.format);
+            if (blockSize > 0)
+            {
+                rowPitch = (static_cast<uint64>(width) + 3) / 4 * blockSize;
+                rowCount = (static_cast<uint64>(height) + 3) / 4;
+            }
+            else
+            {
+                uint32 pixelSize = getImageFormatPixelSize(imageData.format);
+                if (pixelSize == 0)
+                {
+                    return false;
+                }
+
+                rowPitch = static_cast<uint64>(width) * pixelSize;
+                rowCount = height;
+            }
+
+            uint64 depthPitch = rowPitch * rowCount;
+            if (depthPitch > UINT32_MAX)
+            {
+                return false;
+            }
+
+            ImageSubresourceData& subresourceData = imageData.subresourceDataItems[
+                getImageSubresourceIndex(imageData, j, i)];
+            subresourceData.offset = payloadSize;
+            subresourceData.rowPitch = static_cast<uint32>(rowPitch);
+            subresourceData.depthPitch = static_cast<uint32>(depthPitch);
+
+            payloadSize += depthPitch;
+        }
+    }
 
     return true;
 }
+
+void ImageFileParser::skipMipmapLevels(ImageData& imageData, TextureClass textureClass,
+                                       std::vector<ImagePayloadRun>& payloadRuns,
+                                       uint64& payloadSize)
+{
+    uint32 skippedMipmapLevels = getSkippedMipmapLevels(imageData, textureClass);
+
+    uint32 mipmapLevels = imageData.mipmapLevels - skippedMipmapLevels;
+    std::vector<ImageSubresourceData> subresourceDataItems(static_cast<uint64>(mipmapLevels) *
+                                                           imageData.arraySize);
+    payloadRuns = std::vector<ImagePayloadRun>(imageData.arraySize);
+
+    uint64 filePayloadSize = payloadSize;
+    payloadSize = 0;
+    for (uint32 i = 0; i < imageData.arraySize; i++)
+    {
+        ImagePayloadRun& payloadRun = payloadRuns[i];
+        payloadRun.fileOffset = imageData.subresourceDataItems[getImageSubresourceIndex(
+            imageData, skippedMipmapLevels, i)].offset;
+        payloadRun.offset = payloadSize;
+
+        for (uint32 j = 0; j < mipmapLevels; j++)
+        {
+            ImageSubresourceData& subresourceData = subresourceDataItems[j + i * mipmapLevels];
+            subresourceData = imageData.subresourceDataItems[getImageSubresourceIndex(
+                imageData, j + skippedMipmapLevels, i)];
+            subresourceData.offset = payloadSize;
+
+            payloadSize += subresourceData.depthPitch;
+        }
+
+        payloadRun.size = payloadSize - payloadRun.offset;
+    }
+
+    imageData.width = getImageMipmapSize(imageData.width, skippedMipmapLevels);
+    imageData.height = getImageMipmapSize(imageData.height, skippedMipmapLevels);
+    imageData.mipmapLevels = mipmapLevels;
+    imageData.subresourceDataItems = std::move(subresourceDataItems);
+
+    ImageFileStatistics fileStatistics = {};
+    fileStatistics.width = imageData.width;
+    fileStatistics.height = imageData.height;
+    fileStatistics.skippedMipmapLevels = skippedMipmapLevels;
+    fileStatistics.size = payloadSize;
+    fileStatistics.skippedSize = filePayloadSize - payloadSize;
+
+    statistics.skippedSize = fileStatistics.skippedSize;
+    statistics.fileStatisticsItems = {fileStatistics};
+}
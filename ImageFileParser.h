@@ -1,19 +1,78 @@
 #pragma once
 #include <fstream>
+#include <memory>
+
+#include <cstring>
 
 #include <vector>
 
 #include <string>
 
+#include <chrono>
+#include <thread>
+
+#include "MappedFile.h"
+#include "MipmapGenerator.h"
+#include "PixelConverter.h"
+
 #include "DdsUtility.h"
 
 #include "FileParserUtility.h"
 #include "ImageFileParserUtility.h"
+#include "MemoryUtility.h"
 
 class ImageFileParser
 {
+    PixelConverter pixelConverter;
+    MipmapGenerator mipmapGenerator;
+
+    ImageFileParserSettings settings;
+
+    ImageFileParserStatistics statistics;
+
 public:
-    bool parseFile(std::string filename, ImageData& imageData);
+    ImageFileParser();
+
+    ImageFileParserSettings getSettings();
+    void setSettings(ImageFileParserSettings settings);
+
+    ImageFileParserStatistics getStatistics();
+
+    // The texture budget of the class decides how many of the largest mipmap levels are skipped
+    bool parseFile(std::string filename, ImageData& imageData,
+                   TextureClass textureClass = TextureClass::Undefined);
+    // Decodes every file once on up to threadCount threads, the results follow the filenames
+    bool parseFiles(const std::vector<std::string>& filenames, uint32 threadCount,
+                    std::vector<std::shared_ptr<ImageData>>& imageDataItems,
+                    TextureClass textureClass = TextureClass::Undefined);
+
+    bool parseDdsFile(std::string filename, ImageData& imageData,
+                      TextureClass textureClass = TextureClass::Undefined);
+    bool parseMappedDdsFile(std::string filename, ImageData& imageData,
+                            TextureClass textureClass = TextureClass::Undefined);
+
+private:
+    // The extended header is only read when the pixel format has the 'DX10' FourCC
+    // sourceMasks.bitCount stays 0 unless the pixels have to be expanded to RGBA8
+    bool parseDdsHeader(const DdsHeader& header, const DdsHeaderDxt10& headerDxt10,
+                        ImageData& imageData, PixelMasks& sourceMasks);
+    bool parseDdsHeaderDxt10(const DdsHeaderDxt10& headerDxt10, ImageData& imageData);
+    // Lays out every subresource of the format back to back like the file stores them
+    bool initializeSubresourceDataItems(ImageData& imageData, uint64& payloadSize);
+    // Drops the largest mipmap levels the budget of the class skips and lays out the rest back to
+    // back, payloadSize going from the size of the file payload to the size of the levels kept.
+    // The file statistics of the image are started
+    void skipMipmapLevels(ImageData& imageData, TextureClass textureClass,
+                          std::vector<ImagePayloadRun>& payloadRuns, uint64& payloadSize);
+    // Drops the largest generated levels the budget of the class skips, files with a single level
+    // have nothing to skip until their levels are generated from it
+    void skipGeneratedMipmapLevels(ImageData& imageData, TextureClass textureClass);
+    // Of the budget of the class, down to the smallest level and to top levels of whole blocks
+    uint32 getSkippedMipmapLevels(const ImageData& imageData, TextureClass textureClass);
 
-    bool parseDdsFile(std::string filename, ImageData& imageData);
+    // Of the part of the file that holds payloadSize B of the image payload
+    uint64 getDdsSourcePayloadSize(const PixelMasks& sourceMasks, uint64 payloadSize);
+    bool convertPayload(const unsigned char* source, const PixelMasks& sourceMasks,
+                        const std::vector<ImagePayloadRun>& payloadRuns, uint64 payloadSize,
+                        ImageData& imageData);
 };
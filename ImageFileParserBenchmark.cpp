@@ -0,0 +1,175 @@
+#include "ImageFileParserBenchmark.h"
+
+ImageFileParserBenchmark::ImageFileParserBenchmark() : settings{}
+{
+    settings.repeatCount = 1;
+}
+
+BenchmarkSettings ImageFileParserBenchmark::getSettings()
+{
+    return settings;
+}
+
+void ImageFileParserBenchmark::setSettings(BenchmarkSettings settings)
+{
+    this->settings = settings;
+}
+
+bool ImageFileParserBenchmark::run(const std::vector<std::string>& filenames)
+{
+    for (const std::string& filename : filenames)
+    {
+        ImageFileParserStatistics streamStatistics = {};
+        double streamReadingTime = 0.0;
+        ImageData streamImageData = {};
+        bool result = parseFile(filename, ImageFileParserMode::Stream, streamStatistics,
+                                streamReadingTime, streamImageData);
+        if (!result)
+        {
+            std::printf("Failed to parse %s\n", filename.c_str());
+
+            return false;
+        }
+
+        ImageFileParserStatistics mappedStatistics = {};
+        double mappedReadingTime = 0.0;
+        ImageData mappedImageData = {};
+        result = parseFile(filename, ImageFileParserMode::MappedFile, mappedStatistics,
+                           mappedReadingTime, mappedImageData);
+        if (!result)
+        {
+            std::printf("Failed to parse %s\n", filename.c_str());
+
+            return false;
+        }
+
+        double fileSize = mappedStatistics.fileSize / (1024.0 * 1024.0); // MB
+        double mappedTime = mappedStatistics.parsingTime + mappedReadingTime;
+
+        std::printf("DDS loading: %s\n", filename.c_str());
+        std::printf("  size: %.2f MB, %ux%u, %u mipmap levels, %u array slices, format %u\n",
+                    fileSize, mappedImageData.width, mappedImageData.height,
+                    mappedImageData.mipmapLevels, mappedImageData.arraySize,
+                    static_cast<uint32>(mappedImageData.format));
+        std::printf("  stream: %.4f s, %.1f MB/s\n", streamStatistics.parsingTime,
+                    streamStatistics.throughput);
+        std::printf("  mapped file: %.4f s, %.1f MB/s\n", mappedStatistics.parsingTime,
+                    mappedStatistics.throughput);
+        std::printf("  mapped file and payload read: %.4f s, %.1f MB/s\n", mappedTime,
+                    mappedTime > 0.0 ? fileSize / mappedTime : 0.0);
+
+        PixelConverterStatistics pixelConverterStatistics =
+            mappedStatistics.pixelConverterStatistics;
+        if (pixelConverterStatistics.pixelCount > 0)
+        {
+            std::printf("  pixel conversion: %s, %.4f s, %.2f GB/s\n",
+                        getCpuInstructionSetName(pixelConverterStatistics.instructionSet),
+                        pixelConverterStatistics.conversionTime,
+                        pixelConverterStatistics.throughput);
+        }
+
+        MipmapGeneratorStatistics mipmapGeneratorStatistics =
+            mappedStatistics.mipmapGeneratorStatistics;
+        if (mipmapGeneratorStatistics.imageCount > 0)
+        {
+            std::printf("  mipmap generation: %s, %u threads, %.4f s, %.2f GB/s\n",
+                        getCpuInstructionSetName(mipmapGeneratorStatistics.instructionSet),
+                        mipmapGeneratorStatistics.threadCount,
+                        mipmapGeneratorStatistics.generationTime,
+                        mipmapGeneratorStatistics.throughput);
+        }
+
+        // Both modes are meant to give the same image
+        if (getPayloadSize(streamImageData) != getPayloadSize(mappedImageData)
+            || readPayload(streamImageData) != readPayload(mappedImageData))
+        {
+            std::printf("  the modes parsed different images\n");
+
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool ImageFileParserBenchmark::parseFile(const std::string& filename, ImageFileParserMode mode,
+                                         ImageFileParserStatistics& statistics,
+                                         double& readingTime, ImageData& imageData)
+{
+    ImageFileParser imageFileParser;
+    ImageFileParserSettings parserSettings = imageFileParser.getSettings();
+    parserSettings.mode = mode;
+    parserSettings.mipmapGeneratorSettings.threadCount = settings.threadCount;
+    imageFileParser.setSettings(parserSettings);
+
+    for (uint32 i = 0; i < settings.repeatCount; i++)
+    {
+        ImageData runImageData = {};
+        bool result = imageFileParser.parseFile(filename, runImageData);
+        if (!result)
+        {
+            return false;
+        }
+
+        auto startTime = std::chrono::steady_clock::now();
+
+        volatile uint64 sum = readPayload(runImageData);
+        (void)sum;
+
+        std::chrono::duration<double> runReadingTime = std::chrono::steady_clock::now() -
+            startTime;
+
+        ImageFileParserStatistics runStatistics = imageFileParser.getStatistics();
+        if (i == 0 || runStatistics.parsingTime + runReadingTime.count() <
+            statistics.parsingTime + readingTime)
+        {
+            statistics = runStatistics;
+            readingTime = runReadingTime.count();
+        }
+        if (i == 0)
+        {
+            imageData = std::move(runImageData);
+        }
+    }
+
+    return true;
+}
+
+uint64 ImageFileParserBenchmark::getPayloadSize(const ImageData& imageData)
+{
+    uint64 size = 0;
+    for (uint32 i = 0; i < imageData.subresourceDataItems.size(); i++)
+    {
+        const ImageSubresourceData& subresourceData = imageData.subresourceDataItems[i];
+        uint32 depth = getImageMipmapSize(imageData.depth, i % imageData.mipmapLevels);
+        uint64 end = subresourceData.offset + static_cast<uint64>(subresourceData.depthPitch) *
+            depth;
+        if (end > size)
+        {
+            size = end;
+        }
+    }
+
+    return size;
+}
+
+uint64 ImageFileParserBenchmark::readPayload(const ImageData& imageData)
+{
+    const unsigned char* payload = getImagePayload(imageData);
+    uint64 size = getPayloadSize(imageData);
+
+    uint64 sum = 0;
+    uint64 i = 0;
+    for (; i + sizeof(uint64) <= size; i += sizeof(uint64))
+    {
+        uint64 value = 0;
+        std::memcpy(&value, payload + i, sizeof(uint64));
+        sum += value;
+    }
+    for (; i < size; i++)
+    {
+        sum += payload[i];
+    }
+
+    return sum;
+}
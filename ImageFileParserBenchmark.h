@@ -0,0 +1,41 @@
+#pragma once
+#include <cstdio>
+#include <cstring>
+
+#include <string>
+#include <vector>
+
+#include <chrono>
+
+#include "ImageFileParser.h"
+
+#include "BenchmarkUtility.h"
+#include "CpuUtility.h"
+#include "ImageFileParserUtility.h"
+#include "IntUtility.h"
+
+// Loads DDS files in the stream and mapped file modes and prints the throughput of both. A mapped
+// payload is paged in when it is first read, so the mapped file mode is also timed with a read of
+// the whole payload, which is what the upload does
+class ImageFileParserBenchmark
+{
+    BenchmarkSettings settings;
+
+public:
+    ImageFileParserBenchmark();
+
+    BenchmarkSettings getSettings();
+    void setSettings(BenchmarkSettings settings);
+
+    bool run(const std::vector<std::string>& filenames);
+
+private:
+    // Of the fastest run, readingTime is of the payload read after parsing
+    bool parseFile(const std::string& filename, ImageFileParserMode mode,
+                   ImageFileParserStatistics& statistics, double& readingTime,
+                   ImageData& imageData);
+
+    uint64 getPayloadSize(const ImageData& imageData);
+    // Sums the payload so it can't be optimized away
+    uint64 readPayload(const ImageData& imageData);
+};
@@ -0,0 +1,498 @@
+#include "ImageFileParserTests.h"
+
+ImageFileParserTests::ImageFileParserTests() : statistics{}, fileParser()
+{
+}
+
+TestStatistics ImageFileParserTests::getStatistics()
+{
+    return statistics;
+}
+
+void ImageFileParserTests::run()
+{
+    statistics = {};
+
+    const ImageFileParserMode modes[] = {
+        ImageFileParserMode::Stream,
+        ImageFileParserMode::MappedFile,
+    };
+    for (ImageFileParserMode mode : modes)
+    {
+        testLegacyFile(mode);
+        testDxt10File(mode);
+        testCubemapFile(mode);
+        testArrayFile(mode);
+        testTruncatedFile(mode);
+        testHeaderFlags(mode);
+        testFootprint(mode);
+        testSkippedLevelsFootprint(mode);
+    }
+
+    std::remove(ImageFileParserTestFilename);
+}
+
+void ImageFileParserTests::testLegacyFile(ImageFileParserMode mode)
+{
+    std::string modeName = mode == ImageFileParserMode::Stream ? " (stream)" : " (mapped)";
+
+    // Not a multiple of the block size, the smallest levels are partial blocks
+    DdsHeader header = getDdsHeader(60, 36, 6, DdsMagicNumberDxt1.number);
+    std::vector<unsigned char> file;
+    getDdsFile(header, {}, getPayloadSize(60, 36, 6, 1, DdsBc1BlockSize, 0), file);
+
+    ImageData imageData = {};
+    bool result = parseFile(mode, 0, file, imageData);
+    checkTest(result, "ImageFileParser legacy BC1" + modeName, statistics);
+    if (result)
+    {
+        checkImage(imageData, 60, 36, DXGI_FORMAT_BC1_UNORM, 6, 1, false, DdsBc1BlockSize, 0,
+                   "ImageFileParser legacy BC1 layout" + modeName);
+    }
+
+    header = getDdsHeader(16, 8, 5, 0);
+    getDdsFile(header, {}, getPayloadSize(16, 8, 5, 1, 0, 4), file);
+
+    result = parseFile(mode, 0, file, imageData);
+    checkTest(result, "ImageFileParser legacy RGBA8" + modeName, statistics);
+    if (result)
+    {
+        checkImage(imageData, 16, 8, DXGI_FORMAT_R8G8B8A8_UNORM, 5, 1, false, 0, 4,
+                   "ImageFileParser legacy RGBA8 layout" + modeName);
+    }
+}
+
+void ImageFileParserTests::testDxt10File(ImageFileParserMode mode)
+{
+    std::string modeName = mode == ImageFileParserMode::Stream ? " (stream)" : " (mapped)";
+
+    DdsHeaderDxt10 headerDxt10 = {};
+    DdsHeader header = getDdsHeaderDxt10(32, 20, 6, headerDxt10, DXGI_FORMAT_BC7_UNORM, 1,
+                                         false);
+    std::vector<unsigned char> file;
+    getDdsFile(header, headerDxt10, getPayloadSize(32, 20, 6, 1, DdsBc2BlockSize, 0), file);
+
+    ImageData imageData = {};
+    bool result = parseFile(mode, 0, file, imageData);
+    checkTest(result, "ImageFileParser DX10 BC7" + modeName, statistics);
+    if (result)
+    {
+        checkImage(imageData, 32, 20, DXGI_FORMAT_BC7_UNORM, 6, 1, false, DdsBc2BlockSize, 0,
+                   "ImageFileParser DX10 BC7 layout" + modeName);
+    }
+
+    // Only 2D textures are supported
+    headerDxt10.resourceDimension = static_cast<uint32>(DdsResourceDimension::Texture3d);
+    getDdsFile(header, headerDxt10, getPayloadSize(32, 20, 6, 1, DdsBc2BlockSize, 0), file);
+
+    result = parseFile(mode, 0, file, imageData);
+    checkTest(!result, "ImageFileParser DX10 3D texture rejected" + modeName, statistics);
+}
+
+void ImageFileParserTests::testCubemapFile(ImageFileParserMode mode)
+{
+    std::string modeName = mode == ImageFileParserMode::Stream ? " (stream)" : " (mapped)";
+
+    DdsHeader header = getDdsHeader(8, 8, 4, 0);
+    header.caps |= static_cast<uint32>(DdsCaps::Complex);
+    header.caps2 = static_cast<uint32>(DdsCaps2::Cubemap) | DdsCaps2AllFaces;
+    std::vector<unsigned char> file;
+    getDdsFile(header, {}, getPayloadSize(8, 8, 4, 6, 0, 4), file);
+
+    ImageData imageData = {};
+    bool result = parseFile(mode, 0, file, imageData);
+    checkTest(result, "ImageFileParser legacy cubemap" + modeName, statistics);
+    if (result)
+    {
+        checkImage(imageData, 8, 8, DXGI_FORMAT_R8G8B8A8_UNORM, 4, 6, true, 0, 4,
+                   "ImageFileParser legacy cubemap layout" + modeName);
+    }
+
+    // A cubemap with a missing face can't be created as a cube texture
+    header.caps2 &= ~static_cast<uint32>(DdsCaps2::CubemapNegativeZ);
+    getDdsFile(header, {}, getPayloadSize(8, 8, 4, 5, 0, 4), file);
+
+    result = parseFile(mode, 0, file, imageData);
+    checkTest(!result, "ImageFileParser cubemap with a missing face rejected" + modeName,
+              statistics);
+}
+
+void ImageFileParserTests::testArrayFile(ImageFileParserMode mode)
+{
+    std::string modeName = mode == ImageFileParserMode::Stream ? " (stream)" : " (mapped)";
+
+    DdsHeaderDxt10 headerDxt10 = {};
+    DdsHeader header = getDdsHeaderDxt10(16, 8, 5, headerDxt10, DXGI_FORMAT_R8G8B8A8_UNORM, 3,
+                                         false);
+    std::vector<unsigned char> file;
+    getDdsFile(header, headerDxt10, getPayloadSize(16, 8, 5, 3, 0, 4), file);
+
+    ImageData imageData = {};
+    bool result = parseFile(mode, 0, file, imageData);
+    checkTest(result, "ImageFileParser DX10 array" + modeName, statistics);
+    if (result)
+    {
+        checkImage(imageData, 16, 8, DXGI_FORMAT_R8G8B8A8_UNORM, 5, 3, false, 0, 4,
+                   "ImageFileParser DX10 array layout" + modeName);
+    }
+
+    // The array size of a cubemap counts cubes, every one of them has 6 faces
+    header = getDdsHeaderDxt10(8, 8, 2, headerDxt10, DXGI_FORMAT_BC1_UNORM, 2, true);
+    getDdsFile(header, headerDxt10, getPayloadSize(8, 8, 2, 12, DdsBc1BlockSize, 0), file);
+
+    result = parseFile(mode, 0, file, imageData);
+    checkTest(result, "ImageFileParser DX10 cubemap array" + modeName, statistics);
+    if (result)
+    {
+        checkImage(imageData, 8, 8, DXGI_FORMAT_BC1_UNORM, 2, 12, true, DdsBc1BlockSize, 0,
+                   "ImageFileParser DX10 cubemap array layout" + modeName);
+    }
+}
+
+void ImageFileParserTests::testTruncatedFile(ImageFileParserMode mode)
+{
+    std::string modeName = mode == ImageFileParserMode::Stream ? " (stream)" : " (mapped)";
+
+    DdsHeader header = getDdsHeader(64, 64, 7, DdsMagicNumberDxt1.number);
+    std::vector<unsigned char> file;
+    getDdsFile(header, {}, getPayloadSize(64, 64, 7, 1, DdsBc1BlockSize, 0) - 1, file);
+
+    ImageData imageData = {};
+    bool result = parseFile(mode, 0, file, imageData);
+    checkTest(!result, "ImageFileParser truncated payload rejected" + modeName, statistics);
+
+    getDdsFile(header, {}, 0, file);
+    file.resize(DdsMagicNumberSize + sizeof(DdsHeader) / 2);
+
+    result = parseFile(mode, 0, file, imageData);
+    checkTest(!result, "ImageFileParser truncated header rejected" + modeName, statistics);
+
+    DdsHeaderDxt10 headerDxt10 = {};
+    header = getDdsHeaderDxt10(4, 4, 1, headerDxt10, DXGI_FORMAT_BC7_UNORM, 1, false);
+    getDdsFile(header, headerDxt10, 0, file);
+    file.resize(DdsMagicNumberSize + sizeof(DdsHeader) + sizeof(DdsHeaderDxt10) / 2);
+
+    result = parseFile(mode, 0, file, imageData);
+    checkTest(!result, "ImageFileParser truncated DX10 header rejected" + modeName, statistics);
+}
+
+void ImageFileParserTests::testHeaderFlags(ImageFileParserMode mode)
+{
+    std::string modeName = mode == ImageFileParserMode::Stream ? " (stream)" : " (mapped)";
+
+    // Many writers leave DDSD_PIXELFORMAT out
+    DdsHeader header = getDdsHeader(8, 8, 1, DdsMagicNumberDxt1.number);
+    header.flags &= ~static_cast<uint32>(Ddsd::PixelFormat);
+    std::vector<unsigned char> file;
+    getDdsFile(header, {}, getPayloadSize(8, 8, 1, 1, DdsBc1BlockSize, 0), file);
+
+    ImageData imageData = {};
+    bool result = parseFile(mode, 0, file, imageData);
+    checkTest(result, "ImageFileParser header without DDSD_PIXELFORMAT" + modeName, statistics);
+
+    // Either size missing is enough to reject the file
+    header = getDdsHeader(8, 8, 1, DdsMagicNumberDxt1.number);
+    header.flags &= ~static_cast<uint32>(Ddsd::Height);
+    getDdsFile(header, {}, getPayloadSize(8, 8, 1, 1, DdsBc1BlockSize, 0), file);
+
+    result = parseFile(mode, 0, file, imageData);
+    checkTest(!result, "ImageFileParser header without DDSD_HEIGHT rejected" + modeName,
+              statistics);
+}
+
+void ImageFileParserTests::testFootprint(ImageFileParserMode mode)
+{
+    std::string modeName = mode == ImageFileParserMode::Stream ? " (stream)" : " (mapped)";
+
+    DdsHeader header = getDdsHeader(20, 12, 5, DdsMagicNumberDxt5.number);
+    uint64 payloadSize = getPayloadSize(20, 12, 5, 1, DdsBc2BlockSize, 0);
+    std::vector<unsigned char> file;
+    getDdsFile(header, {}, payloadSize, file);
+
+    ImageData imageData = {};
+    bool result = parseFile(mode, 0, file, imageData);
+
+    // Read, the payload is one aligned allocation of the size it has in the file. Mapped, there
+    // is no allocation and the payload is used where the file has it
+    if (result && mode == ImageFileParserMode::Stream)
+    {
+        result = imageData.data.size() == payloadSize && !imageData.mappedFile
+            && reinterpret_cast<uintptr_t>(imageData.data.data()) % ImageDataAlignment == 0;
+    }
+    else if (result)
+    {
+        uint64 headerSize = DdsMagicNumberSize + sizeof(DdsHeader);
+        result = imageData.data.empty() && imageData.mappedFile
+            && imageData.mappedDataOffset == headerSize
+            && getImagePayload(imageData) == imageData.mappedFile->getData() + headerSize;
+    }
+
+    for (uint32 i = 0; i < imageData.mipmapLevels && result; i++)
+    {
+        uint32 blockWidth = (getImageMipmapSize(20, i) + 3) / 4;
+        result = imageData.subresourceDataItems[i].rowPitch == blockWidth * DdsBc2BlockSize;
+    }
+    if (result)
+    {
+        result = isPayloadLaidOut(imageData, DdsBc2BlockSize, 0);
+    }
+
+    checkTest(result, "ImageFileParser payload footprint" + modeName, statistics);
+}
+
+void ImageFileParserTests::testSkippedLevelsFootprint(ImageFileParserMode mode)
+{
+    std::string modeName = mode == ImageFileParserMode::Stream ? " (stream)" : " (mapped)";
+
+    // 2 slices of 32x16 with 6 levels, the 2 largest of each skipped
+    DdsHeaderDxt10 headerDxt10 = {};
+    DdsHeader header = getDdsHeaderDxt10(32, 16, 6, headerDxt10, DXGI_FORMAT_R8G8B8A8_UNORM, 2,
+                                         false);
+    uint64 sliceSize = getPayloadSize(32, 16, 6, 1, 0, 4);
+    uint64 skippedSliceSize = getPayloadSize(32, 16, 2, 1, 0, 4);
+    std::vector<unsigned char> file;
+    getDdsFile(header, headerDxt10, sliceSize * 2, file);
+
+    ImageData imageData = {};
+    bool result = parseFile(mode, 2, file, imageData);
+    if (result)
+    {
+        result = imageData.width == 8 && imageData.height == 4 && imageData.mipmapLevels == 4
+            && imageData.arraySize == 2 && imageData.subresourceDataItems.size() == 8;
+    }
+
+    // Read, only the levels kept are allocated, back to back. Mapped, the skipped ones stay in
+    // the file between the runs of levels kept
+    uint64 keptSliceSize = sliceSize - skippedSliceSize;
+    if (result && mode == ImageFileParserMode::Stream)
+    {
+        result = imageData.data.size() == keptSliceSize * 2;
+    }
+    else if (result)
+    {
+        result = imageData.data.empty() && imageData.mappedFile;
+    }
+
+    for (uint32 i = 0; i < imageData.arraySize && result; i++)
+    {
+        uint64 fileOffset = i * sliceSize + skippedSliceSize;
+        uint64 offset = i * keptSliceSize;
+        if (mode == ImageFileParserMode::MappedFile)
+        {
+            offset = fileOffset;
+        }
+
+        for (uint32 j = 0; j < imageData.mipmapLevels && result; j++)
+        {
+            uint32 subresourceIndex = getImageSubresourceIndex(imageData, j, i);
+            uint64 size = getPayloadSize(getImageMipmapSize(8, j), getImageMipmapSize(4, j), 1, 1,
+                                         0, 4);
+            result = imageData.subresourceDataItems[subresourceIndex].offset == offset;
+
+            const unsigned char* data = getImageSubresourceData(imageData, subresourceIndex);
+            for (uint64 k = 0; k < size && result; k++)
+            {
+                result = data[k] == (fileOffset + k) % 251;
+            }
+
+            fileOffset += size;
+            offset += size;
+        }
+    }
+
+    ImageFileParserStatistics parserStatistics = fileParser.getStatistics();
+    if (result)
+    {
+        const ImageFileStatistics& fileStatistics = parserStatistics.fileStatisticsItems[0];
+        result = fileStatistics.skippedMipmapLevels == 2
+            && fileStatistics.size == keptSliceSize * 2
+            && fileStatistics.skippedSize == skippedSliceSize * 2
+            && parserStatistics.skippedSize == skippedSliceSize * 2;
+    }
+
+    checkTest(result, "ImageFileParser skipped levels footprint" + modeName, statistics);
+}
+
+DdsHeader ImageFileParserTests::getDdsHeader(uint32 width, uint32 height, uint32 mipmapLevels,
+                                             uint32 fourCc)
+{
+    DdsHeader header = {};
+    header.size = sizeof(DdsHeader);
+    header.flags = static_cast<uint32>(Ddsd::Caps) | static_cast<uint32>(Ddsd::Height) |
+        static_cast<uint32>(Ddsd::Width) | static_cast<uint32>(Ddsd::PixelFormat) |
+        static_cast<uint32>(Ddsd::MipmapCount);
+    header.height = height;
+    header.width = width;
+    header.mipMapCount = mipmapLevels;
+
+    DdsPixelFormat& pixelFormat = header.pixelFormat;
+    pixelFormat.size = sizeof(DdsPixelFormat);
+    if (fourCc != 0)
+    {
+        pixelFormat.flags = static_cast<uint32>(Ddpf::FourCc);
+        pixelFormat.fourCc = fourCc;
+    }
+    else
+    {
+        pixelFormat.flags = static_cast<uint32>(Ddpf::Rgb) | static_cast<uint32>(
+            Ddpf::Alphapixels);
+        pixelFormat.rgbBitCount = 32;
+        pixelFormat.rBitMask = Dds32BitMaskFirst8Bit;
+        pixelFormat.gBitMask = Dds32BitMaskSecond8Bit;
+        pixelFormat.bBitMask = Dds32BitMaskThird8Bit;
+        pixelFormat.aBitMask = Dds32BitMaskFourth8Bit;
+    }
+
+    header.caps = static_cast<uint32>(DdsCaps::Texture);
+    if (mipmapLevels > 1)
+    {
+        header.caps |= static_cast<uint32>(DdsCaps::Complex) | static_cast<uint32>(
+            DdsCaps::Mipmap);
+    }
+
+    return header;
+}
+
+DdsHeader ImageFileParserTests::getDdsHeaderDxt10(uint32 width, uint32 height,
+                                                  uint32 mipmapLevels,
+                                                  DdsHeaderDxt10& headerDxt10, DXGI_FORMAT format,
+                                                  uint32 arraySize, bool isCubemap)
+{
+    headerDxt10 = {};
+    headerDxt10.dxgiFormat = format;
+    headerDxt10.resourceDimension = static_cast<uint32>(DdsResourceDimension::Texture2d);
+    if (isCubemap)
+    {
+        headerDxt10.miscFlag = static_cast<uint32>(DdsResourceMisc::TextureCube);
+    }
+    headerDxt10.arraySize = arraySize;
+
+    return getDdsHeader(width, height, mipmapLevels, DdsMagicNumberDx10.number);
+}
+
+void ImageFileParserTests::getDdsFile(const DdsHeader& header, const DdsHeaderDxt10& headerDxt10,
+                                      uint64 payloadSize, std::vector<unsigned char>& file)
+{
+    file.clear();
+
+    const unsigned char* magicNumber = DdsMagicNumberDds.chars;
+    file.insert(file.end(), magicNumber, magicNumber + DdsMagicNumberSize);
+
+    const unsigned char* headerBytes = reinterpret_cast<const unsigned char*>(&header);
+    file.insert(file.end(), headerBytes, headerBytes + sizeof(DdsHeader));
+
+    if (isDdsHeaderDxt10(header))
+    {
+        const unsigned char* headerDxt10Bytes = reinterpret_cast<const unsigned char*>(
+            &headerDxt10);
+        file.insert(file.end(), headerDxt10Bytes, headerDxt10Bytes + sizeof(DdsHeaderDxt10));
+    }
+
+    for (uint64 i = 0; i < payloadSize; i++)
+    {
+        file.push_back(static_cast<unsigned char>(i % 251));
+    }
+}
+
+uint64 ImageFileParserTests::getPayloadSize(uint32 width, uint32 height, uint32 mipmapLevels,
+                                            uint32 arraySize, uint32 blockSize,
+                                            uint32 pixelSize)
+{
+    uint64 sliceSize = 0;
+    for (uint32 i = 0; i < mipmapLevels; i++)
+    {
+        uint64 levelWidth = getImageMipmapSize(width, i);
+        uint64 levelHeight = getImageMipmapSize(height, i);
+        if (blockSize > 0)
+        {
+            sliceSize += (levelWidth + 3) / 4 * ((levelHeight + 3) / 4) * blockSize;
+        }
+        else
+        {
+            sliceSize += levelWidth * levelHeight * pixelSize;
+        }
+    }
+
+    return sliceSize * arraySize;
+}
+
+bool ImageFileParserTests::parseFile(ImageFileParserMode mode, uint32 skippedMipmapLevels,
+                                     const std::vector<unsigned char>& file, ImageData& imageData)
+{
+    // A mapped file can't be written again while an image still holds it
+    imageData = {};
+
+    std::ofstream stream(ImageFileParserTestFilename, std::ios::binary | std::ios::trunc);
+    if (!stream.is_open())
+    {
+        return false;
+    }
+    stream.write(reinterpret_cast<const char*>(file.data()), file.size());
+    stream.close();
+
+    ImageFileParserSettings settings = fileParser.getSettings();
+    settings.mode = mode;
+    settings.isMipmapGenerationEnabled = false;
+    settings.textureBudgetSettings.skippedMipmapLevels = skippedMipmapLevels;
+    fileParser.setSettings(settings);
+
+    return fileParser.parseFile(ImageFileParserTestFilename, imageData);
+}
+
+bool ImageFileParserTests::isPayloadLaidOut(const ImageData& imageData, uint32 blockSize,
+                                            uint32 pixelSize)
+{
+    if (imageData.subresourceDataItems.size() != static_cast<uint64>(imageData.mipmapLevels) *
+        imageData.arraySize)
+    {
+        return false;
+    }
+
+    uint64 offset = 0;
+    for (uint32 i = 0; i < imageData.arraySize; i++)
+    {
+        for (uint32 j = 0; j < imageData.mipmapLevels; j++)
+        {
+            uint32 subresourceIndex = getImageSubresourceIndex(imageData, j, i);
+            uint64 size = getPayloadSize(getImageMipmapSize(imageData.width, j),
+                                         getImageMipmapSize(imageData.height, j), 1, 1,
+                                         blockSize, pixelSize);
+
+            const ImageSubresourceData& subresourceData =
+                imageData.subresourceDataItems[subresourceIndex];
+            if (subresourceData.offset != offset || subresourceData.depthPitch != size)
+            {
+                return false;
+            }
+
+            const unsigned char* data = getImageSubresourceData(imageData, subresourceIndex);
+            for (uint64 k = 0; k < size; k++)
+            {
+                if (data[k] != (offset + k) % 251)
+                {
+                    return false;
+                }
+            }
+
+            offset += size;
+        }
+    }
+
+    return true;
+}
+
+void ImageFileParserTests::checkImage(const ImageData& imageData, uint32 width, uint32 height,
+                                      DXGI_FORMAT format, uint32 mipmapLevels, uint32 arraySize,
+                                      bool isCubemap, uint32 blockSize, uint32 pixelSize,
+                                      const std::string& name)
+{
+    bool result = imageData.width == width && imageData.height == height && imageData.depth == 1
+        && imageData.format == format && imageData.mipmapLevels == mipmapLevels
+        && imageData.arraySize == arraySize && imageData.isCubemap == isCubemap;
+    if (result)
+    {
+        result = isPayloadLaidOut(imageData, blockSize, pixelSize);
+    }
+
+    checkTest(result, name, statistics);
+}
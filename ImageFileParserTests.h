@@ -0,0 +1,71 @@
+#pragma once
+#include <d3d11.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#include <vector>
+
+#include <string>
+
+#include "ImageFileParser.h"
+
+#include "DdsUtility.h"
+#include "ImageFileParserUtility.h"
+#include "IntUtility.h"
+#include "TestUtility.h"
+
+constexpr const char* ImageFileParserTestFilename = "GSPTests.dds";
+
+// Parses synthetic DDS files, written to the working directory, in both parser modes: legacy and
+// DX10 headers, cubemaps, arrays, files cut short and the memory the payload takes. Byte i of
+// every payload is i % 251, so each subresource is checked to be where the file has it
+class ImageFileParserTests
+{
+    TestStatistics statistics;
+
+    ImageFileParser fileParser;
+
+public:
+    ImageFileParserTests();
+
+    TestStatistics getStatistics();
+
+    void run();
+
+private:
+    void testLegacyFile(ImageFileParserMode mode);
+    void testDxt10File(ImageFileParserMode mode);
+    void testCubemapFile(ImageFileParserMode mode);
+    void testArrayFile(ImageFileParserMode mode);
+    void testTruncatedFile(ImageFileParserMode mode);
+    void testHeaderFlags(ImageFileParserMode mode);
+    // Of the single allocation of a read payload and of a payload used in the mapped file
+    void testFootprint(ImageFileParserMode mode);
+    // Of the runs of levels kept when the texture budget skips the largest ones
+    void testSkippedLevelsFootprint(ImageFileParserMode mode);
+
+    // An RGBA8 pixel format when fourCc is 0
+    DdsHeader getDdsHeader(uint32 width, uint32 height, uint32 mipmapLevels, uint32 fourCc);
+    DdsHeader getDdsHeaderDxt10(uint32 width, uint32 height, uint32 mipmapLevels,
+                                DdsHeaderDxt10& headerDxt10, DXGI_FORMAT format,
+                                uint32 arraySize, bool isCubemap);
+    // The extended header is written when the pixel format asks for it
+    void getDdsFile(const DdsHeader& header, const DdsHeaderDxt10& headerDxt10,
+                    uint64 payloadSize, std::vector<unsigned char>& file);
+    // Of every mipmap level of every slice, blockSize is 0 for formats that aren't compressed
+    uint64 getPayloadSize(uint32 width, uint32 height, uint32 mipmapLevels, uint32 arraySize,
+                          uint32 blockSize, uint32 pixelSize);
+
+    // Writes the file and parses it without mipmap generation, skipping the largest levels
+    bool parseFile(ImageFileParserMode mode, uint32 skippedMipmapLevels,
+                   const std::vector<unsigned char>& file, ImageData& imageData);
+    // Whether every subresource is where the file has it, the slices and levels back to back
+    bool isPayloadLaidOut(const ImageData& imageData, uint32 blockSize, uint32 pixelSize);
+
+    void checkImage(const ImageData& imageData, uint32 width, uint32 height, DXGI_FORMAT format,
+                    uint32 mipmapLevels, uint32 arraySize, bool isCubemap, uint32 blockSize,
+                    uint32 pixelSize, const std::string& name);
+};
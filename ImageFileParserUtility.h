@@ -1,12 +1,118 @@
 #pragma once
 #include <d3d11.h>
 
-struct MipmapData
+#include <cstring>
+#include <memory>
+
+#include <vector>
+
+#include "MappedFile.h"
+
+#include "DdsUtility.h"
+#include "IntUtility.h"
+#include "MemoryUtility.h"
+#include "MipmapGeneratorUtility.h"
+#include "PixelConverterUtility.h"
+
+constexpr uint64 ImageDataAlignment = 64; // B
+
+// Largest mipmap levels every parser leaves in the files unless told otherwise, the application
+// raises it from its command line on nodes with less memory
+constexpr uint32 TextureBudgetSkippedMipmapLevels = 0;
+// Class overrides of the skipped levels that defer to the global count
+constexpr uint32 TextureBudgetNoOverride = UINT32_MAX;
+
+enum class ImageFileParserMode : uint8
+{
+    Undefined,
+
+    Stream,
+    MappedFile,
+};
+
+// What an image is loaded for, the budget can skip more levels of some classes than of others
+enum class TextureClass : uint8
+{
+    Undefined,
+
+    Diffuse, // diffuse color images of materials
+    Sprite, // 2D images drawn at their own size
+};
+
+constexpr uint32 TextureClassCount = 3;
+
+// Only whole levels are left out, down to the smallest one, and block-compressed images keep top
+// levels of whole blocks
+struct TextureBudgetSettings
 {
-    uint32 rowPitch;
-    uint32 depthPitch;
+    uint32 skippedMipmapLevels; // largest ones, of every class without an override
+    uint32 classSkippedMipmapLevels[TextureClassCount]; // TextureBudgetNoOverride for the global
+};
+
+// TextureBudgetSkippedMipmapLevels for every class
+inline TextureBudgetSettings getDefaultTextureBudgetSettings()
+{
+    TextureBudgetSettings textureBudgetSettings = {};
+    textureBudgetSettings.skippedMipmapLevels = TextureBudgetSkippedMipmapLevels;
+    for (uint32 i = 0; i < TextureClassCount; i++)
+    {
+        textureBudgetSettings.classSkippedMipmapLevels[i] = TextureBudgetNoOverride;
+    }
+
+    return textureBudgetSettings;
+}
+
+struct ImageFileParserSettings
+{
+    ImageFileParserMode mode;
+    // Images with a single mipmap level in a format the generator takes are given the rest
+    bool isMipmapGenerationEnabled;
+
+    TextureBudgetSettings textureBudgetSettings;
+
+    PixelConverterSettings pixelConverterSettings;
+    MipmapGeneratorSettings mipmapGeneratorSettings;
+};
+
+struct ImageFileStatistics
+{
+    uint32 width; // pixels, of the top level loaded
+    uint32 height; // pixels, of the top level loaded
+    uint32 skippedMipmapLevels;
+
+    uint64 size; // B, of the payload loaded
+    uint64 skippedSize; // B, of the levels never read
+    double parsingTime; // s
+};
+
+struct ImageFileParserStatistics
+{
+    uint32 fileCount;
+    uint64 fileSize; // B
+    uint64 skippedSize; // B, of the mipmap levels left in the files
+    double parsingTime; // s
+    double throughput; // MB/s
+
+    std::vector<ImageFileStatistics> fileStatisticsItems; // in the order of the files
 
-    std::vector<unsigned char> data;
+    PixelConverterStatistics pixelConverterStatistics; // files expanded to RGBA8
+    MipmapGeneratorStatistics mipmapGeneratorStatistics; // files given their mipmap levels
+};
+
+// Where one mipmap level of one array slice lies in the image payload
+struct ImageSubresourceData
+{
+    uint64 offset; // B
+    uint32 rowPitch; // B, of a row of pixels or of blocks
+    uint32 depthPitch; // B
+};
+
+// The mipmap levels of one array slice kept from the file, stored back to back in both
+struct ImagePayloadRun
+{
+    uint64 fileOffset; // B, from the start of the payload in the file
+    uint64 offset; // B, in the image payload
+    uint64 size; // B
 };
 
 struct ImageData
@@ -18,5 +124,237 @@ struct ImageData
     DXGI_FORMAT format;
 
     uint32 mipmapLevels;
-    std::vector<MipmapData> mipmapDataItems;
+    uint32 arraySize; // faces for cubemaps, 6 per cube
+    bool isCubemap;
+
+    // In D3D11 subresource order, every mipmap level of the first slice, then of the next one
+    std::vector<ImageSubresourceData> subresourceDataItems;
+
+    // The whole payload in one allocation, laid out like the file so it is read in one go. Empty
+    // when the payload is used in place from the mapped file, which then stays mapped for as long
+    // as any copy of the image exists
+    std::vector<unsigned char, AlignedAllocator<unsigned char, ImageDataAlignment>> data;
+    std::shared_ptr<MappedFile> mappedFile;
+    uint64 mappedDataOffset; // B, of the payload in the mapped file
 };
+
+// B per 4x4 block of a block-compressed format, 0 for any other format
+inline uint32 getImageFormatBlockSize(DXGI_FORMAT format)
+{
+    switch (format)
+    {
+    case DXGI_FORMAT_BC1_TYPELESS:
+    case DXGI_FORMAT_BC1_UNORM:
+    case DXGI_FORMAT_BC1_UNORM_SRGB:
+    case DXGI_FORMAT_BC4_TYPELESS:
+    case DXGI_FORMAT_BC4_UNORM:
+    case DXGI_FORMAT_BC4_SNORM:
+    {
+        return DdsBc1BlockSize;
+    }
+    case DXGI_FORMAT_BC2_TYPELESS:
+    case DXGI_FORMAT_BC2_UNORM:
+    case DXGI_FORMAT_BC2_UNORM_SRGB:
+    case DXGI_FORMAT_BC3_TYPELESS:
+    case DXGI_FORMAT_BC3_UNORM:
+    case DXGI_FORMAT_BC3_UNORM_SRGB:
+    case DXGI_FORMAT_BC5_TYPELESS:
+    case DXGI_FORMAT_BC5_UNORM:
+    case DXGI_FORMAT_BC5_SNORM:
+    case DXGI_FORMAT_BC6H_TYPELESS:
+    case DXGI_FORMAT_BC6H_UF16:
+    case DXGI_FORMAT_BC6H_SF16:
+    case DXGI_FORMAT_BC7_TYPELESS:
+    case DXGI_FORMAT_BC7_UNORM:
+    case DXGI_FORMAT_BC7_UNORM_SRGB:
+    {
+        return DdsBc2BlockSize;
+    }
+    default:
+    {
+        return 0;
+    }
+    }
+}
+
+// B per pixel of the uncompressed formats images may have, 0 for any other format
+inline uint32 getImageFormatPixelSize(DXGI_FORMAT format)
+{
+    switch (format)
+    {
+    case DXGI_FORMAT_R32G32B32A32_FLOAT:
+    {
+        return 16;
+    }
+    case DXGI_FORMAT_R16G16B16A16_FLOAT:
+    case DXGI_FORMAT_R16G16B16A16_UNORM:
+    case DXGI_FORMAT_R32G32_FLOAT:
+    {
+        return 8;
+    }
+    case DXGI_FORMAT_R10G10B10A2_UNORM:
+    case DXGI_FORMAT_R11G11B10_FLOAT:
+    case DXGI_FORMAT_R8G8B8A8_UNORM:
+    case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+    case DXGI_FORMAT_R16G16_FLOAT:
+    case DXGI_FORMAT_R16G16_UNORM:
+    case DXGI_FORMAT_R32_FLOAT:
+    case DXGI_FORMAT_B8G8R8A8_UNORM:
+    case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
+    case DXGI_FORMAT_B8G8R8X8_UNORM:
+    case DXGI_FORMAT_B8G8R8X8_UNORM_SRGB:
+    {
+        return 4;
+    }
+    case DXGI_FORMAT_R8G8_UNORM:
+    case DXGI_FORMAT_R16_FLOAT:
+    case DXGI_FORMAT_R16_UNORM:
+    {
+        return 2;
+    }
+    case DXGI_FORMAT_R8_UNORM:
+    case DXGI_FORMAT_A8_UNORM:
+    {
+        return 1;
+    }
+    default:
+    {
+        return 0;
+    }
+    }
+}
+
+// DXGI format that stores pixels of these masks as they are, DXGI_FORMAT_UNKNOWN when the
+// layout has to be converted
+inline DXGI_FORMAT getDdsPixelMasksFormat(const PixelMasks& masks)
+{
+    if (masks.bitCount == 32)
+    {
+        if (masks.redMask == 0x000000ff && masks.greenMask == 0x0000ff00
+            && masks.blueMask == 0x00ff0000 && masks.alphaMask == 0xff000000)
+        {
+            return DXGI_FORMAT_R8G8B8A8_UNORM;
+        }
+        if (masks.redMask == 0x00ff0000 && masks.greenMask == 0x0000ff00
+            && masks.blueMask == 0x000000ff && masks.alphaMask == 0xff000000)
+        {
+            return DXGI_FORMAT_B8G8R8A8_UNORM;
+        }
+        if (masks.redMask == 0x00ff0000 && masks.greenMask == 0x0000ff00
+            && masks.blueMask == 0x000000ff && masks.alphaMask == 0)
+        {
+            return DXGI_FORMAT_B8G8R8X8_UNORM;
+        }
+        if (masks.redMask == 0x000003ff && masks.greenMask == 0x000ffc00
+            && masks.blueMask == 0x3ff00000 && masks.alphaMask == 0xc0000000)
+        {
+            return DXGI_FORMAT_R10G10B10A2_UNORM;
+        }
+    }
+    else if (masks.bitCount == 8)
+    {
+        if (masks.redMask == 0 && masks.greenMask == 0 && masks.blueMask == 0
+            && masks.alphaMask == 0xff)
+        {
+            return DXGI_FORMAT_A8_UNORM;
+        }
+        if (masks.redMask == 0xff && masks.greenMask == 0 && masks.blueMask == 0
+            && masks.alphaMask == 0)
+        {
+            return DXGI_FORMAT_R8_UNORM;
+        }
+    }
+
+    return DXGI_FORMAT_UNKNOWN;
+}
+
+inline uint32 getImageMipmapSize(uint32 size, uint32 mipmapLevel)
+{
+    size >>= mipmapLevel;
+    if (size == 0)
+    {
+        return 1;
+    }
+
+    return size;
+}
+
+inline uint32 getImageSubresourceIndex(const ImageData& imageData, uint32 mipmapLevel,
+                                       uint32 arraySlice)
+{
+    return mipmapLevel + arraySlice * imageData.mipmapLevels;
+}
+
+inline const unsigned char* getImagePayload(const ImageData& imageData)
+{
+    if (imageData.mappedFile)
+    {
+        return imageData.mappedFile->getData() + imageData.mappedDataOffset;
+    }
+
+    return imageData.data.data();
+}
+
+inline const unsigned char* getImageSubresourceData(const ImageData& imageData,
+                                                    uint32 subresourceIndex)
+{
+    return getImagePayload(imageData) + imageData.subresourceDataItems[subresourceIndex].offset;
+}
+
+// The levels from mostDetailedMipmapLevel down as an image of their own. A payload in the mapped
+// file stays there, any other one is copied so the levels left out are freed with the image
+inline ImageData getImageMipmapLevels(const ImageData& imageData, uint32 mostDetailedMipmapLevel)
+{
+    uint32 mipmapLevels = imageData.mipmapLevels - mostDetailedMipmapLevel;
+    std::vector<ImageSubresourceData> subresourceDataItems(static_cast<uint64>(mipmapLevels) *
+                                                           imageData.arraySize);
+    uint64 payloadSize = 0;
+    for (uint32 i = 0; i < imageData.arraySize; i++)
+    {
+        for (uint32 j = 0; j < mipmapLevels; j++)
+        {
+            ImageSubresourceData& subresourceData = subresourceDataItems[j + i * mipmapLevels];
+            subresourceData = imageData.subresourceDataItems[getImageSubresourceIndex(
+                imageData, j + mostDetailedMipmapLevel, i)];
+            if (!imageData.mappedFile)
+            {
+                subresourceData.offset = payloadSize;
+            }
+
+            payloadSize += subresourceData.depthPitch;
+        }
+    }
+
+    ImageData keptImageData = {};
+    keptImageData.width = getImageMipmapSize(imageData.width, mostDetailedMipmapLevel);
+    keptImageData.height = getImageMipmapSize(imageData.height, mostDetailedMipmapLevel);
+    keptImageData.depth = imageData.depth;
+    keptImageData.format = imageData.format;
+    keptImageData.mipmapLevels = mipmapLevels;
+    keptImageData.arraySize = imageData.arraySize;
+    keptImageData.isCubemap = imageData.isCubemap;
+    if (imageData.mappedFile)
+    {
+        keptImageData.mappedFile = imageData.mappedFile;
+        keptImageData.mappedDataOffset = imageData.mappedDataOffset;
+    }
+    else
+    {
+        keptImageData.data.resize(payloadSize);
+        for (uint32 i = 0; i < imageData.arraySize; i++)
+        {
+            for (uint32 j = 0; j < mipmapLevels; j++)
+            {
+                const ImageSubresourceData& subresourceData =
+                    subresourceDataItems[j + i * mipmapLevels];
+                std::memcpy(keptImageData.data.data() + subresourceData.offset,
+                            getImageSubresourceData(imageData, getImageSubresourceIndex(
+                                imageData, j + mostDetailedMipmapLevel, i)),
+                            subresourceData.depthPitch);
+            }
+        }
+    }
+    keptImageData.subresourceDataItems = std::move(subresourceDataItems);
+
+    return keptImageData;
+}
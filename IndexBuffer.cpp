@@ -8,6 +8,9 @@ IndexBuffer::IndexBuffer(std::shared_ptr<Direct3d> direct3d) : buffer()
     this->direct3d = direct3d;
 
     size = 0;
+
+    format = DXGI_FORMAT_UNKNOWN;
+    baseVertex = 0;
 }
 
 IndexBuffer::~IndexBuffer()
@@ -49,6 +52,16 @@ Microsoft::WRL::ComPtr<ID3D11Buffer> IndexBuffer::getBuffer()
     return buffer;
 }
 
+DXGI_FORMAT IndexBuffer::getFormat()
+{
+    return format;
+}
+
+uint32 IndexBuffer::getBaseVertex()
+{
+    return baseVertex;
+}
+
 bool IndexBuffer::initialize(
     const uint32* indexes, uint32 indexCount)
 {
@@ -57,10 +70,33 @@ bool IndexBuffer::initialize(
         release();
     }
 
-    bool result = direct3d->createIndexBuffer(buffer, indexes, indexCount);
-    if (!result)
+    // Indexes spanning at most 65535 vertexes are stored as 16 bits relative to the base vertex
+    bool result = canIndexesBeNarrowed(indexes, indexCount, baseVertex);
+    if (result)
     {
-        return false;
+        std::vector<uint16> narrowedIndexes;
+        narrowIndexes(indexes, indexCount, baseVertex, narrowedIndexes);
+
+        result = direct3d->createIndexBuffer(buffer, narrowedIndexes.data(), sizeof(uint16),
+                                             indexCount);
+        if (!result)
+        {
+            return false;
+        }
+
+        format = DXGI_FORMAT_R16_UINT;
+    }
+    else
+    {
+        baseVertex = 0;
+
+        result = direct3d->createIndexBuffer(buffer, indexes, sizeof(uint32), indexCount);
+        if (!result)
+        {
+            return false;
+        }
+
+        format = DXGI_FORMAT_R32_UINT;
     }
 
     size = indexCount;
@@ -79,5 +115,8 @@ void IndexBuffer::release()
     size = 0;
     buffer.Reset();
 
+    format = DXGI_FORMAT_UNKNOWN;
+    baseVertex = 0;
+
     setReleased();
 }
@@ -4,9 +4,12 @@
 #include <wrl/client.h>
 #include <memory>
 
+#include <vector>
+
 #include "Direct3d.h"
 
 #include "IntUtility.h"
+#include "IndexBufferUtility.h"
 
 class IndexBuffer
 {
@@ -18,6 +21,9 @@ class IndexBuffer
     Microsoft::WRL::ComPtr<ID3D11Buffer> buffer;
     uint32 size;
 
+    DXGI_FORMAT format;
+    uint32 baseVertex;
+
 public:
     IndexBuffer(std::shared_ptr<Direct3d> direct3d);
     ~IndexBuffer();
@@ -33,6 +39,9 @@ public:
     Microsoft::WRL::ComPtr<ID3D11Buffer> getBuffer();
     uint32 getSize();
 
+    DXGI_FORMAT getFormat();
+    uint32 getBaseVertex();
+
     bool initialize(const uint32* indexes,
                     uint32 indexCount);
     void release();
@@ -0,0 +1,112 @@
+#include "IndexBufferTests.h"
+
+IndexBufferTests::IndexBufferTests() : statistics{}
+{
+}
+
+TestStatistics IndexBufferTests::getStatistics()
+{
+    return statistics;
+}
+
+void IndexBufferTests::run()
+{
+    statistics = {};
+
+    testNarrowing();
+    testMaxRange();
+    testStripCutIndex();
+    testBaseVertex();
+    testInvalidIndexes();
+}
+
+void IndexBufferTests::testNarrowing()
+{
+    const uint32 indexes[] = { 12, 10, 11, 11, 13, 12 };
+    uint32 indexCount = sizeof(indexes) / sizeof(indexes[0]);
+
+    uint32 baseVertex = 0;
+    bool result = canIndexesBeNarrowed(indexes, indexCount, baseVertex);
+    result = result && baseVertex == 10;
+
+    std::vector<uint16> narrowedIndexes;
+    if (result)
+    {
+        narrowIndexes(indexes, indexCount, baseVertex, narrowedIndexes);
+    }
+    const uint16 expectedIndexes[] = { 2, 0, 1, 1, 3, 2 };
+    result = result && narrowedIndexes.size() == indexCount;
+    for (uint32 i = 0; i < narrowedIndexes.size() && result; i++)
+    {
+        result = narrowedIndexes[i] == expectedIndexes[i];
+    }
+
+    checkTest(result, "IndexBuffer narrowing", statistics);
+}
+
+void IndexBufferTests::testMaxRange()
+{
+    // 65535 vertexes, the last narrowed index is 0xfffe
+    const uint32 indexes[] = { 0, IndexBufferMaxUint16Index, 1 };
+    uint32 baseVertex = 1;
+    bool result = canIndexesBeNarrowed(indexes, 3, baseVertex);
+
+    std::vector<uint16> narrowedIndexes;
+    if (result)
+    {
+        narrowIndexes(indexes, 3, baseVertex, narrowedIndexes);
+    }
+
+    checkTest(result && baseVertex == 0 && narrowedIndexes.size() == 3
+              && narrowedIndexes[1] == 0xfffe, "IndexBuffer max range", statistics);
+}
+
+void IndexBufferTests::testStripCutIndex()
+{
+    // 65536 vertexes would make the last narrowed index the strip cut value
+    const uint32 indexes[] = { 0, 0xffff, 1 };
+    uint32 baseVertex = 0;
+    checkTest(!canIndexesBeNarrowed(indexes, 3, baseVertex), "IndexBuffer strip cut index",
+              statistics);
+
+    // Even at a base vertex
+    const uint32 offsetIndexes[] = { 70000, 70000 + 0xffff };
+    checkTest(!canIndexesBeNarrowed(offsetIndexes, 2, baseVertex),
+              "IndexBuffer strip cut index at base vertex", statistics);
+}
+
+void IndexBufferTests::testBaseVertex()
+{
+    // Indexes past 16 bits still narrow when their range fits
+    const uint32 indexes[] = { 100000 + IndexBufferMaxUint16Index, 100000, 100001 };
+    uint32 baseVertex = 0;
+    bool result = canIndexesBeNarrowed(indexes, 3, baseVertex);
+
+    std::vector<uint16> narrowedIndexes;
+    if (result)
+    {
+        narrowIndexes(indexes, 3, baseVertex, narrowedIndexes);
+    }
+
+    checkTest(result && baseVertex == 100000 && narrowedIndexes.size() == 3
+              && narrowedIndexes[0] == IndexBufferMaxUint16Index && narrowedIndexes[1] == 0
+              && narrowedIndexes[2] == 1, "IndexBuffer base vertex", statistics);
+
+    // The base vertex is a signed draw parameter, so it can't pass INT32_MAX
+    const uint32 largeIndexes[] = { 0x80000000u, 0x80000001u };
+    checkTest(!canIndexesBeNarrowed(largeIndexes, 2, baseVertex), "IndexBuffer large base vertex",
+              statistics);
+
+    const uint32 maxIndexes[] = { INT32_MAX, INT32_MAX };
+    result = canIndexesBeNarrowed(maxIndexes, 2, baseVertex);
+    checkTest(result && baseVertex == INT32_MAX, "IndexBuffer max base vertex", statistics);
+}
+
+void IndexBufferTests::testInvalidIndexes()
+{
+    const uint32 indexes[] = { 0 };
+    uint32 baseVertex = 0;
+    checkTest(!canIndexesBeNarrowed(nullptr, 1, baseVertex)
+              && !canIndexesBeNarrowed(indexes, 0, baseVertex), "IndexBuffer no indexes",
+              statistics);
+}
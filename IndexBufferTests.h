@@ -0,0 +1,27 @@
+#pragma once
+#include <vector>
+
+#include "IntUtility.h"
+#include "IndexBufferUtility.h"
+#include "TestUtility.h"
+
+// Detects the range of indexes and narrows them to 16 bits relative to the base vertex, at the
+// last range that fits, at the strip cut value and past a base vertex the draw call can't take
+class IndexBufferTests
+{
+    TestStatistics statistics;
+
+public:
+    IndexBufferTests();
+
+    TestStatistics getStatistics();
+
+    void run();
+
+private:
+    void testNarrowing();
+    void testMaxRange();
+    void testStripCutIndex();
+    void testBaseVertex();
+    void testInvalidIndexes();
+};
@@ -0,0 +1,53 @@
+#pragma once
+#include <vector>
+
+#include "IntUtility.h"
+
+// 0xffff is the strip cut value of 16-bit indexes, so it is kept out of narrowed indexes to mean
+// the same with any topology
+constexpr uint32 IndexBufferUint16StripCutIndex = 0xffff;
+constexpr uint32 IndexBufferMaxUint16Index = IndexBufferUint16StripCutIndex - 1;
+
+// Finds the smallest index, which is passed to the draw call as the base vertex, and checks that
+// every index fits 16 bits, short of the strip cut value, once it is subtracted
+inline bool canIndexesBeNarrowed(const uint32* indexes, uint32 indexCount, uint32& baseVertex)
+{
+    if (!indexes || indexCount == 0)
+    {
+        return false;
+    }
+
+    uint32 minIndex = indexes[0];
+    uint32 maxIndex = indexes[0];
+    for (uint32 i = 1; i < indexCount; i++)
+    {
+        if (indexes[i] < minIndex)
+        {
+            minIndex = indexes[i];
+        }
+        if (indexes[i] > maxIndex)
+        {
+            maxIndex = indexes[i];
+        }
+    }
+
+    // The base vertex is a signed draw parameter
+    if (minIndex > INT32_MAX || maxIndex - minIndex > IndexBufferMaxUint16Index)
+    {
+        return false;
+    }
+
+    baseVertex = minIndex;
+
+    return true;
+}
+
+inline void narrowIndexes(const uint32* indexes, uint32 indexCount, uint32 baseVertex,
+                          std::vector<uint16>& narrowedIndexes)
+{
+    narrowedIndexes.resize(indexCount);
+    for (uint32 i = 0; i < indexCount; i++)
+    {
+        narrowedIndexes[i] = static_cast<uint16>(indexes[i] - baseVertex);
+    }
+}
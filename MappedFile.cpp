@@ -0,0 +1,136 @@
+#include "MappedFile.h"
+
+MappedFile::MappedFile()
+{
+    initialized = false;
+    released = false;
+
+    fileHandle = INVALID_HANDLE_VALUE;
+    mappingHandle = nullptr;
+
+    data = nullptr;
+    size = 0;
+}
+
+MappedFile::~MappedFile()
+{
+    release();
+}
+
+bool MappedFile::isInitialized()
+{
+    return initialized;
+}
+
+void MappedFile::setInitialized()
+{
+    initialized = true;
+    released = false;
+}
+
+bool MappedFile::isReleased()
+{
+    return released;
+}
+
+void MappedFile::setReleased()
+{
+    initialized = false;
+    released = true;
+}
+
+const unsigned char* MappedFile::getData()
+{
+    return data;
+}
+
+uint64 MappedFile::getSize()
+{
+    return size;
+}
+
+bool MappedFile::initialize(std::string filename)
+{
+    if (isInitialized())
+    {
+        release();
+    }
+
+    fileHandle = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                             OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                             nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize = {};
+    if (!GetFileSizeEx(fileHandle, &fileSize))
+    {
+        closeFile();
+
+        return false;
+    }
+    size = static_cast<uint64>(fileSize.QuadPart);
+
+    // Empty files cannot be mapped, they are exposed as a null range instead
+    if (size == 0)
+    {
+        setInitialized();
+        return true;
+    }
+
+    mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mappingHandle)
+    {
+        closeFile();
+
+        return false;
+    }
+
+    data = static_cast<const unsigned char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0,
+                                                           0));
+    if (!data)
+    {
+        closeFile();
+
+        return false;
+    }
+
+    setInitialized();
+    return true;
+}
+
+void MappedFile::release()
+{
+    if (isReleased())
+    {
+        return;
+    }
+
+    closeFile();
+
+    setReleased();
+}
+
+void MappedFile::closeFile()
+{
+    if (data)
+    {
+        UnmapViewOfFile(data);
+        data = nullptr;
+    }
+    size = 0;
+
+    if (mappingHandle)
+    {
+        CloseHandle(mappingHandle);
+        mappingHandle = nullptr;
+    }
+
+    if (fileHandle != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(fileHandle);
+        fileHandle = INVALID_HANDLE_VALUE;
+    }
+}
@@ -0,0 +1,45 @@
+#pragma once
+#define NOMINMAX
+
+#include <Windows.h>
+
+#include <string>
+
+#include "IntUtility.h"
+
+class MappedFile
+{
+    bool initialized;
+    bool released;
+
+    HANDLE fileHandle;
+    HANDLE mappingHandle;
+
+    const unsigned char* data;
+    uint64 size;
+
+public:
+    MappedFile();
+    ~MappedFile();
+
+    // Owns the handles and the view, a copy would close and unmap them twice
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+private:
+    bool isInitialized();
+    void setInitialized();
+
+    bool isReleased();
+    void setReleased();
+
+public:
+    const unsigned char* getData();
+    uint64 getSize();
+
+    bool initialize(std::string filename);
+    void release();
+
+private:
+    void closeFile();
+};
@@ -1,7 +1,8 @@
 #include "Material.h"
 
-Material::Material(std::shared_ptr<Shader> shader,
-                   std::shared_ptr<Direct3d> direct3d) : diffuseColor{}, diffuseColorTexture()
+Material::Material(std::shared_ptr<Shader> shader, std::shared_ptr<Direct3d> direct3d,
+                   std::shared_ptr<TextureStreamer> textureStreamer)
+    : diffuseColor{}, diffuseColorTexture()
 {
     initialized = false;
     released = false;
@@ -10,6 +11,9 @@ Material::Material(std::shared_ptr<Shader> shader,
 
     this->direct3d = direct3d;
 
+    this->textureStreamer = textureStreamer;
+    diffuseColorTextureIndex = 0;
+
     opacity = 0.0f;
 
     hasDiffuseColorTexture = false;
@@ -23,6 +27,9 @@ Material::Material(const Material& material)
     this->shader = material.shader;
     this->direct3d = material.direct3d;
 
+    this->textureStreamer = material.textureStreamer;
+    diffuseColorTextureIndex = material.diffuseColorTextureIndex;
+
     diffuseColor = material.diffuseColor;
     opacity = material.opacity;
 
@@ -34,6 +41,8 @@ Material::~Material()
 {
     release();
 
+    textureStreamer.reset();
+
     shader.reset();
 
     direct3d.reset();
@@ -78,7 +87,7 @@ bool Material::initialize(MaterialData materialData)
     return true;
 }
 
-bool Material::render()
+bool Material::render(float relativePixelSize)
 {
     MaterialBuffer materialBuffer = {};
     materialBuffer.diffuseColor = diffuseColor;
@@ -94,6 +103,13 @@ bool Material::render()
 
     if (hasDiffuseColorTexture)
     {
+        if (textureStreamer)
+        {
+            textureStreamer->requestMipmapLevel(
+                diffuseColorTextureIndex,
+                getRequestedMipmapLevel(diffuseColorTexture, relativePixelSize));
+        }
+
         result = shader->setPixelShaderTexture(diffuseColorTexture,
                                                PsDiffuseColorTextureResourceSlotIndex);
         if (!result)
@@ -130,7 +146,18 @@ bool Material::initializeData(MaterialData materialData)
     if (hasDiffuseColorTexture)
     {
         diffuseColorTexture = createSharedPointer<Texture>(direct3d);
-        bool result = diffuseColorTexture->initialize(materialData.diffuseColorImageData);
+
+        bool result = false;
+        if (textureStreamer)
+        {
+            result = textureStreamer->addTexture(diffuseColorTexture,
+                                                 materialData.diffuseColorImageData,
+                                                 diffuseColorTextureIndex);
+        }
+        else
+        {
+            result = diffuseColorTexture->initialize(materialData.diffuseColorImageData);
+        }
         if (!result)
         {
             return false;
@@ -139,3 +166,29 @@ bool Material::initializeData(MaterialData materialData)
 
     return true;
 }
+
+uint32 Material::getRequestedMipmapLevel(std::shared_ptr<Texture> texture,
+                                         float relativePixelSize)
+{
+    uint32 size = texture->getWidth();
+    if (texture->getHeight() > size)
+    {
+        size = texture->getHeight();
+    }
+
+    // The texture is taken to cover the model once, so a pixel spans this many of its texels and
+    // the level where one does is the one asked for
+    float texelCount = relativePixelSize * static_cast<float>(size);
+    if (texelCount <= 1.0f)
+    {
+        return 0;
+    }
+
+    uint32 mipmapLevel = static_cast<uint32>(std::floor(std::log2(texelCount)));
+    if (mipmapLevel >= texture->getMipmapLevels())
+    {
+        mipmapLevel = texture->getMipmapLevels() - 1;
+    }
+
+    return mipmapLevel;
+}
@@ -4,6 +4,8 @@
 #include <wrl/client.h>
 #include <memory>
 
+#include <cmath>
+
 #include <string>
 
 #include "Direct3d.h"
@@ -11,6 +13,7 @@
 #include "Shader.h"
 
 #include "Texture.h"
+#include "TextureStreamer.h"
 
 #include "ShaderUtility.h"
 #include "ConstantBufferUtility.h"
@@ -32,8 +35,13 @@ class Material
     bool hasDiffuseColorTexture;
     std::shared_ptr<Texture> diffuseColorTexture;
 
+    // Textures are streamed by it when there is one
+    std::shared_ptr<TextureStreamer> textureStreamer;
+    uint32 diffuseColorTextureIndex;
+
 public:
-    Material(std::shared_ptr<Shader> shader, std::shared_ptr<Direct3d> direct3d);
+    Material(std::shared_ptr<Shader> shader, std::shared_ptr<Direct3d> direct3d,
+             std::shared_ptr<TextureStreamer> textureStreamer = nullptr);
     Material(const Material& material);
     ~Material();
 
@@ -46,9 +54,13 @@ private:
 
 public:
     bool initialize(MaterialData materialData);
-    bool render();
+    // relativePixelSize is the size of a screen pixel relative to the model, 0 for the most
+    // detailed mipmap levels
+    bool render(float relativePixelSize = 0.0f);
     void release();
 
 private:
     bool initializeData(MaterialData materialData);
+
+    uint32 getRequestedMipmapLevel(std::shared_ptr<Texture> texture, float relativePixelSize);
 };
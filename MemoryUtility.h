@@ -1,5 +1,10 @@
 #pragma once
+#include <malloc.h>
+
 #include <memory>
+#include <new>
+
+#include "IntUtility.h"
 
 template <typename T>
 struct Deleter
@@ -31,3 +36,51 @@ void Deleter<T>::operator()(T* pointer)
     pointer->release();
     delete pointer;
 }
+
+// Lets a std::vector own memory aligned for SIMD loads and whole cache lines
+template <typename T, uint64 Alignment>
+struct AlignedAllocator
+{
+    using value_type = T;
+
+    template <typename U>
+    struct rebind
+    {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() = default;
+
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&)
+    {
+    }
+
+    T* allocate(size_t count)
+    {
+        void* pointer = _aligned_malloc(count * sizeof(T), Alignment);
+        if (!pointer)
+        {
+            throw std::bad_alloc();
+        }
+
+        return static_cast<T*>(pointer);
+    }
+
+    void deallocate(T* pointer, size_t)
+    {
+        _aligned_free(pointer);
+    }
+};
+
+template <typename T, typename U, uint64 Alignment>
+bool operator==(const AlignedAllocator<T, Alignment>&, const AlignedAllocator<U, Alignment>&)
+{
+    return true;
+}
+
+template <typename T, typename U, uint64 Alignment>
+bool operator!=(const AlignedAllocator<T, Alignment>&, const AlignedAllocator<U, Alignment>&)
+{
+    return false;
+}
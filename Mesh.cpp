@@ -1,7 +1,7 @@
 #include "Mesh.h"
 
 Mesh::Mesh(std::shared_ptr<Shader> shader, std::shared_ptr<Direct3d> direct3d) : indexBuffer(),
-    material()
+    lodIndexBuffers(), lodErrors(), material()
 {
     initialized = false;
     released = false;
@@ -62,9 +62,27 @@ bool Mesh::initialize(std::shared_ptr<IndexBuffer> indexBuffer, std::shared_ptr<
     return true;
 }
 
-bool Mesh::render()
+bool Mesh::addLod(std::shared_ptr<IndexBuffer> indexBuffer, float error)
 {
-    bool result = shader->setIndexBuffer(indexBuffer);
+    if (!isInitialized() || !indexBuffer)
+    {
+        return false;
+    }
+
+    if (!lodErrors.empty() && error < lodErrors.back())
+    {
+        return false;
+    }
+
+    lodIndexBuffers.push_back(indexBuffer);
+    lodErrors.push_back(error);
+
+    return true;
+}
+
+bool Mesh::render(float maxError, float relativePixelSize)
+{
+    bool result = shader->setIndexBuffer(getLodIndexBuffer(maxError));
     if (!result)
     {
         return false;
@@ -72,7 +90,7 @@ bool Mesh::render()
 
     if (material)
     {
-        result = material->render();
+        result = material->render(relativePixelSize);
         if (!result)
         {
             return false;
@@ -97,7 +115,21 @@ void Mesh::release()
 
     material.reset();
 
+    lodErrors.clear();
+    lodIndexBuffers.clear();
+
     indexBuffer.reset();
 
     setReleased();
 }
+
+std::shared_ptr<IndexBuffer> Mesh::getLodIndexBuffer(float maxError)
+{
+    std::shared_ptr<IndexBuffer> lodIndexBuffer = indexBuffer;
+    for (uint64 i = 0; i < lodIndexBuffers.size() && lodErrors[i] <= maxError; i++)
+    {
+        lodIndexBuffer = lodIndexBuffers[i];
+    }
+
+    return lodIndexBuffer;
+}
@@ -2,6 +2,8 @@
 #include <wrl/client.h>
 #include <memory>
 
+#include <vector>
+
 #include "Direct3d.h"
 
 #include "Shader.h"
@@ -21,6 +23,9 @@ class Mesh
 
     std::shared_ptr<IndexBuffer> indexBuffer;
 
+    std::vector<std::shared_ptr<IndexBuffer>> lodIndexBuffers;
+    std::vector<float> lodErrors; // model units, growing
+
     std::shared_ptr<Material> material;
 
 public:
@@ -36,6 +41,11 @@ private:
 
 public:
     bool initialize(std::shared_ptr<IndexBuffer> indexBuffer, std::shared_ptr<Material> material);
-    bool render();
+    bool addLod(std::shared_ptr<IndexBuffer> indexBuffer, float error);
+    // relativePixelSize is passed on to the material
+    bool render(float maxError = 0.0f, float relativePixelSize = 0.0f);
     void release();
+
+private:
+    std::shared_ptr<IndexBuffer> getLodIndexBuffer(float maxError);
 };
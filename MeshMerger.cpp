@@ -0,0 +1,157 @@
+#include "MeshMerger.h"
+
+MeshMerger::MeshMerger() : settings{}, statistics{}
+{
+}
+
+MeshMergerSettings MeshMerger::getSettings()
+{
+    return settings;
+}
+
+void MeshMerger::setSettings(MeshMergerSettings settings)
+{
+    this->settings = settings;
+}
+
+MeshMergerStatistics MeshMerger::getStatistics()
+{
+    return statistics;
+}
+
+bool MeshMerger::merge(ModelData& modelData)
+{
+    statistics = {};
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    statistics.drawCountBefore = modelData.meshDataItems.size();
+
+    // Groups follow the first mesh of every material, so the draw order barely changes
+    std::unordered_map<std::string, uint64> groupIndexes;
+    std::vector<std::vector<uint64>> groups;
+    for (uint64 i = 0; i < modelData.meshDataItems.size(); i++)
+    {
+        const MeshData& meshData = modelData.meshDataItems[i];
+        if (meshData.indexes.size() % 3 != 0)
+        {
+            return false;
+        }
+
+        auto insertion = groupIndexes.emplace(meshData.materialName, groups.size());
+        if (insertion.second)
+        {
+            groups.emplace_back();
+        }
+
+        groups[insertion.first->second].push_back(i);
+    }
+
+    std::vector<MeshData> mergedMeshDataItems;
+    mergedMeshDataItems.reserve(groups.size());
+    for (const auto& group : groups)
+    {
+        const MeshData& firstMeshData = modelData.meshDataItems[group[0]];
+        if (group.size() == 1 && !settings.isObjectRangeEnabled)
+        {
+            mergedMeshDataItems.push_back(std::move(modelData.meshDataItems[group[0]]));
+
+            continue;
+        }
+
+        MeshData mergedMeshData = {};
+        mergedMeshData.name = group.size() == 1 ? firstMeshData.name : firstMeshData.materialName;
+        mergedMeshData.materialName = firstMeshData.materialName;
+
+        // A mesh with a shorter LOD chain repeats its last level
+        uint32 lodCount = 0;
+        uint64 indexCount = 0;
+        for (uint64 meshIndex : group)
+        {
+            const MeshData& meshData = modelData.meshDataItems[meshIndex];
+            if (meshData.lodDataItems.size() > lodCount)
+            {
+                lodCount = static_cast<uint32>(meshData.lodDataItems.size());
+            }
+
+            indexCount += meshData.indexes.size();
+        }
+
+        mergedMeshData.indexes.reserve(indexCount);
+        mergedMeshData.lodDataItems.resize(lodCount);
+
+        for (uint64 meshIndex : group)
+        {
+            appendMesh(modelData.meshDataItems[meshIndex], lodCount, mergedMeshData);
+        }
+
+        statistics.objectRangeCount += mergedMeshData.objectDataItems.size();
+
+        mergedMeshDataItems.push_back(std::move(mergedMeshData));
+    }
+
+    modelData.meshDataItems = std::move(mergedMeshDataItems);
+
+    statistics.drawCountAfter = modelData.meshDataItems.size();
+
+    std::chrono::duration<double> mergingTime = std::chrono::steady_clock::now() - startTime;
+    statistics.mergingTime = mergingTime.count();
+
+    return true;
+}
+
+void MeshMerger::appendMesh(const MeshData& meshData, uint32 lodCount, MeshData& mergedMeshData)
+{
+    if (settings.isObjectRangeEnabled)
+    {
+        MeshObjectData objectData = {};
+        objectData.name = meshData.name;
+        objectData.indexOffset = mergedMeshData.indexes.size();
+        objectData.indexCount = meshData.indexes.size();
+
+        mergedMeshData.objectDataItems.push_back(objectData);
+    }
+
+    mergedMeshData.indexes.insert(mergedMeshData.indexes.end(), meshData.indexes.begin(),
+                                  meshData.indexes.end());
+
+    for (uint32 i = 0; i < lodCount; i++)
+    {
+        MeshLodData& mergedLodData = mergedMeshData.lodDataItems[i];
+
+        const std::vector<uint32>* indexes = &meshData.indexes;
+        float error = 0.0f;
+        if (!meshData.lodDataItems.empty())
+        {
+            uint64 lodIndex = i < meshData.lodDataItems.size() ? i :
+                meshData.lodDataItems.size() - 1;
+
+            indexes = &meshData.lodDataItems[lodIndex].indexes;
+            error = meshData.lodDataItems[lodIndex].error;
+        }
+
+        mergedLodData.indexes.insert(mergedLodData.indexes.end(), indexes->begin(),
+                                     indexes->end());
+        if (error > mergedLodData.error)
+        {
+            mergedLodData.error = error;
+        }
+    }
+
+    uint32 vertexOffset = static_cast<uint32>(mergedMeshData.meshletVertexes.size());
+    uint32 triangleOffset = static_cast<uint32>(mergedMeshData.meshletTriangles.size() / 3);
+    for (MeshletData meshletData : meshData.meshletDataItems)
+    {
+        meshletData.vertexOffset += vertexOffset;
+        meshletData.triangleOffset += triangleOffset;
+
+        mergedMeshData.meshletDataItems.push_back(meshletData);
+    }
+
+    mergedMeshData.meshletVertexes.insert(mergedMeshData.meshletVertexes.end(),
+                                          meshData.meshletVertexes.begin(),
+                                          meshData.meshletVertexes.end());
+    mergedMeshData.meshletTriangles.insert(mergedMeshData.meshletTriangles.end(),
+                                           meshData.meshletTriangles.begin(),
+                                           meshData.meshletTriangles.end());
+}
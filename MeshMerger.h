@@ -0,0 +1,33 @@
+#pragma once
+#include <vector>
+#include <unordered_map>
+
+#include <string>
+
+#include <chrono>
+
+#include "ModelFileParserUtility.h"
+#include "MeshMergerUtility.h"
+
+// Merges meshes with the same material into one mesh, so a model is drawn with one call per
+// material. Index lists, LOD levels and meshlets are appended in the order of the meshes, so the
+// vertex cache order of every part is kept
+class MeshMerger
+{
+    MeshMergerSettings settings;
+
+    MeshMergerStatistics statistics;
+
+public:
+    MeshMerger();
+
+    MeshMergerSettings getSettings();
+    void setSettings(MeshMergerSettings settings);
+
+    MeshMergerStatistics getStatistics();
+
+    bool merge(ModelData& modelData);
+
+private:
+    void appendMesh(const MeshData& meshData, uint32 lodCount, MeshData& mergedMeshData);
+};
@@ -0,0 +1,18 @@
+#pragma once
+#include "IntUtility.h"
+
+struct MeshMergerSettings
+{
+    // Keeps where every merged object's indexes are, for object-level visibility
+    bool isObjectRangeEnabled;
+};
+
+struct MeshMergerStatistics
+{
+    uint64 drawCountBefore; // one per mesh
+    uint64 drawCountAfter;
+
+    uint64 objectRangeCount;
+
+    double mergingTime; // s
+};
@@ -0,0 +1,456 @@
+#include "MeshOptimizer.h"
+
+MeshOptimizer::MeshOptimizer() : cacheScores{}, valenceScores{}, statistics{}
+{
+    for (int32 i = 0; i < MeshOptimizerCacheSize; i++)
+    {
+        // The vertexes of the last triangle get a fixed score so the next triangle doesn't
+        // simply reuse its edge, which would strip the mesh instead of filling the cache
+        if (i < 3)
+        {
+            cacheScores[i] = MeshOptimizerLastTriangleScore;
+
+            continue;
+        }
+
+        float scale = 1.0f / (MeshOptimizerCacheSize - 3);
+        cacheScores[i] = std::pow(1.0f - (i - 3) * scale, MeshOptimizerCacheDecayPower);
+    }
+
+    for (int32 i = 1; i <= MeshOptimizerMaxValence; i++)
+    {
+        valenceScores[i] = MeshOptimizerValenceBoostScale * std::pow(
+            static_cast<float>(i), -MeshOptimizerValenceBoostPower);
+    }
+}
+
+MeshOptimizerStatistics MeshOptimizer::getStatistics()
+{
+    return statistics;
+}
+
+bool MeshOptimizer::optimize(ModelData& modelData)
+{
+    statistics = {};
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    for (const MeshData& meshData : modelData.meshDataItems)
+    {
+        if (meshData.indexes.size() % 3 != 0)
+        {
+            return false;
+        }
+
+        for (uint32 index : meshData.indexes)
+        {
+            if (index >= modelData.vertexes.size())
+            {
+                return false;
+            }
+        }
+
+        for (const MeshLodData& lodData : meshData.lodDataItems)
+        {
+            if (lodData.indexes.size() % 3 != 0)
+            {
+                return false;
+            }
+
+            for (uint32 index : lodData.indexes)
+            {
+                if (index >= modelData.vertexes.size())
+                {
+                    return false;
+                }
+            }
+        }
+    }
+
+    statistics.meshOptimizationStatisticsItems.reserve(modelData.meshDataItems.size());
+    for (MeshData& meshData : modelData.meshDataItems)
+    {
+        MeshOptimizationStatistics meshStatistics = {};
+        meshStatistics.meshName = meshData.name;
+        meshStatistics.triangleCount = meshData.indexes.size() / 3;
+        meshStatistics.vertexCount = getUniqueVertexCount(meshData.indexes);
+
+        uint64 transformedVertexCount = getTransformedVertexCount(meshData.indexes);
+
+        optimizeVertexCache(meshData.indexes);
+        for (MeshLodData& lodData : meshData.lodDataItems)
+        {
+            optimizeVertexCache(lodData.indexes);
+        }
+
+        uint64 optimizedTransformedVertexCount = getTransformedVertexCount(meshData.indexes);
+
+        if (meshStatistics.triangleCount > 0)
+        {
+            double triangleCount = static_cast<double>(meshStatistics.triangleCount);
+            double vertexCount = static_cast<double>(meshStatistics.vertexCount);
+
+            meshStatistics.acmrBefore = transformedVertexCount / triangleCount;
+            meshStatistics.acmrAfter = optimizedTransformedVertexCount / triangleCount;
+            meshStatistics.atvrBefore = transformedVertexCount / vertexCount;
+            meshStatistics.atvrAfter = optimizedTransformedVertexCount / vertexCount;
+        }
+
+        statistics.meshOptimizationStatisticsItems.push_back(meshStatistics);
+    }
+
+    optimizeVertexFetch(modelData);
+
+    std::chrono::duration<double> optimizationTime = std::chrono::steady_clock::now() - startTime;
+    statistics.optimizationTime = optimizationTime.count();
+
+    return true;
+}
+
+void MeshOptimizer::optimizeVertexCache(std::vector<uint32>& indexes)
+{
+    uint64 triangleCount = indexes.size() / 3;
+    if (triangleCount < 2)
+    {
+        return;
+    }
+
+    uint32 minIndex = 0;
+    uint32 maxIndex = 0;
+    getIndexRange(indexes, minIndex, maxIndex);
+
+    uint64 vertexCount = static_cast<uint64>(maxIndex) - minIndex + 1;
+
+    // Triangles not emitted yet per vertex, stored back to back
+    std::vector<uint32> triangleCounts(vertexCount);
+    for (uint32 index : indexes)
+    {
+        triangleCounts[index - minIndex]++;
+    }
+
+    std::vector<uint32> triangleOffsets(vertexCount);
+    uint32 triangleOffset = 0;
+    for (uint64 i = 0; i < vertexCount; i++)
+    {
+        triangleOffsets[i] = triangleOffset;
+        triangleOffset += triangleCounts[i];
+    }
+
+    std::vector<uint32> adjacentTriangles(indexes.size());
+    std::vector<uint32> adjacentTriangleCounts(vertexCount);
+    for (uint64 i = 0; i < indexes.size(); i++)
+    {
+        uint32 vertex = indexes[i] - minIndex;
+
+        adjacentTriangles[triangleOffsets[vertex] + adjacentTriangleCounts[vertex]] =
+            static_cast<uint32>(i / 3);
+        adjacentTriangleCounts[vertex]++;
+    }
+
+    std::vector<int32> cachePositions(vertexCount, -1);
+
+    std::vector<float> vertexScores(vertexCount);
+    for (uint64 i = 0; i < vertexCount; i++)
+    {
+        vertexScores[i] = getVertexScore(-1, triangleCounts[i]);
+    }
+
+    std::vector<float> triangleScores(triangleCount);
+    uint64 bestTriangle = 0;
+    for (uint64 i = 0; i < triangleCount; i++)
+    {
+        triangleScores[i] = vertexScores[indexes[i * 3] - minIndex] +
+            vertexScores[indexes[i * 3 + 1] - minIndex] + vertexScores[indexes[i * 3 + 2] - minIndex];
+
+        if (triangleScores[i] > triangleScores[bestTriangle])
+        {
+            bestTriangle = i;
+        }
+    }
+
+    std::vector<uint8> isTriangleEmitted(triangleCount);
+
+    std::vector<uint32> optimizedIndexes;
+    optimizedIndexes.reserve(indexes.size());
+
+    uint32 cache[MeshOptimizerCacheSize + 3] = {};
+    int32 cacheSize = 0;
+
+    uint64 nextTriangle = 0;
+    while (bestTriangle < triangleCount)
+    {
+        isTriangleEmitted[bestTriangle] = 1;
+
+        uint32 newCache[MeshOptimizerCacheSize + 3] = {};
+        int32 newCacheSize = 0;
+
+        for (int32 i = 0; i < 3; i++)
+        {
+            uint32 index = indexes[bestTriangle * 3 + i];
+            optimizedIndexes.push_back(index);
+
+            uint32 vertex = index - minIndex;
+
+            uint32* triangles = &adjacentTriangles[triangleOffsets[vertex]];
+            uint32 count = triangleCounts[vertex];
+            for (uint32 j = 0; j < count; j++)
+            {
+                if (triangles[j] == bestTriangle)
+                {
+                    triangles[j] = triangles[count - 1];
+
+                    break;
+                }
+            }
+            triangleCounts[vertex]--;
+
+            bool isCached = false;
+            for (int32 j = 0; j < newCacheSize; j++)
+            {
+                if (newCache[j] == vertex)
+                {
+                    isCached = true;
+
+                    break;
+                }
+            }
+            if (!isCached)
+            {
+                newCache[newCacheSize] = vertex;
+                newCacheSize++;
+            }
+        }
+
+        int32 triangleVertexCount = newCacheSize;
+        for (int32 i = 0; i < cacheSize; i++)
+        {
+            bool isTriangleVertex = false;
+            for (int32 j = 0; j < triangleVertexCount; j++)
+            {
+                if (cache[i] == newCache[j])
+                {
+                    isTriangleVertex = true;
+
+                    break;
+                }
+            }
+            if (!isTriangleVertex)
+            {
+                newCache[newCacheSize] = cache[i];
+                newCacheSize++;
+            }
+        }
+
+        // Vertexes pushed out of the cache lose their cache score
+        for (int32 i = MeshOptimizerCacheSize; i < newCacheSize; i++)
+        {
+            uint32 vertex = newCache[i];
+            cachePositions[vertex] = -1;
+
+            float score = getVertexScore(-1, triangleCounts[vertex]);
+            float scoreDelta = score - vertexScores[vertex];
+            vertexScores[vertex] = score;
+
+            const uint32* triangles = &adjacentTriangles[triangleOffsets[vertex]];
+            for (uint32 j = 0; j < triangleCounts[vertex]; j++)
+            {
+                triangleScores[triangles[j]] += scoreDelta;
+            }
+        }
+
+        cacheSize = newCacheSize;
+        if (cacheSize > MeshOptimizerCacheSize)
+        {
+            cacheSize = MeshOptimizerCacheSize;
+        }
+
+        for (int32 i = 0; i < cacheSize; i++)
+        {
+            uint32 vertex = newCache[i];
+            cache[i] = vertex;
+            cachePositions[vertex] = i;
+
+            float score = getVertexScore(i, triangleCounts[vertex]);
+            float scoreDelta = score - vertexScores[vertex];
+            vertexScores[vertex] = score;
+
+            const uint32* triangles = &adjacentTriangles[triangleOffsets[vertex]];
+            for (uint32 j = 0; j < triangleCounts[vertex]; j++)
+            {
+                triangleScores[triangles[j]] += scoreDelta;
+            }
+        }
+
+        // Only triangles touching the cache changed their score, so the best one is looked for
+        // among them and the rest of the mesh is only scanned once the cache runs dry
+        bestTriangle = triangleCount;
+        float bestTriangleScore = -1.0f;
+        for (int32 i = 0; i < cacheSize; i++)
+        {
+            uint32 vertex = cache[i];
+
+            const uint32* triangles = &adjacentTriangles[triangleOffsets[vertex]];
+            for (uint32 j = 0; j < triangleCounts[vertex]; j++)
+            {
+                if (triangleScores[triangles[j]] > bestTriangleScore)
+                {
+                    bestTriangle = triangles[j];
+                    bestTriangleScore = triangleScores[triangles[j]];
+                }
+            }
+        }
+
+        if (bestTriangle == triangleCount)
+        {
+            while (nextTriangle < triangleCount && isTriangleEmitted[nextTriangle])
+            {
+                nextTriangle++;
+            }
+
+            bestTriangle = nextTriangle;
+        }
+    }
+
+    indexes = std::move(optimizedIndexes);
+}
+
+void MeshOptimizer::optimizeVertexFetch(ModelData& modelData)
+{
+    std::vector<uint32> newIndexes(modelData.vertexes.size(), UINT32_MAX);
+
+    std::vector<Vertex> vertexes;
+    vertexes.reserve(modelData.vertexes.size());
+
+    // Meshes share the vertex buffer, so the order of first use is taken across all of them.
+    // Vertexes no mesh references are dropped
+    for (MeshData& meshData : modelData.meshDataItems)
+    {
+        for (uint32& index : meshData.indexes)
+        {
+            if (newIndexes[index] == UINT32_MAX)
+            {
+                newIndexes[index] = static_cast<uint32>(vertexes.size());
+                vertexes.push_back(modelData.vertexes[index]);
+            }
+
+            index = newIndexes[index];
+        }
+    }
+
+    // LOD levels come after all full meshes, they normally use vertexes numbered already
+    for (MeshData& meshData : modelData.meshDataItems)
+    {
+        for (MeshLodData& lodData : meshData.lodDataItems)
+        {
+            for (uint32& index : lodData.indexes)
+            {
+                if (newIndexes[index] == UINT32_MAX)
+                {
+                    newIndexes[index] = static_cast<uint32>(vertexes.size());
+                    vertexes.push_back(modelData.vertexes[index]);
+                }
+
+                index = newIndexes[index];
+            }
+        }
+    }
+
+    modelData.vertexes = std::move(vertexes);
+}
+
+uint64 MeshOptimizer::getTransformedVertexCount(const std::vector<uint32>& indexes)
+{
+    if (indexes.empty())
+    {
+        return 0;
+    }
+
+    uint32 minIndex = 0;
+    uint32 maxIndex = 0;
+    getIndexRange(indexes, minIndex, maxIndex);
+
+    // A vertex is still cached while fewer than the cache size vertexes were transformed after it
+    std::vector<uint32> timestamps(static_cast<uint64>(maxIndex) - minIndex + 1);
+    uint32 timestamp = MeshOptimizerSimulatedCacheSize + 1;
+
+    uint64 transformedVertexCount = 0;
+    for (uint32 index : indexes)
+    {
+        uint32 vertex = index - minIndex;
+        if (timestamp - timestamps[vertex] > MeshOptimizerSimulatedCacheSize)
+        {
+            timestamps[vertex] = timestamp;
+            timestamp++;
+
+            transformedVertexCount++;
+        }
+    }
+
+    return transformedVertexCount;
+}
+
+uint64 MeshOptimizer::getUniqueVertexCount(const std::vector<uint32>& indexes)
+{
+    if (indexes.empty())
+    {
+        return 0;
+    }
+
+    uint32 minIndex = 0;
+    uint32 maxIndex = 0;
+    getIndexRange(indexes, minIndex, maxIndex);
+
+    std::vector<uint8> isUsed(static_cast<uint64>(maxIndex) - minIndex + 1);
+
+    uint64 uniqueVertexCount = 0;
+    for (uint32 index : indexes)
+    {
+        if (!isUsed[index - minIndex])
+        {
+            isUsed[index - minIndex] = 1;
+
+            uniqueVertexCount++;
+        }
+    }
+
+    return uniqueVertexCount;
+}
+
+float MeshOptimizer::getVertexScore(int32 cachePosition, uint32 remainingTriangleCount)
+{
+    if (remainingTriangleCount == 0)
+    {
+        return -1.0f;
+    }
+
+    float score = 0.0f;
+    if (cachePosition >= 0)
+    {
+        score = cacheScores[cachePosition];
+    }
+
+    if (remainingTriangleCount > MeshOptimizerMaxValence)
+    {
+        remainingTriangleCount = MeshOptimizerMaxValence;
+    }
+
+    return score + valenceScores[remainingTriangleCount];
+}
+
+void MeshOptimizer::getIndexRange(const std::vector<uint32>& indexes, uint32& minIndex,
+                                  uint32& maxIndex)
+{
+    minIndex = UINT32_MAX;
+    maxIndex = 0;
+    for (uint32 index : indexes)
+    {
+        if (index < minIndex)
+        {
+            minIndex = index;
+        }
+        if (index > maxIndex)
+        {
+            maxIndex = index;
+        }
+    }
+}
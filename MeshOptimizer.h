@@ -0,0 +1,40 @@
+#pragma once
+#include <vector>
+
+#include <cmath>
+
+#include <chrono>
+
+#include "ModelFileParserUtility.h"
+#include "MeshOptimizerUtility.h"
+
+// Reorders the triangles of every mesh for the post-transform vertex cache (Tom Forsyth's
+// linear-speed vertex cache optimisation), then reorders the vertexes of the model by first use so
+// vertex fetches walk the vertex buffer forward
+class MeshOptimizer
+{
+    float cacheScores[MeshOptimizerCacheSize];
+    float valenceScores[MeshOptimizerMaxValence + 1];
+
+    MeshOptimizerStatistics statistics;
+
+public:
+    MeshOptimizer();
+
+    MeshOptimizerStatistics getStatistics();
+
+    bool optimize(ModelData& modelData);
+
+    void optimizeVertexCache(std::vector<uint32>& indexes);
+    void optimizeVertexFetch(ModelData& modelData);
+
+    uint64 getTransformedVertexCount(const std::vector<uint32>& indexes);
+    uint64 getUniqueVertexCount(const std::vector<uint32>& indexes);
+
+private:
+    float getVertexScore(int32 cachePosition, uint32 remainingTriangleCount);
+
+    // Per-vertex state is kept for the index range of the mesh only, meshes of a model take
+    // mostly contiguous ranges of its vertex buffer
+    void getIndexRange(const std::vector<uint32>& indexes, uint32& minIndex, uint32& maxIndex);
+};
@@ -0,0 +1,162 @@
+#include "MeshOptimizerTests.h"
+
+MeshOptimizerTests::MeshOptimizerTests() : statistics{}
+{
+}
+
+TestStatistics MeshOptimizerTests::getStatistics()
+{
+    return statistics;
+}
+
+void MeshOptimizerTests::run()
+{
+    statistics = {};
+
+    testCacheEfficiency(false);
+    testCacheEfficiency(true);
+    testContents(false);
+    testContents(true);
+}
+
+void MeshOptimizerTests::testCacheEfficiency(bool isShuffled)
+{
+    std::string orderName = isShuffled ? " (shuffled)" : " (row order)";
+
+    ModelData modelData;
+    getGrid(isShuffled, modelData);
+
+    MeshOptimizer meshOptimizer;
+    bool result = meshOptimizer.optimize(modelData);
+
+    // The statistics have to match the optimized indexes too
+    MeshOptimizerStatistics optimizerStatistics = meshOptimizer.getStatistics();
+    result = result && optimizerStatistics.meshOptimizationStatisticsItems.size() == 1;
+    if (result)
+    {
+        const MeshOptimizationStatistics& meshStatistics = optimizerStatistics.
+            meshOptimizationStatisticsItems[0];
+
+        double triangleCount = static_cast<double>(meshStatistics.triangleCount);
+        double acmr = meshOptimizer.getTransformedVertexCount(modelData.meshDataItems[0].indexes)
+            / triangleCount;
+        result = acmr == meshStatistics.acmrAfter
+            && meshStatistics.acmrAfter <= meshStatistics.acmrBefore
+            && meshStatistics.atvrAfter <= meshStatistics.atvrBefore;
+    }
+
+    checkTest(result, "MeshOptimizer ACMR and ATVR" + orderName, statistics);
+}
+
+void MeshOptimizerTests::testContents(bool isShuffled)
+{
+    std::string orderName = isShuffled ? " (shuffled)" : " (row order)";
+
+    ModelData modelData;
+    getGrid(isShuffled, modelData);
+
+    std::vector<Vertex> triangles;
+    getTriangles(modelData, triangles);
+    std::vector<Vertex> vertexes = modelData.vertexes;
+    std::sort(vertexes.begin(), vertexes.end(), isVertexLess);
+
+    MeshOptimizer meshOptimizer;
+    bool result = meshOptimizer.optimize(modelData);
+
+    std::vector<Vertex> optimizedTriangles;
+    getTriangles(modelData, optimizedTriangles);
+    std::vector<Vertex> optimizedVertexes = modelData.vertexes;
+    std::sort(optimizedVertexes.begin(), optimizedVertexes.end(), isVertexLess);
+
+    checkTest(result && optimizedTriangles.size() == triangles.size() && std::memcmp(
+        optimizedTriangles.data(), triangles.data(), triangles.size() * sizeof(Vertex)) == 0,
+              "MeshOptimizer triangles" + orderName, statistics);
+    checkTest(result && optimizedVertexes.size() == vertexes.size() && std::memcmp(
+        optimizedVertexes.data(), vertexes.data(), vertexes.size() * sizeof(Vertex)) == 0,
+              "MeshOptimizer vertexes" + orderName, statistics);
+}
+
+void MeshOptimizerTests::getGrid(bool isShuffled, ModelData& modelData)
+{
+    const uint32 size = MeshOptimizerTestGridSize;
+    const uint32 rowSize = size + 1;
+
+    modelData = {};
+    modelData.vertexes.resize(rowSize * rowSize);
+    for (uint32 y = 0; y < rowSize; y++)
+    {
+        for (uint32 x = 0; x < rowSize; x++)
+        {
+            Vertex& vertex = modelData.vertexes[y * rowSize + x];
+            vertex.position = DirectX::XMFLOAT3(static_cast<float>(x), 0.0f,
+                                                static_cast<float>(y));
+            vertex.textureCoordinates = DirectX::XMFLOAT3(static_cast<float>(x) / size,
+                                                          static_cast<float>(y) / size, 0.0f);
+            vertex.normal = DirectX::XMFLOAT3(0.0f, 1.0f, 0.0f);
+        }
+    }
+
+    MeshData meshData = {};
+    meshData.name = "Grid";
+    for (uint32 y = 0; y < size; y++)
+    {
+        for (uint32 x = 0; x < size; x++)
+        {
+            uint32 i = y * rowSize + x;
+
+            const uint32 quadIndexes[] = { i, i + rowSize, i + 1, i + 1, i + rowSize,
+                                           i + rowSize + 1 };
+            meshData.indexes.insert(meshData.indexes.end(), quadIndexes, quadIndexes + 6);
+        }
+    }
+
+    if (isShuffled)
+    {
+        uint32 seed = 1;
+        for (uint64 i = meshData.indexes.size() / 3 - 1; i > 0; i--)
+        {
+            seed = seed * 1664525 + 1013904223;
+            uint64 j = (seed >> 8) % (i + 1);
+
+            std::swap_ranges(&meshData.indexes[i * 3], &meshData.indexes[i * 3] + 3,
+                             &meshData.indexes[j * 3]);
+        }
+    }
+
+    modelData.meshDataItems.push_back(std::move(meshData));
+}
+
+void MeshOptimizerTests::getTriangles(const ModelData& modelData, std::vector<Vertex>& triangles)
+{
+    const std::vector<uint32>& indexes = modelData.meshDataItems[0].indexes;
+
+    std::vector<std::vector<Vertex>> sortedTriangles;
+    for (uint64 i = 0; i + 2 < indexes.size(); i += 3)
+    {
+        std::vector<Vertex> triangle = { modelData.vertexes[indexes[i]],
+                                         modelData.vertexes[indexes[i + 1]],
+                                         modelData.vertexes[indexes[i + 2]] };
+
+        // A rotation keeps the winding
+        std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end(),
+                                                       isVertexLess), triangle.end());
+        sortedTriangles.push_back(triangle);
+    }
+    std::sort(sortedTriangles.begin(), sortedTriangles.end(),
+              [](const std::vector<Vertex>& lhs, const std::vector<Vertex>& rhs)
+              {
+                  return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(),
+                                                      rhs.end(), isVertexLess);
+              });
+
+    triangles.clear();
+    for (const std::vector<Vertex>& triangle : sortedTriangles)
+    {
+        triangles.insert(triangles.end(), triangle.begin(), triangle.end());
+    }
+}
+
+bool MeshOptimizerTests::isVertexLess(const Vertex& vertex, const Vertex& otherVertex)
+{
+    return std::memcmp(&vertex, &otherVertex, sizeof(Vertex)) < 0;
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <cstring>
+
+#include <vector>
+#include <algorithm>
+
+#include "Vertex.h"
+#include "MeshOptimizer.h"
+
+#include "IntUtility.h"
+#include "MeshOptimizerUtility.h"
+#include "ModelFileParserUtility.h"
+#include "TestUtility.h"
+
+// Quads per side of the test grid
+constexpr uint32 MeshOptimizerTestGridSize = 32;
+
+// Optimizes a grid with its triangles in row order and shuffled: ACMR and ATVR don't get worse,
+// every triangle keeps its vertexes and winding, and the vertex buffer keeps its vertexes
+class MeshOptimizerTests
+{
+    TestStatistics statistics;
+
+public:
+    MeshOptimizerTests();
+
+    TestStatistics getStatistics();
+
+    void run();
+
+private:
+    void testCacheEfficiency(bool isShuffled);
+    void testContents(bool isShuffled);
+
+    // Every vertex has a position of its own
+    void getGrid(bool isShuffled, ModelData& modelData);
+    // Triangles as the vertexes they use, each rotated to start at its smallest vertex, sorted
+    void getTriangles(const ModelData& modelData, std::vector<Vertex>& triangles);
+    // Bytewise, for sorting
+    static bool isVertexLess(const Vertex& vertex, const Vertex& otherVertex);
+};
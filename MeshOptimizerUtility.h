@@ -0,0 +1,37 @@
+#pragma once
+#include <vector>
+
+#include <string>
+
+#include "IntUtility.h"
+
+constexpr int32 MeshOptimizerCacheSize = 32; // vertexes
+constexpr int32 MeshOptimizerMaxValence = 64; // triangles, larger valences share the last score
+
+constexpr float MeshOptimizerCacheDecayPower = 1.5f;
+constexpr float MeshOptimizerLastTriangleScore = 0.75f;
+constexpr float MeshOptimizerValenceBoostScale = 2.0f;
+constexpr float MeshOptimizerValenceBoostPower = 0.5f;
+
+// ACMR and ATVR are measured on a FIFO cache of this size, the usual size of current GPUs
+constexpr uint32 MeshOptimizerSimulatedCacheSize = 16; // vertexes
+
+struct MeshOptimizationStatistics
+{
+    std::string meshName;
+
+    uint64 triangleCount;
+    uint64 vertexCount; // unique vertexes referenced by the mesh
+
+    double acmrBefore; // transformed vertexes per triangle
+    double acmrAfter;
+    double atvrBefore; // transformed vertexes per unique vertex
+    double atvrAfter;
+};
+
+struct MeshOptimizerStatistics
+{
+    std::vector<MeshOptimizationStatistics> meshOptimizationStatisticsItems;
+
+    double optimizationTime; // s
+};
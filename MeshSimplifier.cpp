@@ -0,0 +1,640 @@
+#include "MeshSimplifier.h"
+
+MeshSimplifier::MeshSimplifier() : settings{}, statistics{}
+{
+    settings.lodCount = 3;
+    settings.indexRatio = 0.5f;
+    settings.textureCoordinatesWeight = 0.5f;
+    settings.normalWeight = 0.25f;
+}
+
+MeshSimplifierSettings MeshSimplifier::getSettings()
+{
+    return settings;
+}
+
+void MeshSimplifier::setSettings(MeshSimplifierSettings settings)
+{
+    this->settings = settings;
+}
+
+MeshSimplifierStatistics MeshSimplifier::getStatistics()
+{
+    return statistics;
+}
+
+bool MeshSimplifier::simplify(ModelData& modelData)
+{
+    statistics = {};
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    for (const MeshData& meshData : modelData.meshDataItems)
+    {
+        if (meshData.indexes.size() % 3 != 0)
+        {
+            return false;
+        }
+
+        for (uint32 index : meshData.indexes)
+        {
+            if (index >= modelData.vertexes.size())
+            {
+                return false;
+            }
+        }
+    }
+
+    statistics.meshSimplificationStatisticsItems.reserve(modelData.meshDataItems.size());
+    for (MeshData& meshData : modelData.meshDataItems)
+    {
+        meshData.lodDataItems.clear();
+
+        MeshSimplificationStatistics meshStatistics = {};
+        meshStatistics.meshName = meshData.name;
+        meshStatistics.lodIndexCounts.push_back(meshData.indexes.size());
+        meshStatistics.lodErrors.push_back(0.0f);
+
+        // Every level is built from the previous one, errors add up along the chain
+        const std::vector<uint32>* indexes = &meshData.indexes;
+        float error = 0.0f;
+        for (uint32 i = 0; i < settings.lodCount; i++)
+        {
+            uint64 targetIndexCount = static_cast<uint64>(indexes->size() / 3 *
+                settings.indexRatio) * 3;
+
+            MeshLodData lodData = {};
+
+            float lodError = 0.0f;
+            bool result = simplifyMesh(modelData.vertexes, *indexes, targetIndexCount,
+                                       lodData.indexes, lodError);
+            if (!result)
+            {
+                return false;
+            }
+
+            if (lodData.indexes.empty() || lodData.indexes.size() > indexes->size() *
+                MeshSimplifierMinIndexReduction)
+            {
+                break;
+            }
+
+            error += lodError;
+            lodData.error = error;
+
+            meshStatistics.lodIndexCounts.push_back(lodData.indexes.size());
+            meshStatistics.lodErrors.push_back(lodData.error);
+
+            meshData.lodDataItems.push_back(lodData);
+            indexes = &meshData.lodDataItems.back().indexes;
+        }
+
+        statistics.meshSimplificationStatisticsItems.push_back(meshStatistics);
+    }
+
+    std::chrono::duration<double> simplificationTime = std::chrono::steady_clock::now() -
+        startTime;
+    statistics.simplificationTime = simplificationTime.count();
+
+    return true;
+}
+
+bool MeshSimplifier::simplifyMesh(const std::vector<Vertex>& vertexes,
+                                  const std::vector<uint32>& indexes, uint64 targetIndexCount,
+                                  std::vector<uint32>& simplifiedIndexes, float& error)
+{
+    error = 0.0f;
+    simplifiedIndexes.clear();
+
+    if (indexes.size() % 3 != 0)
+    {
+        return false;
+    }
+
+    // The mesh is simplified over its own vertexes, numbered in the order of the model's ones
+    std::vector<uint32> modelVertexes(indexes);
+    std::sort(modelVertexes.begin(), modelVertexes.end());
+    modelVertexes.erase(std::unique(modelVertexes.begin(), modelVertexes.end()),
+                        modelVertexes.end());
+
+    std::vector<Vertex> meshVertexes(modelVertexes.size());
+    for (uint64 i = 0; i < modelVertexes.size(); i++)
+    {
+        if (modelVertexes[i] >= vertexes.size())
+        {
+            return false;
+        }
+
+        meshVertexes[i] = vertexes[modelVertexes[i]];
+    }
+
+    std::vector<uint32> meshIndexes(indexes.size());
+    for (uint64 i = 0; i < indexes.size(); i++)
+    {
+        meshIndexes[i] = static_cast<uint32>(std::lower_bound(
+            modelVertexes.begin(), modelVertexes.end(), indexes[i]) - modelVertexes.begin());
+    }
+
+    uint64 vertexCount = meshVertexes.size();
+
+    std::vector<uint32> seamVertexes;
+    std::vector<uint8> isSeamVertex;
+    getSeamVertexes(meshVertexes, seamVertexes, isSeamVertex);
+
+    std::vector<MeshSimplifierQuadric> quadrics;
+    getQuadrics(meshVertexes, meshIndexes, seamVertexes, quadrics);
+
+    DirectX::XMFLOAT3 minPosition = {FLT_MAX, FLT_MAX, FLT_MAX};
+    DirectX::XMFLOAT3 maxPosition = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
+    for (const Vertex& vertex : meshVertexes)
+    {
+        minPosition.x = vertex.position.x < minPosition.x ? vertex.position.x : minPosition.x;
+        minPosition.y = vertex.position.y < minPosition.y ? vertex.position.y : minPosition.y;
+        minPosition.z = vertex.position.z < minPosition.z ? vertex.position.z : minPosition.z;
+        maxPosition.x = vertex.position.x > maxPosition.x ? vertex.position.x : maxPosition.x;
+        maxPosition.y = vertex.position.y > maxPosition.y ? vertex.position.y : maxPosition.y;
+        maxPosition.z = vertex.position.z > maxPosition.z ? vertex.position.z : maxPosition.z;
+    }
+
+    DirectX::XMFLOAT3 diagonal(maxPosition.x - minPosition.x, maxPosition.y - minPosition.y,
+                               maxPosition.z - minPosition.z);
+    float attributeScale = std::sqrt(getDot(diagonal, diagonal));
+
+    std::vector<uint64> edges;
+    std::vector<MeshSimplifierVertexKind> vertexKinds;
+
+    std::vector<uint32> triangleCounts(vertexCount);
+    std::vector<uint32> triangleOffsets(vertexCount);
+    std::vector<uint32> adjacentTriangles;
+
+    std::vector<MeshSimplifierCollapse> collapses;
+
+    std::vector<uint32> collapseTargets(vertexCount);
+    std::vector<uint8> isVertexTouched(vertexCount);
+
+    float maxPositionError = 0.0f;
+    while (meshIndexes.size() > targetIndexCount)
+    {
+        uint64 triangleCount = meshIndexes.size() / 3;
+
+        getVertexKinds(meshVertexes, meshIndexes, seamVertexes, isSeamVertex, edges,
+                       vertexKinds);
+
+        std::fill(triangleCounts.begin(), triangleCounts.end(), 0);
+        for (uint32 index : meshIndexes)
+        {
+            triangleCounts[index]++;
+        }
+
+        uint32 triangleOffset = 0;
+        for (uint64 i = 0; i < vertexCount; i++)
+        {
+            triangleOffsets[i] = triangleOffset;
+            triangleOffset += triangleCounts[i];
+        }
+
+        adjacentTriangles.resize(meshIndexes.size());
+        std::fill(triangleCounts.begin(), triangleCounts.end(), 0);
+        for (uint64 i = 0; i < meshIndexes.size(); i++)
+        {
+            uint32 vertex = meshIndexes[i];
+
+            adjacentTriangles[triangleOffsets[vertex] + triangleCounts[vertex]] =
+                static_cast<uint32>(i / 3);
+            triangleCounts[vertex]++;
+        }
+
+        // The cheapest collapse of every vertex, ties go to the lower target for determinism
+        collapses.assign(vertexCount, {0, UINT32_MAX, FLT_MAX, 0.0f});
+        for (uint64 i = 0; i < meshIndexes.size(); i++)
+        {
+            uint32 edgeVertexes[2] = {meshIndexes[i], meshIndexes[i % 3 == 2 ? i - 2 : i + 1]};
+            for (int32 j = 0; j < 2; j++)
+            {
+                uint32 vertex = edgeVertexes[j];
+                uint32 targetVertex = edgeVertexes[1 - j];
+                if (!canCollapse(vertex, targetVertex, seamVertexes, edges, vertexKinds))
+                {
+                    continue;
+                }
+
+                float positionError = static_cast<float>(evaluateQuadric(
+                    quadrics[vertex], meshVertexes[targetVertex].position));
+                float cost = positionError + getAttributeError(
+                    meshVertexes[vertex], meshVertexes[targetVertex], attributeScale);
+
+                MeshSimplifierCollapse& collapse = collapses[vertex];
+                if (cost < collapse.cost || (cost == collapse.cost && targetVertex < collapse.
+                    targetVertex))
+                {
+                    collapse.vertex = vertex;
+                    collapse.targetVertex = targetVertex;
+                    collapse.cost = cost;
+                    collapse.positionError = positionError;
+                }
+            }
+        }
+
+        collapses.erase(std::remove_if(collapses.begin(), collapses.end(),
+                                       [](const MeshSimplifierCollapse& collapse)
+                                       {
+                                           return collapse.targetVertex == UINT32_MAX;
+                                       }), collapses.end());
+        std::sort(collapses.begin(), collapses.end(),
+                  [](const MeshSimplifierCollapse& lhs, const MeshSimplifierCollapse& rhs)
+                  {
+                      if (lhs.cost != rhs.cost)
+                      {
+                          return lhs.cost < rhs.cost;
+                      }
+
+                      return lhs.vertex < rhs.vertex;
+                  });
+
+        // Collapses of one pass don't share any triangle, so each one is checked against the
+        // mesh it is applied to
+        for (uint64 i = 0; i < vertexCount; i++)
+        {
+            collapseTargets[i] = static_cast<uint32>(i);
+        }
+        std::fill(isVertexTouched.begin(), isVertexTouched.end(), 0);
+
+        uint64 removableTriangleCount = triangleCount - targetIndexCount / 3;
+        uint64 removedTriangleCount = 0;
+        uint64 collapseCount = 0;
+        for (const MeshSimplifierCollapse& collapse : collapses)
+        {
+            if (removedTriangleCount >= removableTriangleCount)
+            {
+                break;
+            }
+
+            uint32 vertex = collapse.vertex;
+            uint32 targetVertex = collapse.targetVertex;
+            if (isVertexTouched[vertex] || isVertexTouched[targetVertex])
+            {
+                continue;
+            }
+
+            const uint32* triangles = &adjacentTriangles[triangleOffsets[vertex]];
+            if (isCollapseFlipping(meshVertexes, meshIndexes, triangles, triangleCounts[vertex],
+                                   vertex, targetVertex))
+            {
+                continue;
+            }
+
+            for (uint32 j = 0; j < triangleCounts[vertex]; j++)
+            {
+                const uint32* triangle = &meshIndexes[triangles[j] * 3];
+                if (triangle[0] == targetVertex || triangle[1] == targetVertex || triangle[2] ==
+                    targetVertex)
+                {
+                    removedTriangleCount++;
+                }
+
+                isVertexTouched[triangle[0]] = 1;
+                isVertexTouched[triangle[1]] = 1;
+                isVertexTouched[triangle[2]] = 1;
+            }
+
+            collapseTargets[vertex] = targetVertex;
+            addQuadric(quadrics[targetVertex], quadrics[vertex]);
+
+            if (collapse.positionError > maxPositionError)
+            {
+                maxPositionError = collapse.positionError;
+            }
+
+            collapseCount++;
+        }
+
+        if (collapseCount == 0)
+        {
+            break;
+        }
+
+        uint64 indexCount = 0;
+        for (uint64 i = 0; i < meshIndexes.size(); i += 3)
+        {
+            uint32 a = collapseTargets[meshIndexes[i]];
+            uint32 b = collapseTargets[meshIndexes[i + 1]];
+            uint32 c = collapseTargets[meshIndexes[i + 2]];
+            if (a == b || b == c || a == c)
+            {
+                continue;
+            }
+
+            meshIndexes[indexCount] = a;
+            meshIndexes[indexCount + 1] = b;
+            meshIndexes[indexCount + 2] = c;
+            indexCount += 3;
+        }
+        meshIndexes.resize(indexCount);
+    }
+
+    simplifiedIndexes.resize(meshIndexes.size());
+    for (uint64 i = 0; i < meshIndexes.size(); i++)
+    {
+        simplifiedIndexes[i] = modelVertexes[meshIndexes[i]];
+    }
+
+    error = std::sqrt(maxPositionError);
+
+    return true;
+}
+
+void MeshSimplifier::getSeamVertexes(const std::vector<Vertex>& vertexes,
+                                     std::vector<uint32>& seamVertexes,
+                                     std::vector<uint8>& isSeamVertex)
+{
+    // Vertexes at the same position share the first of them as their seam vertex, the topology
+    // is built over seam vertexes so UV and normal seams don't look like borders
+    std::vector<uint32> sortedVertexes(vertexes.size());
+    for (uint64 i = 0; i < sortedVertexes.size(); i++)
+    {
+        sortedVertexes[i] = static_cast<uint32>(i);
+    }
+
+    std::sort(sortedVertexes.begin(), sortedVertexes.end(), [&](uint32 lhs, uint32 rhs)
+    {
+        const DirectX::XMFLOAT3& lhsPosition = vertexes[lhs].position;
+        const DirectX::XMFLOAT3& rhsPosition = vertexes[rhs].position;
+        if (lhsPosition.x != rhsPosition.x)
+        {
+            return lhsPosition.x < rhsPosition.x;
+        }
+        if (lhsPosition.y != rhsPosition.y)
+        {
+            return lhsPosition.y < rhsPosition.y;
+        }
+        if (lhsPosition.z != rhsPosition.z)
+        {
+            return lhsPosition.z < rhsPosition.z;
+        }
+
+        return lhs < rhs;
+    });
+
+    seamVertexes.resize(vertexes.size());
+    isSeamVertex.assign(vertexes.size(), 0);
+    for (uint64 i = 0; i < sortedVertexes.size();)
+    {
+        uint64 j = i + 1;
+        while (j < sortedVertexes.size() && vertexes[sortedVertexes[j]].position.x ==
+            vertexes[sortedVertexes[i]].position.x && vertexes[sortedVertexes[j]].position.y ==
+            vertexes[sortedVertexes[i]].position.y && vertexes[sortedVertexes[j]].position.z ==
+            vertexes[sortedVertexes[i]].position.z)
+        {
+            j++;
+        }
+
+        for (uint64 k = i; k < j; k++)
+        {
+            seamVertexes[sortedVertexes[k]] = sortedVertexes[i];
+            isSeamVertex[sortedVertexes[k]] = j - i > 1;
+        }
+
+        i = j;
+    }
+}
+
+void MeshSimplifier::getQuadrics(const std::vector<Vertex>& vertexes,
+                                 const std::vector<uint32>& indexes,
+                                 const std::vector<uint32>& seamVertexes,
+                                 std::vector<MeshSimplifierQuadric>& quadrics)
+{
+    quadrics.assign(vertexes.size(), {});
+
+    std::vector<uint64> edges;
+    edges.reserve(indexes.size());
+    for (uint64 i = 0; i < indexes.size(); i++)
+    {
+        uint64 a = seamVertexes[indexes[i]];
+        uint64 b = seamVertexes[indexes[i % 3 == 2 ? i - 2 : i + 1]];
+
+        edges.push_back(a << 32 | b);
+    }
+    std::sort(edges.begin(), edges.end());
+
+    for (uint64 i = 0; i < indexes.size(); i += 3)
+    {
+        DirectX::XMFLOAT3 positions[3] = {
+            vertexes[indexes[i]].position, vertexes[indexes[i + 1]].position,
+            vertexes[indexes[i + 2]].position
+        };
+
+        DirectX::XMFLOAT3 normal = getTriangleNormal(positions[0], positions[1], positions[2]);
+        float length = std::sqrt(getDot(normal, normal));
+        if (length == 0.0f)
+        {
+            continue;
+        }
+
+        normal = DirectX::XMFLOAT3(normal.x / length, normal.y / length, normal.z / length);
+
+        MeshSimplifierQuadric quadric = getPlaneQuadric(normal, positions[0], length * 0.5);
+        addQuadric(quadrics[indexes[i]], quadric);
+        addQuadric(quadrics[indexes[i + 1]], quadric);
+        addQuadric(quadrics[indexes[i + 2]], quadric);
+
+        // Border edges add a plane standing on the edge to keep the outline in place
+        for (int32 j = 0; j < 3; j++)
+        {
+            uint32 vertex = indexes[i + j];
+            uint32 nextVertex = indexes[i + (j + 1) % 3];
+
+            if (hasEdge(edges, seamVertexes[nextVertex], seamVertexes[vertex]))
+            {
+                continue;
+            }
+
+            const DirectX::XMFLOAT3& position = vertexes[vertex].position;
+            const DirectX::XMFLOAT3& nextPosition = vertexes[nextVertex].position;
+
+            DirectX::XMFLOAT3 edge(nextPosition.x - position.x, nextPosition.y - position.y,
+                                   nextPosition.z - position.z);
+            DirectX::XMFLOAT3 edgeNormal(edge.y * normal.z - edge.z * normal.y,
+                                         edge.z * normal.x - edge.x * normal.z,
+                                         edge.x * normal.y - edge.y * normal.x);
+            float edgeLength = std::sqrt(getDot(edgeNormal, edgeNormal));
+            if (edgeLength == 0.0f)
+            {
+                continue;
+            }
+
+            edgeNormal = DirectX::XMFLOAT3(edgeNormal.x / edgeLength, edgeNormal.y / edgeLength,
+                                           edgeNormal.z / edgeLength);
+
+            MeshSimplifierQuadric edgeQuadric = getPlaneQuadric(
+                edgeNormal, position, edgeLength * edgeLength * MeshSimplifierBorderWeight);
+            addQuadric(quadrics[vertex], edgeQuadric);
+            addQuadric(quadrics[nextVertex], edgeQuadric);
+        }
+    }
+}
+
+void MeshSimplifier::getVertexKinds(const std::vector<Vertex>& vertexes,
+                                    const std::vector<uint32>& indexes,
+                                    const std::vector<uint32>& seamVertexes,
+                                    const std::vector<uint8>& isSeamVertex,
+                                    std::vector<uint64>& edges,
+                                    std::vector<MeshSimplifierVertexKind>& vertexKinds)
+{
+    edges.clear();
+    for (uint64 i = 0; i < indexes.size(); i++)
+    {
+        uint64 a = seamVertexes[indexes[i]];
+        uint64 b = seamVertexes[indexes[i % 3 == 2 ? i - 2 : i + 1]];
+
+        edges.push_back(a << 32 | b);
+    }
+    std::sort(edges.begin(), edges.end());
+
+    std::vector<uint32> borderEdgeCounts(seamVertexes.size());
+    // The vertexes before and after every border vertex along the border
+    std::vector<uint32> previousBorderVertexes(seamVertexes.size(), UINT32_MAX);
+    std::vector<uint32> nextBorderVertexes(seamVertexes.size(), UINT32_MAX);
+    for (uint64 i = 0; i < edges.size(); i++)
+    {
+        uint32 a = static_cast<uint32>(edges[i] >> 32);
+        uint32 b = static_cast<uint32>(edges[i]);
+
+        // An edge used twice in the same direction means non-manifold topology
+        if (a == b || (i > 0 && edges[i - 1] == edges[i]) || (i + 1 < edges.size() && edges[i +
+            1] == edges[i]))
+        {
+            borderEdgeCounts[a] += 3;
+            borderEdgeCounts[b] += 3;
+
+            continue;
+        }
+
+        if (!hasEdge(edges, b, a))
+        {
+            borderEdgeCounts[a]++;
+            borderEdgeCounts[b]++;
+
+            nextBorderVertexes[a] = b;
+            previousBorderVertexes[b] = a;
+        }
+    }
+
+    vertexKinds.resize(seamVertexes.size());
+    for (uint64 i = 0; i < seamVertexes.size(); i++)
+    {
+        uint32 seamVertex = seamVertexes[i];
+        uint32 borderEdgeCount = borderEdgeCounts[seamVertex];
+        if (isSeamVertex[i] || (borderEdgeCount != 0 && borderEdgeCount != 2))
+        {
+            vertexKinds[i] = MeshSimplifierVertexKind::Locked;
+        }
+        else if (borderEdgeCount == 2)
+        {
+            vertexKinds[i] = MeshSimplifierVertexKind::Border;
+
+            // Corners of the outline hold its shape
+            uint32 previousVertex = previousBorderVertexes[seamVertex];
+            uint32 nextVertex = nextBorderVertexes[seamVertex];
+            if (previousVertex == UINT32_MAX || nextVertex == UINT32_MAX || isBorderCorner(
+                vertexes[previousVertex].position, vertexes[seamVertex].position,
+                vertexes[nextVertex].position))
+            {
+                vertexKinds[i] = MeshSimplifierVertexKind::Locked;
+            }
+        }
+        else
+        {
+            vertexKinds[i] = MeshSimplifierVertexKind::Manifold;
+        }
+    }
+}
+
+bool MeshSimplifier::canCollapse(uint32 vertex, uint32 targetVertex,
+                                 const std::vector<uint32>& seamVertexes,
+                                 const std::vector<uint64>& edges,
+                                 const std::vector<MeshSimplifierVertexKind>& vertexKinds)
+{
+    if (vertex == targetVertex)
+    {
+        return false;
+    }
+
+    switch (vertexKinds[vertex])
+    {
+    case MeshSimplifierVertexKind::Manifold:
+        return true;
+    case MeshSimplifierVertexKind::Border:
+    {
+        uint32 seamVertex = seamVertexes[vertex];
+        uint32 targetSeamVertex = seamVertexes[targetVertex];
+
+        // Only along the border, the edge then exists in one direction
+        return hasEdge(edges, seamVertex, targetSeamVertex) != hasEdge(
+            edges, targetSeamVertex, seamVertex);
+    }
+    default:
+        return false;
+    }
+}
+
+bool MeshSimplifier::isCollapseFlipping(const std::vector<Vertex>& vertexes,
+                                        const std::vector<uint32>& indexes,
+                                        const uint32* triangles, uint32 triangleCount,
+                                        uint32 vertex, uint32 targetVertex)
+{
+    for (uint32 i = 0; i < triangleCount; i++)
+    {
+        const uint32* triangle = &indexes[triangles[i] * 3];
+        if (triangle[0] == targetVertex || triangle[1] == targetVertex || triangle[2] ==
+            targetVertex)
+        {
+            continue;
+        }
+
+        DirectX::XMFLOAT3 positions[3] = {};
+        DirectX::XMFLOAT3 movedPositions[3] = {};
+        for (int32 j = 0; j < 3; j++)
+        {
+            positions[j] = vertexes[triangle[j]].position;
+            movedPositions[j] = triangle[j] == vertex ? vertexes[targetVertex].position :
+                positions[j];
+        }
+
+        DirectX::XMFLOAT3 normal = getTriangleNormal(positions[0], positions[1], positions[2]);
+        DirectX::XMFLOAT3 movedNormal = getTriangleNormal(movedPositions[0], movedPositions[1],
+                                                          movedPositions[2]);
+
+        float cosine = getDot(normal, movedNormal);
+        float lengths = std::sqrt(getDot(normal, normal) * getDot(movedNormal, movedNormal));
+        if (cosine <= MeshSimplifierMinNormalCosine * lengths)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+float MeshSimplifier::getAttributeError(const Vertex& vertex, const Vertex& targetVertex,
+                                        float attributeScale)
+{
+    float textureCoordinatesX = vertex.textureCoordinates.x - targetVertex.textureCoordinates.x;
+    float textureCoordinatesY = vertex.textureCoordinates.y - targetVertex.textureCoordinates.y;
+    float textureCoordinatesWeight = settings.textureCoordinatesWeight * attributeScale;
+
+    DirectX::XMFLOAT3 normal(vertex.normal.x - targetVertex.normal.x,
+                             vertex.normal.y - targetVertex.normal.y,
+                             vertex.normal.z - targetVertex.normal.z);
+    float normalWeight = settings.normalWeight * attributeScale;
+
+    return (textureCoordinatesX * textureCoordinatesX + textureCoordinatesY *
+            textureCoordinatesY) * textureCoordinatesWeight * textureCoordinatesWeight +
+        getDot(normal, normal) * normalWeight * normalWeight;
+}
+
+bool MeshSimplifier::hasEdge(const std::vector<uint64>& edges, uint32 vertex,
+                             uint32 targetVertex)
+{
+    return std::binary_search(edges.begin(), edges.end(),
+                              static_cast<uint64>(vertex) << 32 | targetVertex);
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include <DirectXMath.h>
+
+#include <vector>
+#include <algorithm>
+
+#include <cmath>
+#include <cfloat>
+
+#include <chrono>
+
+#include "Vertex.h"
+
+#include "ModelFileParserUtility.h"
+#include "MeshSimplifierUtility.h"
+
+// Builds coarser index lists for every mesh by collapsing vertexes into their neighbours in
+// order of quadric error, so every level still indexes the vertex buffer of the model. Vertexes on
+// UV or normal seams and at corners of the outline are never moved, the other border vertexes only
+// along the border. The result only depends on the input
+class MeshSimplifier
+{
+    MeshSimplifierSettings settings;
+
+    MeshSimplifierStatistics statistics;
+
+public:
+    MeshSimplifier();
+
+    MeshSimplifierSettings getSettings();
+    void setSettings(MeshSimplifierSettings settings);
+
+    MeshSimplifierStatistics getStatistics();
+
+    bool simplify(ModelData& modelData);
+
+    // error is the largest distance (in model units) a collapse moved the surface by
+    bool simplifyMesh(const std::vector<Vertex>& vertexes, const std::vector<uint32>& indexes,
+                      uint64 targetIndexCount, std::vector<uint32>& simplifiedIndexes,
+                      float& error);
+
+private:
+    void getSeamVertexes(const std::vector<Vertex>& vertexes, std::vector<uint32>& seamVertexes,
+                         std::vector<uint8>& isSeamVertex);
+    void getQuadrics(const std::vector<Vertex>& vertexes, const std::vector<uint32>& indexes,
+                     const std::vector<uint32>& seamVertexes,
+                     std::vector<MeshSimplifierQuadric>& quadrics);
+    void getVertexKinds(const std::vector<Vertex>& vertexes, const std::vector<uint32>& indexes,
+                        const std::vector<uint32>& seamVertexes,
+                        const std::vector<uint8>& isSeamVertex, std::vector<uint64>& edges,
+                        std::vector<MeshSimplifierVertexKind>& vertexKinds);
+
+    bool canCollapse(uint32 vertex, uint32 targetVertex, const std::vector<uint32>& seamVertexes,
+                     const std::vector<uint64>& edges,
+                     const std::vector<MeshSimplifierVertexKind>& vertexKinds);
+    bool isCollapseFlipping(const std::vector<Vertex>& vertexes, const std::vector<uint32>& indexes,
+                            const uint32* triangles, uint32 triangleCount, uint32 vertex,
+                            uint32 targetVertex);
+    float getAttributeError(const Vertex& vertex, const Vertex& targetVertex,
+                            float attributeScale);
+
+    bool hasEdge(const std::vector<uint64>& edges, uint32 vertex, uint32 targetVertex);
+};
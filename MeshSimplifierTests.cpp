@@ -0,0 +1,225 @@
+#include "MeshSimplifierTests.h"
+
+MeshSimplifierTests::MeshSimplifierTests() : statistics{}
+{
+}
+
+TestStatistics MeshSimplifierTests::getStatistics()
+{
+    return statistics;
+}
+
+void MeshSimplifierTests::run()
+{
+    statistics = {};
+
+    testDeterminism();
+    testLodErrors();
+    testSeamVertexes();
+    testBorderVertexes();
+}
+
+void MeshSimplifierTests::testDeterminism()
+{
+    ModelData modelData;
+    std::vector<uint32> seamVertexes;
+    getGrid(modelData, seamVertexes);
+    ModelData otherModelData = modelData;
+
+    bool result = simplify(modelData) && simplify(otherModelData);
+
+    const MeshData& meshData = modelData.meshDataItems[0];
+    const MeshData& otherMeshData = otherModelData.meshDataItems[0];
+    result = result && !meshData.lodDataItems.empty()
+        && meshData.lodDataItems.size() == otherMeshData.lodDataItems.size();
+    for (uint64 i = 0; i < meshData.lodDataItems.size() && result; i++)
+    {
+        result = meshData.lodDataItems[i].indexes == otherMeshData.lodDataItems[i].indexes
+            && meshData.lodDataItems[i].error == otherMeshData.lodDataItems[i].error;
+    }
+
+    checkTest(result, "MeshSimplifier determinism", statistics);
+}
+
+void MeshSimplifierTests::testLodErrors()
+{
+    ModelData modelData;
+    std::vector<uint32> seamVertexes;
+    getGrid(modelData, seamVertexes);
+
+    bool result = simplify(modelData);
+
+    // Every level has fewer indexes and at least the error of the one before it
+    const MeshData& meshData = modelData.meshDataItems[0];
+    uint64 indexCount = meshData.indexes.size();
+    float error = 0.0f;
+    result = result && !meshData.lodDataItems.empty();
+    for (uint64 i = 0; i < meshData.lodDataItems.size() && result; i++)
+    {
+        const MeshLodData& lodData = meshData.lodDataItems[i];
+        result = lodData.indexes.size() < indexCount && lodData.error >= error;
+
+        indexCount = lodData.indexes.size();
+        error = lodData.error;
+    }
+
+    checkTest(result, "MeshSimplifier LOD errors", statistics);
+}
+
+void MeshSimplifierTests::testSeamVertexes()
+{
+    ModelData modelData;
+    std::vector<uint32> seamVertexes;
+    getGrid(modelData, seamVertexes);
+
+    bool result = simplify(modelData);
+    for (uint64 i = 0; i < seamVertexes.size() && result; i++)
+    {
+        result = isVertexInLods(modelData.meshDataItems[0], seamVertexes[i]);
+    }
+
+    checkTest(result, "MeshSimplifier seam vertexes", statistics);
+}
+
+void MeshSimplifierTests::testBorderVertexes()
+{
+    ModelData modelData;
+    std::vector<uint32> seamVertexes;
+    getGrid(modelData, seamVertexes);
+
+    bool result = simplify(modelData);
+
+    // The corners of the grid hold its outline
+    const uint32 rowSize = MeshSimplifierTestGridSize + 1;
+    const uint32 corners[] = { 0, rowSize - 1, (rowSize - 1) * rowSize, rowSize * rowSize - 1 };
+    for (uint32 corner : corners)
+    {
+        result = result && isVertexInLods(modelData.meshDataItems[0], corner);
+    }
+
+    // Border edges of every level, used in one direction only, run along the outline
+    const float maxCoordinate = static_cast<float>(MeshSimplifierTestGridSize);
+    for (const MeshLodData& lodData : modelData.meshDataItems[0].lodDataItems)
+    {
+        std::vector<uint64> edges;
+        for (uint64 i = 0; i < lodData.indexes.size(); i++)
+        {
+            const DirectX::XMFLOAT3& position = modelData.vertexes[lodData.indexes[i]].position;
+            const DirectX::XMFLOAT3& nextPosition = modelData.vertexes[lodData.indexes[
+                i % 3 == 2 ? i - 2 : i + 1]].position;
+
+            // By position, so the seam isn't a border
+            uint64 vertex = static_cast<uint64>(position.x) * (MeshSimplifierTestGridSize + 1)
+                + static_cast<uint64>(position.z);
+            uint64 nextVertex = static_cast<uint64>(nextPosition.x) *
+                (MeshSimplifierTestGridSize + 1) + static_cast<uint64>(nextPosition.z);
+            edges.push_back(vertex << 32 | nextVertex);
+        }
+        std::sort(edges.begin(), edges.end());
+
+        for (uint64 edge : edges)
+        {
+            uint64 vertex = edge >> 32;
+            uint64 nextVertex = edge & UINT32_MAX;
+            if (std::binary_search(edges.begin(), edges.end(), nextVertex << 32 | vertex))
+            {
+                continue;
+            }
+
+            float x = static_cast<float>(vertex / (MeshSimplifierTestGridSize + 1));
+            float z = static_cast<float>(vertex % (MeshSimplifierTestGridSize + 1));
+            float nextX = static_cast<float>(nextVertex / (MeshSimplifierTestGridSize + 1));
+            float nextZ = static_cast<float>(nextVertex % (MeshSimplifierTestGridSize + 1));
+            result = result && ((x == nextX && (x == 0.0f || x == maxCoordinate))
+                                || (z == nextZ && (z == 0.0f || z == maxCoordinate)));
+        }
+    }
+
+    checkTest(result, "MeshSimplifier border vertexes", statistics);
+}
+
+void MeshSimplifierTests::getGrid(ModelData& modelData, std::vector<uint32>& seamVertexes)
+{
+    const uint32 size = MeshSimplifierTestGridSize;
+    const uint32 rowSize = size + 1;
+    const uint32 seamColumn = size / 2;
+
+    modelData = {};
+    modelData.vertexes.resize(rowSize * rowSize);
+    for (uint32 z = 0; z < rowSize; z++)
+    {
+        for (uint32 x = 0; x < rowSize; x++)
+        {
+            Vertex& vertex = modelData.vertexes[z * rowSize + x];
+            vertex.position = DirectX::XMFLOAT3(static_cast<float>(x),
+                                                std::sin(x * 0.4f) * std::cos(z * 0.3f),
+                                                static_cast<float>(z));
+            vertex.textureCoordinates = DirectX::XMFLOAT3(static_cast<float>(x) / size,
+                                                          static_cast<float>(z) / size, 0.0f);
+            vertex.normal = DirectX::XMFLOAT3(0.0f, 1.0f, 0.0f);
+        }
+    }
+
+    // The right half starts its texture over
+    seamVertexes.clear();
+    std::vector<uint32> rightSeamVertexes(rowSize);
+    for (uint32 z = 0; z < rowSize; z++)
+    {
+        uint32 vertex = z * rowSize + seamColumn;
+
+        Vertex rightVertex = modelData.vertexes[vertex];
+        rightVertex.textureCoordinates.x = 0.0f;
+
+        rightSeamVertexes[z] = static_cast<uint32>(modelData.vertexes.size());
+        modelData.vertexes.push_back(rightVertex);
+
+        seamVertexes.push_back(vertex);
+        seamVertexes.push_back(rightSeamVertexes[z]);
+    }
+
+    MeshData meshData = {};
+    meshData.name = "Grid";
+    for (uint32 z = 0; z < size; z++)
+    {
+        for (uint32 x = 0; x < size; x++)
+        {
+            uint32 quad[] = { z * rowSize + x, z * rowSize + x + 1, (z + 1) * rowSize + x,
+                              (z + 1) * rowSize + x + 1 };
+            if (x == seamColumn)
+            {
+                quad[0] = rightSeamVertexes[z];
+                quad[2] = rightSeamVertexes[z + 1];
+            }
+
+            const uint32 quadIndexes[] = { quad[0], quad[2], quad[1], quad[1], quad[2],
+                                           quad[3] };
+            meshData.indexes.insert(meshData.indexes.end(), quadIndexes, quadIndexes + 6);
+        }
+    }
+    modelData.meshDataItems.push_back(std::move(meshData));
+}
+
+bool MeshSimplifierTests::simplify(ModelData& modelData)
+{
+    MeshSimplifier meshSimplifier;
+    MeshSimplifierSettings settings = meshSimplifier.getSettings();
+    settings.lodCount = 3;
+    settings.indexRatio = 0.5f;
+    meshSimplifier.setSettings(settings);
+
+    return meshSimplifier.simplify(modelData);
+}
+
+bool MeshSimplifierTests::isVertexInLods(const MeshData& meshData, uint32 vertex)
+{
+    for (const MeshLodData& lodData : meshData.lodDataItems)
+    {
+        if (std::find(lodData.indexes.begin(), lodData.indexes.end(), vertex) ==
+            lodData.indexes.end())
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
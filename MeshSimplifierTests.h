@@ -0,0 +1,45 @@
+#pragma once
+#include <DirectXMath.h>
+
+#include <cmath>
+
+#include <vector>
+#include <algorithm>
+
+#include "Vertex.h"
+#include "MeshSimplifier.h"
+
+#include "IntUtility.h"
+#include "MeshSimplifierUtility.h"
+#include "ModelFileParserUtility.h"
+#include "TestUtility.h"
+
+// Quads per side of the test grid, its middle column of vertexes is a UV seam
+constexpr uint32 MeshSimplifierTestGridSize = 24;
+
+// Simplifies a wavy grid with a UV seam down its middle: the levels only depend on the input,
+// their errors don't decrease from one level to the next, seam vertexes are never removed and
+// the outline of the grid stays in place
+class MeshSimplifierTests
+{
+    TestStatistics statistics;
+
+public:
+    MeshSimplifierTests();
+
+    TestStatistics getStatistics();
+
+    void run();
+
+private:
+    void testDeterminism();
+    void testLodErrors();
+    void testSeamVertexes();
+    void testBorderVertexes();
+
+    // The seam vertexes of the right half repeat the positions of the left half's ones
+    void getGrid(ModelData& modelData, std::vector<uint32>& seamVertexes);
+    bool simplify(ModelData& modelData);
+    // Whether the index list of every level has the vertex
+    bool isVertexInLods(const MeshData& meshData, uint32 vertex);
+};
@@ -0,0 +1,169 @@
+#pragma once
+#include <DirectXMath.h>
+
+#include <vector>
+
+#include <cmath>
+
+#include <string>
+
+#include "IntUtility.h"
+
+constexpr float MeshSimplifierBorderWeight = 10.0f;
+
+// A collapse is rejected when it turns a triangle by more than about 75 degrees
+constexpr float MeshSimplifierMinNormalCosine = 0.25f;
+
+// A border vertex where the border turns by more than 45 degrees is a corner and never moves
+constexpr float MeshSimplifierMinBorderCosine = 0.70710678f;
+
+// A level that keeps more than this share of the previous level's indexes ends the chain
+constexpr float MeshSimplifierMinIndexReduction = 0.95f;
+
+struct MeshSimplifierSettings
+{
+    uint32 lodCount; // levels after the full mesh
+    float indexRatio; // index count of a level relative to the previous one
+
+    // Attribute differences are weighted relative to the size of the mesh, so a weight of 1 makes
+    // a UV (or normal) difference of 1 cost as much as moving the surface by the mesh's diagonal
+    float textureCoordinatesWeight;
+    float normalWeight;
+};
+
+struct MeshSimplificationStatistics
+{
+    std::string meshName;
+
+    std::vector<uint64> lodIndexCounts; // full mesh first
+    std::vector<float> lodErrors; // model units
+};
+
+struct MeshSimplifierStatistics
+{
+    std::vector<MeshSimplificationStatistics> meshSimplificationStatisticsItems;
+
+    double simplificationTime; // s
+};
+
+enum class MeshSimplifierVertexKind : uint8
+{
+    Undefined,
+
+    Manifold, // can collapse to any neighbour
+    Border, // can collapse along its border only
+    Locked, // on a UV or normal seam or on non-manifold topology, never removed
+};
+
+// Area-weighted sum of squared distances to planes, as a symmetric 4x4 matrix
+struct MeshSimplifierQuadric
+{
+    double a00, a11, a22, a01, a02, a12;
+    double b0, b1, b2;
+    double c;
+
+    double weight;
+};
+
+struct MeshSimplifierCollapse
+{
+    uint32 vertex;
+    uint32 targetVertex;
+
+    float cost; // squared model units
+    float positionError; // squared model units, the part of the cost not coming from attributes
+};
+
+inline MeshSimplifierQuadric getPlaneQuadric(DirectX::XMFLOAT3 normal, DirectX::XMFLOAT3 point,
+                                             double weight)
+{
+    double a = normal.x;
+    double b = normal.y;
+    double c = normal.z;
+    double d = -(a * point.x + b * point.y + c * point.z);
+
+    MeshSimplifierQuadric quadric = {};
+    quadric.a00 = a * a * weight;
+    quadric.a11 = b * b * weight;
+    quadric.a22 = c * c * weight;
+    quadric.a01 = a * b * weight;
+    quadric.a02 = a * c * weight;
+    quadric.a12 = b * c * weight;
+    quadric.b0 = a * d * weight;
+    quadric.b1 = b * d * weight;
+    quadric.b2 = c * d * weight;
+    quadric.c = d * d * weight;
+    quadric.weight = weight;
+
+    return quadric;
+}
+
+inline void addQuadric(MeshSimplifierQuadric& quadric, const MeshSimplifierQuadric& addend)
+{
+    quadric.a00 += addend.a00;
+    quadric.a11 += addend.a11;
+    quadric.a22 += addend.a22;
+    quadric.a01 += addend.a01;
+    quadric.a02 += addend.a02;
+    quadric.a12 += addend.a12;
+    quadric.b0 += addend.b0;
+    quadric.b1 += addend.b1;
+    quadric.b2 += addend.b2;
+    quadric.c += addend.c;
+    quadric.weight += addend.weight;
+}
+
+// Mean squared distance from the point to the planes of the quadric
+inline double evaluateQuadric(const MeshSimplifierQuadric& quadric, DirectX::XMFLOAT3 point)
+{
+    if (quadric.weight <= 0.0)
+    {
+        return 0.0;
+    }
+
+    double x = point.x;
+    double y = point.y;
+    double z = point.z;
+
+    double error = quadric.a00 * x * x + quadric.a11 * y * y + quadric.a22 * z * z +
+        2.0 * (quadric.a01 * x * y + quadric.a02 * x * z + quadric.a12 * y * z) +
+        2.0 * (quadric.b0 * x + quadric.b1 * y + quadric.b2 * z) + quadric.c;
+    if (error < 0.0)
+    {
+        return 0.0;
+    }
+
+    return error / quadric.weight;
+}
+
+inline DirectX::XMFLOAT3 getTriangleNormal(DirectX::XMFLOAT3 a, DirectX::XMFLOAT3 b,
+                                           DirectX::XMFLOAT3 c)
+{
+    float abX = b.x - a.x;
+    float abY = b.y - a.y;
+    float abZ = b.z - a.z;
+    float acX = c.x - a.x;
+    float acY = c.y - a.y;
+    float acZ = c.z - a.z;
+
+    return DirectX::XMFLOAT3(abY * acZ - abZ * acY, abZ * acX - abX * acZ, abX * acY - abY * acX);
+}
+
+inline float getDot(DirectX::XMFLOAT3 a, DirectX::XMFLOAT3 b)
+{
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+// Whether the border turns at the vertex by more than MeshSimplifierMinBorderCosine allows
+inline bool isBorderCorner(DirectX::XMFLOAT3 previousPosition, DirectX::XMFLOAT3 position,
+                           DirectX::XMFLOAT3 nextPosition)
+{
+    DirectX::XMFLOAT3 edge(position.x - previousPosition.x, position.y - previousPosition.y,
+                           position.z - previousPosition.z);
+    DirectX::XMFLOAT3 nextEdge(nextPosition.x - position.x, nextPosition.y - position.y,
+                               nextPosition.z - position.z);
+
+    float lengths = std::sqrt(getDot(edge, edge) * getDot(nextEdge, nextEdge));
+
+    return getDot(edge, nextEdge) < MeshSimplifierMinBorderCosine * lengths;
+}
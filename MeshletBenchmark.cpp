@@ -0,0 +1,178 @@
+#include "MeshletBenchmark.h"
+
+MeshletBenchmark::MeshletBenchmark() : settings{}
+{
+    settings.repeatCount = 1;
+}
+
+BenchmarkSettings MeshletBenchmark::getSettings()
+{
+    return settings;
+}
+
+void MeshletBenchmark::setSettings(BenchmarkSettings settings)
+{
+    this->settings = settings;
+}
+
+bool MeshletBenchmark::run(const std::string& filename)
+{
+    ModelData modelData;
+    bool result = parseFile(filename, modelData);
+    if (!result)
+    {
+        std::printf("Failed to parse %s\n", filename.c_str());
+
+        return false;
+    }
+
+    MeshletBuilderStatistics builderStatistics = {};
+    result = buildMeshlets(modelData, builderStatistics);
+    if (!result)
+    {
+        std::printf("Failed to build the meshlets of %s\n", filename.c_str());
+
+        return false;
+    }
+
+    MeshletCullerStatistics cullerStatistics = {};
+    result = cullMeshlets(modelData, cullerStatistics);
+    if (!result)
+    {
+        std::printf("Failed to cull the meshlets of %s\n", filename.c_str());
+
+        return false;
+    }
+
+    std::printf("Meshlets: %s\n", filename.c_str());
+    std::printf("  meshlets: %llu, %.1f vertexes and %.1f triangles per meshlet\n",
+                static_cast<unsigned long long>(builderStatistics.meshletCount),
+                builderStatistics.meshletCount > 0
+                    ? static_cast<double>(builderStatistics.meshletVertexCount) /
+                        builderStatistics.meshletCount : 0.0,
+                builderStatistics.meshletCount > 0
+                    ? static_cast<double>(builderStatistics.triangleCount) /
+                        builderStatistics.meshletCount : 0.0);
+    std::printf("  building: %.3f s, %.0f triangles/ms\n", builderStatistics.buildingTime,
+                builderStatistics.buildingTime > 0.0
+                    ? builderStatistics.triangleCount / (builderStatistics.buildingTime * 1000.0)
+                    : 0.0);
+    std::printf("  culling: %u views, %llu of %llu meshlets culled (%llu frustum, %llu backface)"
+                "\n", MeshletBenchmarkViewCount,
+                static_cast<unsigned long long>(cullerStatistics.frustumCulledMeshletCount +
+                                                cullerStatistics.backfaceCulledMeshletCount),
+                static_cast<unsigned long long>(cullerStatistics.meshletCount),
+                static_cast<unsigned long long>(cullerStatistics.frustumCulledMeshletCount),
+                static_cast<unsigned long long>(cullerStatistics.backfaceCulledMeshletCount));
+    std::printf("  culled triangles: %llu of %llu, %.3f ms, %.0f culled triangles/ms\n",
+                static_cast<unsigned long long>(cullerStatistics.culledTriangleCount),
+                static_cast<unsigned long long>(cullerStatistics.triangleCount),
+                cullerStatistics.cullingTime * 1000.0, cullerStatistics.throughput);
+
+    return true;
+}
+
+bool MeshletBenchmark::parseFile(const std::string& filename, ModelData& modelData)
+{
+    // Meshlets follow the index order, so the meshes are vertex cache optimized first like
+    // ModelFileParser does before building them
+    ModelFileParser modelFileParser;
+    ModelFileParserSettings parserSettings = modelFileParser.getSettings();
+    parserSettings.threadCount = settings.threadCount;
+    parserSettings.isCacheEnabled = false;
+    parserSettings.isOptimizationEnabled = true;
+    parserSettings.isSimplificationEnabled = false;
+    parserSettings.isMeshletGenerationEnabled = false;
+    parserSettings.isMeshMergingEnabled = false;
+    modelFileParser.setSettings(parserSettings);
+
+    return modelFileParser.parseFile(filename, modelData);
+}
+
+bool MeshletBenchmark::buildMeshlets(ModelData& modelData, MeshletBuilderStatistics& statistics)
+{
+    MeshletBuilder meshletBuilder;
+    for (uint32 i = 0; i < settings.repeatCount; i++)
+    {
+        bool result = meshletBuilder.build(modelData);
+        if (!result)
+        {
+            return false;
+        }
+
+        MeshletBuilderStatistics runStatistics = meshletBuilder.getStatistics();
+        if (i == 0 || runStatistics.buildingTime < statistics.buildingTime)
+        {
+            statistics = runStatistics;
+        }
+    }
+
+    return true;
+}
+
+bool MeshletBenchmark::cullMeshlets(const ModelData& modelData,
+                                    MeshletCullerStatistics& statistics)
+{
+    if (isBoundsEmpty(modelData.bounds))
+    {
+        return false;
+    }
+
+    DirectX::XMVECTOR center = DirectX::XMLoadFloat3(&modelData.bounds.center);
+    float distance = modelData.bounds.radius * MeshletBenchmarkViewDistance;
+    DirectX::XMMATRIX projectionMatrix = DirectX::XMMatrixPerspectiveFovLH(
+        MeshletBenchmarkFieldOfView, MeshletBenchmarkAspectRatio, distance * 0.01f,
+        distance * 4.0f);
+
+    MeshletCuller meshletCuller;
+    std::vector<uint32> indexes;
+    for (uint32 i = 0; i < settings.repeatCount; i++)
+    {
+        MeshletCullerStatistics runStatistics = {};
+        for (uint32 j = 0; j < MeshletBenchmarkViewCount; j++)
+        {
+            float angle = DirectX::XM_2PI * j / MeshletBenchmarkViewCount;
+            DirectX::XMVECTOR viewPosition = DirectX::XMVectorAdd(center, DirectX::XMVectorSet(
+                std::cos(angle) * distance, distance * 0.25f, std::sin(angle) * distance, 0.0f));
+            DirectX::XMMATRIX viewMatrix = DirectX::XMMatrixLookAtLH(
+                viewPosition, center, DirectX::XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+            // The model matrix is the identity, the views are in the space of the model
+            DirectX::XMMATRIX mvpMatrix = DirectX::XMMatrixMultiply(viewMatrix, projectionMatrix);
+
+            DirectX::XMFLOAT3 viewPositionFloat3 = {};
+            DirectX::XMStoreFloat3(&viewPositionFloat3, viewPosition);
+
+            for (const MeshData& meshData : modelData.meshDataItems)
+            {
+                bool result = meshletCuller.cull(meshData, mvpMatrix, viewPositionFloat3,
+                                                 indexes);
+                if (!result)
+                {
+                    return false;
+                }
+
+                MeshletCullerStatistics cullerStatistics = meshletCuller.getStatistics();
+                runStatistics.meshletCount += cullerStatistics.meshletCount;
+                runStatistics.frustumCulledMeshletCount +=
+                    cullerStatistics.frustumCulledMeshletCount;
+                runStatistics.backfaceCulledMeshletCount +=
+                    cullerStatistics.backfaceCulledMeshletCount;
+                runStatistics.triangleCount += cullerStatistics.triangleCount;
+                runStatistics.culledTriangleCount += cullerStatistics.culledTriangleCount;
+                runStatistics.cullingTime += cullerStatistics.cullingTime;
+            }
+        }
+        if (runStatistics.cullingTime > 0.0)
+        {
+            runStatistics.throughput = runStatistics.culledTriangleCount /
+                (runStatistics.cullingTime * 1000.0);
+        }
+
+        if (i == 0 || runStatistics.cullingTime < statistics.cullingTime)
+        {
+            statistics = runStatistics;
+        }
+    }
+
+    return true;
+}
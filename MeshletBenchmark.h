@@ -0,0 +1,40 @@
+#pragma once
+#include <DirectXMath.h>
+
+#include <cmath>
+#include <cstdio>
+
+#include <string>
+#include <vector>
+
+#include "MeshletBuilder.h"
+#include "MeshletCuller.h"
+#include "ModelFileParser.h"
+
+#include "BenchmarkUtility.h"
+#include "BoundsUtility.h"
+#include "IntUtility.h"
+#include "MeshletUtility.h"
+#include "ModelFileParserUtility.h"
+
+// Builds the meshlets of an OBJ file's vertex cache optimized meshes and culls them from views
+// around the model, printing the building time and the triangles rejected per millisecond
+class MeshletBenchmark
+{
+    BenchmarkSettings settings;
+
+public:
+    MeshletBenchmark();
+
+    BenchmarkSettings getSettings();
+    void setSettings(BenchmarkSettings settings);
+
+    bool run(const std::string& filename);
+
+private:
+    bool parseFile(const std::string& filename, ModelData& modelData);
+    // Of the fastest run
+    bool buildMeshlets(ModelData& modelData, MeshletBuilderStatistics& statistics);
+    // Summed over every view and mesh of the fastest run
+    bool cullMeshlets(const ModelData& modelData, MeshletCullerStatistics& statistics);
+};
@@ -0,0 +1,243 @@
+#include "MeshletBuilder.h"
+
+MeshletBuilder::MeshletBuilder() : statistics{}
+{
+}
+
+MeshletBuilderStatistics MeshletBuilder::getStatistics()
+{
+    return statistics;
+}
+
+bool MeshletBuilder::build(ModelData& modelData)
+{
+    statistics = {};
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    for (MeshData& meshData : modelData.meshDataItems)
+    {
+        bool result = buildMeshlets(modelData.vertexes, meshData);
+        if (!result)
+        {
+            return false;
+        }
+
+        statistics.meshletCount += meshData.meshletDataItems.size();
+        statistics.meshletVertexCount += meshData.meshletVertexes.size();
+        statistics.triangleCount += meshData.meshletTriangles.size() / 3;
+    }
+
+    std::chrono::duration<double> buildingTime = std::chrono::steady_clock::now() - startTime;
+    statistics.buildingTime = buildingTime.count();
+
+    return true;
+}
+
+bool MeshletBuilder::buildMeshlets(const std::vector<Vertex>& vertexes, MeshData& meshData)
+{
+    meshData.meshletDataItems.clear();
+    meshData.meshletVertexes.clear();
+    meshData.meshletTriangles.clear();
+
+    const std::vector<uint32>& indexes = meshData.indexes;
+    if (indexes.size() % 3 != 0)
+    {
+        return false;
+    }
+
+    for (uint32 index : indexes)
+    {
+        if (index >= vertexes.size())
+        {
+            return false;
+        }
+    }
+
+    meshData.meshletTriangles.reserve(indexes.size());
+
+    // Index of a model vertex in the current meshlet, valid while its meshlet number matches
+    std::vector<uint8> meshletIndexes(vertexes.size());
+    std::vector<uint32> meshletNumbers(vertexes.size(), UINT32_MAX);
+
+    MeshletData meshletData = {};
+    for (uint64 i = 0; i < indexes.size(); i += 3)
+    {
+        uint32 meshletNumber = static_cast<uint32>(meshData.meshletDataItems.size());
+
+        uint32 newVertexCount = 0;
+        for (int32 j = 0; j < 3; j++)
+        {
+            if (meshletNumbers[indexes[i + j]] != meshletNumber)
+            {
+                newVertexCount++;
+            }
+        }
+
+        if (meshletData.vertexCount + newVertexCount > MeshletMaxVertexCount ||
+            meshletData.triangleCount == MeshletMaxTriangleCount)
+        {
+            computeBounds(vertexes, meshData, meshletData);
+            meshData.meshletDataItems.push_back(meshletData);
+
+            meshletData = {};
+            meshletData.vertexOffset = static_cast<uint32>(meshData.meshletVertexes.size());
+            meshletData.triangleOffset = static_cast<uint32>(meshData.meshletTriangles.size() / 3);
+
+            meshletNumber++;
+        }
+
+        for (int32 j = 0; j < 3; j++)
+        {
+            uint32 index = indexes[i + j];
+            if (meshletNumbers[index] != meshletNumber)
+            {
+                meshletNumbers[index] = meshletNumber;
+                meshletIndexes[index] = static_cast<uint8>(meshletData.vertexCount);
+
+                meshData.meshletVertexes.push_back(index);
+                meshletData.vertexCount++;
+            }
+
+            meshData.meshletTriangles.push_back(meshletIndexes[index]);
+        }
+
+        meshletData.triangleCount++;
+    }
+
+    if (meshletData.triangleCount > 0)
+    {
+        computeBounds(vertexes, meshData, meshletData);
+        meshData.meshletDataItems.push_back(meshletData);
+    }
+
+    return true;
+}
+
+void MeshletBuilder::computeBounds(const std::vector<Vertex>& vertexes, const MeshData& meshData,
+                                   MeshletData& meshletData)
+{
+    const uint32* meshletVertexes = &meshData.meshletVertexes[meshletData.vertexOffset];
+    const uint8* meshletTriangles = &meshData.meshletTriangles[meshletData.triangleOffset * 3];
+
+    // Sphere around the center of the bounding box
+    DirectX::XMVECTOR minPosition = DirectX::XMVectorReplicate(FLT_MAX);
+    DirectX::XMVECTOR maxPosition = DirectX::XMVectorReplicate(-FLT_MAX);
+    for (uint32 i = 0; i < meshletData.vertexCount; i++)
+    {
+        DirectX::XMVECTOR position = DirectX::XMLoadFloat3(
+            &vertexes[meshletVertexes[i]].position);
+
+        minPosition = DirectX::XMVectorMin(minPosition, position);
+        maxPosition = DirectX::XMVectorMax(maxPosition, position);
+    }
+
+    DirectX::XMVECTOR center = DirectX::XMVectorScale(
+        DirectX::XMVectorAdd(minPosition, maxPosition), 0.5f);
+
+    float radiusSquared = 0.0f;
+    for (uint32 i = 0; i < meshletData.vertexCount; i++)
+    {
+        DirectX::XMVECTOR position = DirectX::XMLoadFloat3(
+            &vertexes[meshletVertexes[i]].position);
+
+        float distanceSquared = DirectX::XMVectorGetX(DirectX::XMVector3LengthSq(
+            DirectX::XMVectorSubtract(position, center)));
+        if (distanceSquared > radiusSquared)
+        {
+            radiusSquared = distanceSquared;
+        }
+    }
+
+    DirectX::XMStoreFloat3(&meshletData.center, center);
+    meshletData.radius = std::sqrt(radiusSquared);
+
+    // The cone axis is the mean triangle normal, the cutoff comes from the normal furthest from it
+    std::vector<DirectX::XMVECTOR> normals;
+    normals.reserve(meshletData.triangleCount);
+
+    DirectX::XMVECTOR axis = DirectX::XMVectorZero();
+    for (uint32 i = 0; i < meshletData.triangleCount; i++)
+    {
+        DirectX::XMVECTOR a = DirectX::XMLoadFloat3(
+            &vertexes[meshletVertexes[meshletTriangles[i * 3]]].position);
+        DirectX::XMVECTOR b = DirectX::XMLoadFloat3(
+            &vertexes[meshletVertexes[meshletTriangles[i * 3 + 1]]].position);
+        DirectX::XMVECTOR c = DirectX::XMLoadFloat3(
+            &vertexes[meshletVertexes[meshletTriangles[i * 3 + 2]]].position);
+
+        // Clockwise triangles face the viewer in Direct3D
+        DirectX::XMVECTOR normal = DirectX::XMVector3Cross(DirectX::XMVectorSubtract(b, a),
+                                                           DirectX::XMVectorSubtract(c, a));
+        if (DirectX::XMVectorGetX(DirectX::XMVector3LengthSq(normal)) == 0.0f)
+        {
+            continue;
+        }
+
+        normal = DirectX::XMVector3Normalize(normal);
+        normals.push_back(normal);
+
+        axis = DirectX::XMVectorAdd(axis, normal);
+    }
+
+    meshletData.coneApex = meshletData.center;
+    meshletData.coneAxis = DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f);
+    meshletData.coneCutoff = 1.0f;
+
+    if (normals.empty() || DirectX::XMVectorGetX(DirectX::XMVector3LengthSq(axis)) == 0.0f)
+    {
+        return;
+    }
+
+    axis = DirectX::XMVector3Normalize(axis);
+
+    float minCosine = 1.0f;
+    for (DirectX::XMVECTOR normal : normals)
+    {
+        float cosine = DirectX::XMVectorGetX(DirectX::XMVector3Dot(normal, axis));
+        if (cosine < minCosine)
+        {
+            minCosine = cosine;
+        }
+    }
+
+    DirectX::XMStoreFloat3(&meshletData.coneAxis, axis);
+    if (minCosine <= MeshletMinConeCosine)
+    {
+        return;
+    }
+
+    // The apex is moved back along the axis until every triangle plane is in front of it
+    float maxDistance = 0.0f;
+    for (uint32 i = 0, j = 0; i < meshletData.triangleCount; i++)
+    {
+        DirectX::XMVECTOR a = DirectX::XMLoadFloat3(
+            &vertexes[meshletVertexes[meshletTriangles[i * 3]]].position);
+        DirectX::XMVECTOR b = DirectX::XMLoadFloat3(
+            &vertexes[meshletVertexes[meshletTriangles[i * 3 + 1]]].position);
+        DirectX::XMVECTOR c = DirectX::XMLoadFloat3(
+            &vertexes[meshletVertexes[meshletTriangles[i * 3 + 2]]].position);
+
+        DirectX::XMVECTOR normal = DirectX::XMVector3Cross(DirectX::XMVectorSubtract(b, a),
+                                                           DirectX::XMVectorSubtract(c, a));
+        if (DirectX::XMVectorGetX(DirectX::XMVector3LengthSq(normal)) == 0.0f)
+        {
+            continue;
+        }
+
+        normal = normals[j];
+        j++;
+
+        float distance = DirectX::XMVectorGetX(DirectX::XMVector3Dot(
+                DirectX::XMVectorSubtract(center, a), normal)) /
+            DirectX::XMVectorGetX(DirectX::XMVector3Dot(axis, normal));
+        if (distance > maxDistance)
+        {
+            maxDistance = distance;
+        }
+    }
+
+    DirectX::XMStoreFloat3(&meshletData.coneApex, DirectX::XMVectorSubtract(
+                               center, DirectX::XMVectorScale(axis, maxDistance)));
+    meshletData.coneCutoff = std::sqrt(1.0f - minCosine * minCosine);
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include <DirectXMath.h>
+
+#include <vector>
+
+#include <cmath>
+#include <cfloat>
+
+#include <chrono>
+
+#include "Vertex.h"
+
+#include "ModelFileParserUtility.h"
+#include "MeshletUtility.h"
+
+// Splits every mesh into meshlets of at most 64 vertexes and 124 triangles following the index
+// order, so meshlets of a vertex cache optimized mesh come out compact
+class MeshletBuilder
+{
+    MeshletBuilderStatistics statistics;
+
+public:
+    MeshletBuilder();
+
+    MeshletBuilderStatistics getStatistics();
+
+    bool build(ModelData& modelData);
+    bool buildMeshlets(const std::vector<Vertex>& vertexes, MeshData& meshData);
+
+private:
+    void computeBounds(const std::vector<Vertex>& vertexes, const MeshData& meshData,
+                       MeshletData& meshletData);
+};
@@ -0,0 +1,118 @@
+#include "MeshletCuller.h"
+
+MeshletCuller::MeshletCuller() : statistics{}
+{
+}
+
+MeshletCullerStatistics MeshletCuller::getStatistics()
+{
+    return statistics;
+}
+
+bool MeshletCuller::cull(const MeshData& meshData, DirectX::XMMATRIX mvpMatrix,
+                         DirectX::XMFLOAT3 viewPosition, std::vector<uint32>& indexes)
+{
+    statistics = {};
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    indexes.clear();
+    indexes.reserve(meshData.meshletTriangles.size());
+
+    DirectX::XMFLOAT4 planes[6] = {};
+    getFrustumPlanes(mvpMatrix, planes);
+
+    DirectX::XMVECTOR viewPositionVector = DirectX::XMLoadFloat3(&viewPosition);
+
+    for (const MeshletData& meshletData : meshData.meshletDataItems)
+    {
+        if (meshletData.vertexOffset + meshletData.vertexCount > meshData.meshletVertexes.size())
+        {
+            return false;
+        }
+        if ((meshletData.triangleOffset + meshletData.triangleCount) * 3ull >
+            meshData.meshletTriangles.size())
+        {
+            return false;
+        }
+
+        statistics.meshletCount++;
+        statistics.triangleCount += meshletData.triangleCount;
+
+        if (!isMeshletInFrustum(meshletData, planes))
+        {
+            statistics.frustumCulledMeshletCount++;
+            statistics.culledTriangleCount += meshletData.triangleCount;
+
+            continue;
+        }
+        if (isMeshletBackfacing(meshletData, viewPositionVector))
+        {
+            statistics.backfaceCulledMeshletCount++;
+            statistics.culledTriangleCount += meshletData.triangleCount;
+
+            continue;
+        }
+
+        const uint32* meshletVertexes = &meshData.meshletVertexes[meshletData.vertexOffset];
+        const uint8* meshletTriangles = &meshData.meshletTriangles[meshletData.triangleOffset * 3];
+        for (uint32 i = 0; i < meshletData.triangleCount * 3; i++)
+        {
+            if (meshletTriangles[i] >= meshletData.vertexCount)
+            {
+                return false;
+            }
+
+            indexes.push_back(meshletVertexes[meshletTriangles[i]]);
+        }
+    }
+
+    std::chrono::duration<double> cullingTime = std::chrono::steady_clock::now() - startTime;
+    statistics.cullingTime = cullingTime.count();
+
+    if (statistics.cullingTime > 0.0)
+    {
+        statistics.throughput = statistics.culledTriangleCount / (statistics.cullingTime * 1000.0);
+    }
+
+    return true;
+}
+
+bool MeshletCuller::isMeshletInFrustum(const MeshletData& meshletData,
+                                       const DirectX::XMFLOAT4 planes[6])
+{
+    for (int32 i = 0; i < 6; i++)
+    {
+        const DirectX::XMFLOAT4& plane = planes[i];
+
+        float distance = plane.x * meshletData.center.x + plane.y * meshletData.center.y +
+            plane.z * meshletData.center.z + plane.w;
+        if (distance < -meshletData.radius)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool MeshletCuller::isMeshletBackfacing(const MeshletData& meshletData,
+                                        DirectX::XMVECTOR viewPosition)
+{
+    if (meshletData.coneCutoff >= 1.0f)
+    {
+        return false;
+    }
+
+    DirectX::XMVECTOR direction = DirectX::XMVectorSubtract(
+        DirectX::XMLoadFloat3(&meshletData.coneApex), viewPosition);
+    if (DirectX::XMVectorGetX(DirectX::XMVector3LengthSq(direction)) == 0.0f)
+    {
+        return false;
+    }
+
+    float cosine = DirectX::XMVectorGetX(DirectX::XMVector3Dot(
+        DirectX::XMVector3Normalize(direction), DirectX::XMLoadFloat3(&meshletData.coneAxis)));
+
+    return cosine >= meshletData.coneCutoff;
+}
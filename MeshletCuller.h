@@ -0,0 +1,29 @@
+#pragma once
+#include <DirectXMath.h>
+
+#include <vector>
+
+#include <chrono>
+
+#include "ModelFileParserUtility.h"
+#include "MeshletUtility.h"
+
+// Rejects meshlets outside of the view frustum or facing away from the viewer and writes the
+// triangles of the rest into a compacted index list for a single draw
+class MeshletCuller
+{
+    MeshletCullerStatistics statistics;
+
+public:
+    MeshletCuller();
+
+    MeshletCullerStatistics getStatistics();
+
+    // viewPosition is in the space of the model, the one mvpMatrix transforms from
+    bool cull(const MeshData& meshData, DirectX::XMMATRIX mvpMatrix,
+              DirectX::XMFLOAT3 viewPosition, std::vector<uint32>& indexes);
+
+private:
+    bool isMeshletInFrustum(const MeshletData& meshletData, const DirectX::XMFLOAT4 planes[6]);
+    bool isMeshletBackfacing(const MeshletData& meshletData, DirectX::XMVECTOR viewPosition);
+};
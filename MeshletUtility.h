@@ -0,0 +1,72 @@
+#pragma once
+#include <DirectXMath.h>
+
+#include <cmath>
+
+#include "IntUtility.h"
+
+constexpr uint32 MeshletMaxVertexCount = 64;
+constexpr uint32 MeshletMaxTriangleCount = 124;
+
+// Cones wider than this are never backface-culled, too little of the view space would reject them
+constexpr float MeshletMinConeCosine = 0.1f;
+
+struct MeshletBuilderStatistics
+{
+    uint64 meshletCount;
+    uint64 meshletVertexCount; // vertexes shared by meshlets are counted once per meshlet
+    uint64 triangleCount;
+
+    double buildingTime; // s
+};
+
+struct MeshletCullerStatistics
+{
+    uint64 meshletCount;
+    uint64 frustumCulledMeshletCount;
+    uint64 backfaceCulledMeshletCount;
+
+    uint64 triangleCount;
+    uint64 culledTriangleCount;
+
+    double cullingTime; // s
+    double throughput; // culled triangles/ms
+};
+
+// Frustum planes of a (model-)view-projection matrix, pointing inwards and normalized, in the
+// space the matrix transforms from: left, right, bottom, top, near, far
+inline void getFrustumPlanes(DirectX::XMMATRIX mvpMatrix, DirectX::XMFLOAT4 planes[6])
+{
+    DirectX::XMFLOAT4X4 matrix = {};
+    DirectX::XMStoreFloat4x4(&matrix, mvpMatrix);
+
+    for (int32 i = 0; i < 6; i++)
+    {
+        int32 column = i / 2;
+        float sign = i % 2 == 0 ? 1.0f : -1.0f;
+
+        DirectX::XMFLOAT4& plane = planes[i];
+        if (i == 4)
+        {
+            // Direct3D clip z starts at 0
+            plane = DirectX::XMFLOAT4(matrix.m[0][2], matrix.m[1][2], matrix.m[2][2],
+                                      matrix.m[3][2]);
+        }
+        else
+        {
+            plane = DirectX::XMFLOAT4(matrix.m[0][3] + sign * matrix.m[0][column],
+                                      matrix.m[1][3] + sign * matrix.m[1][column],
+                                      matrix.m[2][3] + sign * matrix.m[2][column],
+                                      matrix.m[3][3] + sign * matrix.m[3][column]);
+        }
+
+        float length = std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+        if (length > 0.0f)
+        {
+            plane.x /= length;
+            plane.y /= length;
+            plane.z /= length;
+            plane.w /= length;
+        }
+    }
+}
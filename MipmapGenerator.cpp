@@ -0,0 +1,604 @@
+#include "MipmapGenerator.h"
+
+MipmapGenerator::MipmapGenerator() : settings{}, statistics{}
+{
+    settings.filter = MipmapFilter::Kaiser;
+    settings.colorSpace = MipmapColorSpace::Undefined;
+    settings.instructionSet = CpuInstructionSet::Undefined;
+    settings.threadCount = 1;
+}
+
+MipmapGeneratorSettings MipmapGenerator::getSettings()
+{
+    return settings;
+}
+
+void MipmapGenerator::setSettings(MipmapGeneratorSettings settings)
+{
+    this->settings = settings;
+}
+
+MipmapGeneratorStatistics MipmapGenerator::getStatistics()
+{
+    return statistics;
+}
+
+bool MipmapGenerator::generateMipmaps(const ImageData& imageData, ImageData& mipmappedImageData)
+{
+    statistics = {};
+
+    if (!isMipmapGeneratorFormat(imageData.format))
+    {
+        return false;
+    }
+    if (imageData.depth > 1 || imageData.width == 0 || imageData.height == 0)
+    {
+        return false;
+    }
+
+    uint64 subresourceCount = static_cast<uint64>(imageData.mipmapLevels) * imageData.arraySize;
+    if (subresourceCount == 0 || imageData.subresourceDataItems.size() != subresourceCount)
+    {
+        return false;
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    if (srgbToLinearTable.empty())
+    {
+        initializeSrgbTables();
+    }
+
+    bool isSrgb = settings.colorSpace == MipmapColorSpace::Srgb;
+    if (settings.colorSpace == MipmapColorSpace::Undefined)
+    {
+        isSrgb = isMipmapGeneratorSrgbFormat(imageData.format);
+    }
+
+    MipmapFilter filter = settings.filter;
+    if (filter == MipmapFilter::Undefined)
+    {
+        filter = MipmapFilter::Box;
+    }
+
+    uint32 mipmapLevels = 1;
+    while (getImageMipmapSize(imageData.width, mipmapLevels - 1) > 1
+        || getImageMipmapSize(imageData.height, mipmapLevels - 1) > 1)
+    {
+        mipmapLevels++;
+    }
+
+    ImageData mipmappedData = {};
+    mipmappedData.width = imageData.width;
+    mipmappedData.height = imageData.height;
+    mipmappedData.depth = 1;
+    mipmappedData.format = imageData.format;
+    mipmappedData.mipmapLevels = mipmapLevels;
+    mipmappedData.arraySize = imageData.arraySize;
+    mipmappedData.isCubemap = imageData.isCubemap;
+
+    uint64 payloadSize = 0;
+    mipmappedData.subresourceDataItems.resize(static_cast<uint64>(mipmapLevels) *
+                                              imageData.arraySize);
+    for (uint32 i = 0; i < imageData.arraySize; i++)
+    {
+        for (uint32 j = 0; j < mipmapLevels; j++)
+        {
+            ImageSubresourceData& subresourceData = mipmappedData.subresourceDataItems[j + i *
+                mipmapLevels];
+            subresourceData.offset = payloadSize;
+            subresourceData.rowPitch = getImageMipmapSize(imageData.width, j) *
+                MipmapGeneratorPixelSize;
+            subresourceData.depthPitch = subresourceData.rowPitch * getImageMipmapSize(
+                imageData.height, j);
+            payloadSize += subresourceData.depthPitch;
+        }
+    }
+    mipmappedData.data.resize(payloadSize);
+
+    unsigned char* payload = mipmappedData.data.data();
+    for (uint32 i = 0; i < imageData.arraySize; i++)
+    {
+        const ImageSubresourceData& sourceData = imageData.subresourceDataItems[
+            getImageSubresourceIndex(imageData, 0, i)];
+        const ImageSubresourceData& topData = mipmappedData.subresourceDataItems[i *
+            mipmapLevels];
+        for (uint32 y = 0; y < imageData.height; y++)
+        {
+            std::memcpy(payload + topData.offset + static_cast<uint64>(y) * topData.rowPitch,
+                        getImagePayload(imageData) + sourceData.offset + static_cast<uint64>(y) *
+                        sourceData.rowPitch, topData.rowPitch);
+        }
+    }
+
+    CpuInstructionSet instructionSet = getCpuInstructionSet(settings.instructionSet);
+
+    uint32 threadCount = 1;
+    uint64 pixelCount = 0;
+    for (uint32 j = 1; j < mipmapLevels; j++)
+    {
+        uint32 sourceWidth = getImageMipmapSize(imageData.width, j - 1);
+        uint32 sourceHeight = getImageMipmapSize(imageData.height, j - 1);
+        uint32 width = getImageMipmapSize(imageData.width, j);
+        uint32 height = getImageMipmapSize(imageData.height, j);
+
+        MipmapFilterKernel horizontalKernel = {};
+        initializeKernel(filter, sourceWidth, width, horizontalKernel);
+        MipmapFilterKernel verticalKernel = {};
+        initializeKernel(filter, sourceHeight, height, verticalKernel);
+
+        // Bands of every slice are shared out together, so small levels of arrays still split
+        uint32 sliceBandCount = (height + MipmapGeneratorBandHeight - 1) /
+            MipmapGeneratorBandHeight;
+        uint64 bandCount = static_cast<uint64>(sliceBandCount) * imageData.arraySize;
+        uint32 levelThreadCount = forEachRange(bandCount, [&](uint64 beginBand, uint64 endBand)
+        {
+            std::vector<float> linearRow;
+            std::vector<float> band;
+            std::vector<const float*> bandRows;
+            for (uint64 k = beginBand; k < endBand; k++)
+            {
+                uint32 slice = static_cast<uint32>(k / sliceBandCount);
+                uint32 beginRow = static_cast<uint32>(k % sliceBandCount) *
+                    MipmapGeneratorBandHeight;
+                uint32 endRow = beginRow + MipmapGeneratorBandHeight;
+                if (endRow > height)
+                {
+                    endRow = height;
+                }
+
+                const ImageSubresourceData& upperData = mipmappedData.subresourceDataItems[j -
+                    1 + slice * mipmapLevels];
+                const ImageSubresourceData& lowerData = mipmappedData.subresourceDataItems[j +
+                    slice * mipmapLevels];
+
+                generateRows(payload + upperData.offset, sourceWidth, horizontalKernel,
+                             verticalKernel, isSrgb, instructionSet, beginRow, endRow,
+                             payload + lowerData.offset, width, linearRow, band, bandRows);
+            }
+        });
+        if (levelThreadCount > threadCount)
+        {
+            threadCount = levelThreadCount;
+        }
+
+        pixelCount += static_cast<uint64>(width) * height * imageData.arraySize;
+    }
+
+    mipmappedImageData = std::move(mipmappedData);
+
+    auto endTime = std::chrono::steady_clock::now();
+    std::chrono::duration<double> generationTime = endTime - startTime;
+
+    statistics.instructionSet = instructionSet;
+    statistics.threadCount = threadCount;
+    statistics.imageCount = 1;
+    statistics.pixelCount = pixelCount;
+    statistics.size = pixelCount * MipmapGeneratorPixelSize;
+    statistics.generationTime = generationTime.count();
+    if (statistics.generationTime > 0.0)
+    {
+        statistics.throughput = statistics.size / (1024.0 * 1024.0 * 1024.0) /
+            statistics.generationTime;
+    }
+
+    return true;
+}
+
+void MipmapGenerator::initializeSrgbTables()
+{
+    srgbToLinearTable.resize(256);
+    for (uint32 i = 0; i < 256; i++)
+    {
+        srgbToLinearTable[i] = convertSrgbToLinear(i / 255.0f);
+    }
+
+    // Padded for the 32-bit gathers of the last entries
+    linearToSrgbTable.resize(MipmapGeneratorSrgbTableSize + sizeof(int32) - 1);
+    for (uint32 i = 0; i < MipmapGeneratorSrgbTableSize; i++)
+    {
+        float value = convertLinearToSrgb(static_cast<float>(i) / (MipmapGeneratorSrgbTableSize -
+                                                                   1));
+        linearToSrgbTable[i] = static_cast<uint8>(value * 255.0f + 0.5f);
+    }
+}
+
+void MipmapGenerator::initializeKernel(MipmapFilter filter, uint32 sourceSize, uint32 size,
+                                       MipmapFilterKernel& kernel)
+{
+    float scale = static_cast<float>(sourceSize) / size;
+    float support = getMipmapFilterRadius(filter) * scale;
+
+    // Destination pixel i covers [i * scale, (i + 1) * scale) of the level above, the box takes
+    // the source pixels overlapping it and the others the ones whose centers are strictly within
+    // the support around its center, the weights at its ends being 0
+    std::vector<int32> firstIndexes(size);
+    uint32 tapCount = 0;
+    for (uint32 i = 0; i < size; i++)
+    {
+        float center = (i + 0.5f) * scale;
+        int32 firstIndex = static_cast<int32>(std::floor(center - support - 0.5f)) + 1;
+        int32 lastIndex = static_cast<int32>(std::ceil(center + support - 0.5f)) - 1;
+        if (filter == MipmapFilter::Box)
+        {
+            firstIndex = static_cast<int32>(std::floor(i * scale));
+            lastIndex = static_cast<int32>(std::ceil((i + 1) * scale)) - 1;
+        }
+        firstIndexes[i] = firstIndex;
+
+        uint32 count = static_cast<uint32>(lastIndex - firstIndex + 1);
+        if (count > tapCount)
+        {
+            tapCount = count;
+        }
+    }
+
+    kernel.tapCount = tapCount;
+    kernel.sourceIndexes.assign(static_cast<uint64>(size) * tapCount, 0);
+    kernel.weights.assign(static_cast<uint64>(size) * tapCount, 0.0f);
+    for (uint32 i = 0; i < size; i++)
+    {
+        float center = (i + 0.5f) * scale;
+        uint32* sourceIndexes = kernel.sourceIndexes.data() + static_cast<uint64>(i) * tapCount;
+        float* weights = kernel.weights.data() + static_cast<uint64>(i) * tapCount;
+
+        float weightSum = 0.0f;
+        for (uint32 j = 0; j < tapCount; j++)
+        {
+            int32 index = firstIndexes[i] + static_cast<int32>(j);
+
+            float weight = 0.0f;
+            if (filter == MipmapFilter::Box)
+            {
+                float begin = index > i * scale ? static_cast<float>(index) : i * scale;
+                float end = index + 1 < (i + 1) * scale ? static_cast<float>(index + 1) :
+                    (i + 1) * scale;
+                if (end > begin)
+                {
+                    weight = end - begin;
+                }
+            }
+            else
+            {
+                weight = getMipmapFilterWeight(filter, (index + 0.5f - center) / scale);
+            }
+
+            if (index < 0)
+            {
+                index = 0;
+            }
+            if (index >= static_cast<int32>(sourceSize))
+            {
+                index = static_cast<int32>(sourceSize) - 1;
+            }
+
+            sourceIndexes[j] = static_cast<uint32>(index);
+            weights[j] = weight;
+            weightSum += weight;
+        }
+
+        for (uint32 j = 0; j < tapCount; j++)
+        {
+            weights[j] /= weightSum;
+        }
+    }
+}
+
+void MipmapGenerator::generateRows(const unsigned char* sourcePixels, uint32 sourceWidth,
+                                   const MipmapFilterKernel& horizontalKernel,
+                                   const MipmapFilterKernel& verticalKernel, bool isSrgb,
+                                   CpuInstructionSet instructionSet, uint32 beginRow,
+                                   uint32 endRow, unsigned char* pixels, uint32 width,
+                                   std::vector<float>& linearRow, std::vector<float>& band,
+                                   std::vector<const float*>& bandRows)
+{
+    uint32 tapCount = verticalKernel.tapCount;
+    uint64 sourceRowPitch = static_cast<uint64>(sourceWidth) * MipmapGeneratorPixelSize;
+    uint64 rowValueCount = static_cast<uint64>(width) * MipmapGeneratorPixelSize;
+
+    // Taps of a row never go down, the band starts at the first tap of its first row and ends at
+    // the last tap of its last row
+    uint32 beginSourceRow = verticalKernel.sourceIndexes[static_cast<uint64>(beginRow) *
+        tapCount];
+    uint32 endSourceRow = verticalKernel.sourceIndexes[static_cast<uint64>(endRow) * tapCount -
+        1] + 1;
+
+    linearRow.resize(sourceRowPitch);
+    band.resize((endSourceRow - beginSourceRow) * rowValueCount);
+    bandRows.resize(tapCount);
+
+    for (uint32 y = beginSourceRow; y < endSourceRow; y++)
+    {
+        decodeRow(sourcePixels + y * sourceRowPitch, sourceWidth, isSrgb, instructionSet,
+                  linearRow.data());
+        filterRowHorizontally(linearRow.data(), horizontalKernel, width, instructionSet,
+                              band.data() + (y - beginSourceRow) * rowValueCount);
+    }
+
+    // The decoded row above is done with, the filtered rows go through it before being encoded
+    for (uint32 y = beginRow; y < endRow; y++)
+    {
+        const uint32* sourceIndexes = verticalKernel.sourceIndexes.data() + static_cast<uint64>(
+            y) * tapCount;
+        for (uint32 i = 0; i < tapCount; i++)
+        {
+            bandRows[i] = band.data() + (sourceIndexes[i] - beginSourceRow) * rowValueCount;
+        }
+
+        filterRowVertically(bandRows.data(), verticalKernel.weights.data() + static_cast<uint64>(
+            y) * tapCount, tapCount, static_cast<uint32>(rowValueCount), instructionSet,
+            linearRow.data());
+        encodeRow(linearRow.data(), width, isSrgb, instructionSet, pixels + y * rowValueCount);
+    }
+}
+
+void MipmapGenerator::decodeRow(const unsigned char* sourcePixels, uint32 pixelCount,
+                                bool isSrgb, CpuInstructionSet instructionSet,
+                                float* linearPixels)
+{
+    if (instructionSet == CpuInstructionSet::Avx2)
+    {
+        decodeRowAvx2(sourcePixels, pixelCount, isSrgb, linearPixels);
+
+        return;
+    }
+
+    for (uint32 i = 0; i < pixelCount * MipmapGeneratorPixelSize; i++)
+    {
+        bool isColor = i % MipmapGeneratorPixelSize != 3;
+        if (isSrgb && isColor)
+        {
+            linearPixels[i] = srgbToLinearTable[sourcePixels[i]];
+        }
+        else
+        {
+            linearPixels[i] = sourcePixels[i] * (1.0f / 255.0f);
+        }
+    }
+}
+
+void MipmapGenerator::filterRowHorizontally(const float* linearPixels,
+                                            const MipmapFilterKernel& kernel, uint32 pixelCount,
+                                            CpuInstructionSet instructionSet,
+                                            float* filteredPixels)
+{
+    if (instructionSet == CpuInstructionSet::Avx2)
+    {
+        filterRowHorizontallyAvx2(linearPixels, kernel, pixelCount, filteredPixels);
+
+        return;
+    }
+
+    for (uint32 i = 0; i < pixelCount; i++)
+    {
+        const uint32* sourceIndexes = kernel.sourceIndexes.data() + static_cast<uint64>(i) *
+            kernel.tapCount;
+        const float* weights = kernel.weights.data() + static_cast<uint64>(i) * kernel.tapCount;
+
+        float sums[MipmapGeneratorPixelSize] = {};
+        for (uint32 j = 0; j < kernel.tapCount; j++)
+        {
+            const float* sourcePixel = linearPixels + sourceIndexes[j] * MipmapGeneratorPixelSize;
+            for (uint32 k = 0; k < MipmapGeneratorPixelSize; k++)
+            {
+                sums[k] += weights[j] * sourcePixel[k];
+            }
+        }
+
+        for (uint32 k = 0; k < MipmapGeneratorPixelSize; k++)
+        {
+            filteredPixels[i * MipmapGeneratorPixelSize + k] = sums[k];
+        }
+    }
+}
+
+void MipmapGenerator::filterRowVertically(const float* const* bandRows, const float* weights,
+                                          uint32 tapCount, uint32 valueCount,
+                                          CpuInstructionSet instructionSet,
+                                          float* filteredValues)
+{
+    if (instructionSet == CpuInstructionSet::Avx2)
+    {
+        filterRowVerticallyAvx2(bandRows, weights, tapCount, valueCount, filteredValues);
+
+        return;
+    }
+
+    for (uint32 i = 0; i < valueCount; i++)
+    {
+        float sum = 0.0f;
+        for (uint32 j = 0; j < tapCount; j++)
+        {
+            sum += weights[j] * bandRows[j][i];
+        }
+
+        filteredValues[i] = sum;
+    }
+}
+
+void MipmapGenerator::encodeRow(const float* linearPixels, uint32 pixelCount, bool isSrgb,
+                                CpuInstructionSet instructionSet, unsigned char* pixels)
+{
+    if (instructionSet == CpuInstructionSet::Avx2)
+    {
+        encodeRowAvx2(linearPixels, pixelCount, isSrgb, pixels);
+
+        return;
+    }
+
+    for (uint32 i = 0; i < pixelCount * MipmapGeneratorPixelSize; i++)
+    {
+        // Sinc filters ring past [0, 1] around edges
+        float value = linearPixels[i];
+        if (value < 0.0f)
+        {
+            value = 0.0f;
+        }
+        if (value > 1.0f)
+        {
+            value = 1.0f;
+        }
+
+        bool isColor = i % MipmapGeneratorPixelSize != 3;
+        if (isSrgb && isColor)
+        {
+            pixels[i] = linearToSrgbTable[static_cast<int32>(value *
+                (MipmapGeneratorSrgbTableSize - 1) + 0.5f)];
+        }
+        else
+        {
+            pixels[i] = static_cast<unsigned char>(static_cast<int32>(value * 255.0f + 0.5f));
+        }
+    }
+}
+
+void MipmapGenerator::decodeRowAvx2(const unsigned char* sourcePixels, uint32 pixelCount,
+                                    bool isSrgb, float* linearPixels)
+{
+    // 2 pixels per iteration, the alpha of both in lanes 3 and 7
+    __m256 scale = _mm256_set1_ps(1.0f / 255.0f);
+
+    uint32 i = 0;
+    for (; i + 2 <= pixelCount; i += 2)
+    {
+        __m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(sourcePixels + i *
+            MipmapGeneratorPixelSize));
+        __m256i values = _mm256_cvtepu8_epi32(bytes);
+
+        __m256 linearValues = _mm256_mul_ps(_mm256_cvtepi32_ps(values), scale);
+        if (isSrgb)
+        {
+            __m256 colors = _mm256_i32gather_ps(srgbToLinearTable.data(), values, 4);
+            linearValues = _mm256_blend_ps(colors, linearValues, 0x88);
+        }
+
+        _mm256_storeu_ps(linearPixels + i * MipmapGeneratorPixelSize, linearValues);
+    }
+
+    if (i < pixelCount)
+    {
+        decodeRow(sourcePixels + i * MipmapGeneratorPixelSize, pixelCount - i, isSrgb,
+                  CpuInstructionSet::Scalar, linearPixels + i * MipmapGeneratorPixelSize);
+    }
+}
+
+void MipmapGenerator::filterRowHorizontallyAvx2(const float* linearPixels,
+                                                const MipmapFilterKernel& kernel,
+                                                uint32 pixelCount, float* filteredPixels)
+{
+    uint32 tapCount = kernel.tapCount;
+
+    // 2 destination pixels per iteration, one in each 128-bit lane
+    uint32 i = 0;
+    for (; i + 2 <= pixelCount; i += 2)
+    {
+        const uint32* sourceIndexes = kernel.sourceIndexes.data() + static_cast<uint64>(i) *
+            tapCount;
+        const float* weights = kernel.weights.data() + static_cast<uint64>(i) * tapCount;
+
+        __m256 sums = _mm256_setzero_ps();
+        for (uint32 j = 0; j < tapCount; j++)
+        {
+            __m256 sourceValues = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(
+                linearPixels + sourceIndexes[j] * MipmapGeneratorPixelSize)), _mm_loadu_ps(
+                linearPixels + sourceIndexes[j + tapCount] * MipmapGeneratorPixelSize), 1);
+            __m256 weightValues = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_set1_ps(
+                weights[j])), _mm_set1_ps(weights[j + tapCount]), 1);
+
+            sums = _mm256_add_ps(sums, _mm256_mul_ps(weightValues, sourceValues));
+        }
+
+        _mm256_storeu_ps(filteredPixels + i * MipmapGeneratorPixelSize, sums);
+    }
+
+    if (i < pixelCount)
+    {
+        const uint32* sourceIndexes = kernel.sourceIndexes.data() + static_cast<uint64>(i) *
+            tapCount;
+        const float* weights = kernel.weights.data() + static_cast<uint64>(i) * tapCount;
+
+        __m128 sums = _mm_setzero_ps();
+        for (uint32 j = 0; j < tapCount; j++)
+        {
+            sums = _mm_add_ps(sums, _mm_mul_ps(_mm_set1_ps(weights[j]), _mm_loadu_ps(
+                linearPixels + sourceIndexes[j] * MipmapGeneratorPixelSize)));
+        }
+
+        _mm_storeu_ps(filteredPixels + i * MipmapGeneratorPixelSize, sums);
+    }
+}
+
+void MipmapGenerator::filterRowVerticallyAvx2(const float* const* bandRows, const float* weights,
+                                              uint32 tapCount, uint32 valueCount,
+                                              float* filteredValues)
+{
+    uint32 i = 0;
+    for (; i + 8 <= valueCount; i += 8)
+    {
+        __m256 sums = _mm256_setzero_ps();
+        for (uint32 j = 0; j < tapCount; j++)
+        {
+            sums = _mm256_add_ps(sums, _mm256_mul_ps(_mm256_set1_ps(weights[j]), _mm256_loadu_ps(
+                bandRows[j] + i)));
+        }
+
+        _mm256_storeu_ps(filteredValues + i, sums);
+    }
+
+    for (; i < valueCount; i++)
+    {
+        float sum = 0.0f;
+        for (uint32 j = 0; j < tapCount; j++)
+        {
+            sum += weights[j] * bandRows[j][i];
+        }
+
+        filteredValues[i] = sum;
+    }
+}
+
+void MipmapGenerator::encodeRowAvx2(const float* linearPixels, uint32 pixelCount, bool isSrgb,
+                                    unsigned char* pixels)
+{
+    __m256 zero = _mm256_setzero_ps();
+    __m256 one = _mm256_set1_ps(1.0f);
+    __m256 half = _mm256_set1_ps(0.5f);
+    __m256 unormScale = _mm256_set1_ps(255.0f);
+    __m256 srgbScale = _mm256_set1_ps(static_cast<float>(MipmapGeneratorSrgbTableSize - 1));
+
+    // 2 pixels per iteration, the alpha of both in lanes 3 and 7
+    uint32 i = 0;
+    for (; i + 2 <= pixelCount; i += 2)
+    {
+        __m256 values = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(linearPixels + i *
+            MipmapGeneratorPixelSize), zero), one);
+        __m256i unormValues = _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(values,
+            unormScale), half));
+
+        if (isSrgb)
+        {
+            __m256i srgbIndexes = _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(values,
+                srgbScale), half));
+            __m256i srgbValues = _mm256_i32gather_epi32(reinterpret_cast<const int*>(
+                linearToSrgbTable.data()), srgbIndexes, 1);
+            srgbValues = _mm256_and_si256(srgbValues, _mm256_set1_epi32(0xFF));
+            unormValues = _mm256_blend_epi32(srgbValues, unormValues, 0x88);
+        }
+
+        // 32-bit lanes to bytes, the 2 pixels end up in the low 32 bits of each 128-bit lane
+        __m256i words = _mm256_packus_epi32(unormValues, unormValues);
+        __m256i bytes = _mm256_packus_epi16(words, words);
+
+        uint32 pixelPair[2] = {
+            static_cast<uint32>(_mm256_extract_epi32(bytes, 0)),
+            static_cast<uint32>(_mm256_extract_epi32(bytes, 4)),
+        };
+        std::memcpy(pixels + i * MipmapGeneratorPixelSize, pixelPair, sizeof(pixelPair));
+    }
+
+    if (i < pixelCount)
+    {
+        encodeRow(linearPixels + i * MipmapGeneratorPixelSize, pixelCount - i, isSrgb,
+                  CpuInstructionSet::Scalar, pixels + i * MipmapGeneratorPixelSize);
+    }
+}
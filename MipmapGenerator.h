@@ -0,0 +1,110 @@
+#pragma once
+#include <d3d11.h>
+#include <immintrin.h>
+
+#include <cstring>
+
+#include <vector>
+
+#include <chrono>
+#include <thread>
+
+#include "CpuUtility.h"
+#include "ImageFileParserUtility.h"
+#include "IntUtility.h"
+#include "MemoryUtility.h"
+#include "MipmapGeneratorUtility.h"
+
+// Generates the mipmap levels of 8-bit RGBA and BGRA images on the CPU, every level from the one
+// above with a separable box, Kaiser or Lanczos filter, in linear space for sRGB colors. A level
+// is split between threads in bands of rows, each filtered horizontally into floats and then
+// vertically, 2 pixels per instruction with AVX2
+class MipmapGenerator
+{
+    MipmapGeneratorSettings settings;
+
+    MipmapGeneratorStatistics statistics;
+
+    // Built by the first generation
+    std::vector<float> srgbToLinearTable; // per 8-bit value
+    std::vector<uint8> linearToSrgbTable; // per MipmapGeneratorSrgbTableSize step of [0, 1]
+
+public:
+    MipmapGenerator();
+
+    MipmapGeneratorSettings getSettings();
+    void setSettings(MipmapGeneratorSettings settings);
+
+    MipmapGeneratorStatistics getStatistics();
+
+    // Replaces the mipmap levels below the top one of every array slice with ones down to 1x1,
+    // the rows of pixels tightly packed and the subresources back to back in D3D11 order
+    bool generateMipmaps(const ImageData& imageData, ImageData& mipmappedImageData);
+
+private:
+    template <typename Function>
+    uint32 forEachRange(uint64 count, Function function);
+
+    void initializeSrgbTables();
+    void initializeKernel(MipmapFilter filter, uint32 sourceSize, uint32 size,
+                          MipmapFilterKernel& kernel);
+
+    // Rows of the level above are decoded to linear floats, filtered horizontally into the band,
+    // then the band vertically into the rows of the level
+    void generateRows(const unsigned char* sourcePixels, uint32 sourceWidth,
+                      const MipmapFilterKernel& horizontalKernel,
+                      const MipmapFilterKernel& verticalKernel, bool isSrgb,
+                      CpuInstructionSet instructionSet, uint32 beginRow, uint32 endRow,
+                      unsigned char* pixels, uint32 width, std::vector<float>& linearRow,
+                      std::vector<float>& band, std::vector<const float*>& bandRows);
+
+    void decodeRow(const unsigned char* sourcePixels, uint32 pixelCount, bool isSrgb,
+                   CpuInstructionSet instructionSet, float* linearPixels);
+    void filterRowHorizontally(const float* linearPixels, const MipmapFilterKernel& kernel,
+                               uint32 pixelCount, CpuInstructionSet instructionSet,
+                               float* filteredPixels);
+    void filterRowVertically(const float* const* bandRows, const float* weights,
+                             uint32 tapCount, uint32 valueCount, CpuInstructionSet instructionSet,
+                             float* filteredValues);
+    void encodeRow(const float* linearPixels, uint32 pixelCount, bool isSrgb,
+                   CpuInstructionSet instructionSet, unsigned char* pixels);
+
+    void decodeRowAvx2(const unsigned char* sourcePixels, uint32 pixelCount, bool isSrgb,
+                       float* linearPixels);
+    void filterRowHorizontallyAvx2(const float* linearPixels, const MipmapFilterKernel& kernel,
+                                   uint32 pixelCount, float* filteredPixels);
+    void filterRowVerticallyAvx2(const float* const* bandRows, const float* weights,
+                                 uint32 tapCount, uint32 valueCount, float* filteredValues);
+    void encodeRowAvx2(const float* linearPixels, uint32 pixelCount, bool isSrgb,
+                       unsigned char* pixels);
+};
+
+template <typename Function>
+uint32 MipmapGenerator::forEachRange(uint64 count, Function function)
+{
+    uint64 rangeCount = count;
+    if (rangeCount > settings.threadCount)
+    {
+        rangeCount = settings.threadCount;
+    }
+    if (rangeCount == 0)
+    {
+        rangeCount = 1;
+    }
+
+    std::vector<std::thread> threads;
+    threads.reserve(rangeCount - 1);
+    for (uint64 i = 1; i < rangeCount; i++)
+    {
+        threads.emplace_back(function, count * i / rangeCount, count * (i + 1) / rangeCount);
+    }
+
+    function(0, count / rangeCount);
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    return static_cast<uint32>(rangeCount);
+}
@@ -0,0 +1,185 @@
+#pragma once
+#include <d3d11.h>
+
+#include <cmath>
+
+#include <vector>
+
+#include "CpuUtility.h"
+#include "IntUtility.h"
+
+constexpr uint32 MipmapGeneratorPixelSize = 4; // B, of the 8-bit RGBA and BGRA formats
+// Rows of a mipmap level filtered together, the rows of the level above they need are filtered
+// horizontally once per band
+constexpr uint32 MipmapGeneratorBandHeight = 32;
+// Entries of the table that encodes linear values to sRGB, enough for every 8-bit value to be
+// hit exactly
+constexpr uint32 MipmapGeneratorSrgbTableSize = 16384;
+
+// Half-widths, in pixels of the level being generated
+constexpr float MipmapFilterBoxRadius = 0.5f;
+constexpr float MipmapFilterKaiserRadius = 3.0f;
+constexpr float MipmapFilterKaiserAlpha = 4.0f;
+constexpr float MipmapFilterLanczosRadius = 3.0f;
+
+enum class MipmapFilter : uint8
+{
+    Undefined,
+
+    Box, // averages the pixels under every pixel, like GenerateMips
+    Kaiser, // windowed sinc, sharper with little ringing
+    Lanczos, // windowed sinc, sharpest with the most ringing
+};
+
+enum class MipmapColorSpace : uint8
+{
+    Undefined, // sRGB for the _SRGB formats, linear otherwise
+
+    Linear,
+    Srgb, // color channels are filtered in linear space, alpha always is
+};
+
+struct MipmapGeneratorSettings
+{
+    MipmapFilter filter;
+    MipmapColorSpace colorSpace;
+    CpuInstructionSet instructionSet;
+
+    uint32 threadCount;
+};
+
+struct MipmapGeneratorStatistics
+{
+    CpuInstructionSet instructionSet;
+    uint32 threadCount;
+
+    uint32 imageCount;
+    uint64 pixelCount; // generated
+    uint64 size; // B, generated
+    double generationTime; // s
+    double throughput; // GB/s, generated
+};
+
+// One axis of the filter from a mipmap level to the next one, with the same number of taps for
+// every destination pixel. Taps past the image edge are folded into the edge pixel, unused ones
+// have a weight of 0
+struct MipmapFilterKernel
+{
+    uint32 tapCount;
+
+    std::vector<uint32> sourceIndexes; // tapCount per destination pixel
+    std::vector<float> weights; // tapCount per destination pixel, summing to 1
+};
+
+inline bool isMipmapGeneratorFormat(DXGI_FORMAT format)
+{
+    switch (format)
+    {
+    case DXGI_FORMAT_R8G8B8A8_UNORM:
+    case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+    case DXGI_FORMAT_B8G8R8A8_UNORM:
+    case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
+    case DXGI_FORMAT_B8G8R8X8_UNORM:
+    case DXGI_FORMAT_B8G8R8X8_UNORM_SRGB:
+    {
+        return true;
+    }
+    default:
+    {
+        return false;
+    }
+    }
+}
+
+inline bool isMipmapGeneratorSrgbFormat(DXGI_FORMAT format)
+{
+    return format == DXGI_FORMAT_R8G8B8A8_UNORM_SRGB || format == DXGI_FORMAT_B8G8R8A8_UNORM_SRGB
+        || format == DXGI_FORMAT_B8G8R8X8_UNORM_SRGB;
+}
+
+inline float getMipmapFilterRadius(MipmapFilter filter)
+{
+    switch (filter)
+    {
+    case MipmapFilter::Kaiser:
+    {
+        return MipmapFilterKaiserRadius;
+    }
+    case MipmapFilter::Lanczos:
+    {
+        return MipmapFilterLanczosRadius;
+    }
+    default:
+    {
+        return MipmapFilterBoxRadius;
+    }
+    }
+}
+
+inline float getMipmapSinc(float x)
+{
+    if (x == 0.0f)
+    {
+        return 1.0f;
+    }
+
+    float pi = 3.14159265f;
+
+    return std::sin(pi * x) / (pi * x);
+}
+
+// Zeroth-order modified Bessel function of the first kind, its series converges fast enough for
+// the alphas windows use
+inline float getMipmapBessel0(float x)
+{
+    float sum = 1.0f;
+    float term = 1.0f;
+    for (int32 i = 1; i < 32 && term > sum * 1e-7f; i++)
+    {
+        float halfX = x / (2.0f * i);
+        term *= halfX * halfX;
+        sum += term;
+    }
+
+    return sum;
+}
+
+// Weight of the windowed sinc filters at x pixels of the level being generated from the center
+inline float getMipmapFilterWeight(MipmapFilter filter, float x)
+{
+    float radius = getMipmapFilterRadius(filter);
+    if (x <= -radius || x >= radius)
+    {
+        return 0.0f;
+    }
+
+    if (filter == MipmapFilter::Kaiser)
+    {
+        float t = x / radius;
+
+        return getMipmapSinc(x) * getMipmapBessel0(MipmapFilterKaiserAlpha * std::sqrt(1.0f -
+            t * t)) / getMipmapBessel0(MipmapFilterKaiserAlpha);
+    }
+
+    return getMipmapSinc(x) * getMipmapSinc(x / radius);
+}
+
+inline float convertSrgbToLinear(float value)
+{
+    if (value <= 0.04045f)
+    {
+        return value / 12.92f;
+    }
+
+    return std::pow((value + 0.055f) / 1.055f, 2.4f);
+}
+
+inline float convertLinearToSrgb(float value)
+{
+    if (value <= 0.0031308f)
+    {
+        return value * 12.92f;
+    }
+
+    return 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+}
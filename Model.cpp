@@ -1,7 +1,11 @@
 #include "Model.h"
 
-Model::Model(std::shared_ptr<Shader> shader, std::shared_ptr<Direct3d> direct3d) : fileParser(),
-    vertexBuffer(), meshes()
+// Surface error allowed per unit of view depth, about a pixel at 1080p and a 45 degree field of view
+const float Model::lodErrorThreshold = 0.0008f;
+
+Model::Model(std::shared_ptr<Shader> shader, std::shared_ptr<Direct3d> direct3d,
+             std::shared_ptr<TextureStreamer> textureStreamer) : fileParser(),
+    vertexEncoder(), vertexBuffer(), meshes(), meshBoundsItems(), meshWorldBoundsItems()
 {
     initialized = false;
     released = false;
@@ -10,7 +14,14 @@ Model::Model(std::shared_ptr<Shader> shader, std::shared_ptr<Direct3d> direct3d)
 
     this->direct3d = direct3d;
 
+    this->textureStreamer = textureStreamer;
+
+    vertexDequantization = {};
+
     transformation = Transformation::identity;
+
+    bounds = getEmptyBounds();
+    worldBounds = getEmptyBounds();
 }
 
 Model::Model(const Model& model)
@@ -22,17 +33,29 @@ Model::Model(const Model& model)
 
     shader = model.shader;
 
+    vertexEncoder = model.vertexEncoder;
+
     vertexBuffer = model.vertexBuffer;
+    vertexDequantization = model.vertexDequantization;
 
     meshes = model.meshes;
 
+    textureStreamer = model.textureStreamer;
+
     transformation = model.transformation;
+
+    bounds = model.bounds;
+    meshBoundsItems = model.meshBoundsItems;
+    worldBounds = model.worldBounds;
+    meshWorldBoundsItems = model.meshWorldBoundsItems;
 }
 
 Model::~Model()
 {
     Model::release();
 
+    textureStreamer.reset();
+
     shader.reset();
 
     direct3d.reset();
@@ -60,6 +83,11 @@ void Model::setReleased()
     released = true;
 }
 
+VertexEncoderStatistics Model::getVertexEncoderStatistics()
+{
+    return vertexEncoder.getStatistics();
+}
+
 Transformation Model::getTransformation()
 {
     return transformation;
@@ -68,9 +96,27 @@ Transformation Model::getTransformation()
 void Model::setTransformation(Transformation transformation)
 {
     this->transformation = transformation;
+
+    updateWorldBounds();
+}
+
+Bounds Model::getBounds()
+{
+    return bounds;
 }
 
-bool Model::initialize(std::string filename, Transformation transformation)
+Bounds Model::getWorldBounds()
+{
+    return worldBounds;
+}
+
+std::vector<Bounds> Model::getMeshWorldBoundsItems()
+{
+    return meshWorldBoundsItems;
+}
+
+bool Model::initialize(std::string filename, Transformation transformation,
+                       TextureBudgetSettings textureBudgetSettings)
 {
     if (isInitialized())
     {
@@ -79,7 +125,7 @@ bool Model::initialize(std::string filename, Transformation transformation)
 
     ModelData modelData = {};
 
-    bool result = readMeshes(filename, modelData);
+    bool result = readMeshes(filename, textureBudgetSettings, modelData);
     if (!result)
     {
         return false;
@@ -97,7 +143,10 @@ bool Model::initialize(std::string filename, Transformation transformation)
         return false;
     }
 
+    initializeBounds(modelData);
+
     this->transformation = transformation;
+    updateWorldBounds();
 
     setInitialized();
     return true;
@@ -122,7 +171,10 @@ bool Model::initialize(ModelData modelData, Transformation transformation)
         return false;
     }
 
+    initializeBounds(modelData);
+
     this->transformation = transformation;
+    updateWorldBounds();
 
     setInitialized();
     return true;
@@ -138,6 +190,21 @@ bool Model::render(DirectX::XMMATRIX viewProjectionMatrix)
 
     DirectX::XMMATRIX modelMatrix = transformation.getTransformationMatrix();
 
+    float maxError = getLodMaxError(DirectX::XMMatrixMultiply(modelMatrix, viewProjectionMatrix));
+    float relativePixelSize = getRelativePixelSize(maxError);
+
+    if (shader->getVertexEncoding() == VertexEncoding::Quantized)
+    {
+        DirectX::XMMATRIX dequantizationMatrix = DirectX::XMMatrixMultiply(
+            DirectX::XMMatrixScaling(vertexDequantization.scale.x, vertexDequantization.scale.y,
+                                     vertexDequantization.scale.z),
+            DirectX::XMMatrixTranslation(vertexDequantization.offset.x,
+                                         vertexDequantization.offset.y,
+                                         vertexDequantization.offset.z));
+
+        modelMatrix = DirectX::XMMatrixMultiply(dequantizationMatrix, modelMatrix);
+    }
+
     MvpBuffer mvpBuffer = {};
     mvpBuffer.mvpMatrix = DirectX::XMMatrixMultiply(modelMatrix, viewProjectionMatrix);
     mvpBuffer.mvpMatrix = DirectX::XMMatrixTranspose(mvpBuffer.mvpMatrix);
@@ -150,7 +217,7 @@ bool Model::render(DirectX::XMMATRIX viewProjectionMatrix)
 
     for (auto& mesh : meshes)
     {
-        result = mesh->render();
+        result = mesh->render(maxError, relativePixelSize);
         if (!result)
         {
             return false;
@@ -169,15 +236,26 @@ void Model::release()
 
     transformation = Transformation::identity;
 
+    meshWorldBoundsItems.clear();
+    worldBounds = getEmptyBounds();
+    meshBoundsItems.clear();
+    bounds = getEmptyBounds();
+
     meshes.clear();
 
+    vertexDequantization = {};
     vertexBuffer.reset();
 
     setReleased();
 }
 
-bool Model::readMeshes(std::string filename, ModelData& modelData)
+bool Model::readMeshes(std::string filename, TextureBudgetSettings textureBudgetSettings,
+                       ModelData& modelData)
 {
+    ModelFileParserSettings fileParserSettings = fileParser.getSettings();
+    fileParserSettings.imageFileParserSettings.textureBudgetSettings = textureBudgetSettings;
+    fileParser.setSettings(fileParserSettings);
+
     bool result = fileParser.parseFile(filename, modelData);
     if (!result)
     {
@@ -187,26 +265,83 @@ bool Model::readMeshes(std::string filename, ModelData& modelData)
     return true;
 }
 
-bool Model::initializeVertexBuffer(ModelData modelData)
+bool Model::initializeVertexBuffer(const ModelData& modelData)
 {
-    vertexBuffer = createSharedPointer<VertexBuffer<Vertex>>(direct3d);
-    bool result = vertexBuffer->initialize(modelData.vertexes.data(), modelData.vertexes.size());
-    if (!result)
+    // The vertex format has to match the input layout of the shader the model is drawn with
+    switch (shader->getVertexEncoding())
     {
-        return false;
+    case VertexEncoding::Compact:
+    {
+        std::vector<CompactVertex> compactVertexes;
+        bool result = vertexEncoder.encodeCompact(modelData.vertexes, compactVertexes);
+        if (!result)
+        {
+            return false;
+        }
+
+        std::shared_ptr<VertexBuffer<CompactVertex>> compactVertexBuffer = createSharedPointer<
+            VertexBuffer<CompactVertex>>(direct3d);
+        result = compactVertexBuffer->initialize(compactVertexes.data(), compactVertexes.size());
+        if (!result)
+        {
+            return false;
+        }
+
+        vertexBuffer = compactVertexBuffer;
+
+        break;
+    }
+    case VertexEncoding::Quantized:
+    {
+        std::vector<QuantizedVertex> quantizedVertexes;
+        bool result = vertexEncoder.encodeQuantized(modelData.vertexes, quantizedVertexes,
+                                                    vertexDequantization);
+        if (!result)
+        {
+            return false;
+        }
+
+        std::shared_ptr<VertexBuffer<QuantizedVertex>> quantizedVertexBuffer =
+            createSharedPointer<VertexBuffer<QuantizedVertex>>(direct3d);
+        result = quantizedVertexBuffer->initialize(quantizedVertexes.data(),
+                                                   quantizedVertexes.size());
+        if (!result)
+        {
+            return false;
+        }
+
+        vertexBuffer = quantizedVertexBuffer;
+
+        break;
+    }
+    default:
+    {
+        std::shared_ptr<VertexBuffer<Vertex>> fullVertexBuffer = createSharedPointer<VertexBuffer<
+            Vertex>>(direct3d);
+        bool result = fullVertexBuffer->initialize(modelData.vertexes.data(),
+                                                   modelData.vertexes.size());
+        if (!result)
+        {
+            return false;
+        }
+
+        vertexBuffer = fullVertexBuffer;
+
+        break;
+    }
     }
 
     return true;
 }
 
-bool Model::initializeMeshes(ModelData modelData)
+bool Model::initializeMeshes(const ModelData& modelData)
 {
     std::unordered_map<std::string, std::shared_ptr<Material>> uniqueMaterials;
     uniqueMaterials.reserve(modelData.materialDataItems.size());
     for (const auto& pair : modelData.materialDataItems)
     {
         std::shared_ptr<Material>& uniqueMaterial = uniqueMaterials[pair.first];
-        uniqueMaterial = createSharedPointer<Material>(shader, direct3d);
+        uniqueMaterial = createSharedPointer<Material>(shader, direct3d, textureStreamer);
         bool result = uniqueMaterial->initialize(pair.second);
         if (!result)
         {
@@ -234,6 +369,23 @@ bool Model::initializeMeshes(ModelData modelData)
             return false;
         }
 
+        for (const auto& lodData : meshData.lodDataItems)
+        {
+            std::shared_ptr<IndexBuffer> lodIndexBuffer = createSharedPointer<IndexBuffer>(
+                direct3d);
+            result = lodIndexBuffer->initialize(lodData.indexes.data(), lodData.indexes.size());
+            if (!result)
+            {
+                return false;
+            }
+
+            result = mesh->addLod(lodIndexBuffer, lodData.error);
+            if (!result)
+            {
+                return false;
+            }
+        }
+
         meshes.push_back(mesh);
     }
 
@@ -241,3 +393,69 @@ bool Model::initializeMeshes(ModelData modelData)
 
     return true;
 }
+
+void Model::initializeBounds(const ModelData& modelData)
+{
+    bounds = modelData.bounds;
+
+    meshBoundsItems.clear();
+    meshBoundsItems.reserve(modelData.meshDataItems.size());
+    for (const auto& meshData : modelData.meshDataItems)
+    {
+        meshBoundsItems.push_back(meshData.bounds);
+    }
+}
+
+void Model::updateWorldBounds()
+{
+    DirectX::XMMATRIX modelMatrix = transformation.getTransformationMatrix();
+
+    worldBounds = transformBounds(bounds, modelMatrix);
+
+    meshWorldBoundsItems.resize(meshBoundsItems.size());
+    for (uint64 i = 0; i < meshBoundsItems.size(); i++)
+    {
+        meshWorldBoundsItems[i] = transformBounds(meshBoundsItems[i], modelMatrix);
+    }
+}
+
+float Model::getLodMaxError(DirectX::XMMATRIX mvpMatrix)
+{
+    // The clip w of the model origin is its view depth
+    DirectX::XMVECTOR origin = DirectX::XMVector4Transform(
+        DirectX::XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f), mvpMatrix);
+    float depth = DirectX::XMVectorGetW(origin);
+    if (depth <= 0.0f)
+    {
+        return 0.0f;
+    }
+
+    // Errors are in model units, scaling the model scales them too
+    DirectX::XMFLOAT3 scale = transformation.scale_;
+    float maxScale = std::fabs(scale.x);
+    if (std::fabs(scale.y) > maxScale)
+    {
+        maxScale = std::fabs(scale.y);
+    }
+    if (std::fabs(scale.z) > maxScale)
+    {
+        maxScale = std::fabs(scale.z);
+    }
+    if (maxScale == 0.0f)
+    {
+        return 0.0f;
+    }
+
+    return lodErrorThreshold * depth / maxScale;
+}
+
+float Model::getRelativePixelSize(float maxError)
+{
+    // The allowed error is about a pixel in model units, the model is about as wide as its sphere
+    if (isBoundsEmpty(bounds) || bounds.radius == 0.0f)
+    {
+        return 0.0f;
+    }
+
+    return maxError / (2.0f * bounds.radius);
+}
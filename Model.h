@@ -1,6 +1,8 @@
 #pragma once
 #include <memory>
 
+#include <cmath>
+
 #include <string>
 
 #include <vector>
@@ -11,9 +13,11 @@
 #include "ModelFileParser.h"
 
 #include "VertexBuffer.h"
+#include "VertexEncoder.h"
 
 #include "Mesh.h"
 #include "Material.h"
+#include "TextureStreamer.h"
 
 #include "Transformation.h"
 
@@ -21,6 +25,8 @@
 #include "ConstantBufferUtility.h"
 
 #include "ModelFileParserUtility.h"
+#include "VertexEncodingUtility.h"
+#include "BoundsUtility.h"
 
 class Model
 {
@@ -33,14 +39,27 @@ class Model
 
     ModelFileParser fileParser;
 
-    std::shared_ptr<VertexBuffer<Vertex>> vertexBuffer;
+    VertexEncoder vertexEncoder;
+
+    std::shared_ptr<AbstractVertexBuffer> vertexBuffer;
+    VertexDequantization vertexDequantization;
 
     std::vector<std::shared_ptr<Mesh>> meshes;
 
+    std::shared_ptr<TextureStreamer> textureStreamer; // of the materials, when there is one
+
     Transformation transformation;
 
+    Bounds bounds; // model space
+    std::vector<Bounds> meshBoundsItems;
+    Bounds worldBounds;
+    std::vector<Bounds> meshWorldBoundsItems;
+
+    static const float lodErrorThreshold;
+
 public:
-    Model(std::shared_ptr<Shader> shader, std::shared_ptr<Direct3d> direct3d);
+    Model(std::shared_ptr<Shader> shader, std::shared_ptr<Direct3d> direct3d,
+          std::shared_ptr<TextureStreamer> textureStreamer = nullptr);
     Model(const Model& model);
     ~Model();
 
@@ -52,18 +71,33 @@ private:
     void setReleased();
 
 public:
+    VertexEncoderStatistics getVertexEncoderStatistics();
+
     Transformation getTransformation();
     void setTransformation(Transformation transformation);
 
+    Bounds getBounds();
+    Bounds getWorldBounds();
+    std::vector<Bounds> getMeshWorldBoundsItems();
+
     bool initialize(std::string filename,
-                            Transformation transformation = Transformation::identity);
+                            Transformation transformation = Transformation::identity,
+                            TextureBudgetSettings textureBudgetSettings =
+                                getDefaultTextureBudgetSettings());
     bool initialize(ModelData modelData,
                             Transformation transformation = Transformation::identity);
     bool render(DirectX::XMMATRIX viewProjectionMatrix);
     void release();
 
 private:
-    bool readMeshes(std::string filename, ModelData& modelData);
-    bool initializeVertexBuffer(ModelData modelData);
-    bool initializeMeshes(ModelData modelData);
+    bool readMeshes(std::string filename, TextureBudgetSettings textureBudgetSettings,
+                    ModelData& modelData);
+    bool initializeVertexBuffer(const ModelData& modelData);
+    bool initializeMeshes(const ModelData& modelData);
+    void initializeBounds(const ModelData& modelData);
+
+    void updateWorldBounds();
+
+    float getLodMaxError(DirectX::XMMATRIX mvpMatrix);
+    float getRelativePixelSize(float maxError);
 };
@@ -0,0 +1,478 @@
+#include "ModelCache.h"
+
+ModelCache::ModelCache()
+{
+}
+
+std::string ModelCache::getCacheFilename(std::string filename)
+{
+    return replaceFileFormat(filename, "gspmesh");
+}
+
+bool ModelCache::readFile(std::string filename, uint32 flags, uint32 settingsHash,
+                          ModelData& modelData)
+{
+    MappedFile file;
+    bool result = file.initialize(getCacheFilename(filename));
+    if (!result)
+    {
+        return false;
+    }
+
+    const unsigned char* cursor = file.getData();
+    const unsigned char* end = cursor + file.getSize();
+
+    GspMeshHeader header = {};
+    result = readGspMeshData(cursor, end, &header, sizeof(header));
+    if (!result)
+    {
+        return false;
+    }
+
+    if (header.magicNumber != GspMeshMagicNumberGspm || header.version != GspMeshVersion ||
+        header.vertexSize != sizeof(Vertex) || header.flags != flags ||
+        header.settingsHash != settingsHash)
+    {
+        return false;
+    }
+
+    result = readDependencies(cursor, end, header.dependencyCount, modelData);
+    if (!result)
+    {
+        return false;
+    }
+
+    // The vertex count comes from the file, check it against the mapping before allocating
+    if (header.vertexCount > static_cast<uint64>(end - cursor) / sizeof(Vertex))
+    {
+        return false;
+    }
+
+    modelData.vertexes.resize(header.vertexCount);
+    result = readGspMeshData(cursor, end, modelData.vertexes.data(),
+                             header.vertexCount * sizeof(Vertex));
+    if (!result)
+    {
+        return false;
+    }
+
+    if (header.flags & static_cast<uint32>(GspMeshFlags::Tangents))
+    {
+        if (header.vertexCount > static_cast<uint64>(end - cursor) / sizeof(DirectX::XMFLOAT4))
+        {
+            return false;
+        }
+
+        modelData.tangents.resize(header.vertexCount);
+        result = readGspMeshData(cursor, end, modelData.tangents.data(),
+                                 header.vertexCount * sizeof(DirectX::XMFLOAT4));
+        if (!result)
+        {
+            return false;
+        }
+    }
+
+    modelData.meshDataItems.resize(header.meshCount);
+    for (MeshData& meshData : modelData.meshDataItems)
+    {
+        GspMeshMesh mesh = {};
+        result = readGspMeshData(cursor, end, &mesh, sizeof(mesh));
+        if (!result)
+        {
+            return false;
+        }
+
+        result = readString(cursor, end, mesh.nameSize, meshData.name);
+        if (!result)
+        {
+            return false;
+        }
+        result = readString(cursor, end, mesh.materialNameSize, meshData.materialName);
+        if (!result)
+        {
+            return false;
+        }
+
+        result = readIndexes(cursor, end, mesh.indexCount, meshData.indexes);
+        if (!result)
+        {
+            return false;
+        }
+
+        // Every level takes at least its record, which bounds the count before allocating
+        if (mesh.lodCount > static_cast<uint64>(end - cursor) / sizeof(GspMeshLod))
+        {
+            return false;
+        }
+
+        meshData.lodDataItems.resize(mesh.lodCount);
+        for (MeshLodData& lodData : meshData.lodDataItems)
+        {
+            GspMeshLod lod = {};
+            result = readGspMeshData(cursor, end, &lod, sizeof(lod));
+            if (!result)
+            {
+                return false;
+            }
+
+            lodData.error = lod.error;
+
+            result = readIndexes(cursor, end, lod.indexCount, lodData.indexes);
+            if (!result)
+            {
+                return false;
+            }
+        }
+
+        result = readMeshlets(cursor, end, mesh, meshData);
+        if (!result)
+        {
+            return false;
+        }
+
+        result = readObjects(cursor, end, mesh.objectCount, meshData);
+        if (!result)
+        {
+            return false;
+        }
+    }
+
+    for (uint32 i = 0; i < header.materialCount; i++)
+    {
+        GspMeshMaterial material = {};
+        result = readGspMeshData(cursor, end, &material, sizeof(material));
+        if (!result)
+        {
+            return false;
+        }
+
+        MaterialData materialData = {};
+        materialData.diffuseColor = material.diffuseColor;
+        materialData.opacity = material.opacity;
+        materialData.hasDiffuseColorImage = material.hasDiffuseColorImage != 0;
+
+        result = readString(cursor, end, material.nameSize, materialData.name);
+        if (!result)
+        {
+            return false;
+        }
+        result = readString(cursor, end, material.diffuseColorImageFilenameSize,
+                            materialData.diffuseColorImageFilename);
+        if (!result)
+        {
+            return false;
+        }
+
+        modelData.materialDataItems[materialData.name] = materialData;
+    }
+
+    if (cursor != end)
+    {
+        return false;
+    }
+
+    file.release();
+
+    return true;
+}
+
+bool ModelCache::writeFile(std::string filename, uint32 flags, uint32 settingsHash,
+                           const ModelData& modelData)
+{
+    if (flags & static_cast<uint32>(GspMeshFlags::Tangents) &&
+        modelData.tangents.size() != modelData.vertexes.size())
+    {
+        return false;
+    }
+
+    std::vector<std::string> dependencyFilenames = getDependencyFilenames(filename, modelData);
+
+    std::vector<GspMeshDependency> dependencies(dependencyFilenames.size());
+    for (uint64 i = 0; i < dependencies.size(); i++)
+    {
+        FileStamp fileStamp = {};
+        bool result = getFileStamp(dependencyFilenames[i], fileStamp);
+        if (!result)
+        {
+            return false;
+        }
+
+        dependencies[i].fileSize = fileStamp.size;
+        dependencies[i].fileWriteTime = fileStamp.writeTime;
+        dependencies[i].filenameSize = static_cast<uint32>(dependencyFilenames[i].size());
+    }
+
+    std::string cacheFilename = getCacheFilename(filename);
+
+    std::ofstream file(cacheFilename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    GspMeshHeader header = {};
+    header.magicNumber = GspMeshMagicNumberGspm;
+    header.version = GspMeshVersion;
+    header.vertexSize = sizeof(Vertex);
+    header.dependencyCount = static_cast<uint32>(dependencies.size());
+    header.vertexCount = modelData.vertexes.size();
+    header.meshCount = static_cast<uint32>(modelData.meshDataItems.size());
+    header.materialCount = static_cast<uint32>(modelData.materialDataItems.size());
+    header.flags = flags;
+    header.settingsHash = settingsHash;
+    writeData(file, &header, sizeof(header));
+
+    for (uint64 i = 0; i < dependencies.size(); i++)
+    {
+        writeData(file, &dependencies[i], sizeof(GspMeshDependency));
+        writeString(file, dependencyFilenames[i]);
+    }
+
+    writeData(file, modelData.vertexes.data(), modelData.vertexes.size() * sizeof(Vertex));
+    if (flags & static_cast<uint32>(GspMeshFlags::Tangents))
+    {
+        writeData(file, modelData.tangents.data(),
+                  modelData.tangents.size() * sizeof(DirectX::XMFLOAT4));
+    }
+
+    for (const MeshData& meshData : modelData.meshDataItems)
+    {
+        GspMeshMesh mesh = {};
+        mesh.indexCount = meshData.indexes.size();
+        mesh.nameSize = static_cast<uint32>(meshData.name.size());
+        mesh.materialNameSize = static_cast<uint32>(meshData.materialName.size());
+        mesh.lodCount = static_cast<uint32>(meshData.lodDataItems.size());
+        mesh.meshletCount = static_cast<uint32>(meshData.meshletDataItems.size());
+        mesh.meshletVertexCount = static_cast<uint32>(meshData.meshletVertexes.size());
+        mesh.meshletTriangleCount = static_cast<uint32>(meshData.meshletTriangles.size() / 3);
+        mesh.objectCount = static_cast<uint32>(meshData.objectDataItems.size());
+        writeData(file, &mesh, sizeof(mesh));
+
+        writeString(file, meshData.name);
+        writeString(file, meshData.materialName);
+
+        writeData(file, meshData.indexes.data(), meshData.indexes.size() * sizeof(uint32));
+
+        for (const MeshLodData& lodData : meshData.lodDataItems)
+        {
+            GspMeshLod lod = {};
+            lod.indexCount = lodData.indexes.size();
+            lod.error = lodData.error;
+            writeData(file, &lod, sizeof(lod));
+
+            writeData(file, lodData.indexes.data(), lodData.indexes.size() * sizeof(uint32));
+        }
+
+        writeData(file, meshData.meshletDataItems.data(),
+                  meshData.meshletDataItems.size() * sizeof(MeshletData));
+        writeData(file, meshData.meshletVertexes.data(),
+                  meshData.meshletVertexes.size() * sizeof(uint32));
+        writeData(file, meshData.meshletTriangles.data(), meshData.meshletTriangles.size());
+
+        for (const MeshObjectData& objectData : meshData.objectDataItems)
+        {
+            GspMeshObject object = {};
+            object.indexOffset = objectData.indexOffset;
+            object.indexCount = objectData.indexCount;
+            object.nameSize = static_cast<uint32>(objectData.name.size());
+            writeData(file, &object, sizeof(object));
+
+            writeString(file, objectData.name);
+        }
+    }
+
+    for (const auto& materialDataItem : modelData.materialDataItems)
+    {
+        const MaterialData& materialData = materialDataItem.second;
+
+        GspMeshMaterial material = {};
+        material.diffuseColor = materialData.diffuseColor;
+        material.opacity = materialData.opacity;
+        material.hasDiffuseColorImage = materialData.hasDiffuseColorImage;
+        material.nameSize = static_cast<uint32>(materialData.name.size());
+        material.diffuseColorImageFilenameSize = static_cast<uint32>(materialData.
+            diffuseColorImageFilename.size());
+        writeData(file, &material, sizeof(material));
+
+        writeString(file, materialData.name);
+        writeString(file, materialData.diffuseColorImageFilename);
+    }
+
+    file.close();
+    if (file.fail())
+    {
+        std::remove(cacheFilename.c_str());
+
+        return false;
+    }
+
+    return true;
+}
+
+std::vector<std::string> ModelCache::getDependencyFilenames(std::string filename,
+                                                            const ModelData& modelData)
+{
+    std::vector<std::string> dependencyFilenames;
+    dependencyFilenames.push_back(filename);
+
+    if (!modelData.materialLibraryFilename.empty())
+    {
+        dependencyFilenames.push_back(modelData.materialLibraryFilename);
+    }
+
+    return dependencyFilenames;
+}
+
+bool ModelCache::readDependencies(const unsigned char*& cursor, const unsigned char* end,
+                                  uint32 dependencyCount, ModelData& modelData)
+{
+    if (dependencyCount == 0)
+    {
+        return false;
+    }
+
+    for (uint32 i = 0; i < dependencyCount; i++)
+    {
+        GspMeshDependency dependency = {};
+        bool result = readGspMeshData(cursor, end, &dependency, sizeof(dependency));
+        if (!result)
+        {
+            return false;
+        }
+
+        std::string dependencyFilename;
+        result = readString(cursor, end, dependency.filenameSize, dependencyFilename);
+        if (!result)
+        {
+            return false;
+        }
+
+        FileStamp fileStamp = {};
+        result = getFileStamp(dependencyFilename, fileStamp);
+        if (!result)
+        {
+            return false;
+        }
+
+        if (fileStamp.size != dependency.fileSize || fileStamp.writeTime != dependency.
+            fileWriteTime)
+        {
+            return false;
+        }
+
+        // The first dependency is the model file itself, the second one is its material library
+        if (i == 1)
+        {
+            modelData.materialLibraryFilename = dependencyFilename;
+        }
+    }
+
+    return true;
+}
+
+bool ModelCache::readIndexes(const unsigned char*& cursor, const unsigned char* end,
+                             uint64 indexCount, std::vector<uint32>& indexes)
+{
+    if (indexCount > static_cast<uint64>(end - cursor) / sizeof(uint32))
+    {
+        return false;
+    }
+
+    indexes.resize(indexCount);
+
+    return readGspMeshData(cursor, end, indexes.data(), indexCount * sizeof(uint32));
+}
+
+bool ModelCache::readMeshlets(const unsigned char*& cursor, const unsigned char* end,
+                              const GspMeshMesh& mesh, MeshData& meshData)
+{
+    if (mesh.meshletCount > static_cast<uint64>(end - cursor) / sizeof(MeshletData))
+    {
+        return false;
+    }
+
+    meshData.meshletDataItems.resize(mesh.meshletCount);
+
+    bool result = readGspMeshData(cursor, end, meshData.meshletDataItems.data(),
+                                  mesh.meshletCount * sizeof(MeshletData));
+    if (!result)
+    {
+        return false;
+    }
+
+    result = readIndexes(cursor, end, mesh.meshletVertexCount, meshData.meshletVertexes);
+    if (!result)
+    {
+        return false;
+    }
+
+    uint64 meshletTriangleSize = mesh.meshletTriangleCount * 3ull;
+    if (meshletTriangleSize > static_cast<uint64>(end - cursor))
+    {
+        return false;
+    }
+
+    meshData.meshletTriangles.resize(meshletTriangleSize);
+
+    return readGspMeshData(cursor, end, meshData.meshletTriangles.data(), meshletTriangleSize);
+}
+
+bool ModelCache::readObjects(const unsigned char*& cursor, const unsigned char* end,
+                             uint32 objectCount, MeshData& meshData)
+{
+    if (objectCount > static_cast<uint64>(end - cursor) / sizeof(GspMeshObject))
+    {
+        return false;
+    }
+
+    meshData.objectDataItems.resize(objectCount);
+    for (MeshObjectData& objectData : meshData.objectDataItems)
+    {
+        GspMeshObject object = {};
+        bool result = readGspMeshData(cursor, end, &object, sizeof(object));
+        if (!result)
+        {
+            return false;
+        }
+
+        objectData.indexOffset = object.indexOffset;
+        objectData.indexCount = object.indexCount;
+
+        result = readString(cursor, end, object.nameSize, objectData.name);
+        if (!result)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool ModelCache::readString(const unsigned char*& cursor, const unsigned char* end, uint32 size,
+                            std::string& value)
+{
+    if (static_cast<uint64>(end - cursor) < size)
+    {
+        return false;
+    }
+
+    value.assign(reinterpret_cast<const char*>(cursor), size);
+    cursor += size;
+
+    return true;
+}
+
+void ModelCache::writeData(std::ofstream& file, const void* data, uint64 size)
+{
+    if (size == 0)
+    {
+        return;
+    }
+
+    file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+}
+
+void ModelCache::writeString(std::ofstream& file, const std::string& value)
+{
+    writeData(file, value.data(), value.size());
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <fstream>
+
+#include <vector>
+
+#include <string>
+
+#include <cstdio>
+
+#include "MappedFile.h"
+
+#include "FileParserUtility.h"
+#include "ModelFileParserUtility.h"
+#include "GspMeshUtility.h"
+
+// Keeps the parsed model next to its source as a .gspmesh file. The file is only trusted while
+// the sizes and write times of the source files it was built from are unchanged
+class ModelCache
+{
+public:
+    ModelCache();
+
+    std::string getCacheFilename(std::string filename);
+
+    bool readFile(std::string filename, uint32 flags, uint32 settingsHash, ModelData& modelData);
+    bool writeFile(std::string filename, uint32 flags, uint32 settingsHash,
+                   const ModelData& modelData);
+
+private:
+    std::vector<std::string> getDependencyFilenames(std::string filename,
+                                                    const ModelData& modelData);
+
+    bool readDependencies(const unsigned char*& cursor, const unsigned char* end,
+                          uint32 dependencyCount, ModelData& modelData);
+    bool readIndexes(const unsigned char*& cursor, const unsigned char* end, uint64 indexCount,
+                     std::vector<uint32>& indexes);
+    bool readMeshlets(const unsigned char*& cursor, const unsigned char* end,
+                      const GspMeshMesh& mesh, MeshData& meshData);
+    bool readObjects(const unsigned char*& cursor, const unsigned char* end, uint32 objectCount,
+                     MeshData& meshData);
+    bool readString(const unsigned char*& cursor, const unsigned char* end, uint32 size,
+                    std::string& value);
+
+    void writeData(std::ofstream& file, const void* data, uint64 size);
+    void writeString(std::ofstream& file, const std::string& value);
+};
@@ -1,14 +1,218 @@
 #include "ModelFileParser.h"
 
+ModelFileParser::ModelFileParser() : imageFileParser(), modelCache(), vertexWelder(),
+                                     meshOptimizer(), meshSimplifier(), meshletBuilder(),
+                                     meshMerger(), tangentFrameGenerator(), settings{},
+                                     statistics{}
+{
+    settings.mode = ModelFileParserMode::MappedFile;
+    settings.isMaterialImageParsingEnabled = true;
+    settings.imageFileParserSettings = imageFileParser.getSettings();
+    settings.isCacheEnabled = true;
+    settings.isWeldingEnabled = false;
+    settings.vertexWelderSettings = vertexWelder.getSettings();
+    settings.isOptimizationEnabled = false;
+    settings.isSimplificationEnabled = false;
+    settings.meshSimplifierSettings = meshSimplifier.getSettings();
+    settings.isMeshMergingEnabled = false;
+    settings.meshMergerSettings = meshMerger.getSettings();
+    settings.isTangentGenerationEnabled = false;
+}
+
+ModelFileParserSettings ModelFileParser::getSettings()
+{
+    return settings;
+}
+
+void ModelFileParser::setSettings(ModelFileParserSettings settings)
+{
+    this->settings = settings;
+}
+
+ModelFileParserStatistics ModelFileParser::getStatistics()
+{
+    return statistics;
+}
+
 bool ModelFileParser::parseFile(std::string filename, ModelData& modelData)
 {
+    statistics = {};
+
     std::string format = getFileFormat(filename);
-    if (format == "obj")
+    if (format != "obj")
+    {
+        return false;
+    }
+
+    ProcessMemoryData processMemoryData = {};
+    getProcessMemoryData(processMemoryData);
+    statistics.startWorkingSetSize = processMemoryData.workingSetSize;
+    statistics.startPeakWorkingSetSize = processMemoryData.peakWorkingSetSize;
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    bool result = false;
+    if (settings.isCacheEnabled)
+    {
+        result = modelCache.readFile(filename, getCacheFlags(), getCacheSettingsHash(),
+                                     modelData);
+        if (!result)
+        {
+            modelData = {};
+        }
+
+        statistics.isCached = result;
+
+        // Images are not part of the cache, they are decoded from their own files
+        if (statistics.isCached && settings.isMaterialImageParsingEnabled)
+        {
+            result = parseMaterialImages(modelData);
+            if (!result)
+            {
+                return false;
+            }
+        }
+    }
+
+    if (!statistics.isCached)
+    {
+        auto objStartTime = std::chrono::steady_clock::now();
+
+        if (settings.mode == ModelFileParserMode::Stream)
+        {
+            result = parseObjFile(filename, modelData);
+        }
+        else
+        {
+            result = parseMappedObjFile(filename, modelData);
+        }
+        if (!result)
+        {
+            return false;
+        }
+
+        // The images are decoded from within the MTL parsing
+        std::chrono::duration<double> objParsingTime = std::chrono::steady_clock::now() -
+            objStartTime;
+        statistics.objParsingTime = objParsingTime.count() - statistics.imageParsingTime;
+
+        if (settings.isWeldingEnabled)
+        {
+            vertexWelder.setSettings(settings.vertexWelderSettings);
+            result = vertexWelder.weld(modelData);
+            if (!result)
+            {
+                return false;
+            }
+
+            statistics.vertexWelderStatistics = vertexWelder.getStatistics();
+        }
+
+        if (settings.isSimplificationEnabled)
+        {
+            meshSimplifier.setSettings(settings.meshSimplifierSettings);
+            result = meshSimplifier.simplify(modelData);
+            if (!result)
+            {
+                return false;
+            }
+
+            statistics.meshSimplifierStatistics = meshSimplifier.getStatistics();
+        }
+
+        // Runs after simplification so the LOD levels are reordered as well
+        if (settings.isOptimizationEnabled)
+        {
+            result = meshOptimizer.optimize(modelData);
+            if (!result)
+            {
+                return false;
+            }
+
+            statistics.meshOptimizerStatistics = meshOptimizer.getStatistics();
+        }
+
+        // Runs after optimization so meshlets follow the vertex cache order
+        if (settings.isMeshletGenerationEnabled)
+        {
+            result = meshletBuilder.build(modelData);
+            if (!result)
+            {
+                return false;
+            }
+
+            statistics.meshletBuilderStatistics = meshletBuilder.getStatistics();
+        }
+
+        // Runs last, every mesh stage before it works on the separate objects
+        if (settings.isMeshMergingEnabled)
+        {
+            meshMerger.setSettings(settings.meshMergerSettings);
+            result = meshMerger.merge(modelData);
+            if (!result)
+            {
+                return false;
+            }
+
+            statistics.meshMergerStatistics = meshMerger.getStatistics();
+        }
+
+        // Needs the final vertex order, the stages before it may reorder or weld vertexes
+        if (settings.isTangentGenerationEnabled)
+        {
+            TangentFrameGeneratorSettings tangentFrameGeneratorSettings = {};
+            tangentFrameGeneratorSettings.threadCount = getThreadCount();
+            tangentFrameGenerator.setSettings(tangentFrameGeneratorSettings);
+
+            result = tangentFrameGenerator.generateTangents(modelData);
+            if (!result)
+            {
+                return false;
+            }
+
+            TangentFrameGeneratorStatistics tangentFrameGeneratorStatistics =
+                tangentFrameGenerator.getStatistics();
+            statistics.tangentFrameGeneratorStatistics.generatedTangentCount =
+                tangentFrameGeneratorStatistics.generatedTangentCount;
+            statistics.tangentFrameGeneratorStatistics.tangentGenerationTime =
+                tangentFrameGeneratorStatistics.tangentGenerationTime;
+            statistics.tangentFrameGeneratorStatistics.tangentThroughput =
+                tangentFrameGeneratorStatistics.tangentThroughput;
+        }
+
+        // A model that can't be cached still loads, it is just parsed again next time
+        if (settings.isCacheEnabled)
+        {
+            modelCache.writeFile(filename, getCacheFlags(), getCacheSettingsHash(), modelData);
+        }
+    }
+
+    computeBounds(modelData);
+
+    std::chrono::duration<double> parsingTime = std::chrono::steady_clock::now() - startTime;
+
+    statistics.fileSize = getFileSize(filename);
+    statistics.parsingTime = parsingTime.count();
+    if (statistics.parsingTime > 0.0)
+    {
+        statistics.throughput = statistics.fileSize / (1024.0 * 1024.0) / statistics.parsingTime;
+    }
+    if (statistics.objParsingTime > 0.0)
     {
-        return parseObjFile(filename, modelData);
+        statistics.objThroughput = statistics.fileSize / (1024.0 * 1024.0) /
+            statistics.objParsingTime;
     }
 
-    return false;
+    getProcessMemoryData(processMemoryData);
+    statistics.peakWorkingSetSize = processMemoryData.peakWorkingSetSize;
+    if (statistics.peakWorkingSetSize > statistics.startPeakWorkingSetSize)
+    {
+        statistics.isPeakWorkingSetIncreaseMeasured = true;
+        statistics.peakWorkingSetIncrease = statistics.peakWorkingSetSize -
+            statistics.startWorkingSetSize;
+    }
+
+    return true;
 }
 
 bool ModelFileParser::parseObjFile(std::string filename, ModelData& modelData)
@@ -44,14 +248,32 @@ bool ModelFileParser::parseObjFile(std::string filename, ModelData& modelData)
         }
     }
 
-    MeshData meshData = {};
+    ObjLineCounts lineCounts = {};
+    bool result = countObjFileLines(filename, lineCounts);
+    if (!result)
+    {
+        return false;
+    }
 
     std::vector<DirectX::XMFLOAT3> positions;
+    positions.reserve(lineCounts.positionCount);
     std::vector<DirectX::XMFLOAT3> textureCoordinatesItems;
+    textureCoordinatesItems.reserve(lineCounts.textureCoordinatesCount);
     std::vector<DirectX::XMFLOAT3> normals;
+    normals.reserve(lineCounts.normalCount);
+
+    VertexIndexTable uniqueVertexes;
+    uniqueVertexes.reserve(getObjVertexCountEstimate(lineCounts.positionCount,
+                                                     lineCounts.textureCoordinatesCount,
+                                                     lineCounts.normalCount,
+                                                     lineCounts.faceCount * 3));
 
-    std::unordered_map<Vertex, uint32> uniqueVertexes;
+    modelData.meshDataItems.reserve(lineCounts.objectFaceCounts.size());
+
+    MeshData meshData = {};
+    meshData.indexes.reserve(lineCounts.objectFaceCounts[0] * 3);
 
+    uint64 objectIndex = 0;
     while (std::getline(file, line))
     {
         std::istringstream lineStream(line);
@@ -82,11 +304,18 @@ bool ModelFileParser::parseObjFile(std::string filename, ModelData& modelData)
             if (!meshData.name.empty() && !meshData.indexes.empty() && !meshData.materialName.
                 empty())
             {
-                modelData.meshDataItems.push_back(meshData);
+                modelData.meshDataItems.push_back(std::move(meshData));
 
                 meshData = {};
             }
 
+            objectIndex++;
+            if (objectIndex < lineCounts.objectFaceCounts.size())
+            {
+                meshData.indexes.reserve(meshData.indexes.size() + lineCounts.objectFaceCounts[
+                    objectIndex] * 3);
+            }
+
             lineStream >> std::ws;
             std::getline(lineStream, meshData.name);
         }
@@ -113,13 +342,36 @@ bool ModelFileParser::parseObjFile(std::string filename, ModelData& modelData)
                 std::string normalIndex;
                 std::getline(vertexDataIndexesStream, normalIndex, ' ');
 
-                Vertex vertex = {};
+                ObjFaceCorner faceCorner = {};
                 try
                 {
-                    vertex.position = positions[std::stoull(positionIndex) - 1];
-                    vertex.textureCoordinates = textureCoordinatesItems[
-                        std::stoull(textureCoordinatesIndex) - 1];
-                    vertex.normal = normals[std::stoull(normalIndex) - 1];
+                    uint64 index = std::stoull(positionIndex);
+                    if (index == 0 || index > positions.size())
+                    {
+                        return false;
+                    }
+                    faceCorner.positionIndex = static_cast<uint32>(index);
+
+                    // 'v', 'v/vt' and 'v//vn' corners leave the missing indexes empty
+                    if (!textureCoordinatesIndex.empty())
+                    {
+                        index = std::stoull(textureCoordinatesIndex);
+                        if (index == 0 || index > textureCoordinatesItems.size())
+                        {
+                            return false;
+                        }
+                        faceCorner.textureCoordinatesIndex = static_cast<uint32>(index);
+                    }
+
+                    if (!normalIndex.empty())
+                    {
+                        index = std::stoull(normalIndex);
+                        if (index == 0 || index > normals.size())
+                        {
+                            return false;
+                        }
+                        faceCorner.normalIndex = static_cast<uint32>(index);
+                    }
                 }
                 catch (const std::invalid_argument&)
                 {
@@ -130,14 +382,12 @@ bool ModelFileParser::parseObjFile(std::string filename, ModelData& modelData)
                     return false;
                 }
 
-                if (uniqueVertexes.count(vertex) == 0)
-                {
-                    uniqueVertexes[vertex] = modelData.vertexes.size();
-
-                    modelData.vertexes.push_back(vertex);
-                }
+                // Vertexes are only built once the file is read and their count is known
+                bool isInserted = false;
+                uint32 index = uniqueVertexes.findOrInsert(
+                    faceCorner, static_cast<uint32>(uniqueVertexes.getSize()), isInserted);
 
-                meshData.indexes.push_back(uniqueVertexes[vertex]);
+                meshData.indexes.push_back(index);
             }
 
             lineStream >> std::ws;
@@ -157,7 +407,65 @@ bool ModelFileParser::parseObjFile(std::string filename, ModelData& modelData)
             return false;
         }
 
-        modelData.meshDataItems.push_back(meshData);
+        modelData.meshDataItems.push_back(std::move(meshData));
+    }
+
+    return createObjVertexes(uniqueVertexes, positions, textureCoordinatesItems, normals,
+                             modelData);
+}
+
+bool ModelFileParser::parseMappedObjFile(std::string filename, ModelData& modelData)
+{
+    MappedFile file;
+    bool result = file.initialize(filename);
+    if (!result)
+    {
+        return false;
+    }
+
+    auto cursor = reinterpret_cast<const char*>(file.getData());
+    const char* end = cursor + file.getSize();
+
+    bool isMtlFileParsed = false;
+    while (cursor < end && !isMtlFileParsed)
+    {
+        const char* lineEnd = findObjLineEnd(cursor, end);
+
+        const char* keyword = nullptr;
+        uint64 keywordSize = 0;
+        readObjToken(cursor, lineEnd, keyword, keywordSize);
+
+        if (isObjToken(keyword, keywordSize, "mtllib"))
+        {
+            const char* mtlFilename = nullptr;
+            uint64 mtlFilenameSize = 0;
+            readObjRestOfLine(cursor, lineEnd, mtlFilename, mtlFilenameSize);
+
+            result = parseMtlFile(std::string(mtlFilename, mtlFilenameSize), modelData);
+            if (!result)
+            {
+                return false;
+            }
+
+            isMtlFileParsed = true;
+        }
+
+        cursor = getNextObjLine(lineEnd, end);
+    }
+
+    std::vector<ObjChunkData> chunkDataItems;
+    result = parseObjChunks(cursor, end, chunkDataItems);
+    if (!result)
+    {
+        return false;
+    }
+
+    file.release();
+
+    result = mergeObjChunks(chunkDataItems, modelData);
+    if (!result)
+    {
+        return false;
     }
 
     return true;
@@ -171,6 +479,8 @@ bool ModelFileParser::parseMtlFile(std::string filename, ModelData& modelData)
         return false;
     }
 
+    modelData.materialLibraryFilename = filename;
+
     MaterialData materialData = {};
 
     std::string line;
@@ -213,28 +523,656 @@ bool ModelFileParser::parseMtlFile(std::string filename, ModelData& modelData)
         {
             materialData.hasDiffuseColorImage = true;
 
-            std::string diffuseColorFilename;
-
             lineStream >> std::ws;
-            std::getline(lineStream, diffuseColorFilename);
+            std::getline(lineStream, materialData.diffuseColorImageFilename);
 
-            bool result = imageFileParser.parseFile(diffuseColorFilename,
-                                                    materialData.diffuseColorImageData);
-            if (!result)
+        }
+    }
+
+    file.close();
+
+    if (!materialData.name.empty())
+    {
+        modelData.materialDataItems[materialData.name] = materialData;
+    }
+
+    if (!settings.isMaterialImageParsingEnabled)
+    {
+        return true;
+    }
+
+    return parseMaterialImages(modelData);
+}
+
+bool ModelFileParser::parseMaterialImages(ModelData& modelData)
+{
+    auto startTime = std::chrono::steady_clock::now();
+
+    // Request table of the unique image files, materials refer to it by index
+    std::unordered_map<std::string, uint64> requestIndexes;
+    std::vector<std::string> requestFilenames;
+
+    uint32 requestCount = 0;
+    for (const auto& materialDataItem : modelData.materialDataItems)
+    {
+        const MaterialData& materialData = materialDataItem.second;
+        if (!materialData.hasDiffuseColorImage)
+        {
+            continue;
+        }
+
+        auto insertion = requestIndexes.emplace(materialData.diffuseColorImageFilename,
+                                                requestFilenames.size());
+        if (insertion.second)
+        {
+            requestFilenames.push_back(materialData.diffuseColorImageFilename);
+        }
+
+        requestCount++;
+    }
+
+    imageFileParser.setSettings(settings.imageFileParserSettings);
+
+    std::vector<std::shared_ptr<ImageData>> imageDataItems;
+    bool result = imageFileParser.parseFiles(requestFilenames, getThreadCount(), imageDataItems,
+                                             TextureClass::Diffuse);
+    if (!result)
+    {
+        return false;
+    }
+
+    for (auto& materialDataItem : modelData.materialDataItems)
+    {
+        MaterialData& materialData = materialDataItem.second;
+        if (!materialData.hasDiffuseColorImage)
+        {
+            continue;
+        }
+
+        materialData.diffuseColorImageData = imageDataItems[requestIndexes[
+            materialData.diffuseColorImageFilename]];
+    }
+
+    std::chrono::duration<double> imageParsingTime = std::chrono::steady_clock::now() -
+        startTime;
+
+    statistics.imageRequestCount += requestCount;
+    statistics.uniqueImageCount += static_cast<uint32>(requestFilenames.size());
+    statistics.imageParsingTime += imageParsingTime.count();
+    statistics.imageFileParserStatistics = imageFileParser.getStatistics();
+
+    return true;
+}
+
+// Reads blocks of whole lines instead of mapping the file, so the pre-pass doesn't add the file
+// size to the working set before the stream parsing starts
+bool ModelFileParser::countObjFileLines(std::string filename, ObjLineCounts& lineCounts)
+{
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    lineCounts = {};
+
+    std::vector<char> block(ObjMinChunkSize);
+    uint64 blockSize = 0; // B, including the unfinished line of the previous block
+    while (file)
+    {
+        if (blockSize == block.size())
+        {
+            block.resize(block.size() * 2);
+        }
+
+        file.read(block.data() + blockSize, block.size() - blockSize);
+        blockSize += static_cast<uint64>(file.gcount());
+
+        const char* begin = block.data();
+        const char* end = begin + blockSize;
+        if (file)
+        {
+            const char* lineEnd = end;
+            while (lineEnd > begin && lineEnd[-1] != '\n')
             {
-                return false;
+                lineEnd--;
             }
+            end = lineEnd;
         }
+
+        countObjLines(begin, end, lineCounts);
+
+        blockSize -= end - begin;
+        std::memmove(block.data(), end, blockSize);
     }
 
     file.close();
 
-    if (materialData.name.empty())
+    return true;
+}
+
+bool ModelFileParser::createObjVertexes(VertexIndexTable& uniqueVertexes,
+                                        std::vector<DirectX::XMFLOAT3>& positions,
+                                        std::vector<DirectX::XMFLOAT3>& textureCoordinatesItems,
+                                        std::vector<DirectX::XMFLOAT3>& normals,
+                                        ModelData& modelData)
+{
+    modelData.vertexes.resize(uniqueVertexes.getSize());
+
+    // OBJ position indexes of vertexes without a normal, 0 otherwise
+    std::vector<uint32> vertexPositionIndexes(uniqueVertexes.getSize());
+    for (const auto& entry : uniqueVertexes.getEntries())
+    {
+        const ObjFaceCorner& faceCorner = entry.faceCorner;
+        if (faceCorner.positionIndex == 0)
+        {
+            continue;
+        }
+
+        Vertex& vertex = modelData.vertexes[entry.vertexIndex];
+        vertex.position = positions[faceCorner.positionIndex - 1];
+        if (faceCorner.textureCoordinatesIndex > 0)
+        {
+            vertex.textureCoordinates = textureCoordinatesItems[faceCorner.
+                textureCoordinatesIndex - 1];
+        }
+
+        // Missing normals are generated once the temporary arrays are released
+        if (faceCorner.normalIndex > 0)
+        {
+            vertex.normal = normals[faceCorner.normalIndex - 1];
+        }
+        else
+        {
+            vertexPositionIndexes[entry.vertexIndex] = faceCorner.positionIndex;
+        }
+    }
+
+    uint64 positionCount = positions.size();
+
+    uniqueVertexes.clear();
+    positions.clear();
+    positions.shrink_to_fit();
+    textureCoordinatesItems.clear();
+    textureCoordinatesItems.shrink_to_fit();
+    normals.clear();
+    normals.shrink_to_fit();
+
+    return generateMissingNormals(modelData, vertexPositionIndexes, positionCount);
+}
+
+bool ModelFileParser::generateMissingNormals(ModelData& modelData,
+                                             const std::vector<uint32>& vertexPositionIndexes,
+                                             uint64 positionCount)
+{
+    bool hasMissingNormals = false;
+    for (uint32 positionIndex : vertexPositionIndexes)
+    {
+        if (positionIndex != 0)
+        {
+            hasMissingNormals = true;
+
+            break;
+        }
+    }
+    if (!hasMissingNormals)
     {
         return true;
     }
 
-    modelData.materialDataItems[materialData.name] = materialData;
+    TangentFrameGeneratorSettings tangentFrameGeneratorSettings = {};
+    tangentFrameGeneratorSettings.threadCount = getThreadCount();
+    tangentFrameGenerator.setSettings(tangentFrameGeneratorSettings);
+
+    bool result = tangentFrameGenerator.generateNormals(modelData, vertexPositionIndexes,
+                                                        positionCount);
+    if (!result)
+    {
+        return false;
+    }
+
+    statistics.tangentFrameGeneratorStatistics = tangentFrameGenerator.getStatistics();
+
+    return true;
+}
+
+uint32 ModelFileParser::getThreadCount()
+{
+    if (settings.threadCount > 0)
+    {
+        return settings.threadCount;
+    }
+
+    uint32 threadCount = std::thread::hardware_concurrency();
+    if (threadCount == 0)
+    {
+        return 1;
+    }
+
+    return threadCount;
+}
+
+void ModelFileParser::computeBounds(ModelData& modelData)
+{
+    modelData.bounds = getBounds(modelData.vertexes, nullptr, 0);
+
+    for (MeshData& meshData : modelData.meshDataItems)
+    {
+        meshData.bounds = getBounds(modelData.vertexes, meshData.indexes.data(),
+                                    meshData.indexes.size());
+
+        for (MeshObjectData& objectData : meshData.objectDataItems)
+        {
+            objectData.bounds = getEmptyBounds();
+            if (objectData.indexOffset + objectData.indexCount <= meshData.indexes.size())
+            {
+                objectData.bounds = getBounds(modelData.vertexes,
+                                              meshData.indexes.data() + objectData.indexOffset,
+                                              objectData.indexCount);
+            }
+        }
+    }
+}
+
+uint32 ModelFileParser::getCacheFlags()
+{
+    uint32 flags = 0;
+    if (settings.isWeldingEnabled)
+    {
+        flags |= static_cast<uint32>(GspMeshFlags::Welded);
+    }
+    if (settings.isTangentGenerationEnabled)
+    {
+        flags |= static_cast<uint32>(GspMeshFlags::Tangents);
+    }
+    if (settings.isOptimizationEnabled)
+    {
+        flags |= static_cast<uint32>(GspMeshFlags::Optimized);
+    }
+    if (settings.isSimplificationEnabled)
+    {
+        flags |= static_cast<uint32>(GspMeshFlags::Simplified);
+    }
+    if (settings.isMeshletGenerationEnabled)
+    {
+        flags |= static_cast<uint32>(GspMeshFlags::Meshlets);
+    }
+    if (settings.isMeshMergingEnabled)
+    {
+        flags |= static_cast<uint32>(GspMeshFlags::Merged);
+
+        if (settings.meshMergerSettings.isObjectRangeEnabled)
+        {
+            flags |= static_cast<uint32>(GspMeshFlags::ObjectRanges);
+        }
+    }
+
+    return flags;
+}
+
+uint32 ModelFileParser::getCacheSettingsHash()
+{
+    std::vector<uint32> values;
+    if (settings.isWeldingEnabled)
+    {
+        const VertexWelderSettings& vertexWelderSettings = settings.vertexWelderSettings;
+
+        addCacheSettingsValue(vertexWelderSettings.positionEpsilon, values);
+        addCacheSettingsValue(vertexWelderSettings.textureCoordinatesEpsilon, values);
+        addCacheSettingsValue(vertexWelderSettings.normalEpsilon, values);
+    }
+    if (settings.isSimplificationEnabled)
+    {
+        const MeshSimplifierSettings& meshSimplifierSettings = settings.meshSimplifierSettings;
+
+        values.push_back(meshSimplifierSettings.lodCount);
+        addCacheSettingsValue(meshSimplifierSettings.indexRatio, values);
+        addCacheSettingsValue(meshSimplifierSettings.textureCoordinatesWeight, values);
+        addCacheSettingsValue(meshSimplifierSettings.normalWeight, values);
+    }
+
+    uint32 hash = 2166136261; // FNV-1a
+    auto bytes = reinterpret_cast<const unsigned char*>(values.data());
+    for (uint64 i = 0; i < values.size() * sizeof(uint32); i++)
+    {
+        hash = (hash ^ bytes[i]) * 16777619;
+    }
+
+    return hash;
+}
+
+void ModelFileParser::addCacheSettingsValue(float value, std::vector<uint32>& values)
+{
+    uint32 bits = 0;
+    std::memcpy(&bits, &value, sizeof(float));
+
+    values.push_back(bits);
+}
+
+bool ModelFileParser::parseObjChunks(const char* begin, const char* end,
+                                     std::vector<ObjChunkData>& chunkDataItems)
+{
+    uint64 size = end - begin;
+
+    uint64 chunkCount = size / ObjMinChunkSize;
+    if (chunkCount > getThreadCount())
+    {
+        chunkCount = getThreadCount();
+    }
+    if (chunkCount == 0)
+    {
+        chunkCount = 1;
+    }
+
+    std::vector<const char*> chunkBegins(chunkCount + 1);
+    chunkBegins[0] = begin;
+    chunkBegins[chunkCount] = end;
+    for (uint64 i = 1; i < chunkCount; i++)
+    {
+        const char* chunkBegin = begin + size * i / chunkCount;
+        if (chunkBegin < chunkBegins[i - 1])
+        {
+            chunkBegin = chunkBegins[i - 1];
+        }
+
+        // Chunks start right after a newline so no line is split between two chunks
+        chunkBegins[i] = getNextObjLine(findObjLineEnd(chunkBegin - 1, end), end);
+    }
+
+    chunkDataItems = std::vector<ObjChunkData>(chunkCount);
+
+    std::vector<std::thread> threads;
+    threads.reserve(chunkCount - 1);
+    for (uint64 i = 1; i < chunkCount; i++)
+    {
+        threads.emplace_back([&, i]()
+        {
+            chunkDataItems[i].isParsed = parseObjChunk(chunkBegins[i], chunkBegins[i + 1],
+                                                       chunkDataItems[i]);
+        });
+    }
+
+    chunkDataItems[0].isParsed = parseObjChunk(chunkBegins[0], chunkBegins[1], chunkDataItems[0]);
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (const auto& chunkData : chunkDataItems)
+    {
+        if (!chunkData.isParsed)
+        {
+            return false;
+        }
+    }
 
     return true;
 }
+
+bool ModelFileParser::parseObjChunk(const char* begin, const char* end, ObjChunkData& chunkData)
+{
+    ObjLineCounts lineCounts = {};
+    countObjLines(begin, end, lineCounts);
+
+    chunkData.positions.reserve(lineCounts.positionCount);
+    chunkData.textureCoordinatesItems.reserve(lineCounts.textureCoordinatesCount);
+    chunkData.normals.reserve(lineCounts.normalCount);
+    chunkData.faceCorners.reserve(lineCounts.faceCount * 3);
+
+    const char* cursor = begin;
+    while (cursor < end)
+    {
+        const char* lineEnd = findObjLineEnd(cursor, end);
+
+        const char* keyword = nullptr;
+        uint64 keywordSize = 0;
+        readObjToken(cursor, lineEnd, keyword, keywordSize);
+
+        if (isObjToken(keyword, keywordSize, "v"))
+        {
+            DirectX::XMFLOAT3 position = {};
+            readObjFloat3(cursor, lineEnd, position);
+            chunkData.positions.push_back(position);
+        }
+        else if (isObjToken(keyword, keywordSize, "vn"))
+        {
+            DirectX::XMFLOAT3 normal = {};
+            readObjFloat3(cursor, lineEnd, normal);
+            chunkData.normals.push_back(normal);
+        }
+        else if (isObjToken(keyword, keywordSize, "vt"))
+        {
+            DirectX::XMFLOAT3 textureCoordinates = {};
+            readObjFloat3(cursor, lineEnd, textureCoordinates);
+            chunkData.textureCoordinatesItems.push_back(textureCoordinates);
+        }
+        else if (isObjToken(keyword, keywordSize, "o") || isObjToken(keyword, keywordSize,
+            "usemtl"))
+        {
+            ObjChunkEvent event = {};
+            if (isObjToken(keyword, keywordSize, "o"))
+            {
+                event.type = ObjChunkEventType::Object;
+            }
+            else
+            {
+                event.type = ObjChunkEventType::Material;
+            }
+            event.faceCornerIndex = chunkData.faceCorners.size();
+
+            const char* name = nullptr;
+            uint64 nameSize = 0;
+            readObjRestOfLine(cursor, lineEnd, name, nameSize);
+            event.name.assign(name, nameSize);
+
+            chunkData.events.push_back(event);
+        }
+        else if (isObjToken(keyword, keywordSize, "f"))
+        {
+            for (int32 i = 0; i < 3; i++)
+            {
+                uint64 positionIndex = 0;
+                uint64 textureCoordinatesIndex = 0;
+                uint64 normalIndex = 0;
+                bool result = readObjFaceCorner(cursor, lineEnd, positionIndex,
+                                                textureCoordinatesIndex, normalIndex);
+                if (!result)
+                {
+                    return false;
+                }
+
+                if (positionIndex == 0 || positionIndex > UINT32_MAX
+                    || textureCoordinatesIndex > UINT32_MAX || normalIndex > UINT32_MAX)
+                {
+                    return false;
+                }
+
+                int64 positionIndexDeficit = static_cast<int64>(positionIndex) - chunkData.
+                    positions.size();
+                if (positionIndexDeficit > chunkData.positionIndexDeficit)
+                {
+                    chunkData.positionIndexDeficit = positionIndexDeficit;
+                }
+
+                int64 textureCoordinatesIndexDeficit = static_cast<int64>(textureCoordinatesIndex)
+                    - chunkData.textureCoordinatesItems.size();
+                if (textureCoordinatesIndexDeficit > chunkData.textureCoordinatesIndexDeficit)
+                {
+                    chunkData.textureCoordinatesIndexDeficit = textureCoordinatesIndexDeficit;
+                }
+
+                int64 normalIndexDeficit = static_cast<int64>(normalIndex) - chunkData.normals.
+                    size();
+                if (normalIndexDeficit > chunkData.normalIndexDeficit)
+                {
+                    chunkData.normalIndexDeficit = normalIndexDeficit;
+                }
+
+                ObjFaceCorner faceCorner = {};
+                faceCorner.positionIndex = static_cast<uint32>(positionIndex);
+                faceCorner.textureCoordinatesIndex = static_cast<uint32>(textureCoordinatesIndex);
+                faceCorner.normalIndex = static_cast<uint32>(normalIndex);
+                chunkData.faceCorners.push_back(faceCorner);
+            }
+
+            skipObjSpaces(cursor, lineEnd);
+            if (cursor != lineEnd)
+            {
+                return false;
+            }
+        }
+
+        cursor = getNextObjLine(lineEnd, end);
+    }
+
+    return true;
+}
+
+bool ModelFileParser::mergeObjChunks(std::vector<ObjChunkData>& chunkDataItems,
+                                     ModelData& modelData)
+{
+    uint64 positionCount = 0;
+    uint64 textureCoordinatesCount = 0;
+    uint64 normalCount = 0;
+    for (const auto& chunkData : chunkDataItems)
+    {
+        if (chunkData.positionIndexDeficit > static_cast<int64>(positionCount)
+            || chunkData.textureCoordinatesIndexDeficit > static_cast<int64>(
+                textureCoordinatesCount)
+            || chunkData.normalIndexDeficit > static_cast<int64>(normalCount))
+        {
+            return false;
+        }
+
+        positionCount += chunkData.positions.size();
+        textureCoordinatesCount += chunkData.textureCoordinatesItems.size();
+        normalCount += chunkData.normals.size();
+    }
+
+    std::vector<DirectX::XMFLOAT3> positions;
+    positions.reserve(positionCount);
+    std::vector<DirectX::XMFLOAT3> textureCoordinatesItems;
+    textureCoordinatesItems.reserve(textureCoordinatesCount);
+    std::vector<DirectX::XMFLOAT3> normals;
+    normals.reserve(normalCount);
+    for (auto& chunkData : chunkDataItems)
+    {
+        positions.insert(positions.end(), chunkData.positions.begin(), chunkData.positions.end());
+        chunkData.positions.clear();
+        chunkData.positions.shrink_to_fit();
+
+        textureCoordinatesItems.insert(textureCoordinatesItems.end(),
+                                       chunkData.textureCoordinatesItems.begin(),
+                                       chunkData.textureCoordinatesItems.end());
+        chunkData.textureCoordinatesItems.clear();
+        chunkData.textureCoordinatesItems.shrink_to_fit();
+
+        normals.insert(normals.end(), chunkData.normals.begin(), chunkData.normals.end());
+        chunkData.normals.clear();
+        chunkData.normals.shrink_to_fit();
+    }
+
+    uint64 faceCornerCount = 0;
+    for (const auto& chunkData : chunkDataItems)
+    {
+        faceCornerCount += chunkData.faceCorners.size();
+    }
+
+    // Face corners before the first o, then after each o, so every mesh reserves its indexes once
+    std::vector<uint64> objectFaceCornerCounts(1);
+    for (const auto& chunkData : chunkDataItems)
+    {
+        uint64 faceCornerIndex = 0;
+        for (const auto& event : chunkData.events)
+        {
+            objectFaceCornerCounts.back() += event.faceCornerIndex - faceCornerIndex;
+            faceCornerIndex = event.faceCornerIndex;
+
+            if (event.type == ObjChunkEventType::Object)
+            {
+                objectFaceCornerCounts.push_back(0);
+            }
+        }
+        objectFaceCornerCounts.back() += chunkData.faceCorners.size() - faceCornerIndex;
+    }
+
+    VertexIndexTable uniqueVertexes;
+    uniqueVertexes.reserve(getObjVertexCountEstimate(positionCount, textureCoordinatesCount,
+                                                     normalCount, faceCornerCount));
+
+    modelData.meshDataItems.reserve(objectFaceCornerCounts.size());
+
+    MeshData meshData = {};
+    meshData.indexes.reserve(objectFaceCornerCounts[0]);
+
+    // Chunks are replayed in file order, so meshes and indexes come out exactly as if the file
+    // had been read sequentially
+    uint64 objectIndex = 0;
+    for (auto& chunkData : chunkDataItems)
+    {
+        uint64 faceCornerIndex = 0;
+        for (uint64 i = 0; i <= chunkData.events.size(); i++)
+        {
+            uint64 eventFaceCornerIndex = chunkData.faceCorners.size();
+            if (i < chunkData.events.size())
+            {
+                eventFaceCornerIndex = chunkData.events[i].faceCornerIndex;
+            }
+
+            for (; faceCornerIndex < eventFaceCornerIndex; faceCornerIndex++)
+            {
+                // Vertexes are only built once every chunk is replayed and their count is known
+                bool isInserted = false;
+                uint32 index = uniqueVertexes.findOrInsert(
+                    chunkData.faceCorners[faceCornerIndex],
+                    static_cast<uint32>(uniqueVertexes.getSize()), isInserted);
+
+                meshData.indexes.push_back(index);
+            }
+
+            if (i == chunkData.events.size())
+            {
+                break;
+            }
+
+            const ObjChunkEvent& event = chunkData.events[i];
+            if (event.type == ObjChunkEventType::Object)
+            {
+                if (!meshData.name.empty() && !meshData.indexes.empty() && !meshData.materialName.
+                    empty())
+                {
+                    modelData.meshDataItems.push_back(std::move(meshData));
+
+                    meshData = {};
+                }
+
+                objectIndex++;
+                meshData.indexes.reserve(meshData.indexes.size() + objectFaceCornerCounts[
+                    objectIndex]);
+
+                meshData.name = event.name;
+            }
+            else if (event.type == ObjChunkEventType::Material)
+            {
+                meshData.materialName = event.name;
+            }
+        }
+
+        chunkData.faceCorners.clear();
+        chunkData.faceCorners.shrink_to_fit();
+    }
+
+    if (!meshData.name.empty())
+    {
+        if (meshData.indexes.empty())
+        {
+            return false;
+        }
+
+        modelData.meshDataItems.push_back(std::move(meshData));
+    }
+
+    return createObjVertexes(uniqueVertexes, positions, textureCoordinatesItems, normals,
+                             modelData);
+}
@@ -2,26 +2,84 @@
 #include <fstream>
 #include <sstream>
 
+#include <cstring>
+
 #include <vector>
-#include <unordered_map>
 
 #include <string>
 
+#include <chrono>
+#include <thread>
+
 #include "Vertex.h"
 
+#include "MappedFile.h"
+#include "VertexIndexTable.h"
+#include "ModelCache.h"
+#include "VertexWelder.h"
+#include "MeshOptimizer.h"
+#include "MeshSimplifier.h"
+#include "MeshletBuilder.h"
+#include "MeshMerger.h"
+#include "TangentFrameGenerator.h"
+
 #include "ImageFileParser.h"
 
 #include "FileParserUtility.h"
+#include "ProcessMemoryUtility.h"
 #include "ModelFileParserUtility.h"
 #include "ImageFileParserUtility.h"
+#include "ObjUtility.h"
 
 class ModelFileParser
 {
     ImageFileParser imageFileParser;
 
+    ModelCache modelCache;
+    VertexWelder vertexWelder;
+    MeshOptimizer meshOptimizer;
+    MeshSimplifier meshSimplifier;
+    MeshletBuilder meshletBuilder;
+    MeshMerger meshMerger;
+    TangentFrameGenerator tangentFrameGenerator;
+
+    ModelFileParserSettings settings;
+
+    ModelFileParserStatistics statistics;
+
 public:
+    ModelFileParser();
+
+    ModelFileParserSettings getSettings();
+    void setSettings(ModelFileParserSettings settings);
+
+    ModelFileParserStatistics getStatistics();
+
     bool parseFile(std::string filename, ModelData& modelData);
 
     bool parseObjFile(std::string filename, ModelData& modelData);
+    bool parseMappedObjFile(std::string filename, ModelData& modelData);
     bool parseMtlFile(std::string filename, ModelData& modelData);
+
+private:
+    bool parseMaterialImages(ModelData& modelData);
+    bool countObjFileLines(std::string filename, ObjLineCounts& lineCounts);
+    bool createObjVertexes(VertexIndexTable& uniqueVertexes,
+                           std::vector<DirectX::XMFLOAT3>& positions,
+                           std::vector<DirectX::XMFLOAT3>& textureCoordinatesItems,
+                           std::vector<DirectX::XMFLOAT3>& normals, ModelData& modelData);
+    bool generateMissingNormals(ModelData& modelData,
+                                const std::vector<uint32>& vertexPositionIndexes,
+                                uint64 positionCount);
+
+    uint32 getThreadCount();
+    void computeBounds(ModelData& modelData);
+    uint32 getCacheFlags();
+    uint32 getCacheSettingsHash();
+    void addCacheSettingsValue(float value, std::vector<uint32>& values);
+
+    bool parseObjChunks(const char* begin, const char* end,
+                        std::vector<ObjChunkData>& chunkDataItems);
+    bool parseObjChunk(const char* begin, const char* end, ObjChunkData& chunkData);
+    bool mergeObjChunks(std::vector<ObjChunkData>& chunkDataItems, ModelData& modelData);
 };
@@ -0,0 +1,195 @@
+#include "ModelFileParserBenchmark.h"
+
+ModelFileParserBenchmark::ModelFileParserBenchmark() : settings{}
+{
+    settings.repeatCount = 1;
+}
+
+BenchmarkSettings ModelFileParserBenchmark::getSettings()
+{
+    return settings;
+}
+
+void ModelFileParserBenchmark::setSettings(BenchmarkSettings settings)
+{
+    this->settings = settings;
+}
+
+bool ModelFileParserBenchmark::run(const std::string& filename)
+{
+    ModelFileParserStatistics streamStatistics = {};
+    bool result = measureMode(filename, ModelFileParserMode::Stream, streamStatistics);
+    if (!result)
+    {
+        std::printf("Failed to parse %s\n", filename.c_str());
+
+        return false;
+    }
+
+    ModelFileParserStatistics mappedStatistics = {};
+    result = measureMode(filename, ModelFileParserMode::MappedFile, mappedStatistics);
+    if (!result)
+    {
+        std::printf("Failed to parse %s\n", filename.c_str());
+
+        return false;
+    }
+
+    // Once more in this process, for the models to compare
+    ModelFileParserStatistics statistics = {};
+    ModelData streamModelData;
+    result = parseFile(filename, ModelFileParserMode::Stream, 1, statistics, streamModelData);
+    ModelData mappedModelData;
+    result = result && parseFile(filename, ModelFileParserMode::MappedFile, 1, statistics,
+                                 mappedModelData);
+    if (!result)
+    {
+        std::printf("Failed to parse %s\n", filename.c_str());
+
+        return false;
+    }
+
+    uint64 indexCount = 0;
+    for (const MeshData& meshData : mappedModelData.meshDataItems)
+    {
+        indexCount += meshData.indexes.size();
+    }
+
+    std::printf("OBJ parsing: %s\n", filename.c_str());
+    std::printf("  size: %.2f MB, %llu vertexes, %llu triangles\n",
+                statistics.fileSize / (1024.0 * 1024.0),
+                static_cast<unsigned long long>(mappedModelData.vertexes.size()),
+                static_cast<unsigned long long>(indexCount / 3));
+    printStatistics("stream", streamStatistics);
+    printStatistics("mapped file", mappedStatistics);
+    if (mappedStatistics.objParsingTime > 0.0)
+    {
+        std::printf("  speedup: %.2fx\n",
+                    streamStatistics.objParsingTime / mappedStatistics.objParsingTime);
+    }
+
+    // Both modes are meant to give the same model
+    if (!isModelDataParsedEqual(streamModelData, mappedModelData))
+    {
+        std::printf("  the modes parsed different models\n");
+
+        return false;
+    }
+
+    return true;
+}
+
+bool ModelFileParserBenchmark::runMode(const std::string& filename, ModelFileParserMode mode)
+{
+    ModelFileParserStatistics statistics = {};
+    ModelData modelData;
+    bool result = parseFile(filename, mode, settings.repeatCount, statistics, modelData);
+    if (!result)
+    {
+        return false;
+    }
+
+    std::printf("%.9f %.3f %d %llu\n", statistics.objParsingTime, statistics.objThroughput,
+                statistics.isPeakWorkingSetIncreaseMeasured ? 1 : 0,
+                static_cast<unsigned long long>(statistics.peakWorkingSetIncrease));
+
+    return true;
+}
+
+bool ModelFileParserBenchmark::measureMode(const std::string& filename, ModelFileParserMode mode,
+                                           ModelFileParserStatistics& statistics)
+{
+    char executableFilename[MAX_PATH] = {};
+    DWORD size = GetModuleFileNameA(nullptr, executableFilename, MAX_PATH);
+    if (size == 0 || size == MAX_PATH)
+    {
+        return false;
+    }
+
+    const char* command = ModelFileParserBenchmarkStreamCommand;
+    if (mode == ModelFileParserMode::MappedFile)
+    {
+        command = ModelFileParserBenchmarkMappedCommand;
+    }
+
+    // cmd strips the outer quotes of a line that has more than two, so the whole line is quoted
+    std::string commandLine = "\"\"" + std::string(executableFilename) + "\" --repeats " +
+        std::to_string(settings.repeatCount) + " --threads " +
+        std::to_string(settings.threadCount) + " " + command + " \"" + filename + "\"\"";
+
+    FILE* pipe = _popen(commandLine.c_str(), "r");
+    if (pipe == nullptr)
+    {
+        return false;
+    }
+
+    int32 isPeakWorkingSetIncreaseMeasured = 0;
+    unsigned long long peakWorkingSetIncrease = 0;
+    int32 valueCount = std::fscanf(pipe, "%lf %lf %d %llu", &statistics.objParsingTime,
+                                   &statistics.objThroughput, &isPeakWorkingSetIncreaseMeasured,
+                                   &peakWorkingSetIncrease);
+    if (_pclose(pipe) != 0 || valueCount != 4)
+    {
+        return false;
+    }
+
+    statistics.isPeakWorkingSetIncreaseMeasured = isPeakWorkingSetIncreaseMeasured != 0;
+    statistics.peakWorkingSetIncrease = peakWorkingSetIncrease;
+
+    return true;
+}
+
+bool ModelFileParserBenchmark::parseFile(const std::string& filename, ModelFileParserMode mode,
+                                         uint32 repeatCount,
+                                         ModelFileParserStatistics& statistics,
+                                         ModelData& modelData)
+{
+    ModelFileParser modelFileParser;
+    ModelFileParserSettings parserSettings = modelFileParser.getSettings();
+    parserSettings.mode = mode;
+    parserSettings.threadCount = settings.threadCount;
+    parserSettings.isMaterialImageParsingEnabled = false;
+    parserSettings.isCacheEnabled = false;
+    parserSettings.isWeldingEnabled = false;
+    parserSettings.isOptimizationEnabled = false;
+    parserSettings.isSimplificationEnabled = false;
+    parserSettings.isMeshletGenerationEnabled = false;
+    parserSettings.isMeshMergingEnabled = false;
+    parserSettings.isTangentGenerationEnabled = false;
+    modelFileParser.setSettings(parserSettings);
+
+    for (uint32 i = 0; i < repeatCount; i++)
+    {
+        ModelData runModelData;
+        bool result = modelFileParser.parseFile(filename, runModelData);
+        if (!result)
+        {
+            return false;
+        }
+
+        ModelFileParserStatistics runStatistics = modelFileParser.getStatistics();
+        if (i == 0 || runStatistics.objParsingTime < statistics.objParsingTime)
+        {
+            statistics = runStatistics;
+        }
+        if (i == 0)
+        {
+            modelData = std::move(runModelData);
+        }
+    }
+
+    return true;
+}
+
+void ModelFileParserBenchmark::printStatistics(const char* modeName,
+                                               const ModelFileParserStatistics& statistics)
+{
+    std::printf("  %s: %.3f s, %.1f MB/s", modeName, statistics.objParsingTime,
+                statistics.objThroughput);
+    if (statistics.isPeakWorkingSetIncreaseMeasured)
+    {
+        std::printf(", peak working set +%.1f MB",
+                    statistics.peakWorkingSetIncrease / (1024.0 * 1024.0));
+    }
+    std::printf("\n");
+}
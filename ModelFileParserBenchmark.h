@@ -0,0 +1,42 @@
+#pragma once
+#define NOMINMAX
+
+#include <Windows.h>
+
+#include <cstdio>
+
+#include <string>
+
+#include "ModelFileParser.h"
+
+#include "BenchmarkUtility.h"
+#include "IntUtility.h"
+#include "ModelFileParserUtility.h"
+
+// Parses an OBJ file in the stream and mapped file modes with the cache, the material images and
+// every mesh stage disabled, and prints the throughput of the text parsing of both. Each mode is
+// timed in a process of its own, so the peak working set it prints belongs to that mode alone.
+// The modes must give the same model
+class ModelFileParserBenchmark
+{
+    BenchmarkSettings settings;
+
+public:
+    ModelFileParserBenchmark();
+
+    BenchmarkSettings getSettings();
+    void setSettings(BenchmarkSettings settings);
+
+    bool run(const std::string& filename);
+    // Of a process started by run, prints the statistics of the mode for run to read
+    bool runMode(const std::string& filename, ModelFileParserMode mode);
+
+private:
+    // Runs the benchmark again with the command of the mode and reads what runMode printed
+    bool measureMode(const std::string& filename, ModelFileParserMode mode,
+                     ModelFileParserStatistics& statistics);
+    // Of the fastest of repeatCount runs
+    bool parseFile(const std::string& filename, ModelFileParserMode mode, uint32 repeatCount,
+                   ModelFileParserStatistics& statistics, ModelData& modelData);
+    void printStatistics(const char* modeName, const ModelFileParserStatistics& statistics);
+};
@@ -0,0 +1,209 @@
+#include "ModelFileParserTests.h"
+
+ModelFileParserTests::ModelFileParserTests() : statistics{}
+{
+}
+
+TestStatistics ModelFileParserTests::getStatistics()
+{
+    return statistics;
+}
+
+void ModelFileParserTests::run()
+{
+    statistics = {};
+
+    testChunkedFile();
+
+    std::remove(ModelFileParserTestFilename);
+    std::remove(ModelFileParserTestMtlFilename);
+}
+
+void ModelFileParserTests::testChunkedFile()
+{
+    // Large enough for 7 chunks, with objects both smaller and larger than a chunk
+    const uint32 objectCount = 12;
+    bool result = writeObjFile(8 * ObjMinChunkSize, objectCount);
+    checkTest(result, "ModelFileParser chunked file written", statistics);
+    if (!result)
+    {
+        return;
+    }
+
+    ModelData streamModelData;
+    result = parseFile(ModelFileParserMode::Stream, 1, streamModelData);
+    checkTest(result, "ModelFileParser chunked file (stream)", statistics);
+    if (!result)
+    {
+        return;
+    }
+
+    result = streamModelData.meshDataItems.size() == objectCount;
+    for (uint32 i = 0; i < streamModelData.meshDataItems.size() && result; i++)
+    {
+        result = streamModelData.meshDataItems[i].name == "Object " + std::to_string(i);
+    }
+    checkTest(result, "ModelFileParser chunked file meshes (stream)", statistics);
+
+    const uint32 threadCounts[] = { 1, 2, 7 };
+    for (uint32 threadCount : threadCounts)
+    {
+        std::string name = "ModelFileParser chunked file (mapped, " + std::to_string(threadCount)
+            + " threads)";
+
+        ModelData mappedModelData;
+        result = parseFile(ModelFileParserMode::MappedFile, threadCount, mappedModelData);
+        checkTest(result, name, statistics);
+        if (result)
+        {
+            checkTest(isModelDataParsedEqual(streamModelData, mappedModelData),
+                      name + " matches the stream mode", statistics);
+        }
+    }
+}
+
+bool ModelFileParserTests::writeObjFile(uint64 minSize, uint32 objectCount)
+{
+    std::ofstream mtlStream(ModelFileParserTestMtlFilename, std::ios::binary | std::ios::trunc);
+    if (!mtlStream.is_open())
+    {
+        return false;
+    }
+    for (uint32 i = 0; i < 3; i++)
+    {
+        mtlStream << "newmtl Material " << i << "\nKd 0.5 0.5 0.5\n";
+    }
+    mtlStream.close();
+
+    std::string file = "mtllib " + std::string(ModelFileParserTestMtlFilename) + "\n";
+
+    // Every fourth object takes four times the bytes of the others
+    uint64 weightSum = 0;
+    for (uint32 i = 0; i < objectCount; i++)
+    {
+        weightSum += i % 4 == 0 ? 4 : 1;
+    }
+
+    uint32 seed = 1;
+    auto getRandom = [&seed]()
+    {
+        seed = seed * 1664525 + 1013904223;
+
+        return seed >> 8;
+    };
+    // Mostly near the end, so vertexes repeat, sometimes anywhere in the file
+    auto getIndex = [&getRandom](uint64 count)
+    {
+        uint64 range = count;
+        if (getRandom() % 8 != 0 && range > 64)
+        {
+            range = 64;
+        }
+
+        return count - getRandom() % range;
+    };
+
+    const char* const attributeKeywords[] = { "v", "vt", "vn" };
+
+    uint64 attributeCount = 0;
+    char line[128];
+    for (uint32 i = 0; i < objectCount; i++)
+    {
+        uint64 objectBegin = file.size();
+        uint64 objectSize = minSize * (i % 4 == 0 ? 4 : 1) / weightSum;
+
+        file += "o Object " + std::to_string(i) + "\n";
+        file += "usemtl Material " + std::to_string(i % 3) + "\n";
+
+        bool isMaterialSwitched = false;
+        while (file.size() - objectBegin < objectSize
+               || (i + 1 == objectCount && file.size() < minSize))
+        {
+            // The material changes midway through some objects
+            if (!isMaterialSwitched && i % 2 == 1 && file.size() - objectBegin > objectSize / 2)
+            {
+                file += "usemtl Material " + std::to_string((i + 1) % 3) + "\n";
+
+                isMaterialSwitched = true;
+            }
+
+            for (const char* keyword : attributeKeywords)
+            {
+                for (uint32 j = 0; j < 8; j++)
+                {
+                    std::snprintf(line, sizeof(line), "%s %.4f %.4f %.4f\n", keyword,
+                                  getRandom() % 20000 / 1000.0f - 10.0f,
+                                  getRandom() % 20000 / 1000.0f - 10.0f,
+                                  getRandom() % 20000 / 1000.0f - 10.0f);
+                    file += line;
+                }
+            }
+            attributeCount += 8;
+
+            for (uint32 j = 0; j < 20; j++)
+            {
+                file += "f";
+
+                uint32 cornerFormat = getRandom() % 4;
+                for (uint32 k = 0; k < 3; k++)
+                {
+                    unsigned long long positionIndex = getIndex(attributeCount);
+                    unsigned long long textureCoordinatesIndex = getIndex(attributeCount);
+                    unsigned long long normalIndex = getIndex(attributeCount);
+                    if (cornerFormat == 0)
+                    {
+                        std::snprintf(line, sizeof(line), " %llu", positionIndex);
+                    }
+                    else if (cornerFormat == 1)
+                    {
+                        std::snprintf(line, sizeof(line), " %llu/%llu", positionIndex,
+                                      textureCoordinatesIndex);
+                    }
+                    else if (cornerFormat == 2)
+                    {
+                        std::snprintf(line, sizeof(line), " %llu//%llu", positionIndex,
+                                      normalIndex);
+                    }
+                    else
+                    {
+                        std::snprintf(line, sizeof(line), " %llu/%llu/%llu", positionIndex,
+                                      textureCoordinatesIndex, normalIndex);
+                    }
+                    file += line;
+                }
+
+                file += "\n";
+            }
+        }
+    }
+
+    std::ofstream stream(ModelFileParserTestFilename, std::ios::binary | std::ios::trunc);
+    if (!stream.is_open())
+    {
+        return false;
+    }
+    stream.write(file.data(), file.size());
+    stream.close();
+
+    return true;
+}
+
+bool ModelFileParserTests::parseFile(ModelFileParserMode mode, uint32 threadCount,
+                                     ModelData& modelData)
+{
+    ModelFileParser modelFileParser;
+    ModelFileParserSettings settings = modelFileParser.getSettings();
+    settings.mode = mode;
+    settings.threadCount = threadCount;
+    settings.isMaterialImageParsingEnabled = false;
+    settings.isCacheEnabled = false;
+    settings.isWeldingEnabled = false;
+    settings.isOptimizationEnabled = false;
+    settings.isSimplificationEnabled = false;
+    settings.isMeshletGenerationEnabled = false;
+    settings.isMeshMergingEnabled = false;
+    settings.isTangentGenerationEnabled = false;
+    modelFileParser.setSettings(settings);
+
+    return modelFileParser.parseFile(ModelFileParserTestFilename, modelData);
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <cstdio>
+#include <fstream>
+
+#include <vector>
+
+#include <string>
+
+#include "ModelFileParser.h"
+
+#include "IntUtility.h"
+#include "ModelFileParserUtility.h"
+#include "ObjUtility.h"
+#include "TestUtility.h"
+
+constexpr const char* ModelFileParserTestFilename = "GSPTests.obj";
+constexpr const char* ModelFileParserTestMtlFilename = "GSPTests.mtl";
+
+// Parses a synthetic OBJ file, written to the working directory, in the stream mode and in the
+// mapped file mode split into chunks of 1, 2 and 7 threads. Objects and material switches span
+// chunk boundaries, faces refer to data of earlier chunks and mix 'v', 'v/vt', 'v//vn' and
+// 'v/vt/vn' corners, and every mode must give the same model
+class ModelFileParserTests
+{
+    TestStatistics statistics;
+
+public:
+    ModelFileParserTests();
+
+    TestStatistics getStatistics();
+
+    void run();
+
+private:
+    void testChunkedFile();
+
+    // Of at least minSize bytes, objectCount objects named "Object <i>"
+    bool writeObjFile(uint64 minSize, uint32 objectCount);
+    // With the cache, the material images and every mesh stage disabled
+    bool parseFile(ModelFileParserMode mode, uint32 threadCount, ModelData& modelData);
+};
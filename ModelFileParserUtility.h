@@ -1,4 +1,8 @@
 #pragma once
+#include <memory>
+
+#include <cstring>
+
 #include <vector>
 #include <unordered_map>
 
@@ -6,7 +10,83 @@
 
 #include "Vertex.h"
 
+#include "IntUtility.h"
+
+#include "BoundsUtility.h"
 #include "ImageFileParserUtility.h"
+#include "MeshOptimizerUtility.h"
+#include "MeshSimplifierUtility.h"
+#include "MeshletUtility.h"
+#include "MeshMergerUtility.h"
+#include "VertexWelderUtility.h"
+#include "TangentFrameGeneratorUtility.h"
+
+enum class ModelFileParserMode : uint8
+{
+    Undefined,
+
+    Stream,
+    MappedFile,
+};
+
+struct ModelFileParserSettings
+{
+    ModelFileParserMode mode;
+
+    uint32 threadCount; // 0 for one thread per hardware thread
+
+    bool isMaterialImageParsingEnabled; // map_Kd images decoded with the model
+    ImageFileParserSettings imageFileParserSettings;
+
+    bool isCacheEnabled;
+
+    bool isWeldingEnabled; // nearly equal vertexes
+    VertexWelderSettings vertexWelderSettings;
+
+    bool isOptimizationEnabled; // vertex cache and vertex fetch order
+
+    bool isSimplificationEnabled; // LOD levels
+    MeshSimplifierSettings meshSimplifierSettings;
+
+    bool isMeshletGenerationEnabled; // meshlets of the full meshes for cluster culling
+
+    bool isMeshMergingEnabled; // one mesh per material
+    MeshMergerSettings meshMergerSettings;
+
+    bool isTangentGenerationEnabled; // for normal mapping
+};
+
+struct ModelFileParserStatistics
+{
+    uint64 fileSize; // B
+    double parsingTime; // s
+    double throughput; // MB/s
+    // Of the OBJ and MTL text alone, without the images, mesh stages and bounds. 0 when cached
+    double objParsingTime; // s
+    double objThroughput; // MB/s
+
+    // Of the process, the peak is since it started and can't be reset, so the parsing only has a
+    // peak of its own when it raises the peak of the process
+    uint64 startWorkingSetSize; // B
+    uint64 startPeakWorkingSetSize; // B
+    uint64 peakWorkingSetSize; // B
+    bool isPeakWorkingSetIncreaseMeasured; // the parsing raised the peak of the process
+    uint64 peakWorkingSetIncrease; // B, over the start working set, 0 when not measured
+
+    bool isCached; // loaded from the .gspmesh file
+
+    uint32 imageRequestCount; // map_Kd references
+    uint32 uniqueImageCount; // decoded files
+    double imageParsingTime; // s
+    ImageFileParserStatistics imageFileParserStatistics;
+
+    VertexWelderStatistics vertexWelderStatistics;
+    MeshOptimizerStatistics meshOptimizerStatistics;
+    MeshSimplifierStatistics meshSimplifierStatistics;
+    MeshletBuilderStatistics meshletBuilderStatistics;
+    MeshMergerStatistics meshMergerStatistics;
+    TangentFrameGeneratorStatistics tangentFrameGeneratorStatistics; // normals missing in the file
+};
 
 struct MaterialData
 {
@@ -18,7 +98,8 @@ struct MaterialData
 
     ImageData ambientColorImageData;
     bool hasDiffuseColorImage;
-    ImageData diffuseColorImageData;
+    std::shared_ptr<ImageData> diffuseColorImageData; // shared by materials with the same file
+    std::string diffuseColorImageFilename;
     ImageData specularColorImageData;
 
     float opacity; // Tr / inverted d;
@@ -41,11 +122,55 @@ struct MaterialData
     std::string bumpFilename;
 };
 
+struct MeshLodData
+{
+    std::vector<uint32> indexes;
+
+    float error; // model units
+};
+
+struct MeshletData
+{
+    uint32 vertexOffset; // into MeshData::meshletVertexes
+    uint32 vertexCount;
+    uint32 triangleOffset; // into MeshData::meshletTriangles, in triangles
+    uint32 triangleCount;
+
+    DirectX::XMFLOAT3 center;
+    float radius;
+
+    // The meshlet faces away from every view position p with
+    // dot(normalize(coneApex - p), coneAxis) >= coneCutoff
+    DirectX::XMFLOAT3 coneApex;
+    DirectX::XMFLOAT3 coneAxis;
+    float coneCutoff;
+};
+
+// Index range of an object merged into a mesh of its material
+struct MeshObjectData
+{
+    std::string name;
+
+    uint64 indexOffset;
+    uint64 indexCount;
+
+    Bounds bounds; // model space
+};
+
 struct MeshData
 {
     std::string name;
 
     std::vector<uint32> indexes;
+    std::vector<MeshLodData> lodDataItems; // coarser levels after the full mesh
+
+    std::vector<MeshletData> meshletDataItems;
+    std::vector<uint32> meshletVertexes; // model vertex indexes
+    std::vector<uint8> meshletTriangles; // 3 meshlet vertex indexes per triangle
+
+    std::vector<MeshObjectData> objectDataItems; // only kept on request by the mesh merger
+
+    Bounds bounds; // model space
 
     std::string materialName;
 };
@@ -53,8 +178,52 @@ struct MeshData
 struct ModelData
 {
     std::vector<Vertex> vertexes;
+    std::vector<DirectX::XMFLOAT4> tangents; // empty or one per vertex, w is the handedness
 
     std::vector<MeshData> meshDataItems;
 
+    Bounds bounds; // model space
+
     std::unordered_map<std::string, MaterialData> materialDataItems;
+
+    std::string materialLibraryFilename;
 };
+
+// Compares what OBJ parsing produces: the vertex bytes, the tangents and every mesh's name,
+// material and indexes
+inline bool isModelDataParsedEqual(const ModelData& modelData, const ModelData& otherModelData)
+{
+    if (modelData.vertexes.size() != otherModelData.vertexes.size()
+        || modelData.tangents.size() != otherModelData.tangents.size()
+        || modelData.meshDataItems.size() != otherModelData.meshDataItems.size()
+        || modelData.materialLibraryFilename != otherModelData.materialLibraryFilename)
+    {
+        return false;
+    }
+
+    if (!modelData.vertexes.empty() && std::memcmp(modelData.vertexes.data(),
+        otherModelData.vertexes.data(), modelData.vertexes.size() * sizeof(Vertex)) != 0)
+    {
+        return false;
+    }
+    if (!modelData.tangents.empty() && std::memcmp(modelData.tangents.data(),
+        otherModelData.tangents.data(),
+        modelData.tangents.size() * sizeof(DirectX::XMFLOAT4)) != 0)
+    {
+        return false;
+    }
+
+    for (uint64 i = 0; i < modelData.meshDataItems.size(); i++)
+    {
+        const MeshData& meshData = modelData.meshDataItems[i];
+        const MeshData& otherMeshData = otherModelData.meshDataItems[i];
+        if (meshData.name != otherMeshData.name
+            || meshData.materialName != otherMeshData.materialName
+            || meshData.indexes != otherMeshData.indexes)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,434 @@
+#pragma once
+#include <DirectXMath.h>
+
+#include <cstdlib>
+#include <cstring>
+
+#include <vector>
+
+#include <string>
+
+#include "IntUtility.h"
+
+constexpr int32 ObjMaxNumberLength = 64;
+
+constexpr uint64 ObjMinChunkSize = 1024 * 1024; // B
+
+constexpr uint64 ObjMaxExactFloatMantissa = 1 << 24;
+constexpr int32 ObjMaxExactFloatExponent = 10;
+
+constexpr float ObjExactPowersOf10[ObjMaxExactFloatExponent + 1] = {
+    1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f
+};
+
+struct ObjFaceCorner
+{
+    uint32 positionIndex; // 1-based
+    uint32 textureCoordinatesIndex; // 1-based, 0 when the face has none
+    uint32 normalIndex; // 1-based, 0 when the face has none
+};
+
+enum class ObjChunkEventType : uint8
+{
+    Undefined,
+
+    Object, // o
+    Material, // usemtl
+};
+
+struct ObjChunkEvent
+{
+    ObjChunkEventType type;
+    uint64 faceCornerIndex; // face corners of the chunk read before the event
+
+    std::string name;
+};
+
+// Taken by a pre-pass so every array of the import is reserved once
+struct ObjLineCounts
+{
+    uint64 positionCount; // v
+    uint64 textureCoordinatesCount; // vt
+    uint64 normalCount; // vn
+    uint64 faceCount; // f
+
+    std::vector<uint64> objectFaceCounts; // faces before the first o, then after each o
+};
+
+struct ObjChunkData
+{
+    bool isParsed;
+
+    std::vector<DirectX::XMFLOAT3> positions;
+    std::vector<DirectX::XMFLOAT3> textureCoordinatesItems;
+    std::vector<DirectX::XMFLOAT3> normals;
+
+    std::vector<ObjFaceCorner> faceCorners;
+
+    std::vector<ObjChunkEvent> events;
+
+    // Largest (index - items of the chunk read before it), the preceding chunks have to provide
+    // at least that many items for every index to point backwards like in a sequential read
+    int64 positionIndexDeficit;
+    int64 textureCoordinatesIndexDeficit;
+    int64 normalIndexDeficit;
+};
+
+inline bool isObjSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+inline bool isObjDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+inline const char* findObjLineEnd(const char* cursor, const char* end)
+{
+    auto lineEnd = static_cast<const char*>(std::memchr(cursor, '\n', end - cursor));
+    if (!lineEnd)
+    {
+        return end;
+    }
+
+    return lineEnd;
+}
+
+inline void skipObjSpaces(const char*& cursor, const char* end)
+{
+    while (cursor < end && isObjSpace(*cursor))
+    {
+        cursor++;
+    }
+}
+
+// Reads the next whitespace-separated token of the line without copying it
+inline bool readObjToken(const char*& cursor, const char* end, const char*& token,
+                         uint64& tokenSize)
+{
+    skipObjSpaces(cursor, end);
+
+    token = cursor;
+    while (cursor < end && !isObjSpace(*cursor))
+    {
+        cursor++;
+    }
+    tokenSize = cursor - token;
+
+    return tokenSize > 0;
+}
+
+inline bool isObjToken(const char* token, uint64 tokenSize, const char* expected)
+{
+    uint64 expectedSize = std::strlen(expected);
+
+    return tokenSize == expectedSize && std::memcmp(token, expected, expectedSize) == 0;
+}
+
+// Returns the rest of the line with leading spaces and a trailing '\r' removed
+inline void readObjRestOfLine(const char*& cursor, const char* end, const char*& rest,
+                              uint64& restSize)
+{
+    skipObjSpaces(cursor, end);
+
+    const char* restEnd = end;
+    if (restEnd > cursor && restEnd[-1] == '\r')
+    {
+        restEnd--;
+    }
+
+    rest = cursor;
+    restSize = restEnd - cursor;
+
+    cursor = end;
+}
+
+inline bool readObjIndex(const char*& cursor, const char* end, uint64& index)
+{
+    if (cursor >= end || !isObjDigit(*cursor))
+    {
+        return false;
+    }
+
+    index = 0;
+    while (cursor < end && isObjDigit(*cursor))
+    {
+        index = index * 10 + (*cursor - '0');
+        cursor++;
+    }
+
+    return true;
+}
+
+// Parses a float in place. Short decimal numbers, which are what exporters write, are converted
+// with a single exactly rounded multiplication or division; anything else goes through strtof
+// on a stack copy so the result always matches the stream extraction
+inline bool readObjFloat(const char*& cursor, const char* end, float& value)
+{
+    skipObjSpaces(cursor, end);
+
+    const char* number = cursor;
+
+    bool isNegative = false;
+    if (cursor < end && (*cursor == '-' || *cursor == '+'))
+    {
+        isNegative = *cursor == '-';
+        cursor++;
+    }
+
+    uint64 mantissa = 0;
+    int32 mantissaDigitCount = 0;
+    int32 exponent = 0;
+    bool hasDigits = false;
+
+    while (cursor < end && isObjDigit(*cursor))
+    {
+        if (mantissaDigitCount < 19)
+        {
+            mantissa = mantissa * 10 + (*cursor - '0');
+            if (mantissa != 0)
+            {
+                mantissaDigitCount++;
+            }
+        }
+        else
+        {
+            exponent++;
+        }
+
+        hasDigits = true;
+        cursor++;
+    }
+
+    if (cursor < end && *cursor == '.')
+    {
+        cursor++;
+
+        while (cursor < end && isObjDigit(*cursor))
+        {
+            if (mantissaDigitCount < 19)
+            {
+                mantissa = mantissa * 10 + (*cursor - '0');
+                if (mantissa != 0)
+                {
+                    mantissaDigitCount++;
+                }
+                exponent--;
+            }
+
+            hasDigits = true;
+            cursor++;
+        }
+    }
+
+    if (!hasDigits)
+    {
+        cursor = number;
+
+        return false;
+    }
+
+    bool isSimple = true;
+    if (cursor < end && (*cursor == 'e' || *cursor == 'E'))
+    {
+        isSimple = false;
+    }
+    else if (cursor < end && !isObjSpace(*cursor))
+    {
+        isSimple = false;
+    }
+
+    if (isSimple && mantissa <= ObjMaxExactFloatMantissa && exponent >= -ObjMaxExactFloatExponent
+        && exponent <= ObjMaxExactFloatExponent)
+    {
+        value = static_cast<float>(mantissa);
+        if (exponent < 0)
+        {
+            value /= ObjExactPowersOf10[-exponent];
+        }
+        else
+        {
+            value *= ObjExactPowersOf10[exponent];
+        }
+
+        if (isNegative)
+        {
+            value = -value;
+        }
+
+        return true;
+    }
+
+    const char* numberEnd = number;
+    while (numberEnd < end && !isObjSpace(*numberEnd))
+    {
+        numberEnd++;
+    }
+
+    uint64 numberSize = numberEnd - number;
+    if (numberSize >= ObjMaxNumberLength)
+    {
+        cursor = number;
+
+        return false;
+    }
+
+    char buffer[ObjMaxNumberLength];
+    std::memcpy(buffer, number, numberSize);
+    buffer[numberSize] = '\0';
+
+    char* bufferEnd = nullptr;
+    value = std::strtof(buffer, &bufferEnd);
+    if (bufferEnd == buffer)
+    {
+        cursor = number;
+
+        return false;
+    }
+
+    cursor = number + (bufferEnd - buffer);
+
+    return true;
+}
+
+// Components missing from the line are left zeroed, like the stream extraction does
+inline bool readObjFloat3(const char*& cursor, const char* end, DirectX::XMFLOAT3& value)
+{
+    value = {};
+
+    if (!readObjFloat(cursor, end, value.x))
+    {
+        return false;
+    }
+    if (!readObjFloat(cursor, end, value.y))
+    {
+        return false;
+    }
+    if (!readObjFloat(cursor, end, value.z))
+    {
+        return false;
+    }
+
+    return true;
+}
+
+inline bool readObjIndexSeparator(const char*& cursor, const char* end)
+{
+    if (cursor >= end || *cursor != '/')
+    {
+        return false;
+    }
+
+    cursor++;
+
+    return true;
+}
+
+// Reads a 'v', 'v/vt', 'v//vn' or 'v/vt/vn' face corner, indexes stay 1-based as in the file and
+// missing ones are 0
+inline bool readObjFaceCorner(const char*& cursor, const char* end, uint64& positionIndex,
+                              uint64& textureCoordinatesIndex, uint64& normalIndex)
+{
+    skipObjSpaces(cursor, end);
+
+    textureCoordinatesIndex = 0;
+    normalIndex = 0;
+
+    if (!readObjIndex(cursor, end, positionIndex))
+    {
+        return false;
+    }
+
+    if (readObjIndexSeparator(cursor, end))
+    {
+        if ((cursor >= end || *cursor != '/') && !readObjIndex(cursor, end,
+                                                               textureCoordinatesIndex))
+        {
+            return false;
+        }
+
+        if (readObjIndexSeparator(cursor, end) && !readObjIndex(cursor, end, normalIndex))
+        {
+            return false;
+        }
+    }
+
+    return cursor == end || isObjSpace(*cursor);
+}
+
+inline const char* getNextObjLine(const char* lineEnd, const char* end)
+{
+    if (lineEnd < end)
+    {
+        return lineEnd + 1;
+    }
+
+    return end;
+}
+
+// Only looks at the keyword of every line, which is far cheaper than parsing the numbers after
+// it. Adds to the counts, so a file can be counted in blocks of whole lines
+inline void countObjLines(const char* begin, const char* end, ObjLineCounts& lineCounts)
+{
+    if (lineCounts.objectFaceCounts.empty())
+    {
+        lineCounts.objectFaceCounts.push_back(0);
+    }
+
+    const char* cursor = begin;
+    while (cursor < end)
+    {
+        const char* lineEnd = findObjLineEnd(cursor, end);
+
+        const char* keyword = nullptr;
+        uint64 keywordSize = 0;
+        readObjToken(cursor, lineEnd, keyword, keywordSize);
+
+        if (isObjToken(keyword, keywordSize, "v"))
+        {
+            lineCounts.positionCount++;
+        }
+        else if (isObjToken(keyword, keywordSize, "vt"))
+        {
+            lineCounts.textureCoordinatesCount++;
+        }
+        else if (isObjToken(keyword, keywordSize, "vn"))
+        {
+            lineCounts.normalCount++;
+        }
+        else if (isObjToken(keyword, keywordSize, "f"))
+        {
+            lineCounts.faceCount++;
+            lineCounts.objectFaceCounts.back()++;
+        }
+        else if (isObjToken(keyword, keywordSize, "o"))
+        {
+            lineCounts.objectFaceCounts.push_back(0);
+        }
+
+        cursor = getNextObjLine(lineEnd, end);
+    }
+}
+
+// Files rarely list data no face uses, so the largest of the counts is a close lower bound of
+// the unique vertexes; reserving the face corners instead would overshoot several times
+inline uint64 getObjVertexCountEstimate(uint64 positionCount, uint64 textureCoordinatesCount,
+                                        uint64 normalCount, uint64 faceCornerCount)
+{
+    uint64 vertexCount = positionCount;
+    if (textureCoordinatesCount > vertexCount)
+    {
+        vertexCount = textureCoordinatesCount;
+    }
+    if (normalCount > vertexCount)
+    {
+        vertexCount = normalCount;
+    }
+    if (faceCornerCount < vertexCount)
+    {
+        vertexCount = faceCornerCount;
+    }
+
+    return vertexCount;
+}
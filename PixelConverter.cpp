@@ -0,0 +1,229 @@
+#include "PixelConverter.h"
+
+PixelConverter::PixelConverter() : settings{}, statistics{}
+{
+    settings.instructionSet = CpuInstructionSet::Undefined;
+}
+
+PixelConverterSettings PixelConverter::getSettings()
+{
+    return settings;
+}
+
+void PixelConverter::setSettings(PixelConverterSettings settings)
+{
+    this->settings = settings;
+}
+
+PixelConverterStatistics PixelConverter::getStatistics()
+{
+    return statistics;
+}
+
+bool PixelConverter::convertToRgba8(const unsigned char* source, const PixelMasks& masks,
+                                    uint64 pixelCount, unsigned char* destination)
+{
+    statistics = {};
+
+    if (masks.bitCount != 8 && masks.bitCount != 16 && masks.bitCount != 24 && masks.bitCount !=
+        32)
+    {
+        return false;
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    uint32 pixelSize = masks.bitCount / 8;
+
+    int32 byteIndexes[PixelConverterRgba8PixelSize] = {
+        getPixelMaskByteIndex(masks.redMask, masks.bitCount),
+        getPixelMaskByteIndex(masks.greenMask, masks.bitCount),
+        getPixelMaskByteIndex(masks.blueMask, masks.bitCount),
+        getPixelMaskByteIndex(masks.alphaMask, masks.bitCount),
+    };
+
+    bool isShuffled = pixelSize >= 3;
+    for (int32 byteIndex : byteIndexes)
+    {
+        if (byteIndex < -1)
+        {
+            isShuffled = false;
+        }
+    }
+
+    statistics.instructionSet = CpuInstructionSet::Scalar;
+    if (isShuffled)
+    {
+        CpuInstructionSet instructionSet = getCpuInstructionSet(settings.instructionSet);
+
+        // The wider kernel leaves its tail to the narrower ones
+        uint64 pixelIndex = 0;
+        if (instructionSet == CpuInstructionSet::Avx2)
+        {
+            pixelIndex += shuffleAvx2(source, pixelSize, byteIndexes, pixelCount, destination);
+        }
+        if (instructionSet == CpuInstructionSet::Avx2
+            || instructionSet == CpuInstructionSet::Ssse3)
+        {
+            pixelIndex += shuffleSsse3(source + pixelIndex * pixelSize, pixelSize, byteIndexes,
+                                       pixelCount - pixelIndex,
+                                       destination + pixelIndex * PixelConverterRgba8PixelSize);
+        }
+        shuffleScalar(source, pixelSize, byteIndexes, pixelIndex, pixelCount, destination);
+
+        statistics.instructionSet = instructionSet;
+    }
+    else
+    {
+        convertMasks(source, masks, pixelCount, destination);
+    }
+
+    std::chrono::duration<double> conversionTime = std::chrono::steady_clock::now() - startTime;
+
+    statistics.pixelCount = pixelCount;
+    statistics.size = pixelCount * PixelConverterRgba8PixelSize;
+    statistics.conversionTime = conversionTime.count();
+    if (statistics.conversionTime > 0.0)
+    {
+        statistics.throughput = statistics.size / (1024.0 * 1024.0 * 1024.0) / statistics.
+            conversionTime;
+    }
+
+    return true;
+}
+
+void PixelConverter::shuffleScalar(const unsigned char* source, uint32 pixelSize,
+                                   const int32 byteIndexes[PixelConverterRgba8PixelSize],
+                                   uint64 pixelBegin, uint64 pixelEnd, unsigned char* destination)
+{
+    for (uint64 i = pixelBegin; i < pixelEnd; i++)
+    {
+        const unsigned char* sourcePixel = source + i * pixelSize;
+        unsigned char* destinationPixel = destination + i * PixelConverterRgba8PixelSize;
+
+        for (int32 j = 0; j < PixelConverterRgba8PixelSize; j++)
+        {
+            if (byteIndexes[j] >= 0)
+            {
+                destinationPixel[j] = sourcePixel[byteIndexes[j]];
+            }
+            else
+            {
+                destinationPixel[j] = j == 3 ? 0xff : 0;
+            }
+        }
+    }
+}
+
+// 4 pixels per 16 B load, a load may not read past the last pixel so the tail is left over
+uint64 PixelConverter::shuffleSsse3(const unsigned char* source, uint32 pixelSize,
+                                    const int32 byteIndexes[PixelConverterRgba8PixelSize],
+                                    uint64 pixelCount, unsigned char* destination)
+{
+    alignas(16) int8 shuffleItems[16];
+    for (int32 i = 0; i < 4; i++)
+    {
+        for (int32 j = 0; j < PixelConverterRgba8PixelSize; j++)
+        {
+            int32 byteIndex = byteIndexes[j];
+            shuffleItems[i * 4 + j] = byteIndex >= 0 ? static_cast<int8>(i * pixelSize +
+                byteIndex) : static_cast<int8>(0x80);
+        }
+    }
+    __m128i shuffle = _mm_load_si128(reinterpret_cast<const __m128i*>(shuffleItems));
+    __m128i alpha = _mm_set1_epi32(byteIndexes[3] >= 0 ? 0 : static_cast<int32>(0xff000000));
+
+    uint64 pixelIndex = 0;
+    for (; pixelIndex * pixelSize + 16 <= pixelCount * pixelSize; pixelIndex += 4)
+    {
+        __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + pixelIndex *
+            pixelSize));
+        pixels = _mm_or_si128(_mm_shuffle_epi8(pixels, shuffle), alpha);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + pixelIndex *
+                             PixelConverterRgba8PixelSize), pixels);
+    }
+
+    return pixelIndex;
+}
+
+// 8 pixels per iteration, each 128-bit lane shuffles the 4 pixels of its own 16 B load
+uint64 PixelConverter::shuffleAvx2(const unsigned char* source, uint32 pixelSize,
+                                   const int32 byteIndexes[PixelConverterRgba8PixelSize],
+                                   uint64 pixelCount, unsigned char* destination)
+{
+    alignas(16) int8 shuffleItems[16];
+    for (int32 i = 0; i < 4; i++)
+    {
+        for (int32 j = 0; j < PixelConverterRgba8PixelSize; j++)
+        {
+            int32 byteIndex = byteIndexes[j];
+            shuffleItems[i * 4 + j] = byteIndex >= 0 ? static_cast<int8>(i * pixelSize +
+                byteIndex) : static_cast<int8>(0x80);
+        }
+    }
+    __m128i laneShuffle = _mm_load_si128(reinterpret_cast<const __m128i*>(shuffleItems));
+    __m256i shuffle = _mm256_inserti128_si256(_mm256_castsi128_si256(laneShuffle), laneShuffle,
+                                              1);
+    __m256i alpha = _mm256_set1_epi32(byteIndexes[3] >= 0 ? 0 : static_cast<int32>(0xff000000));
+
+    uint64 pixelIndex = 0;
+    for (; (pixelIndex + 4) * pixelSize + 16 <= pixelCount * pixelSize; pixelIndex += 8)
+    {
+        const unsigned char* sourcePixels = source + pixelIndex * pixelSize;
+        __m128i lowPixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(sourcePixels));
+        __m128i highPixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(sourcePixels + 4 *
+            pixelSize));
+
+        __m256i pixels = _mm256_inserti128_si256(_mm256_castsi128_si256(lowPixels), highPixels,
+                                                 1);
+        pixels = _mm256_or_si256(_mm256_shuffle_epi8(pixels, shuffle), alpha);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + pixelIndex *
+                                PixelConverterRgba8PixelSize), pixels);
+    }
+
+    return pixelIndex;
+}
+
+void PixelConverter::convertMasks(const unsigned char* source, const PixelMasks& masks,
+                                  uint64 pixelCount, unsigned char* destination)
+{
+    uint32 channelMasks[PixelConverterRgba8PixelSize] = {
+        masks.redMask, masks.greenMask, masks.blueMask, masks.alphaMask
+    };
+
+    uint32 shifts[PixelConverterRgba8PixelSize] = {};
+    uint32 maxValues[PixelConverterRgba8PixelSize] = {};
+    for (int32 i = 0; i < PixelConverterRgba8PixelSize; i++)
+    {
+        shifts[i] = getPixelMaskShift(channelMasks[i]);
+        maxValues[i] = channelMasks[i] >> shifts[i];
+    }
+
+    uint32 pixelSize = masks.bitCount / 8;
+    for (uint64 i = 0; i < pixelCount; i++)
+    {
+        const unsigned char* sourcePixel = source + i * pixelSize;
+
+        uint32 pixel = 0;
+        for (uint32 j = 0; j < pixelSize; j++)
+        {
+            pixel |= static_cast<uint32>(sourcePixel[j]) << (j * 8);
+        }
+
+        unsigned char* destinationPixel = destination + i * PixelConverterRgba8PixelSize;
+        for (int32 j = 0; j < PixelConverterRgba8PixelSize; j++)
+        {
+            if (maxValues[j] == 0)
+            {
+                destinationPixel[j] = j == 3 ? 0xff : 0;
+
+                continue;
+            }
+
+            // Rescaled with rounding, so 5-bit and 6-bit channels reach 0 and 255 exactly
+            uint64 value = (pixel & channelMasks[j]) >> shifts[j];
+            destinationPixel[j] = static_cast<unsigned char>((value * 255 + maxValues[j] / 2) /
+                maxValues[j]);
+        }
+    }
+}
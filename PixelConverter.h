@@ -0,0 +1,43 @@
+#pragma once
+#include <immintrin.h>
+
+#include <chrono>
+
+#include "CpuUtility.h"
+#include "IntUtility.h"
+#include "PixelConverterUtility.h"
+
+// Expands packed pixels of any mask layout to R8G8B8A8. Layouts whose channels are whole bytes of
+// a 24-bit or 32-bit pixel are swizzled with byte shuffles, SSSE3 or AVX2 when the CPU has them,
+// every other layout is converted channel by channel
+class PixelConverter
+{
+    PixelConverterSettings settings;
+
+    PixelConverterStatistics statistics;
+
+public:
+    PixelConverter();
+
+    PixelConverterSettings getSettings();
+    void setSettings(PixelConverterSettings settings);
+
+    PixelConverterStatistics getStatistics();
+
+    // Missing color channels become 0 and a missing alpha channel 255, like D3D samples them
+    bool convertToRgba8(const unsigned char* source, const PixelMasks& masks, uint64 pixelCount,
+                        unsigned char* destination);
+
+private:
+    void shuffleScalar(const unsigned char* source, uint32 pixelSize,
+                       const int32 byteIndexes[PixelConverterRgba8PixelSize], uint64 pixelBegin,
+                       uint64 pixelEnd, unsigned char* destination);
+    uint64 shuffleSsse3(const unsigned char* source, uint32 pixelSize,
+                        const int32 byteIndexes[PixelConverterRgba8PixelSize], uint64 pixelCount,
+                        unsigned char* destination);
+    uint64 shuffleAvx2(const unsigned char* source, uint32 pixelSize,
+                       const int32 byteIndexes[PixelConverterRgba8PixelSize], uint64 pixelCount,
+                       unsigned char* destination);
+    void convertMasks(const unsigned char* source, const PixelMasks& masks, uint64 pixelCount,
+                      unsigned char* destination);
+};
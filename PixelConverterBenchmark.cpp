@@ -0,0 +1,137 @@
+#include "PixelConverterBenchmark.h"
+
+PixelConverterBenchmark::PixelConverterBenchmark() : settings{}
+{
+    settings.repeatCount = 1;
+}
+
+BenchmarkSettings PixelConverterBenchmark::getSettings()
+{
+    return settings;
+}
+
+void PixelConverterBenchmark::setSettings(BenchmarkSettings settings)
+{
+    this->settings = settings;
+}
+
+bool PixelConverterBenchmark::run()
+{
+    struct Layout
+    {
+        const char* name;
+        PixelMasks masks;
+    };
+    const Layout layouts[] = {
+        { "RGB24", { 24, 0x0000ff, 0x00ff00, 0xff0000, 0 } },
+        { "BGR24", { 24, 0xff0000, 0x00ff00, 0x0000ff, 0 } },
+        { "ABGR32", { 32, 0xff000000, 0x00ff0000, 0x0000ff00, 0x000000ff } },
+        { "R5G6B5", { 16, 0xf800, 0x07e0, 0x001f, 0 } },
+    };
+    const CpuInstructionSet instructionSets[] = {
+        CpuInstructionSet::Scalar,
+        CpuInstructionSet::Ssse3,
+        CpuInstructionSet::Avx2,
+    };
+
+    std::printf("Pixel conversion: %llu pixels\n",
+                static_cast<unsigned long long>(PixelConverterBenchmarkPixelCount));
+
+    // Any bytes do, the conversion doesn't depend on them
+    std::vector<unsigned char> source(PixelConverterBenchmarkPixelCount * 4);
+    uint32 state = 1;
+    for (unsigned char& value : source)
+    {
+        state = state * 1664525u + 1013904223u;
+        value = static_cast<unsigned char>(state >> 24);
+    }
+
+    for (const Layout& layout : layouts)
+    {
+        std::printf("  %s:", layout.name);
+
+        const char* separator = " ";
+        std::vector<unsigned char> scalarDestination;
+        for (CpuInstructionSet instructionSet : instructionSets)
+        {
+            if (getCpuInstructionSet(instructionSet) != instructionSet)
+            {
+                continue;
+            }
+
+            PixelConverterStatistics statistics = {};
+            std::vector<unsigned char> destination;
+            bool result = convertPixels(source, layout.masks, instructionSet, statistics,
+                                        destination);
+            if (!result)
+            {
+                std::printf("\nFailed to convert the %s pixels\n", layout.name);
+
+                return false;
+            }
+
+            // Packed layouts are converted channel by channel with any instruction set
+            if (statistics.instructionSet != instructionSet)
+            {
+                continue;
+            }
+
+            std::printf("%s%s %.2f GB/s", separator, getCpuInstructionSetName(instructionSet),
+                        statistics.throughput);
+            separator = ", ";
+
+            if (instructionSet == CpuInstructionSet::Scalar)
+            {
+                scalarDestination = std::move(destination);
+            }
+            else if (destination != scalarDestination)
+            {
+                std::printf("\n  %s differs from scalar\n",
+                            getCpuInstructionSetName(instructionSet));
+
+                return false;
+            }
+        }
+
+        std::printf("\n");
+    }
+
+    return true;
+}
+
+bool PixelConverterBenchmark::convertPixels(const std::vector<unsigned char>& source,
+                                            const PixelMasks& masks,
+                                            CpuInstructionSet instructionSet,
+                                            PixelConverterStatistics& statistics,
+                                            std::vector<unsigned char>& destination)
+{
+    PixelConverter pixelConverter;
+    PixelConverterSettings converterSettings = pixelConverter.getSettings();
+    converterSettings.instructionSet = instructionSet;
+    pixelConverter.setSettings(converterSettings);
+
+    uint64 pixelCount = source.size() / (masks.bitCount / 8);
+    if (pixelCount > PixelConverterBenchmarkPixelCount)
+    {
+        pixelCount = PixelConverterBenchmarkPixelCount;
+    }
+    destination.resize(pixelCount * PixelConverterRgba8PixelSize);
+
+    for (uint32 i = 0; i < settings.repeatCount; i++)
+    {
+        bool result = pixelConverter.convertToRgba8(source.data(), masks, pixelCount,
+                                                    destination.data());
+        if (!result)
+        {
+            return false;
+        }
+
+        PixelConverterStatistics runStatistics = pixelConverter.getStatistics();
+        if (i == 0 || runStatistics.conversionTime < statistics.conversionTime)
+        {
+            statistics = runStatistics;
+        }
+    }
+
+    return true;
+}
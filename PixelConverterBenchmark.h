@@ -0,0 +1,34 @@
+#pragma once
+#include <cstdio>
+#include <cstring>
+
+#include <vector>
+
+#include "PixelConverter.h"
+
+#include "BenchmarkUtility.h"
+#include "CpuUtility.h"
+#include "IntUtility.h"
+#include "PixelConverterUtility.h"
+
+// Converts generated pixels of byte-aligned and packed mask layouts to RGBA8 with every
+// instruction set the CPU has, checks that they all give the scalar result and prints their
+// throughput
+class PixelConverterBenchmark
+{
+    BenchmarkSettings settings;
+
+public:
+    PixelConverterBenchmark();
+
+    BenchmarkSettings getSettings();
+    void setSettings(BenchmarkSettings settings);
+
+    bool run();
+
+private:
+    // Of the fastest run
+    bool convertPixels(const std::vector<unsigned char>& source, const PixelMasks& masks,
+                       CpuInstructionSet instructionSet, PixelConverterStatistics& statistics,
+                       std::vector<unsigned char>& destination);
+};
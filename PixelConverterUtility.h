@@ -0,0 +1,68 @@
+#pragma once
+#include "CpuUtility.h"
+#include "IntUtility.h"
+
+constexpr int32 PixelConverterRgba8PixelSize = 4; // B
+
+struct PixelConverterSettings
+{
+    CpuInstructionSet instructionSet;
+};
+
+struct PixelConverterStatistics
+{
+    CpuInstructionSet instructionSet; // used by the last conversion
+
+    uint64 pixelCount;
+    uint64 size; // B, written
+    double conversionTime; // s
+    double throughput; // GB/s, written
+};
+
+// Channel masks of a packed little-endian pixel, a zero mask means the channel is missing
+struct PixelMasks
+{
+    uint32 bitCount; // 8, 16, 24 or 32
+
+    uint32 redMask;
+    uint32 greenMask;
+    uint32 blueMask;
+    uint32 alphaMask;
+};
+
+inline uint32 getPixelMaskShift(uint32 mask)
+{
+    if (mask == 0)
+    {
+        return 0;
+    }
+
+    uint32 shift = 0;
+    while (!(mask & 1))
+    {
+        mask >>= 1;
+        shift++;
+    }
+
+    return shift;
+}
+
+// Byte of the pixel a mask covers exactly, -1 for a missing channel and -2 when the mask doesn't
+// cover a whole byte
+inline int32 getPixelMaskByteIndex(uint32 mask, uint32 bitCount)
+{
+    if (mask == 0)
+    {
+        return -1;
+    }
+
+    for (uint32 i = 0; i < bitCount / 8; i++)
+    {
+        if (mask == 0xffu << (i * 8))
+        {
+            return static_cast<int32>(i);
+        }
+    }
+
+    return -2;
+}
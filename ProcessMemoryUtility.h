@@ -0,0 +1,28 @@
+#pragma once
+#define NOMINMAX
+
+#include <Windows.h>
+#include <Psapi.h>
+
+#include "IntUtility.h"
+
+struct ProcessMemoryData
+{
+    uint64 workingSetSize; // B
+    uint64 peakWorkingSetSize; // B, since the process started
+};
+
+inline bool getProcessMemoryData(ProcessMemoryData& processMemoryData)
+{
+    PROCESS_MEMORY_COUNTERS processMemoryCounters = {};
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &processMemoryCounters,
+                              sizeof(processMemoryCounters)))
+    {
+        return false;
+    }
+
+    processMemoryData.workingSetSize = processMemoryCounters.WorkingSetSize;
+    processMemoryData.peakWorkingSetSize = processMemoryCounters.PeakWorkingSetSize;
+
+    return true;
+}
@@ -3,8 +3,14 @@
 const std::wstring Renderer::materialShaderFilename = L"MaterialShader.hlsl";
 const std::wstring Renderer::textureShaderFilename = L"TextureShader.hlsl";
 
+const VertexEncoding Renderer::modelVertexEncoding = VertexEncoding::Compact;
+
 const std::string Renderer::sceneFilename = "Scene001.scene";
 
+// Of the streamed scene textures, the upload limit keeps a frame from recreating too many of them
+const uint64 Renderer::textureBudgetSize = 512ull * 1024 * 1024; // B
+const uint64 Renderer::textureMaxUploadSize = 16ull * 1024 * 1024; // B, per frame
+
 const std::string Renderer::spriteTextureFilename = "AdImage.dds";
 
 const float Renderer::perspectiveNear = 0.1f;
@@ -25,7 +31,8 @@ const float Renderer::mouseCameraRotationSpeed = 10.0f;
 const std::string Renderer::sound3dFilename = "TestMono.wav";
 
 Renderer::Renderer(std::shared_ptr<Window> window, std::shared_ptr<Input> input,
-                   std::shared_ptr<Timer> timer) : direct3d(), materialShader(), scene(), camera(),
+                   std::shared_ptr<Timer> timer) : direct3d(), materialShader(), textureStreamer(),
+                                                   scene(), camera(),
                                                    directSound()
 {
     initialized = false;
@@ -33,6 +40,8 @@ Renderer::Renderer(std::shared_ptr<Window> window, std::shared_ptr<Input> input,
 
     vsyncEnabled = false;
 
+    textureBudgetSettings = getDefaultTextureBudgetSettings();
+
     this->window = window;
 
     this->input = input;
@@ -71,7 +80,7 @@ void Renderer::setReleased()
     released = true;
 }
 
-bool Renderer::initialize(bool isVsyncEnabled)
+bool Renderer::initialize(bool isVsyncEnabled, TextureBudgetSettings textureBudgetSettings)
 {
     if (isInitialized())
     {
@@ -80,6 +89,8 @@ bool Renderer::initialize(bool isVsyncEnabled)
 
     vsyncEnabled = isVsyncEnabled;
 
+    this->textureBudgetSettings = textureBudgetSettings;
+
     bool result = initializeDirect3d();
     if (!result)
     {
@@ -190,6 +201,8 @@ void Renderer::release()
 
     scene.reset();
 
+    textureStreamer.reset();
+
     textureShader.reset();
     materialShader.reset();
 
@@ -219,29 +232,8 @@ bool Renderer::initializeDirect3d()
 
 bool Renderer::initializeShaders()
 {
-    std::vector<D3D11_INPUT_ELEMENT_DESC> inputElementDescs(2);
-
-    D3D11_INPUT_ELEMENT_DESC& positionDesc = inputElementDescs[0];
-    positionDesc.SemanticName = "POSITION";
-    positionDesc.SemanticIndex = 0;
-    positionDesc.Format = DXGI_FORMAT_R32G32B32_FLOAT;
-    positionDesc.InputSlot = 0;
-    positionDesc.AlignedByteOffset = 0;
-    positionDesc.InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
-    positionDesc.InstanceDataStepRate = 0;
-
-    D3D11_INPUT_ELEMENT_DESC& textureCoordinateDesc = inputElementDescs[1];
-    textureCoordinateDesc.SemanticName = "TEXCOORD";
-    textureCoordinateDesc.SemanticIndex = 0;
-    textureCoordinateDesc.Format = DXGI_FORMAT_R32G32_FLOAT;
-    textureCoordinateDesc.InputSlot = 0;
-    textureCoordinateDesc.AlignedByteOffset = D3D11_APPEND_ALIGNED_ELEMENT;
-    textureCoordinateDesc.InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
-    textureCoordinateDesc.InstanceDataStepRate = 0;
-
     materialShader = createSharedPointer<Shader>(direct3d);
-    bool result = materialShader->initialize(materialShaderFilename, inputElementDescs.data(),
-                                             inputElementDescs.size());
+    bool result = materialShader->initialize(materialShaderFilename, modelVertexEncoding);
     if (!result)
     {
         MessageBox(window->getHandle(), L"Could not initialize MaterialShader", L"Error", MB_OK);
@@ -250,9 +242,8 @@ bool Renderer::initializeShaders()
     }
 
     textureShader = createSharedPointer<Shader>(direct3d);
-    result = textureShader->initialize(textureShaderFilename,
-                                       inputElementDescs.data(),
-                                       inputElementDescs.size());
+    // Sprites build their quads from full vertexes
+    result = textureShader->initialize(textureShaderFilename, VertexEncoding::Full);
     if (!result)
     {
         MessageBox(window->getHandle(), L"Could not initialize TextureShader", L"Error", MB_OK);
@@ -335,8 +326,15 @@ bool Renderer::initializeShaders()
 
 bool Renderer::initializeScene()
 {
-    scene = createSharedPointer<Scene>(materialShader, direct3d);
-    bool result = scene->initialize(sceneFilename);
+    textureStreamer = createSharedPointer<TextureStreamer>();
+
+    TextureStreamerSettings textureStreamerSettings = textureStreamer->getSettings();
+    textureStreamerSettings.residencyManagerSettings.budgetSize = textureBudgetSize;
+    textureStreamerSettings.residencyManagerSettings.maxUploadSize = textureMaxUploadSize;
+    textureStreamer->setSettings(textureStreamerSettings);
+
+    scene = createSharedPointer<Scene>(materialShader, direct3d, textureStreamer);
+    bool result = scene->initialize(sceneFilename, textureBudgetSettings);
     if (!result)
     {
         MessageBox(window->getHandle(), L"Could not initialize Scene", L"Error", MB_OK);
@@ -380,7 +378,8 @@ bool Renderer::initializeCamera()
 bool Renderer::initializeSprite()
 {
     sprite = createSharedPointer<Sprite>(textureShader, window, direct3d);
-    bool result = sprite->initialize(spriteTextureFilename, DirectX::XMFLOAT2(0.075f, 0.1f));
+    bool result = sprite->initialize(spriteTextureFilename, DirectX::XMFLOAT2(0.075f, 0.1f),
+                                     textureBudgetSettings);
     if (!result)
     {
         MessageBox(window->getHandle(), L"Could not initialize Sprite", L"Error", MB_OK);
@@ -503,6 +502,13 @@ bool Renderer::updateScene()
         return false;
     }
 
+    // Levels drawing asked for are made resident for the next frames
+    result = textureStreamer->update();
+    if (!result)
+    {
+        return false;
+    }
+
     return true;
 }
 
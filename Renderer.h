@@ -15,6 +15,7 @@
 
 #include "Shader.h"
 #include "Scene.h"
+#include "TextureStreamer.h"
 #include "Camera.h"
 #include "Sprite.h"
 
@@ -28,7 +29,9 @@
 #include "XAudio2Sound.h"
 
 #include "MemoryUtility.h"
+#include "ImageFileParserUtility.h"
 #include "ShaderUtility.h"
+#include "VertexEncodingUtility.h"
 #include "SoundUtility.h"
 
 class Renderer
@@ -38,6 +41,9 @@ class Renderer
 
     bool vsyncEnabled;
 
+    // Of every texture read from a file, the scene ones and the sprite
+    TextureBudgetSettings textureBudgetSettings;
+
     std::shared_ptr<Input> input;
     std::shared_ptr<Timer> timer;
 
@@ -46,8 +52,13 @@ class Renderer
     static const std::wstring materialShaderFilename;
     static const std::wstring textureShaderFilename;
 
+    static const VertexEncoding modelVertexEncoding;
+
     static const std::string sceneFilename;
 
+    static const uint64 textureBudgetSize;
+    static const uint64 textureMaxUploadSize;
+
     static const std::string spriteTextureFilename;
 
     static const float perspectiveNear;
@@ -72,6 +83,8 @@ class Renderer
     std::shared_ptr<Shader> materialShader;
     std::shared_ptr<Shader> textureShader;
 
+    std::shared_ptr<TextureStreamer> textureStreamer;
+
     std::shared_ptr<Scene> scene;
 
     std::shared_ptr<Camera> camera;
@@ -97,7 +110,7 @@ private:
     void setReleased();
 
 public:
-    bool initialize(bool isVsyncEnabled);
+    bool initialize(bool isVsyncEnabled, TextureBudgetSettings textureBudgetSettings);
     bool renderFrame();
     void release();
 
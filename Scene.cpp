@@ -1,13 +1,15 @@
 #include "Scene.h"
 
-Scene::Scene(std::shared_ptr<Shader> modelShader,
-             std::shared_ptr<Direct3d> direct3d) : fileParser(), models()
+Scene::Scene(std::shared_ptr<Shader> modelShader, std::shared_ptr<Direct3d> direct3d,
+             std::shared_ptr<TextureStreamer> textureStreamer) : fileParser(), models()
 {
     initialized = false;
     released = false;
 
     this->modelShader = modelShader;
 
+    this->textureStreamer = textureStreamer;
+
     this->direct3d = direct3d;
 }
 
@@ -15,6 +17,8 @@ Scene::~Scene()
 {
     release();
 
+    textureStreamer.reset();
+
     modelShader.reset();
 
     direct3d.reset();
@@ -47,7 +51,18 @@ std::vector<std::shared_ptr<Model>> Scene::getModels()
     return models;
 }
 
-bool Scene::initialize(std::string filename)
+Bounds Scene::getWorldBounds()
+{
+    Bounds worldBounds = getEmptyBounds();
+    for (const auto& model : models)
+    {
+        worldBounds = mergeBounds(worldBounds, model->getWorldBounds());
+    }
+
+    return worldBounds;
+}
+
+bool Scene::initialize(std::string filename, TextureBudgetSettings textureBudgetSettings)
 {
     if (isInitialized())
     {
@@ -56,7 +71,7 @@ bool Scene::initialize(std::string filename)
 
     SceneData sceneData = {};
 
-    bool result = readModels(filename, sceneData);
+    bool result = readModels(filename, textureBudgetSettings, sceneData);
     if (!result)
     {
         return false;
@@ -121,10 +136,15 @@ void Scene::addModel(std::shared_ptr<Model> model)
     models.push_back(model);
 }
 
-bool Scene::readModels(std::string filename, SceneData& sceneData)
+bool Scene::readModels(std::string filename, TextureBudgetSettings textureBudgetSettings,
+                       SceneData& sceneData)
 {
     sceneData = {};
 
+    ModelFileParserSettings modelFileParserSettings = fileParser.getModelFileParserSettings();
+    modelFileParserSettings.imageFileParserSettings.textureBudgetSettings = textureBudgetSettings;
+    fileParser.setModelFileParserSettings(modelFileParserSettings);
+
     bool result = fileParser.parseFile(filename, sceneData);
     if (!result)
     {
@@ -141,7 +161,7 @@ bool Scene::initializeModels(SceneData sceneData)
     for (const auto& pair : sceneData.uniqueModelDataItems)
     {
         std::shared_ptr<Model>& uniqueModel = uniqueModels[pair.first];
-        uniqueModel = createSharedPointer<Model>(modelShader, direct3d);
+        uniqueModel = createSharedPointer<Model>(modelShader, direct3d, textureStreamer);
         bool result = uniqueModel->initialize(pair.second);
         if (!result)
         {
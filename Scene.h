@@ -9,10 +9,13 @@
 #include "SceneFileParser.h"
 
 #include "Model.h"
+#include "TextureStreamer.h"
 
 #include "Transformation.h"
 
+#include "ImageFileParserUtility.h"
 #include "SceneFileParserUtility.h"
+#include "BoundsUtility.h"
 
 class Scene
 {
@@ -23,12 +26,15 @@ class Scene
 
     std::shared_ptr<Shader> modelShader;
 
+    std::shared_ptr<TextureStreamer> textureStreamer; // of the models, when there is one
+
     SceneFileParser fileParser;
 
     std::vector<std::shared_ptr<Model>> models;
 
 public:
-    Scene(std::shared_ptr<Shader> modelShader, std::shared_ptr<Direct3d> direct3d);
+    Scene(std::shared_ptr<Shader> modelShader, std::shared_ptr<Direct3d> direct3d,
+          std::shared_ptr<TextureStreamer> textureStreamer = nullptr);
     ~Scene();
 
 private:
@@ -41,7 +47,13 @@ private:
 public:
     std::vector<std::shared_ptr<Model>> getModels();
 
-    bool initialize(std::string filename);
+    // Merged from the models on every call, so it follows their transformation changes
+    Bounds getWorldBounds();
+
+    // The budget is the one the material images of the models are read with
+    bool initialize(std::string filename,
+                    TextureBudgetSettings textureBudgetSettings =
+                        getDefaultTextureBudgetSettings());
     bool initialize(SceneData sceneData);
     bool render(DirectX::XMMATRIX vpMatrix);
     void release();
@@ -49,6 +61,7 @@ public:
     void addModel(std::shared_ptr<Model> model);
 
 private:
-    bool readModels(std::string filename, SceneData& sceneData);
+    bool readModels(std::string filename, TextureBudgetSettings textureBudgetSettings,
+                    SceneData& sceneData);
     bool initializeModels(SceneData sceneData);
 };
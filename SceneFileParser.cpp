@@ -1,5 +1,15 @@
 #include "SceneFileParser.h"
 
+ModelFileParserSettings SceneFileParser::getModelFileParserSettings()
+{
+    return modelFileParser.getSettings();
+}
+
+void SceneFileParser::setModelFileParserSettings(ModelFileParserSettings modelFileParserSettings)
+{
+    modelFileParser.setSettings(modelFileParserSettings);
+}
+
 bool SceneFileParser::parseFile(std::string filename, SceneData& sceneData)
 {
     std::string format = getFileFormat(filename);
@@ -116,7 +126,8 @@ bool SceneFileParser::parseSceneFile(std::string filename, SceneData& sceneData)
                     return false;
                 }
 
-                sceneData.uniqueModelDataItems[modelData.filename] = uniqueModelData;
+                sceneData.uniqueModelDataItems[modelData.filename] = std::move(
+                    uniqueModelData);
             }
         }
     }
@@ -13,6 +13,7 @@
 #include "ModelFileParser.h"
 
 #include "FileParserUtility.h"
+#include "ModelFileParserUtility.h"
 #include "SceneFileParserUtility.h"
 
 class SceneFileParser
@@ -20,6 +21,10 @@ class SceneFileParser
     ModelFileParser modelFileParser;
 
 public:
+    // Of the models the scene files refer to
+    ModelFileParserSettings getModelFileParserSettings();
+    void setModelFileParserSettings(ModelFileParserSettings modelFileParserSettings);
+
     bool parseFile(std::string filename, SceneData& sceneData);
 
     bool parseSceneFile(std::string filename, SceneData& sceneData);
@@ -9,6 +9,8 @@ Shader::Shader(std::shared_ptr<Direct3d> direct3d) : vertexShader(), pixelShader
     released = false;
 
     this->direct3d = direct3d;
+
+    vertexEncoding = VertexEncoding::Undefined;
 }
 
 Shader::~Shader()
@@ -40,6 +42,11 @@ void Shader::setReleased()
     released = true;
 }
 
+VertexEncoding Shader::getVertexEncoding()
+{
+    return vertexEncoding;
+}
+
 bool Shader::setVertexShaderConstantBuffer(std::shared_ptr<AbstractConstantBuffer> constantBuffer,
                                            uint32 slotIndex)
 {
@@ -63,6 +70,23 @@ bool Shader::setPixelShaderSampler(std::shared_ptr<Sampler> sampler, uint32 slot
     return true;
 }
 
+bool Shader::initialize(std::wstring filename, VertexEncoding vertexEncoding)
+{
+    std::vector<D3D11_INPUT_ELEMENT_DESC> inputElementDescs;
+    getVertexInputElementDescs(vertexEncoding, inputElementDescs);
+
+    bool result = initialize(filename, inputElementDescs.data(),
+                             static_cast<uint32>(inputElementDescs.size()));
+    if (!result)
+    {
+        return false;
+    }
+
+    this->vertexEncoding = vertexEncoding;
+
+    return true;
+}
+
 bool Shader::initialize(std::wstring filename, const D3D11_INPUT_ELEMENT_DESC* inputElementDescs,
                         uint32 inputElementDescCount)
 {
@@ -113,7 +137,8 @@ bool Shader::render()
         return false;
     }
 
-    result = direct3d->setIndexBufferToInputAssembler(indexBuffer->getBuffer());
+    result = direct3d->setIndexBufferToInputAssembler(indexBuffer->getBuffer(),
+                                                      indexBuffer->getFormat());
     if (!result)
     {
         return false;
@@ -168,7 +193,7 @@ bool Shader::render()
         return false;
     }
 
-    result = direct3d->drawIndexed(indexBuffer->getSize());
+    result = direct3d->drawIndexed(indexBuffer->getSize(), indexBuffer->getBaseVertex());
     if (!result)
     {
         return false;
@@ -195,6 +220,7 @@ void Shader::release()
     vertexBuffer.reset();
 
     inputLayout.reset();
+    vertexEncoding = VertexEncoding::Undefined;
 
     pixelShader.Reset();
     vertexShader.Reset();
@@ -5,6 +5,7 @@
 #include <wrl/client.h>
 #include <memory>
 
+#include <vector>
 #include <unordered_map>
 
 #include "Direct3d.h"
@@ -21,6 +22,7 @@
 #include "Texture.h"
 
 #include "IntUtility.h"
+#include "VertexEncodingUtility.h"
 
 class Shader
 {
@@ -33,6 +35,7 @@ class Shader
     Microsoft::WRL::ComPtr<ID3D11PixelShader> pixelShader;
 
     std::shared_ptr<InputLayout> inputLayout;
+    VertexEncoding vertexEncoding;
 
     std::shared_ptr<AbstractVertexBuffer> vertexBuffer;
     std::shared_ptr<IndexBuffer> indexBuffer;
@@ -56,12 +59,15 @@ private:
     void setReleased();
 
 public:
+    VertexEncoding getVertexEncoding();
+
     bool setVertexShaderConstantBuffer(std::shared_ptr<AbstractConstantBuffer> constantBuffer,
                                        uint32 slotIndex);
     bool setPixelShaderConstantBuffer(std::shared_ptr<AbstractConstantBuffer> constantBuffer,
                                       uint32 slotIndex);
     bool setPixelShaderSampler(std::shared_ptr<Sampler> sampler, uint32 slotIndex);
 
+    bool initialize(std::wstring filename, VertexEncoding vertexEncoding);
     bool initialize(std::wstring filename, const D3D11_INPUT_ELEMENT_DESC* inputElementDescs,
                     uint32 inputElementDescCount);
     bool render();
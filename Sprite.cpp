@@ -65,68 +65,67 @@ Transformation Sprite::getTransformation()
     return transformation;
 }
 
-bool Sprite::initialize(std::string textureFilename, DirectX::XMFLOAT2 relativeSize)
+bool Sprite::initialize(std::string textureFilename, DirectX::XMFLOAT2 relativeSize,
+                        TextureBudgetSettings textureBudgetSettings)
 {
     if (isInitialized())
     {
         release();
     }
 
-    relativeSize.x = std::max(relativeSize.x, 0.0f);
-    relativeSize.x = std::min(relativeSize.x, 1.0f);
-
-    relativeSize.y = std::max(relativeSize.y, 0.0f);
-    relativeSize.y = std::min(relativeSize.y, 1.0f);
-
-    DirectX::XMFLOAT2 absoluteSize = {};
-    absoluteSize.x = window->getWidth() * relativeSize.x;
-    absoluteSize.y = window->getHeight() * relativeSize.y;
-
-    float x = absoluteSize.x / 2;
-    float y = absoluteSize.y / 2;
-
-    std::array<Vertex, 4> vertexes;
+    bool result = initializeBuffers(relativeSize, DirectX::XMFLOAT2(0.0f, 0.0f),
+                                    DirectX::XMFLOAT2(1.0f, 1.0f));
+    if (!result)
+    {
+        return false;
+    }
 
-    Vertex* vertex = &vertexes[0];
-    vertex->position = DirectX::XMFLOAT3(-x, -y, 1.0f);
-    vertex->textureCoordinates = DirectX::XMFLOAT3(0.0f, 1.0f, 0.0f);
+    diffuseColorTexture = createSharedPointer<Texture>(direct3d);
+    result = diffuseColorTexture->initialize(textureFilename, TextureClass::Sprite,
+                                             textureBudgetSettings);
+    if (!result)
+    {
+        return false;
+    }
 
-    vertex = &vertexes[1];
-    vertex->position = DirectX::XMFLOAT3(-x, y, 1.0f);
-    vertex->textureCoordinates = DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f);
+    this->transformation = transformation;
 
-    vertex = &vertexes[2];
-    vertex->position = DirectX::XMFLOAT3(x, -y, 1.0f);
-    vertex->textureCoordinates = DirectX::XMFLOAT3(1.0f, 1.0f, 0.0f);
+    setInitialized();
+    return true;
+}
 
-    vertex = &vertexes[3];
-    vertex->position = DirectX::XMFLOAT3(x, y, 1.0f);
-    vertex->textureCoordinates = DirectX::XMFLOAT3(1.0f, 0.0f, 0.0f);
+bool Sprite::initialize(std::shared_ptr<TextureAtlas> textureAtlas, uint32 regionIndex,
+                        DirectX::XMFLOAT2 relativeSize)
+{
+    if (isInitialized())
+    {
+        release();
+    }
 
-    vertexBuffer = createSharedPointer<VertexBuffer<Vertex>>(direct3d);
-    bool result = vertexBuffer->initialize(vertexes.data(), vertexes.size());
-    if (!result)
+    if (!textureAtlas)
     {
         return false;
     }
 
-    std::array<uint32, 6> indexes = {0, 1, 2, 3, 2, 1};
-
-    indexBuffer = createSharedPointer<IndexBuffer>(direct3d);
-    result = indexBuffer->initialize(indexes.data(), indexes.size());
+    TextureAtlasRegion region = {};
+    bool result = textureAtlas->getRegion(regionIndex, region);
     if (!result)
     {
         return false;
     }
 
-    diffuseColorTexture = createSharedPointer<Texture>(direct3d);
-    result = diffuseColorTexture->initialize(textureFilename);
+    result = initializeBuffers(relativeSize, region.minTextureCoordinates,
+                               region.maxTextureCoordinates);
     if (!result)
     {
         return false;
     }
 
-    this->transformation = transformation;
+    diffuseColorTexture = textureAtlas->getPageTexture(region.pageIndex);
+    if (!diffuseColorTexture)
+    {
+        return false;
+    }
 
     setInitialized();
     return true;
@@ -190,3 +189,61 @@ void Sprite::release()
 
     setReleased();
 }
+
+bool Sprite::initializeBuffers(DirectX::XMFLOAT2 relativeSize,
+                               DirectX::XMFLOAT2 minTextureCoordinates,
+                               DirectX::XMFLOAT2 maxTextureCoordinates)
+{
+    relativeSize.x = std::max(relativeSize.x, 0.0f);
+    relativeSize.x = std::min(relativeSize.x, 1.0f);
+
+    relativeSize.y = std::max(relativeSize.y, 0.0f);
+    relativeSize.y = std::min(relativeSize.y, 1.0f);
+
+    DirectX::XMFLOAT2 absoluteSize = {};
+    absoluteSize.x = window->getWidth() * relativeSize.x;
+    absoluteSize.y = window->getHeight() * relativeSize.y;
+
+    float x = absoluteSize.x / 2;
+    float y = absoluteSize.y / 2;
+
+    std::array<Vertex, 4> vertexes;
+
+    Vertex* vertex = &vertexes[0];
+    vertex->position = DirectX::XMFLOAT3(-x, -y, 1.0f);
+    vertex->textureCoordinates = DirectX::XMFLOAT3(minTextureCoordinates.x,
+                                                   maxTextureCoordinates.y, 0.0f);
+
+    vertex = &vertexes[1];
+    vertex->position = DirectX::XMFLOAT3(-x, y, 1.0f);
+    vertex->textureCoordinates = DirectX::XMFLOAT3(minTextureCoordinates.x,
+                                                   minTextureCoordinates.y, 0.0f);
+
+    vertex = &vertexes[2];
+    vertex->position = DirectX::XMFLOAT3(x, -y, 1.0f);
+    vertex->textureCoordinates = DirectX::XMFLOAT3(maxTextureCoordinates.x,
+                                                   maxTextureCoordinates.y, 0.0f);
+
+    vertex = &vertexes[3];
+    vertex->position = DirectX::XMFLOAT3(x, y, 1.0f);
+    vertex->textureCoordinates = DirectX::XMFLOAT3(maxTextureCoordinates.x,
+                                                   minTextureCoordinates.y, 0.0f);
+
+    vertexBuffer = createSharedPointer<VertexBuffer<Vertex>>(direct3d);
+    bool result = vertexBuffer->initialize(vertexes.data(), vertexes.size());
+    if (!result)
+    {
+        return false;
+    }
+
+    std::array<uint32, 6> indexes = {0, 1, 2, 3, 2, 1};
+
+    indexBuffer = createSharedPointer<IndexBuffer>(direct3d);
+    result = indexBuffer->initialize(indexes.data(), indexes.size());
+    if (!result)
+    {
+        return false;
+    }
+
+    return true;
+}
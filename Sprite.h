@@ -23,6 +23,7 @@
 #include "IndexBuffer.h"
 
 #include "Material.h"
+#include "TextureAtlas.h"
 
 #include "Vertex.h"
 
@@ -31,6 +32,7 @@
 #include "ShaderUtility.h"
 
 #include "ImageFileParserUtility.h"
+#include "TextureAtlasBuilderUtility.h"
 
 #include "Transformation.h"
 
@@ -68,7 +70,17 @@ private:
 public:
     Transformation getTransformation();
 
-    bool initialize(std::string filename, DirectX::XMFLOAT2 relativeSize);
+    bool initialize(std::string filename, DirectX::XMFLOAT2 relativeSize,
+                    TextureBudgetSettings textureBudgetSettings =
+                        getDefaultTextureBudgetSettings());
+    // Draws a region of an atlas page, sprites of the same page share its texture
+    bool initialize(std::shared_ptr<TextureAtlas> textureAtlas, uint32 regionIndex,
+                    DirectX::XMFLOAT2 relativeSize);
     bool render(DirectX::XMMATRIX projectionMatrix);
     void release();
+
+private:
+    bool initializeBuffers(DirectX::XMFLOAT2 relativeSize,
+                           DirectX::XMFLOAT2 minTextureCoordinates,
+                           DirectX::XMFLOAT2 maxTextureCoordinates);
 };
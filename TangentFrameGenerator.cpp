@@ -0,0 +1,388 @@
+#include "TangentFrameGenerator.h"
+
+TangentFrameGenerator::TangentFrameGenerator() : settings{}, statistics{}
+{
+    settings.threadCount = 1;
+}
+
+TangentFrameGeneratorSettings TangentFrameGenerator::getSettings()
+{
+    return settings;
+}
+
+void TangentFrameGenerator::setSettings(TangentFrameGeneratorSettings settings)
+{
+    this->settings = settings;
+}
+
+TangentFrameGeneratorStatistics TangentFrameGenerator::getStatistics()
+{
+    return statistics;
+}
+
+bool TangentFrameGenerator::generateNormals(ModelData& modelData,
+                                            const std::vector<uint32>& vertexPositionIndexes,
+                                            uint64 positionCount)
+{
+    statistics = {};
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    std::vector<Vertex>& vertexes = modelData.vertexes;
+    if (vertexPositionIndexes.size() != vertexes.size())
+    {
+        return false;
+    }
+
+    for (uint32 positionIndex : vertexPositionIndexes)
+    {
+        if (positionIndex > positionCount)
+        {
+            return false;
+        }
+    }
+
+    std::vector<uint32> indexes;
+    getIndexes(modelData, indexes);
+    for (uint32 index : indexes)
+    {
+        if (index >= vertexes.size())
+        {
+            return false;
+        }
+    }
+
+    uint64 triangleCount = indexes.size() / 3;
+    statistics.triangleCount = triangleCount;
+
+    // Corners of vertexes with the same position add up, so UV seams don't split the normal
+    uint64 rangeCount = getRangeCount(triangleCount);
+    std::vector<uint64> cornerOffsets;
+    std::vector<uint64> rangeBegins;
+    getCornerOffsets(indexes, positionCount + 1, rangeCount,
+                     [&](uint32 vertexIndex, uint32& positionIndex)
+    {
+        positionIndex = vertexPositionIndexes[vertexIndex];
+
+        return positionIndex != 0;
+    }, cornerOffsets, rangeBegins);
+
+    std::vector<NormalCorner> corners(rangeBegins[rangeCount]);
+    statistics.cornerMemorySize = corners.size() * sizeof(NormalCorner);
+    forEachRange(triangleCount, rangeCount,
+                 [&](uint64 rangeIndex, uint64 beginTriangle, uint64 endTriangle)
+    {
+        getCornerNormals(vertexes, indexes, vertexPositionIndexes, beginTriangle, endTriangle,
+                         positionCount, rangeCount, &cornerOffsets[rangeIndex * rangeCount],
+                         corners);
+    });
+
+    std::vector<DirectX::XMFLOAT3> positionNormals(positionCount + 1, DirectX::XMFLOAT3(
+        0.0f, 0.0f, 0.0f));
+    forEachRange(positionCount + 1, rangeCount,
+                 [&](uint64 rangeIndex, uint64 beginPosition, uint64 endPosition)
+    {
+        for (uint64 i = rangeBegins[rangeIndex]; i < rangeBegins[rangeIndex + 1]; i++)
+        {
+            DirectX::XMFLOAT3& positionNormal = positionNormals[corners[i].positionIndex];
+            DirectX::XMStoreFloat3(&positionNormal, DirectX::XMVectorAdd(
+                                       DirectX::XMLoadFloat3(&positionNormal),
+                                       DirectX::XMLoadFloat3(&corners[i].normal)));
+        }
+    });
+
+    forEachRange(vertexes.size(), rangeCount,
+                 [&](uint64 rangeIndex, uint64 beginVertex, uint64 endVertex)
+    {
+        for (uint64 i = beginVertex; i < endVertex; i++)
+        {
+            uint32 positionIndex = vertexPositionIndexes[i];
+            if (positionIndex == 0)
+            {
+                continue;
+            }
+
+            DirectX::XMVECTOR normal = DirectX::XMLoadFloat3(&positionNormals[positionIndex]);
+            if (DirectX::XMVectorGetX(DirectX::XMVector3LengthSq(normal)) == 0.0f)
+            {
+                // Only degenerate faces use the position
+                normal = DirectX::XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
+            }
+
+            DirectX::XMStoreFloat3(&vertexes[i].normal, DirectX::XMVector3Normalize(normal));
+        }
+    });
+
+    for (uint32 positionIndex : vertexPositionIndexes)
+    {
+        if (positionIndex != 0)
+        {
+            statistics.generatedNormalCount++;
+        }
+    }
+
+    std::chrono::duration<double> normalGenerationTime = std::chrono::steady_clock::now() -
+        startTime;
+    statistics.normalGenerationTime = normalGenerationTime.count();
+    if (statistics.normalGenerationTime > 0.0)
+    {
+        statistics.normalThroughput = triangleCount / (statistics.normalGenerationTime * 1000.0);
+    }
+
+    return true;
+}
+
+bool TangentFrameGenerator::generateTangents(ModelData& modelData)
+{
+    statistics = {};
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    const std::vector<Vertex>& vertexes = modelData.vertexes;
+
+    std::vector<uint32> indexes;
+    getIndexes(modelData, indexes);
+    for (uint32 index : indexes)
+    {
+        if (index >= vertexes.size())
+        {
+            return false;
+        }
+    }
+
+    uint64 triangleCount = indexes.size() / 3;
+    statistics.triangleCount = triangleCount;
+
+    uint64 rangeCount = getRangeCount(triangleCount);
+    std::vector<uint64> cornerOffsets;
+    std::vector<uint64> rangeBegins;
+    getCornerOffsets(indexes, vertexes.size(), rangeCount,
+                     [](uint32 vertexIndex, uint32& sum)
+    {
+        sum = vertexIndex;
+
+        return true;
+    }, cornerOffsets, rangeBegins);
+
+    std::vector<TangentCorner> corners(rangeBegins[rangeCount]);
+    statistics.cornerMemorySize = corners.size() * sizeof(TangentCorner);
+    forEachRange(triangleCount, rangeCount,
+                 [&](uint64 rangeIndex, uint64 beginTriangle, uint64 endTriangle)
+    {
+        getCornerTangents(vertexes, indexes, beginTriangle, endTriangle, rangeCount,
+                          &cornerOffsets[rangeIndex * rangeCount], corners);
+    });
+
+    modelData.tangents.resize(vertexes.size());
+    std::vector<DirectX::XMFLOAT3> vertexTangents(vertexes.size(), DirectX::XMFLOAT3(
+        0.0f, 0.0f, 0.0f));
+    std::vector<DirectX::XMFLOAT3> vertexBitangents(vertexes.size(), DirectX::XMFLOAT3(
+        0.0f, 0.0f, 0.0f));
+    forEachRange(vertexes.size(), rangeCount,
+                 [&](uint64 rangeIndex, uint64 beginVertex, uint64 endVertex)
+    {
+        for (uint64 i = rangeBegins[rangeIndex]; i < rangeBegins[rangeIndex + 1]; i++)
+        {
+            const TangentCorner& corner = corners[i];
+
+            DirectX::XMFLOAT3& vertexTangent = vertexTangents[corner.vertexIndex];
+            DirectX::XMStoreFloat3(&vertexTangent, DirectX::XMVectorAdd(
+                                       DirectX::XMLoadFloat3(&vertexTangent),
+                                       DirectX::XMLoadFloat3(&corner.tangent)));
+
+            DirectX::XMFLOAT3& vertexBitangent = vertexBitangents[corner.vertexIndex];
+            DirectX::XMStoreFloat3(&vertexBitangent, DirectX::XMVectorAdd(
+                                       DirectX::XMLoadFloat3(&vertexBitangent),
+                                       DirectX::XMLoadFloat3(&corner.bitangent)));
+        }
+
+        for (uint64 i = beginVertex; i < endVertex; i++)
+        {
+            DirectX::XMVECTOR normal = DirectX::XMVector3Normalize(
+                DirectX::XMLoadFloat3(&vertexes[i].normal));
+            DirectX::XMVECTOR tangent = DirectX::XMLoadFloat3(&vertexTangents[i]);
+
+            // Gram-Schmidt, the tangent has to be perpendicular to the normal
+            tangent = DirectX::XMVectorSubtract(tangent, DirectX::XMVectorScale(
+                                                    normal, DirectX::XMVectorGetX(
+                                                        DirectX::XMVector3Dot(normal, tangent))));
+            if (DirectX::XMVectorGetX(DirectX::XMVector3LengthSq(tangent)) < 1e-20f)
+            {
+                // No usable UV direction, any perpendicular axis will do
+                DirectX::XMVECTOR axis = DirectX::XMVectorSet(1.0f, 0.0f, 0.0f, 0.0f);
+                if (std::fabs(vertexes[i].normal.x) > 0.9f)
+                {
+                    axis = DirectX::XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
+                }
+
+                tangent = DirectX::XMVector3Cross(normal, axis);
+            }
+            tangent = DirectX::XMVector3Normalize(tangent);
+
+            float handedness = 1.0f;
+            if (DirectX::XMVectorGetX(DirectX::XMVector3Dot(
+                    DirectX::XMVector3Cross(normal, tangent),
+                    DirectX::XMLoadFloat3(&vertexBitangents[i]))) < 0.0f)
+            {
+                handedness = -1.0f;
+            }
+
+            DirectX::XMStoreFloat4(&modelData.tangents[i],
+                                   DirectX::XMVectorSetW(tangent, handedness));
+        }
+    });
+
+    statistics.generatedTangentCount = modelData.tangents.size();
+
+    std::chrono::duration<double> tangentGenerationTime = std::chrono::steady_clock::now() -
+        startTime;
+    statistics.tangentGenerationTime = tangentGenerationTime.count();
+    if (statistics.tangentGenerationTime > 0.0)
+    {
+        statistics.tangentThroughput = triangleCount / (statistics.tangentGenerationTime *
+            1000.0);
+    }
+
+    return true;
+}
+
+void TangentFrameGenerator::getIndexes(const ModelData& modelData, std::vector<uint32>& indexes)
+{
+    uint64 indexCount = 0;
+    for (const MeshData& meshData : modelData.meshDataItems)
+    {
+        indexCount += meshData.indexes.size() / 3 * 3;
+    }
+
+    indexes.clear();
+    indexes.reserve(indexCount);
+    for (const MeshData& meshData : modelData.meshDataItems)
+    {
+        indexes.insert(indexes.end(), meshData.indexes.begin(),
+                       meshData.indexes.begin() + meshData.indexes.size() / 3 * 3);
+    }
+}
+
+void TangentFrameGenerator::getCornerNormals(const std::vector<Vertex>& vertexes,
+                                             const std::vector<uint32>& indexes,
+                                             const std::vector<uint32>& vertexPositionIndexes,
+                                             uint64 beginTriangle, uint64 endTriangle,
+                                             uint64 positionCount, uint64 rangeCount,
+                                             uint64* cornerOffsets,
+                                             std::vector<NormalCorner>& corners)
+{
+    for (uint64 i = beginTriangle; i < endTriangle; i++)
+    {
+        DirectX::XMVECTOR positions[3] = {};
+        for (int32 j = 0; j < 3; j++)
+        {
+            positions[j] = DirectX::XMLoadFloat3(&vertexes[indexes[i * 3 + j]].position);
+        }
+
+        // The length of the cross product is twice the area of the triangle
+        DirectX::XMVECTOR faceNormal = DirectX::XMVector3Cross(
+            DirectX::XMVectorSubtract(positions[1], positions[0]),
+            DirectX::XMVectorSubtract(positions[2], positions[0]));
+
+        for (int32 j = 0; j < 3; j++)
+        {
+            DirectX::XMVECTOR edge0 = DirectX::XMVectorSubtract(positions[(j + 1) % 3],
+                                                                positions[j]);
+            DirectX::XMVECTOR edge1 = DirectX::XMVectorSubtract(positions[(j + 2) % 3],
+                                                                positions[j]);
+
+            DirectX::XMVECTOR angle = DirectX::XMVectorZero();
+            if (DirectX::XMVectorGetX(DirectX::XMVector3LengthSq(edge0)) > 0.0f &&
+                DirectX::XMVectorGetX(DirectX::XMVector3LengthSq(edge1)) > 0.0f)
+            {
+                angle = DirectX::XMVector3AngleBetweenNormals(DirectX::XMVector3Normalize(edge0),
+                                                              DirectX::XMVector3Normalize(edge1));
+            }
+
+            uint32 positionIndex = vertexPositionIndexes[indexes[i * 3 + j]];
+            if (positionIndex == 0)
+            {
+                continue;
+            }
+
+            NormalCorner& corner = corners[cornerOffsets[getRangeIndex(
+                positionIndex, positionCount + 1, rangeCount)]++];
+            corner.positionIndex = positionIndex;
+            DirectX::XMStoreFloat3(&corner.normal, DirectX::XMVectorMultiply(faceNormal, angle));
+        }
+    }
+}
+
+void TangentFrameGenerator::getCornerTangents(const std::vector<Vertex>& vertexes,
+                                              const std::vector<uint32>& indexes,
+                                              uint64 beginTriangle, uint64 endTriangle,
+                                              uint64 rangeCount, uint64* cornerOffsets,
+                                              std::vector<TangentCorner>& corners)
+{
+    for (uint64 i = beginTriangle; i < endTriangle; i++)
+    {
+        const Vertex& vertex0 = vertexes[indexes[i * 3]];
+        const Vertex& vertex1 = vertexes[indexes[i * 3 + 1]];
+        const Vertex& vertex2 = vertexes[indexes[i * 3 + 2]];
+
+        DirectX::XMVECTOR position0 = DirectX::XMLoadFloat3(&vertex0.position);
+        DirectX::XMVECTOR edge0 = DirectX::XMVectorSubtract(
+            DirectX::XMLoadFloat3(&vertex1.position), position0);
+        DirectX::XMVECTOR edge1 = DirectX::XMVectorSubtract(
+            DirectX::XMLoadFloat3(&vertex2.position), position0);
+
+        float du0 = vertex1.textureCoordinates.x - vertex0.textureCoordinates.x;
+        float dv0 = vertex1.textureCoordinates.y - vertex0.textureCoordinates.y;
+        float du1 = vertex2.textureCoordinates.x - vertex0.textureCoordinates.x;
+        float dv1 = vertex2.textureCoordinates.y - vertex0.textureCoordinates.y;
+
+        DirectX::XMVECTOR tangent = DirectX::XMVectorZero();
+        DirectX::XMVECTOR bitangent = DirectX::XMVectorZero();
+
+        float determinant = du0 * dv1 - du1 * dv0;
+        if (determinant != 0.0f)
+        {
+            float scale = 1.0f / determinant;
+
+            // Only the directions are kept, so tiny UV triangles don't outweigh their neighbours
+            tangent = DirectX::XMVector3Normalize(DirectX::XMVectorScale(
+                DirectX::XMVectorSubtract(DirectX::XMVectorScale(edge0, dv1),
+                                          DirectX::XMVectorScale(edge1, dv0)), scale));
+            bitangent = DirectX::XMVector3Normalize(DirectX::XMVectorScale(
+                DirectX::XMVectorSubtract(DirectX::XMVectorScale(edge1, du0),
+                                          DirectX::XMVectorScale(edge0, du1)), scale));
+        }
+
+        for (int32 j = 0; j < 3; j++)
+        {
+            uint32 vertexIndex = indexes[i * 3 + j];
+
+            TangentCorner& corner = corners[cornerOffsets[getRangeIndex(
+                vertexIndex, vertexes.size(), rangeCount)]++];
+            corner.vertexIndex = vertexIndex;
+            DirectX::XMStoreFloat3(&corner.tangent, tangent);
+            DirectX::XMStoreFloat3(&corner.bitangent, bitangent);
+        }
+    }
+}
+
+uint64 TangentFrameGenerator::getRangeCount(uint64 triangleCount)
+{
+    uint64 rangeCount = triangleCount / TangentFrameGeneratorMinTriangleRangeSize;
+    if (rangeCount > settings.threadCount)
+    {
+        rangeCount = settings.threadCount;
+    }
+    if (rangeCount == 0)
+    {
+        rangeCount = 1;
+    }
+
+    return rangeCount;
+}
+
+uint64 TangentFrameGenerator::getRangeIndex(uint64 item, uint64 count, uint64 rangeCount)
+{
+    // The last range whose begin, count * i / rangeCount, is at most the item
+    return ((item + 1) * rangeCount - 1) / count;
+}
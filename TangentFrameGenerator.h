@@ -0,0 +1,123 @@
+#pragma once
+#include <DirectXMath.h>
+
+#include <vector>
+
+#include <cmath>
+
+#include <chrono>
+#include <thread>
+
+#include "Vertex.h"
+
+#include "ModelFileParserUtility.h"
+#include "TangentFrameGeneratorUtility.h"
+
+// Generates vertex normals from the area- and angle-weighted normals of the faces around every
+// position, and tangents with a handedness from the UV directions of the faces. Every thread
+// weighs the corners of its range of triangles and sorts them by the range of sums they go to,
+// then every thread adds up the corners of its range of sums in triangle order. The corners take
+// the scratch memory, not a copy of the sums per thread, and any thread count gives the same sums
+class TangentFrameGenerator
+{
+    TangentFrameGeneratorSettings settings;
+
+    TangentFrameGeneratorStatistics statistics;
+
+public:
+    TangentFrameGenerator();
+
+    TangentFrameGeneratorSettings getSettings();
+    void setSettings(TangentFrameGeneratorSettings settings);
+
+    TangentFrameGeneratorStatistics getStatistics();
+
+    // Vertexes with a non-zero entry in vertexPositionIndexes get a normal smoothed over every
+    // vertex with the same position index, the others keep theirs
+    bool generateNormals(ModelData& modelData, const std::vector<uint32>& vertexPositionIndexes,
+                         uint64 positionCount);
+    bool generateTangents(ModelData& modelData);
+
+private:
+    void getIndexes(const ModelData& modelData, std::vector<uint32>& indexes);
+
+    uint64 getRangeCount(uint64 triangleCount);
+    // Calls function(rangeIndex, begin, end) for rangeCount ranges of [0, count), one per thread
+    template <typename Function>
+    void forEachRange(uint64 count, uint64 rangeCount, Function function);
+    // Of the range of [0, count) the item is in, as forEachRange splits it
+    uint64 getRangeIndex(uint64 item, uint64 count, uint64 rangeCount);
+    // Counts the corners every range of triangles has for every range of [0, sumCount), and turns
+    // the counts into where the range of triangles writes them, at [triangle range * rangeCount +
+    // sum range]. The corners of sum range i start at rangeBegins[i]. getSum(vertexIndex, sum)
+    // returns false for corners that add to no sum
+    template <typename GetSum>
+    void getCornerOffsets(const std::vector<uint32>& indexes, uint64 sumCount, uint64 rangeCount,
+                          GetSum getSum, std::vector<uint64>& cornerOffsets,
+                          std::vector<uint64>& rangeBegins);
+
+    void getCornerNormals(const std::vector<Vertex>& vertexes, const std::vector<uint32>& indexes,
+                          const std::vector<uint32>& vertexPositionIndexes,
+                          uint64 beginTriangle, uint64 endTriangle, uint64 positionCount,
+                          uint64 rangeCount, uint64* cornerOffsets,
+                          std::vector<NormalCorner>& corners);
+    void getCornerTangents(const std::vector<Vertex>& vertexes, const std::vector<uint32>& indexes,
+                           uint64 beginTriangle, uint64 endTriangle, uint64 rangeCount,
+                           uint64* cornerOffsets, std::vector<TangentCorner>& corners);
+};
+
+template <typename Function>
+void TangentFrameGenerator::forEachRange(uint64 count, uint64 rangeCount, Function function)
+{
+    std::vector<std::thread> threads;
+    threads.reserve(rangeCount - 1);
+    for (uint64 i = 1; i < rangeCount; i++)
+    {
+        threads.emplace_back(function, i, count * i / rangeCount, count * (i + 1) / rangeCount);
+    }
+
+    function(0, 0, count / rangeCount);
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+}
+
+template <typename GetSum>
+void TangentFrameGenerator::getCornerOffsets(const std::vector<uint32>& indexes, uint64 sumCount,
+                                             uint64 rangeCount, GetSum getSum,
+                                             std::vector<uint64>& cornerOffsets,
+                                             std::vector<uint64>& rangeBegins)
+{
+    cornerOffsets.assign(rangeCount * rangeCount, 0);
+    forEachRange(indexes.size() / 3, rangeCount,
+                 [&](uint64 rangeIndex, uint64 beginTriangle, uint64 endTriangle)
+    {
+        uint64* cornerCounts = &cornerOffsets[rangeIndex * rangeCount];
+        for (uint64 i = beginTriangle * 3; i < endTriangle * 3; i++)
+        {
+            uint32 sum = 0;
+            if (getSum(indexes[i], sum))
+            {
+                cornerCounts[getRangeIndex(sum, sumCount, rangeCount)]++;
+            }
+        }
+    });
+
+    // Grouped by the range of sums, and within it by the range of triangles, in file order
+    rangeBegins.resize(rangeCount + 1);
+    uint64 cornerCount = 0;
+    for (uint64 i = 0; i < rangeCount; i++)
+    {
+        rangeBegins[i] = cornerCount;
+        for (uint64 j = 0; j < rangeCount; j++)
+        {
+            uint64& cornerOffset = cornerOffsets[j * rangeCount + i];
+            uint64 rangeCornerCount = cornerOffset;
+            cornerOffset = cornerCount;
+            cornerCount += rangeCornerCount;
+        }
+    }
+    rangeBegins[rangeCount] = cornerCount;
+}
@@ -0,0 +1,170 @@
+#include "TangentFrameGeneratorBenchmark.h"
+
+TangentFrameGeneratorBenchmark::TangentFrameGeneratorBenchmark() : settings{}
+{
+    settings.repeatCount = 1;
+}
+
+BenchmarkSettings TangentFrameGeneratorBenchmark::getSettings()
+{
+    return settings;
+}
+
+void TangentFrameGeneratorBenchmark::setSettings(BenchmarkSettings settings)
+{
+    this->settings = settings;
+}
+
+bool TangentFrameGeneratorBenchmark::run()
+{
+    ModelData gridModelData;
+    std::vector<uint32> vertexPositionIndexes;
+    getGrid(gridModelData, vertexPositionIndexes);
+
+    std::printf("Tangent frame generation: %llu vertexes, %llu triangles\n",
+                static_cast<unsigned long long>(gridModelData.vertexes.size()),
+                static_cast<unsigned long long>(gridModelData.meshDataItems[0].indexes.size() / 3));
+
+    std::vector<uint32> threadCounts;
+    for (uint32 threadCount = 1; threadCount < settings.threadCount; threadCount *= 2)
+    {
+        threadCounts.push_back(threadCount);
+    }
+    threadCounts.push_back(settings.threadCount);
+
+    ModelData firstModelData;
+    for (uint32 threadCount : threadCounts)
+    {
+        TangentFrameGeneratorStatistics normalStatistics = {};
+        TangentFrameGeneratorStatistics tangentStatistics = {};
+        ModelData modelData;
+        bool result = generateTangentFrames(gridModelData, vertexPositionIndexes, threadCount,
+                                            normalStatistics, tangentStatistics, modelData);
+        if (!result)
+        {
+            std::printf("Failed to generate the tangent frames\n");
+
+            return false;
+        }
+
+        if (threadCount == 1)
+        {
+            std::printf("  corners: %.1f MB normals, %.1f MB tangents\n",
+                        normalStatistics.cornerMemorySize / (1024.0 * 1024.0),
+                        tangentStatistics.cornerMemorySize / (1024.0 * 1024.0));
+        }
+
+        std::printf("  %u threads: normals %.1f ms, %.0f triangles/ms, tangents %.1f ms, "
+                    "%.0f triangles/ms\n", threadCount,
+                    normalStatistics.normalGenerationTime * 1000.0,
+                    normalStatistics.normalThroughput,
+                    tangentStatistics.tangentGenerationTime * 1000.0,
+                    tangentStatistics.tangentThroughput);
+
+        // The corners are added up in triangle order with any thread count
+        if (threadCount == 1)
+        {
+            firstModelData = std::move(modelData);
+        }
+        else if (!isModelDataParsedEqual(firstModelData, modelData))
+        {
+            std::printf("  %u threads differ from 1 thread\n", threadCount);
+
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void TangentFrameGeneratorBenchmark::getGrid(ModelData& modelData,
+                                             std::vector<uint32>& vertexPositionIndexes)
+{
+    const uint32 size = TangentFrameBenchmarkGridSize;
+    const uint32 rowSize = size + 1;
+
+    modelData = {};
+    modelData.vertexes.resize(rowSize * rowSize);
+    vertexPositionIndexes.resize(modelData.vertexes.size());
+    for (uint32 y = 0; y < rowSize; y++)
+    {
+        for (uint32 x = 0; x < rowSize; x++)
+        {
+            uint32 i = y * rowSize + x;
+
+            Vertex& vertex = modelData.vertexes[i];
+            vertex.position = DirectX::XMFLOAT3(static_cast<float>(x),
+                                                std::sin(x * 0.1f) * std::cos(y * 0.1f),
+                                                static_cast<float>(y));
+            vertex.textureCoordinates = DirectX::XMFLOAT3(static_cast<float>(x) / size,
+                                                          static_cast<float>(y) / size, 0.0f);
+
+            vertexPositionIndexes[i] = i + 1;
+        }
+    }
+
+    MeshData meshData = {};
+    meshData.name = "Grid";
+    meshData.indexes.reserve(static_cast<uint64>(size) * size * 6);
+    for (uint32 y = 0; y < size; y++)
+    {
+        for (uint32 x = 0; x < size; x++)
+        {
+            uint32 i = y * rowSize + x;
+
+            const uint32 quadIndexes[] = { i, i + rowSize, i + 1, i + 1, i + rowSize,
+                                           i + rowSize + 1 };
+            meshData.indexes.insert(meshData.indexes.end(), quadIndexes, quadIndexes + 6);
+        }
+    }
+    modelData.meshDataItems.push_back(std::move(meshData));
+}
+
+bool TangentFrameGeneratorBenchmark::generateTangentFrames(
+    const ModelData& gridModelData, const std::vector<uint32>& vertexPositionIndexes,
+    uint32 threadCount, TangentFrameGeneratorStatistics& normalStatistics,
+    TangentFrameGeneratorStatistics& tangentStatistics, ModelData& modelData)
+{
+    TangentFrameGenerator tangentFrameGenerator;
+    TangentFrameGeneratorSettings generatorSettings = tangentFrameGenerator.getSettings();
+    generatorSettings.threadCount = threadCount;
+    tangentFrameGenerator.setSettings(generatorSettings);
+
+    for (uint32 i = 0; i < settings.repeatCount; i++)
+    {
+        // The normals are generated again from the grid every run
+        ModelData runModelData = gridModelData;
+        bool result = tangentFrameGenerator.generateNormals(runModelData, vertexPositionIndexes,
+                                                            runModelData.vertexes.size());
+        if (!result)
+        {
+            return false;
+        }
+
+        TangentFrameGeneratorStatistics runStatistics = tangentFrameGenerator.getStatistics();
+        if (i == 0 || runStatistics.normalGenerationTime < normalStatistics.normalGenerationTime)
+        {
+            normalStatistics = runStatistics;
+        }
+
+        result = tangentFrameGenerator.generateTangents(runModelData);
+        if (!result)
+        {
+            return false;
+        }
+
+        runStatistics = tangentFrameGenerator.getStatistics();
+        if (i == 0
+            || runStatistics.tangentGenerationTime < tangentStatistics.tangentGenerationTime)
+        {
+            tangentStatistics = runStatistics;
+        }
+
+        if (i == 0)
+        {
+            modelData = std::move(runModelData);
+        }
+    }
+
+    return true;
+}
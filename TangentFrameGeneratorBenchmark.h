@@ -0,0 +1,43 @@
+#pragma once
+#include <DirectXMath.h>
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#include <vector>
+
+#include "TangentFrameGenerator.h"
+
+#include "BenchmarkUtility.h"
+#include "IntUtility.h"
+#include "ModelFileParserUtility.h"
+#include "TangentFrameGeneratorUtility.h"
+
+// Generates the normals and tangents of a generated grid of about a million triangles with 1,
+// 2, 4... threads up to the thread count, checks that every thread count gives the result of one
+// thread and prints the time and triangles per millisecond of each
+class TangentFrameGeneratorBenchmark
+{
+    BenchmarkSettings settings;
+
+public:
+    TangentFrameGeneratorBenchmark();
+
+    BenchmarkSettings getSettings();
+    void setSettings(BenchmarkSettings settings);
+
+    bool run();
+
+private:
+    // A wavy grid with UVs, every vertex with a position of its own and no normal
+    void getGrid(ModelData& modelData, std::vector<uint32>& vertexPositionIndexes);
+
+    // Of the fastest runs
+    bool generateTangentFrames(const ModelData& gridModelData,
+                               const std::vector<uint32>& vertexPositionIndexes,
+                               uint32 threadCount,
+                               TangentFrameGeneratorStatistics& normalStatistics,
+                               TangentFrameGeneratorStatistics& tangentStatistics,
+                               ModelData& modelData);
+};
@@ -0,0 +1,42 @@
+#pragma once
+#include <DirectXMath.h>
+
+#include "IntUtility.h"
+
+// Triangles are split between threads in ranges of at least this many
+constexpr uint64 TangentFrameGeneratorMinTriangleRangeSize = 64 * 1024;
+
+// The weighted face normal a corner adds to the normal of its position
+struct NormalCorner
+{
+    uint32 positionIndex;
+    DirectX::XMFLOAT3 normal;
+};
+
+// The UV directions of its face a corner adds to its vertex
+struct TangentCorner
+{
+    uint32 vertexIndex;
+    DirectX::XMFLOAT3 tangent;
+    DirectX::XMFLOAT3 bitangent;
+};
+
+struct TangentFrameGeneratorSettings
+{
+    uint32 threadCount;
+};
+
+struct TangentFrameGeneratorStatistics
+{
+    uint64 triangleCount;
+    // B, of the corners sorted by the thread that adds them up, the same for any thread count
+    uint64 cornerMemorySize;
+
+    uint64 generatedNormalCount;
+    double normalGenerationTime; // s
+    double normalThroughput; // triangles/ms
+
+    uint64 generatedTangentCount;
+    double tangentGenerationTime; // s
+    double tangentThroughput; // triangles/ms
+};
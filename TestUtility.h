@@ -0,0 +1,30 @@
+#pragma once
+#include <cstdio>
+
+#include <string>
+
+#include "IntUtility.h"
+
+struct TestStatistics
+{
+    uint32 testCount;
+    uint32 failedTestCount;
+};
+
+// A failed test is printed and counted, the tests after it still run
+inline void checkTest(bool result, const std::string& name, TestStatistics& statistics)
+{
+    statistics.testCount++;
+    if (!result)
+    {
+        statistics.failedTestCount++;
+
+        std::printf("FAILED %s\n", name.c_str());
+    }
+}
+
+inline void addTestStatistics(const TestStatistics& otherStatistics, TestStatistics& statistics)
+{
+    statistics.testCount += otherStatistics.testCount;
+    statistics.failedTestCount += otherStatistics.failedTestCount;
+}
@@ -1,10 +1,16 @@
 #include "Texture.h"
 
-Texture::Texture(std::shared_ptr<Direct3d> direct3d) : fileParser(), buffer(), shaderResourceView()
+Texture::Texture(std::shared_ptr<Direct3d> direct3d)
+    : fileParser(), buffer(), shaderResourceView(), streamedImageData()
 {
     initialized = false;
     released = false;
 
+    width = 0;
+    height = 0;
+    mipmapLevels = 0;
+    mostDetailedMipmapLevel = 0;
+
     this->direct3d = direct3d;
 }
 
@@ -47,7 +53,28 @@ Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> Texture::getShaderResourceView(
     return shaderResourceView;
 }
 
-bool Texture::initialize(std::string filename)
+uint32 Texture::getWidth()
+{
+    return width;
+}
+
+uint32 Texture::getHeight()
+{
+    return height;
+}
+
+uint32 Texture::getMipmapLevels()
+{
+    return mipmapLevels;
+}
+
+uint32 Texture::getMostDetailedMipmapLevel()
+{
+    return mostDetailedMipmapLevel;
+}
+
+bool Texture::initialize(std::string filename, TextureClass textureClass,
+                         TextureBudgetSettings textureBudgetSettings)
 {
     if (isInitialized())
     {
@@ -56,21 +83,71 @@ bool Texture::initialize(std::string filename)
 
     ImageData imageData = {};
 
-    bool result = readImageData(filename, imageData);
+    bool result = readImageData(filename, textureClass, textureBudgetSettings, imageData);
+    if (!result)
+    {
+        return false;
+    }
+
+    result = initializeBuffer(imageData);
+    if (!result)
+    {
+        return false;
+    }
+
+    result = initializeShaderResourceView(imageData);
     if (!result)
     {
         return false;
     }
 
-    bool shouldGenerateMipmaps = false;
+    setInitialized();
+    return true;
+}
+
+bool Texture::initialize(const ImageData& imageData)
+{
+    if (isInitialized())
+    {
+        release();
+    }
+
+    bool result = initializeBuffer(imageData);
+    if (!result)
+    {
+        return false;
+    }
+
+    result = initializeShaderResourceView(imageData);
+    if (!result)
+    {
+        return false;
+    }
+
+    setInitialized();
+    return true;
+}
+
+bool Texture::initialize(std::shared_ptr<ImageData> imageData)
+{
+    if (isInitialized())
+    {
+        release();
+    }
+
+    if (!imageData)
+    {
+        return false;
+    }
 
-    result = initializeBuffer(imageData, shouldGenerateMipmaps);
+    // Uploaded straight from the shared image, which stays with the materials that use it
+    bool result = initializeBuffer(*imageData);
     if (!result)
     {
         return false;
     }
 
-    result = initializeShaderResourceView(imageData.format, shouldGenerateMipmaps);
+    result = initializeShaderResourceView(*imageData);
     if (!result)
     {
         return false;
@@ -80,27 +157,32 @@ bool Texture::initialize(std::string filename)
     return true;
 }
 
-bool Texture::initialize(ImageData imageData)
+bool Texture::initialize(std::shared_ptr<ImageData> imageData, uint32 mostDetailedMipmapLevel)
 {
     if (isInitialized())
     {
         release();
     }
 
-    bool shouldGenerateMipmaps = false;
+    if (!imageData || mostDetailedMipmapLevel >= imageData->mipmapLevels)
+    {
+        return false;
+    }
 
-    bool result = initializeBuffer(imageData, shouldGenerateMipmaps);
+    bool result = initializeBuffer(*imageData, mostDetailedMipmapLevel);
     if (!result)
     {
         return false;
     }
 
-    result = initializeShaderResourceView(imageData.format, shouldGenerateMipmaps);
+    result = initializeShaderResourceView(*imageData);
     if (!result)
     {
         return false;
     }
 
+    streamedImageData = imageData;
+
     setInitialized();
     return true;
 }
@@ -116,73 +198,111 @@ void Texture::release()
 
     buffer.Reset();
 
+    streamedImageData.reset();
+
     setReleased();
 }
 
-bool Texture::readImageData(std::string filename, ImageData& imageData)
+bool Texture::setMostDetailedMipmapLevel(uint32 mostDetailedMipmapLevel)
 {
-    bool result = fileParser.parseFile(filename, imageData);
+    if (!isInitialized() || !streamedImageData)
+    {
+        return false;
+    }
+    if (mostDetailedMipmapLevel >= streamedImageData->mipmapLevels)
+    {
+        return false;
+    }
+    if (mostDetailedMipmapLevel == this->mostDetailedMipmapLevel)
+    {
+        return true;
+    }
+
+    // Immutable textures cannot take new levels, the whole texture is created again and the old
+    // one goes once nothing binds it
+    Microsoft::WRL::ComPtr<ID3D11Texture2D> previousBuffer = buffer;
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> previousShaderResourceView =
+        shaderResourceView;
+    buffer.Reset();
+    shaderResourceView.Reset();
+    uint32 previousMostDetailedMipmapLevel = this->mostDetailedMipmapLevel;
+
+    bool result = initializeBuffer(*streamedImageData, mostDetailedMipmapLevel);
+    if (result)
+    {
+        result = initializeShaderResourceView(*streamedImageData);
+    }
     if (!result)
     {
+        buffer = previousBuffer;
+        shaderResourceView = previousShaderResourceView;
+        this->mostDetailedMipmapLevel = previousMostDetailedMipmapLevel;
+
         return false;
     }
 
     return true;
 }
 
-bool Texture::initializeBuffer(ImageData imageData, bool& shouldGenerateMipmaps)
+bool Texture::readImageData(std::string filename, TextureClass textureClass,
+                            TextureBudgetSettings textureBudgetSettings, ImageData& imageData)
+{
+    ImageFileParserSettings fileParserSettings = fileParser.getSettings();
+    fileParserSettings.textureBudgetSettings = textureBudgetSettings;
+    fileParser.setSettings(fileParserSettings);
+
+    bool result = fileParser.parseFile(filename, imageData, textureClass);
+    if (!result)
+    {
+        return false;
+    }
+
+    return true;
+}
+
+bool Texture::initializeBuffer(const ImageData& imageData, uint32 mostDetailedMipmapLevel)
 {
     D3D11_TEXTURE2D_DESC texture2dDesc = {};
 
-    texture2dDesc.Width = imageData.width;
-    texture2dDesc.Height = imageData.height;
-    texture2dDesc.ArraySize = 1;
+    texture2dDesc.Width = getImageMipmapSize(imageData.width, mostDetailedMipmapLevel);
+    texture2dDesc.Height = getImageMipmapSize(imageData.height, mostDetailedMipmapLevel);
+    texture2dDesc.ArraySize = imageData.arraySize;
     texture2dDesc.Format = imageData.format;
 
     DXGI_SAMPLE_DESC& sampleDesc = texture2dDesc.SampleDesc;
     sampleDesc.Count = 1;
     sampleDesc.Quality = 0;
 
-    std::vector<D3D11_SUBRESOURCE_DATA> initialData;
+    // Mipmap levels come with the image, from the file or generated by the parser on the CPU
+    uint32 residentMipmapLevels = imageData.mipmapLevels - mostDetailedMipmapLevel;
+    texture2dDesc.MipLevels = residentMipmapLevels;
 
-    if (imageData.mipmapLevels < 2 && direct3d->canMipmapBeGenerated(imageData.format))
+    texture2dDesc.Usage = D3D11_USAGE_IMMUTABLE;
+    texture2dDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+    texture2dDesc.MiscFlags = 0;
+    if (imageData.isCubemap)
     {
-        shouldGenerateMipmaps = true;
-
-        texture2dDesc.MipLevels = 0;
-
-        texture2dDesc.Usage = D3D11_USAGE_DEFAULT;
-        texture2dDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_RENDER_TARGET;
-        texture2dDesc.MiscFlags = D3D11_RESOURCE_MISC_GENERATE_MIPS;
-
-        MipmapData mipmapData = imageData.mipmapDataItems[0];
-
-        D3D11_SUBRESOURCE_DATA subresourceData = {};
-        subresourceData.pSysMem = mipmapData.data.data();
-        subresourceData.SysMemPitch = mipmapData.rowPitch;
-        subresourceData.SysMemSlicePitch = mipmapData.depthPitch;
-
-        initialData = {subresourceData};
+        texture2dDesc.MiscFlags = D3D11_RESOURCE_MISC_TEXTURECUBE;
     }
-    else
-    {
-        shouldGenerateMipmaps = false;
-
-        texture2dDesc.MipLevels = imageData.mipmapLevels;
 
-        texture2dDesc.Usage = D3D11_USAGE_IMMUTABLE;
-        texture2dDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
-        texture2dDesc.MiscFlags = 0;
+    std::vector<D3D11_SUBRESOURCE_DATA> initialData(static_cast<uint64>(residentMipmapLevels)
+                                                    * imageData.arraySize);
 
-        initialData = std::vector<D3D11_SUBRESOURCE_DATA>(imageData.mipmapLevels);
-        for (uint32 i = 0; i < imageData.mipmapLevels; i++)
+    // Every subresource points into the image payload, which may still be the mapped file,
+    // nothing is copied before the upload
+    for (uint32 i = 0; i < imageData.arraySize; i++)
+    {
+        for (uint32 j = 0; j < residentMipmapLevels; j++)
         {
-            MipmapData& mipmapData = imageData.mipmapDataItems[i];
-            D3D11_SUBRESOURCE_DATA& subresourceData = initialData[i];
-
-            subresourceData.pSysMem = mipmapData.data.data();
-            subresourceData.SysMemPitch = mipmapData.rowPitch;
-            subresourceData.SysMemSlicePitch = mipmapData.depthPitch;
+            uint32 subresourceIndex = getImageSubresourceIndex(imageData,
+                                                               j + mostDetailedMipmapLevel, i);
+            const ImageSubresourceData& imageSubresourceData =
+                imageData.subresourceDataItems[subresourceIndex];
+            D3D11_SUBRESOURCE_DATA& subresourceData = initialData[j + i * residentMipmapLevels];
+
+            subresourceData.pSysMem = getImageSubresourceData(imageData, subresourceIndex);
+            subresourceData.SysMemPitch = imageSubresourceData.rowPitch;
+            subresourceData.SysMemSlicePitch = imageSubresourceData.depthPitch;
         }
     }
 
@@ -192,21 +312,58 @@ bool Texture::initializeBuffer(ImageData imageData, bool& shouldGenerateMipmaps)
         return false;
     }
 
+    width = imageData.width;
+    height = imageData.height;
+    mipmapLevels = imageData.mipmapLevels;
+    this->mostDetailedMipmapLevel = mostDetailedMipmapLevel;
+
     return true;
 }
 
-bool Texture::initializeShaderResourceView(DXGI_FORMAT format, bool shouldGenerateMipmaps)
+bool Texture::initializeShaderResourceView(const ImageData& imageData)
 {
     D3D11_SHADER_RESOURCE_VIEW_DESC shaderResourceViewDesc = {};
-    shaderResourceViewDesc.Format = format;
-    shaderResourceViewDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
+    shaderResourceViewDesc.Format = imageData.format;
 
-    D3D11_TEX2D_SRV& texture2d = shaderResourceViewDesc.Texture2D;
-    texture2d.MostDetailedMip = 0;
-    texture2d.MipLevels = -1;
+    if (imageData.isCubemap && imageData.arraySize == 6)
+    {
+        shaderResourceViewDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURECUBE;
+
+        D3D11_TEXCUBE_SRV& textureCube = shaderResourceViewDesc.TextureCube;
+        textureCube.MostDetailedMip = 0;
+        textureCube.MipLevels = -1;
+    }
+    else if (imageData.isCubemap)
+    {
+        shaderResourceViewDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURECUBEARRAY;
+
+        D3D11_TEXCUBE_ARRAY_SRV& textureCubeArray = shaderResourceViewDesc.TextureCubeArray;
+        textureCubeArray.MostDetailedMip = 0;
+        textureCubeArray.MipLevels = -1;
+        textureCubeArray.First2DArrayFace = 0;
+        textureCubeArray.NumCubes = imageData.arraySize / 6;
+    }
+    else if (imageData.arraySize > 1)
+    {
+        shaderResourceViewDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2DARRAY;
+
+        D3D11_TEX2D_ARRAY_SRV& texture2dArray = shaderResourceViewDesc.Texture2DArray;
+        texture2dArray.MostDetailedMip = 0;
+        texture2dArray.MipLevels = -1;
+        texture2dArray.FirstArraySlice = 0;
+        texture2dArray.ArraySize = imageData.arraySize;
+    }
+    else
+    {
+        shaderResourceViewDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
+
+        D3D11_TEX2D_SRV& texture2d = shaderResourceViewDesc.Texture2D;
+        texture2d.MostDetailedMip = 0;
+        texture2d.MipLevels = -1;
+    }
 
     bool result = direct3d->createShaderResourceView(shaderResourceView, shaderResourceViewDesc,
-                                                     buffer, shouldGenerateMipmaps);
+                                                     buffer);
     if (!result)
     {
         return false;
@@ -27,6 +27,16 @@ class Texture
 
     Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> shaderResourceView;
 
+    // Of the whole image, whatever part of it is resident
+    uint32 width;
+    uint32 height;
+    uint32 mipmapLevels;
+
+    // Streamed textures keep their image to upload other mipmap levels from, see
+    // TextureStreamerUtility.h for what it costs on the CPU
+    std::shared_ptr<ImageData> streamedImageData;
+    uint32 mostDetailedMipmapLevel; // resident
+
 public:
     Texture(std::shared_ptr<Direct3d> direct3d);
     ~Texture();
@@ -42,12 +52,28 @@ public:
     Microsoft::WRL::ComPtr<ID3D11Texture2D> getBuffer();
     Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> getShaderResourceView();
 
-    bool initialize(std::string filename);
-    bool initialize(ImageData imageData);
+    uint32 getWidth();
+    uint32 getHeight();
+    uint32 getMipmapLevels();
+    uint32 getMostDetailedMipmapLevel();
+
+    // Read with the budget given, the renderer passes the one of the application
+    bool initialize(std::string filename, TextureClass textureClass = TextureClass::Undefined,
+                    TextureBudgetSettings textureBudgetSettings =
+                        getDefaultTextureBudgetSettings());
+    bool initialize(const ImageData& imageData);
+    bool initialize(std::shared_ptr<ImageData> imageData);
+    // Streamed, only the levels from mostDetailedMipmapLevel down are resident
+    bool initialize(std::shared_ptr<ImageData> imageData, uint32 mostDetailedMipmapLevel);
     void release();
 
+    // Recreates a streamed texture with the levels from mostDetailedMipmapLevel down, keeping the
+    // resident ones when that fails
+    bool setMostDetailedMipmapLevel(uint32 mostDetailedMipmapLevel);
+
 private:
-    bool readImageData(std::string filename, ImageData& imageData);
-    bool initializeBuffer(ImageData imageData, bool& shouldGenerateMipmaps);
-    bool initializeShaderResourceView(DXGI_FORMAT format, bool shouldGenerateMipmaps);
+    bool readImageData(std::string filename, TextureClass textureClass,
+                       TextureBudgetSettings textureBudgetSettings, ImageData& imageData);
+    bool initializeBuffer(const ImageData& imageData, uint32 mostDetailedMipmapLevel = 0);
+    bool initializeShaderResourceView(const ImageData& imageData);
 };
@@ -0,0 +1,170 @@
+#include "TextureAtlas.h"
+
+TextureAtlas::TextureAtlas(std::shared_ptr<Direct3d> direct3d) : fileParser(), builder(),
+    pageTextures(), regions()
+{
+    initialized = false;
+    released = false;
+
+    this->direct3d = direct3d;
+}
+
+TextureAtlas::~TextureAtlas()
+{
+    release();
+
+    direct3d.reset();
+}
+
+bool TextureAtlas::isInitialized()
+{
+    return initialized;
+}
+
+void TextureAtlas::setInitialized()
+{
+    initialized = true;
+    released = false;
+}
+
+bool TextureAtlas::isReleased()
+{
+    return released;
+}
+
+void TextureAtlas::setReleased()
+{
+    initialized = false;
+    released = true;
+}
+
+TextureAtlasBuilderSettings TextureAtlas::getBuilderSettings()
+{
+    return builder.getSettings();
+}
+
+void TextureAtlas::setBuilderSettings(TextureAtlasBuilderSettings builderSettings)
+{
+    builder.setSettings(builderSettings);
+}
+
+TextureAtlasBuilderStatistics TextureAtlas::getBuilderStatistics()
+{
+    return builder.getStatistics();
+}
+
+uint32 TextureAtlas::getRegionCount()
+{
+    return static_cast<uint32>(regions.size());
+}
+
+bool TextureAtlas::getRegion(uint32 regionIndex, TextureAtlasRegion& region)
+{
+    if (regionIndex >= regions.size())
+    {
+        return false;
+    }
+
+    region = regions[regionIndex];
+
+    return true;
+}
+
+std::shared_ptr<Texture> TextureAtlas::getPageTexture(uint32 pageIndex)
+{
+    if (pageIndex >= pageTextures.size())
+    {
+        return nullptr;
+    }
+
+    return pageTextures[pageIndex];
+}
+
+bool TextureAtlas::initialize(const std::vector<std::string>& filenames)
+{
+    if (isInitialized())
+    {
+        release();
+    }
+
+    std::vector<std::shared_ptr<ImageData>> imageDataItems;
+
+    bool result = readImageData(filenames, imageDataItems);
+    if (!result)
+    {
+        return false;
+    }
+
+    return initialize(imageDataItems);
+}
+
+bool TextureAtlas::initialize(const std::vector<std::shared_ptr<ImageData>>& imageDataItems)
+{
+    if (isInitialized())
+    {
+        release();
+    }
+
+    std::vector<std::shared_ptr<ImageData>> pageImageDataItems;
+
+    bool result = builder.buildAtlas(imageDataItems, pageImageDataItems, regions);
+    if (!result)
+    {
+        return false;
+    }
+
+    result = initializePages(pageImageDataItems);
+    if (!result)
+    {
+        return false;
+    }
+
+    setInitialized();
+    return true;
+}
+
+void TextureAtlas::release()
+{
+    if (isReleased())
+    {
+        return;
+    }
+
+    regions.clear();
+
+    pageTextures.clear();
+
+    setReleased();
+}
+
+bool TextureAtlas::readImageData(const std::vector<std::string>& filenames,
+                                 std::vector<std::shared_ptr<ImageData>>& imageDataItems)
+{
+    bool result = fileParser.parseFiles(filenames, 1, imageDataItems, TextureClass::Sprite);
+    if (!result)
+    {
+        return false;
+    }
+
+    return true;
+}
+
+bool TextureAtlas::initializePages(
+    const std::vector<std::shared_ptr<ImageData>>& pageImageDataItems)
+{
+    pageTextures.clear();
+    pageTextures.reserve(pageImageDataItems.size());
+    for (const auto& pageImageData : pageImageDataItems)
+    {
+        std::shared_ptr<Texture> pageTexture = createSharedPointer<Texture>(direct3d);
+        bool result = pageTexture->initialize(*pageImageData);
+        if (!result)
+        {
+            return false;
+        }
+
+        pageTextures.push_back(pageTexture);
+    }
+
+    return true;
+}
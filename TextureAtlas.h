@@ -0,0 +1,61 @@
+#pragma once
+#include <memory>
+
+#include <vector>
+
+#include <string>
+
+#include "Direct3d.h"
+
+#include "ImageFileParser.h"
+#include "TextureAtlasBuilder.h"
+#include "Texture.h"
+
+#include "ImageFileParserUtility.h"
+#include "TextureAtlasBuilderUtility.h"
+
+// Atlas pages packed from many sprite images, sprites drawn from the same page share its texture
+class TextureAtlas
+{
+    bool initialized;
+    bool released;
+
+    std::shared_ptr<Direct3d> direct3d;
+
+    ImageFileParser fileParser;
+
+    TextureAtlasBuilder builder;
+
+    std::vector<std::shared_ptr<Texture>> pageTextures;
+    std::vector<TextureAtlasRegion> regions; // in the order of the images
+
+public:
+    TextureAtlas(std::shared_ptr<Direct3d> direct3d);
+    ~TextureAtlas();
+
+private:
+    bool isInitialized();
+    void setInitialized();
+
+    bool isReleased();
+    void setReleased();
+
+public:
+    TextureAtlasBuilderSettings getBuilderSettings();
+    void setBuilderSettings(TextureAtlasBuilderSettings builderSettings);
+
+    TextureAtlasBuilderStatistics getBuilderStatistics();
+
+    uint32 getRegionCount();
+    bool getRegion(uint32 regionIndex, TextureAtlasRegion& region);
+    std::shared_ptr<Texture> getPageTexture(uint32 pageIndex);
+
+    bool initialize(const std::vector<std::string>& filenames);
+    bool initialize(const std::vector<std::shared_ptr<ImageData>>& imageDataItems);
+    void release();
+
+private:
+    bool readImageData(const std::vector<std::string>& filenames,
+                       std::vector<std::shared_ptr<ImageData>>& imageDataItems);
+    bool initializePages(const std::vector<std::shared_ptr<ImageData>>& pageImageDataItems);
+};
@@ -0,0 +1,510 @@
+#include "TextureAtlasBuilder.h"
+
+TextureAtlasBuilder::TextureAtlasBuilder() : settings{}, statistics{}, bcDecoder(),
+    mipmapGenerator()
+{
+    settings.pageWidth = TextureAtlasPageSize;
+    settings.pageHeight = TextureAtlasPageSize;
+    settings.padding = TextureAtlasPadding;
+    settings.mipmapLevels = TextureAtlasMipmapLevels;
+    settings.isSrgb = false;
+
+    settings.bcDecoderSettings = bcDecoder.getSettings();
+    settings.mipmapGeneratorSettings = mipmapGenerator.getSettings();
+}
+
+TextureAtlasBuilderSettings TextureAtlasBuilder::getSettings()
+{
+    return settings;
+}
+
+void TextureAtlasBuilder::setSettings(TextureAtlasBuilderSettings settings)
+{
+    this->settings = settings;
+}
+
+TextureAtlasBuilderStatistics TextureAtlasBuilder::getStatistics()
+{
+    return statistics;
+}
+
+bool TextureAtlasBuilder::buildAtlas(const std::vector<std::shared_ptr<ImageData>>& imageDataItems,
+                                     std::vector<std::shared_ptr<ImageData>>& pageImageDataItems,
+                                     std::vector<TextureAtlasRegion>& regions)
+{
+    statistics = {};
+    pageImageDataItems.clear();
+    regions.clear();
+
+    uint32 alignment = getAlignment();
+    if (settings.pageWidth == 0 || settings.pageHeight == 0
+        || settings.pageWidth % alignment != 0 || settings.pageHeight % alignment != 0)
+    {
+        return false;
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    std::vector<TextureAtlasImageSize> sizes(imageDataItems.size());
+    for (uint32 i = 0; i < imageDataItems.size(); i++)
+    {
+        if (!imageDataItems[i])
+        {
+            return false;
+        }
+
+        const ImageData& imageData = *imageDataItems[i];
+        if (imageData.width == 0 || imageData.height == 0 || imageData.depth > 1
+            || imageData.subresourceDataItems.empty())
+        {
+            return false;
+        }
+
+        TextureAtlasImageSize& size = sizes[i];
+        size.imageIndex = i;
+        size.width = getTextureAtlasAlignedSize(imageData.width + 2 * settings.padding,
+                                                alignment);
+        size.height = getTextureAtlasAlignedSize(imageData.height + 2 * settings.padding,
+                                                 alignment);
+
+        statistics.imagePixelCount += static_cast<uint64>(imageData.width) * imageData.height;
+        statistics.cellPixelCount += static_cast<uint64>(size.width) * size.height;
+    }
+
+    std::vector<TextureAtlasCell> cells;
+    uint32 pageCount = 0;
+    bool result = packCells(sizes, cells, pageCount);
+    if (!result)
+    {
+        return false;
+    }
+
+    auto packingEndTime = std::chrono::steady_clock::now();
+    std::chrono::duration<double> packingTime = packingEndTime - startTime;
+
+    pageImageDataItems.resize(pageCount);
+    for (auto& pageImageData : pageImageDataItems)
+    {
+        pageImageData = std::make_shared<ImageData>();
+        result = initializePage(*pageImageData);
+        if (!result)
+        {
+            return false;
+        }
+    }
+
+    regions.resize(imageDataItems.size());
+    for (uint32 i = 0; i < imageDataItems.size(); i++)
+    {
+        const ImageData& imageData = *imageDataItems[i];
+        const TextureAtlasCell& cell = cells[i];
+        ImageData& pageImageData = *pageImageDataItems[cell.pageIndex];
+
+        if (getImageFormatBlockSize(imageData.format) != 0)
+        {
+            ImageData decodedImageData = {};
+            result = decodeBcImage(imageData, decodedImageData);
+            if (!result)
+            {
+                return false;
+            }
+
+            copyImage(decodedImageData, cell, pageImageData);
+        }
+        else
+        {
+            if (!isMipmapGeneratorFormat(imageData.format))
+            {
+                return false;
+            }
+
+            copyImage(imageData, cell, pageImageData);
+        }
+
+        // The image sits at the top left of its cell, what alignment adds goes right and down
+        TextureAtlasRegion& region = regions[i];
+        region.pageIndex = cell.pageIndex;
+        region.x = cell.x + settings.padding;
+        region.y = cell.y + settings.padding;
+        region.width = imageData.width;
+        region.height = imageData.height;
+
+        float pageWidth = static_cast<float>(settings.pageWidth);
+        float pageHeight = static_cast<float>(settings.pageHeight);
+        region.minTextureCoordinates = DirectX::XMFLOAT2(region.x / pageWidth,
+                                                         region.y / pageHeight);
+        region.maxTextureCoordinates = DirectX::XMFLOAT2((region.x + region.width) / pageWidth,
+                                                         (region.y + region.height) / pageHeight);
+    }
+
+    for (auto& pageImageData : pageImageDataItems)
+    {
+        result = generatePageMipmaps(*pageImageData);
+        if (!result)
+        {
+            return false;
+        }
+    }
+
+    auto endTime = std::chrono::steady_clock::now();
+    std::chrono::duration<double> buildingTime = endTime - startTime;
+
+    statistics.imageCount = static_cast<uint32>(imageDataItems.size());
+    statistics.pageCount = pageCount;
+    statistics.pagePixelCount = static_cast<uint64>(pageCount) * settings.pageWidth
+        * settings.pageHeight;
+    if (statistics.pagePixelCount > 0)
+    {
+        statistics.occupancy = static_cast<double>(statistics.imagePixelCount)
+            / statistics.pagePixelCount;
+    }
+    statistics.packingTime = packingTime.count();
+    statistics.buildingTime = buildingTime.count();
+
+    return true;
+}
+
+bool TextureAtlasBuilder::packCells(const std::vector<TextureAtlasImageSize>& sizes,
+                                    std::vector<TextureAtlasCell>& cells, uint32& pageCount)
+{
+    cells.assign(sizes.size(), {});
+    pageCount = 0;
+
+    std::vector<uint32> order(sizes.size());
+    for (uint32 i = 0; i < order.size(); i++)
+    {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(),
+              [&sizes](uint32 index, uint32 otherIndex)
+              {
+                  return isTextureAtlasImageSizeBefore(sizes[index], sizes[otherIndex]);
+              });
+
+    // Every cell goes on the first page it fits in, a new page is started when none has room
+    std::vector<std::vector<SkylineNode>> skylines;
+    for (uint32 index : order)
+    {
+        const TextureAtlasImageSize& size = sizes[index];
+        if (size.width == 0 || size.height == 0 || size.width > settings.pageWidth
+            || size.height > settings.pageHeight)
+        {
+            return false;
+        }
+
+        uint32 nodeIndex = 0;
+        uint32 x = 0;
+        uint32 y = 0;
+        uint32 pageIndex = 0;
+        for (; pageIndex < skylines.size(); pageIndex++)
+        {
+            if (findSkylinePosition(skylines[pageIndex], size.width, size.height, nodeIndex, x, y))
+            {
+                break;
+            }
+        }
+        if (pageIndex == skylines.size())
+        {
+            SkylineNode node = {};
+            node.width = settings.pageWidth;
+            skylines.push_back({node});
+
+            findSkylinePosition(skylines[pageIndex], size.width, size.height, nodeIndex, x, y);
+        }
+
+        addSkylineNode(skylines[pageIndex], nodeIndex, x, y, size.width, size.height);
+
+        TextureAtlasCell& cell = cells[index];
+        cell.pageIndex = pageIndex;
+        cell.x = x;
+        cell.y = y;
+        cell.width = size.width;
+        cell.height = size.height;
+    }
+
+    pageCount = static_cast<uint32>(skylines.size());
+
+    return true;
+}
+
+uint32 TextureAtlasBuilder::getAlignment()
+{
+    if (settings.mipmapLevels <= 1)
+    {
+        return 1;
+    }
+
+    return 1u << (settings.mipmapLevels - 1);
+}
+
+bool TextureAtlasBuilder::findSkylinePosition(const std::vector<SkylineNode>& skyline,
+                                              uint32 width, uint32 height, uint32& nodeIndex,
+                                              uint32& x, uint32& y)
+{
+    bool isFound = false;
+    uint32 bestTop = UINT32_MAX;
+    for (uint32 i = 0; i < skyline.size(); i++)
+    {
+        uint32 nodeX = skyline[i].x;
+        if (nodeX + width > settings.pageWidth)
+        {
+            break;
+        }
+
+        // The cell rests on the highest node it spans
+        uint32 nodeY = 0;
+        uint32 spannedWidth = 0;
+        for (uint32 j = i; j < skyline.size() && spannedWidth < width; j++)
+        {
+            if (skyline[j].y > nodeY)
+            {
+                nodeY = skyline[j].y;
+            }
+            spannedWidth += skyline[j].width;
+        }
+        if (nodeY + height > settings.pageHeight || nodeY + height >= bestTop)
+        {
+            continue;
+        }
+
+        isFound = true;
+        bestTop = nodeY + height;
+        nodeIndex = i;
+        x = nodeX;
+        y = nodeY;
+    }
+
+    return isFound;
+}
+
+void TextureAtlasBuilder::addSkylineNode(std::vector<SkylineNode>& skyline, uint32 nodeIndex,
+                                         uint32 x, uint32 y, uint32 width, uint32 height)
+{
+    SkylineNode node = {};
+    node.x = x;
+    node.y = y + height;
+    node.width = width;
+    skyline.insert(skyline.begin() + nodeIndex, node);
+
+    // Nodes under the cell are cut away, the space below it is not used again
+    uint32 right = x + width;
+    for (uint32 i = nodeIndex + 1; i < skyline.size();)
+    {
+        SkylineNode& nextNode = skyline[i];
+        if (nextNode.x >= right)
+        {
+            break;
+        }
+
+        uint32 coveredWidth = right - nextNode.x;
+        if (nextNode.width <= coveredWidth)
+        {
+            skyline.erase(skyline.begin() + i);
+
+            continue;
+        }
+
+        nextNode.x += coveredWidth;
+        nextNode.width -= coveredWidth;
+        break;
+    }
+
+    for (uint32 i = 0; i + 1 < skyline.size();)
+    {
+        if (skyline[i].y == skyline[i + 1].y)
+        {
+            skyline[i].width += skyline[i + 1].width;
+            skyline.erase(skyline.begin() + i + 1);
+
+            continue;
+        }
+
+        i++;
+    }
+}
+
+bool TextureAtlasBuilder::decodeBcImage(const ImageData& imageData, ImageData& decodedImageData)
+{
+    DXGI_FORMAT decodedFormat = getBcDecodedFormat(imageData.format);
+    if (decodedFormat != DXGI_FORMAT_R8G8B8A8_UNORM
+        && decodedFormat != DXGI_FORMAT_R8G8B8A8_UNORM_SRGB)
+    {
+        return false;
+    }
+
+    // Decoded in whole blocks, the pixels past the image edge are never copied
+    uint32 blockColumnCount = getBcBlockCount(imageData.width);
+    uint32 blockRowCount = getBcBlockCount(imageData.height);
+
+    decodedImageData.width = imageData.width;
+    decodedImageData.height = imageData.height;
+    decodedImageData.depth = 1;
+    decodedImageData.format = decodedFormat;
+    decodedImageData.mipmapLevels = 1;
+    decodedImageData.arraySize = 1;
+
+    ImageSubresourceData subresourceData = {};
+    subresourceData.offset = 0;
+    subresourceData.rowPitch = blockColumnCount * BcBlockWidth * BcDecodedPixelSize;
+    subresourceData.depthPitch = subresourceData.rowPitch * blockRowCount * BcBlockWidth;
+    decodedImageData.subresourceDataItems.assign(1, subresourceData);
+    decodedImageData.data.resize(subresourceData.depthPitch);
+
+    bcDecoder.setSettings(settings.bcDecoderSettings);
+
+    const ImageSubresourceData& sourceSubresourceData = imageData.subresourceDataItems[0];
+    const unsigned char* blocks = getImageSubresourceData(imageData, 0);
+    for (uint32 i = 0; i < blockRowCount; i++)
+    {
+        bool result = bcDecoder.decodeBlockRow(
+            imageData.format, blocks + static_cast<uint64>(i) * sourceSubresourceData.rowPitch,
+            blockColumnCount,
+            decodedImageData.data.data() + static_cast<uint64>(i) * BcBlockWidth
+                * subresourceData.rowPitch,
+            subresourceData.rowPitch);
+        if (!result)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void TextureAtlasBuilder::copyImage(const ImageData& imageData, const TextureAtlasCell& cell,
+                                    ImageData& pageImageData)
+{
+    bool isBgra = imageData.format == DXGI_FORMAT_B8G8R8A8_UNORM
+        || imageData.format == DXGI_FORMAT_B8G8R8A8_UNORM_SRGB
+        || imageData.format == DXGI_FORMAT_B8G8R8X8_UNORM
+        || imageData.format == DXGI_FORMAT_B8G8R8X8_UNORM_SRGB;
+    bool hasAlpha = imageData.format != DXGI_FORMAT_B8G8R8X8_UNORM
+        && imageData.format != DXGI_FORMAT_B8G8R8X8_UNORM_SRGB;
+
+    const ImageSubresourceData& subresourceData = imageData.subresourceDataItems[0];
+    const unsigned char* pixels = getImageSubresourceData(imageData, 0);
+
+    uint32 pageRowPitch = pageImageData.subresourceDataItems[0].rowPitch;
+    unsigned char* pagePixels = pageImageData.data.data();
+
+    uint32 leftWidth = settings.padding;
+    uint32 rightWidth = cell.width - settings.padding - imageData.width;
+
+    // Rows of the padding above and below repeat the edge rows, columns beside every row repeat
+    // its edge pixels
+    for (uint32 i = 0; i < cell.height; i++)
+    {
+        uint32 row = 0;
+        if (i >= settings.padding)
+        {
+            row = i - settings.padding;
+        }
+        if (row >= imageData.height)
+        {
+            row = imageData.height - 1;
+        }
+
+        const unsigned char* sourceRow = pixels + static_cast<uint64>(row)
+            * subresourceData.rowPitch;
+        unsigned char* pageRow = pagePixels + static_cast<uint64>(cell.y + i) * pageRowPitch
+            + static_cast<uint64>(cell.x) * MipmapGeneratorPixelSize;
+        unsigned char* imageRow = pageRow + static_cast<uint64>(leftWidth)
+            * MipmapGeneratorPixelSize;
+
+        if (isBgra)
+        {
+            for (uint32 j = 0; j < imageData.width; j++)
+            {
+                const unsigned char* sourcePixel = sourceRow + j * MipmapGeneratorPixelSize;
+                unsigned char* pixel = imageRow + j * MipmapGeneratorPixelSize;
+                pixel[0] = sourcePixel[2];
+                pixel[1] = sourcePixel[1];
+                pixel[2] = sourcePixel[0];
+                pixel[3] = hasAlpha ? sourcePixel[3] : 255;
+            }
+        }
+        else
+        {
+            std::memcpy(imageRow, sourceRow,
+                        static_cast<uint64>(imageData.width) * MipmapGeneratorPixelSize);
+        }
+
+        for (uint32 j = 0; j < leftWidth; j++)
+        {
+            std::memcpy(pageRow + j * MipmapGeneratorPixelSize, imageRow,
+                        MipmapGeneratorPixelSize);
+        }
+
+        unsigned char* lastPixel = imageRow + static_cast<uint64>(imageData.width - 1)
+            * MipmapGeneratorPixelSize;
+        for (uint32 j = 1; j <= rightWidth; j++)
+        {
+            std::memcpy(lastPixel + j * MipmapGeneratorPixelSize, lastPixel,
+                        MipmapGeneratorPixelSize);
+        }
+    }
+}
+
+bool TextureAtlasBuilder::initializePage(ImageData& pageImageData)
+{
+    pageImageData.width = settings.pageWidth;
+    pageImageData.height = settings.pageHeight;
+    pageImageData.depth = 1;
+    pageImageData.format = DXGI_FORMAT_R8G8B8A8_UNORM;
+    if (settings.isSrgb)
+    {
+        pageImageData.format = DXGI_FORMAT_R8G8B8A8_UNORM_SRGB;
+    }
+    pageImageData.mipmapLevels = 1;
+    pageImageData.arraySize = 1;
+    pageImageData.isCubemap = false;
+
+    ImageSubresourceData subresourceData = {};
+    subresourceData.offset = 0;
+    subresourceData.rowPitch = settings.pageWidth * MipmapGeneratorPixelSize;
+    subresourceData.depthPitch = subresourceData.rowPitch * settings.pageHeight;
+    pageImageData.subresourceDataItems.assign(1, subresourceData);
+
+    // Space no cell covers stays transparent black
+    pageImageData.data.assign(subresourceData.depthPitch, 0);
+
+    return true;
+}
+
+bool TextureAtlasBuilder::generatePageMipmaps(ImageData& pageImageData)
+{
+    if (settings.mipmapLevels <= 1)
+    {
+        return true;
+    }
+
+    // Box filtering of pages whose sides are multiples of the alignment averages aligned squares
+    // of pixels, which never straddle two cells
+    MipmapGeneratorSettings mipmapGeneratorSettings = settings.mipmapGeneratorSettings;
+    mipmapGeneratorSettings.filter = MipmapFilter::Box;
+    mipmapGeneratorSettings.colorSpace = MipmapColorSpace::Undefined;
+    mipmapGenerator.setSettings(mipmapGeneratorSettings);
+
+    ImageData mipmappedImageData = {};
+    bool result = mipmapGenerator.generateMipmaps(pageImageData, mipmappedImageData);
+    if (!result)
+    {
+        return false;
+    }
+
+    // Smaller levels would mix the cells and are left out
+    if (mipmappedImageData.mipmapLevels > settings.mipmapLevels)
+    {
+        mipmappedImageData.mipmapLevels = settings.mipmapLevels;
+        mipmappedImageData.subresourceDataItems.resize(settings.mipmapLevels);
+
+        const ImageSubresourceData& lastSubresourceData =
+            mipmappedImageData.subresourceDataItems.back();
+        mipmappedImageData.data.resize(lastSubresourceData.offset
+                                       + lastSubresourceData.depthPitch);
+    }
+
+    pageImageData = std::move(mipmappedImageData);
+
+    return true;
+}
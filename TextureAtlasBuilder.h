@@ -0,0 +1,71 @@
+#pragma once
+#include <d3d11.h>
+
+#include <cstring>
+
+#include <memory>
+
+#include <vector>
+
+#include <algorithm>
+
+#include <chrono>
+
+#include "BcDecoder.h"
+#include "MipmapGenerator.h"
+
+#include "BcDecoderUtility.h"
+#include "ImageFileParserUtility.h"
+#include "IntUtility.h"
+#include "MemoryUtility.h"
+#include "MipmapGeneratorUtility.h"
+#include "TextureAtlasBuilderUtility.h"
+
+// Packs the top levels of many images into RGBA8 atlas pages on the CPU. Images are placed with a
+// bottom-left skyline packer on the first page they fit in, each in a cell of its padding rounded
+// up to the mipmap alignment, which is filled with its edge pixels. The pages are then given their
+// mipmap levels with a box filter, which keeps every level inside the cells
+class TextureAtlasBuilder
+{
+    TextureAtlasBuilderSettings settings;
+
+    TextureAtlasBuilderStatistics statistics;
+
+    BcDecoder bcDecoder;
+    MipmapGenerator mipmapGenerator;
+
+public:
+    TextureAtlasBuilder();
+
+    TextureAtlasBuilderSettings getSettings();
+    void setSettings(TextureAtlasBuilderSettings settings);
+
+    TextureAtlasBuilderStatistics getStatistics();
+
+    // Images may be RGBA8, BGRA8, BGRX8 or block-compressed, regions follow their order
+    bool buildAtlas(const std::vector<std::shared_ptr<ImageData>>& imageDataItems,
+                    std::vector<std::shared_ptr<ImageData>>& pageImageDataItems,
+                    std::vector<TextureAtlasRegion>& regions);
+
+    // Places cells of these sizes on as many pages as they need, cells follow the order of sizes
+    bool packCells(const std::vector<TextureAtlasImageSize>& sizes,
+                   std::vector<TextureAtlasCell>& cells, uint32& pageCount);
+
+private:
+    uint32 getAlignment();
+
+    // Lowest top, then leftmost, position of a cell on the skyline, false when it does not fit
+    bool findSkylinePosition(const std::vector<SkylineNode>& skyline, uint32 width,
+                             uint32 height, uint32& nodeIndex, uint32& x, uint32& y);
+    void addSkylineNode(std::vector<SkylineNode>& skyline, uint32 nodeIndex, uint32 x, uint32 y,
+                        uint32 width, uint32 height);
+
+    // Decodes the top level of the first array slice, in whole blocks
+    bool decodeBcImage(const ImageData& imageData, ImageData& decodedImageData);
+    // Copies the top level of the first array slice of an 8-bit RGBA or BGRA image into its cell,
+    // swizzled to RGBA, and fills the rest of the cell with its edge pixels
+    void copyImage(const ImageData& imageData, const TextureAtlasCell& cell,
+                   ImageData& pageImageData);
+    bool initializePage(ImageData& pageImageData);
+    bool generatePageMipmaps(ImageData& pageImageData);
+};
@@ -0,0 +1,127 @@
+#include "TextureAtlasBuilderBenchmark.h"
+
+TextureAtlasBuilderBenchmark::TextureAtlasBuilderBenchmark() : settings{}
+{
+    settings.repeatCount = 1;
+}
+
+BenchmarkSettings TextureAtlasBuilderBenchmark::getSettings()
+{
+    return settings;
+}
+
+void TextureAtlasBuilderBenchmark::setSettings(BenchmarkSettings settings)
+{
+    this->settings = settings;
+}
+
+bool TextureAtlasBuilderBenchmark::run(const std::vector<std::string>& filenames)
+{
+    std::vector<std::shared_ptr<ImageData>> imageDataItems;
+    if (filenames.empty())
+    {
+        generateImages(imageDataItems);
+    }
+    else
+    {
+        ImageFileParser imageFileParser;
+        bool result = imageFileParser.parseFiles(filenames, settings.threadCount,
+                                                 imageDataItems, TextureClass::Sprite);
+        if (!result)
+        {
+            std::printf("Failed to parse the images\n");
+
+            return false;
+        }
+    }
+
+    TextureAtlasBuilderStatistics statistics = {};
+    bool result = buildAtlas(imageDataItems, statistics);
+    if (!result)
+    {
+        std::printf("Failed to build the atlas\n");
+
+        return false;
+    }
+
+    std::printf("Atlas: %u images, %u pages\n", statistics.imageCount, statistics.pageCount);
+    std::printf("  images: %.1f%% of the pages, with padding and alignment %.1f%%\n",
+                statistics.occupancy * 100.0,
+                statistics.pagePixelCount > 0
+                    ? static_cast<double>(statistics.cellPixelCount) /
+                        statistics.pagePixelCount * 100.0 : 0.0);
+    std::printf("  packing: %.3f ms\n", statistics.packingTime * 1000.0);
+    std::printf("  building: %.3f ms\n", statistics.buildingTime * 1000.0);
+
+    return true;
+}
+
+void TextureAtlasBuilderBenchmark::generateImages(
+    std::vector<std::shared_ptr<ImageData>>& imageDataItems)
+{
+    imageDataItems.clear();
+    imageDataItems.reserve(TextureAtlasBenchmarkImageCount);
+
+    uint32 state = 1;
+    auto getRandomSize = [&state]()
+    {
+        state = state * 1664525u + 1013904223u;
+        return TextureAtlasBenchmarkMinImageSize + (state >> 8) %
+            (TextureAtlasBenchmarkMaxImageSize - TextureAtlasBenchmarkMinImageSize + 1);
+    };
+
+    for (uint32 i = 0; i < TextureAtlasBenchmarkImageCount; i++)
+    {
+        auto imageData = std::make_shared<ImageData>();
+        imageData->width = getRandomSize();
+        imageData->height = getRandomSize();
+        imageData->depth = 1;
+        imageData->format = DXGI_FORMAT_R8G8B8A8_UNORM;
+        imageData->mipmapLevels = 1;
+        imageData->arraySize = 1;
+
+        ImageSubresourceData subresourceData = {};
+        subresourceData.rowPitch = imageData->width * 4;
+        subresourceData.depthPitch = subresourceData.rowPitch * imageData->height;
+        imageData->subresourceDataItems.push_back(subresourceData);
+
+        // A color per image
+        imageData->data.resize(subresourceData.depthPitch);
+        for (uint64 j = 0; j < imageData->data.size(); j++)
+        {
+            imageData->data[j] = static_cast<unsigned char>(i * 4 + j % 4);
+        }
+
+        imageDataItems.push_back(imageData);
+    }
+}
+
+bool TextureAtlasBuilderBenchmark::buildAtlas(
+    const std::vector<std::shared_ptr<ImageData>>& imageDataItems,
+    TextureAtlasBuilderStatistics& statistics)
+{
+    TextureAtlasBuilder builder;
+    TextureAtlasBuilderSettings builderSettings = builder.getSettings();
+    builderSettings.bcDecoderSettings.threadCount = settings.threadCount;
+    builderSettings.mipmapGeneratorSettings.threadCount = settings.threadCount;
+    builder.setSettings(builderSettings);
+
+    for (uint32 i = 0; i < settings.repeatCount; i++)
+    {
+        std::vector<std::shared_ptr<ImageData>> pageImageDataItems;
+        std::vector<TextureAtlasRegion> regions;
+        bool result = builder.buildAtlas(imageDataItems, pageImageDataItems, regions);
+        if (!result)
+        {
+            return false;
+        }
+
+        TextureAtlasBuilderStatistics runStatistics = builder.getStatistics();
+        if (i == 0 || runStatistics.buildingTime < statistics.buildingTime)
+        {
+            statistics = runStatistics;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include <d3d11.h>
+
+#include <cstdio>
+
+#include <memory>
+
+#include <string>
+#include <vector>
+
+#include "ImageFileParser.h"
+#include "TextureAtlasBuilder.h"
+
+#include "BenchmarkUtility.h"
+#include "ImageFileParserUtility.h"
+#include "IntUtility.h"
+#include "TextureAtlasBuilderUtility.h"
+
+// Packs images into atlas pages and builds the pages with their mipmap levels, printing how much
+// of the pages the images fill and the packing and building times. Sprites of random sizes are
+// generated when no image files are given
+class TextureAtlasBuilderBenchmark
+{
+    BenchmarkSettings settings;
+
+public:
+    TextureAtlasBuilderBenchmark();
+
+    BenchmarkSettings getSettings();
+    void setSettings(BenchmarkSettings settings);
+
+    bool run(const std::vector<std::string>& filenames);
+
+private:
+    void generateImages(std::vector<std::shared_ptr<ImageData>>& imageDataItems);
+    // Of the fastest run
+    bool buildAtlas(const std::vector<std::shared_ptr<ImageData>>& imageDataItems,
+                    TextureAtlasBuilderStatistics& statistics);
+};
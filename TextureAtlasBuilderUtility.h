@@ -0,0 +1,100 @@
+#pragma once
+#include <d3d11.h>
+#include <DirectXMath.h>
+
+#include "BcDecoderUtility.h"
+#include "IntUtility.h"
+#include "MipmapGeneratorUtility.h"
+
+constexpr uint32 TextureAtlasPageSize = 2048; // pixels, of both sides
+// Around every image, filled with its edge pixels so filtering never reaches another image
+constexpr uint32 TextureAtlasPadding = 4; // pixels
+// Down to where the padding of the smallest level is still a pixel wide
+constexpr uint32 TextureAtlasMipmapLevels = 3;
+
+struct TextureAtlasBuilderSettings
+{
+    uint32 pageWidth; // pixels
+    uint32 pageHeight; // pixels
+    uint32 padding; // pixels, at least 2 ^ (mipmapLevels - 1) for bilinear filtering of every level
+    // Images are placed on multiples of 2 ^ (mipmapLevels - 1) so no level mixes two of them
+    uint32 mipmapLevels;
+    bool isSrgb; // pages are R8G8B8A8_UNORM_SRGB rather than R8G8B8A8_UNORM
+
+    BcDecoderSettings bcDecoderSettings;
+    MipmapGeneratorSettings mipmapGeneratorSettings;
+};
+
+struct TextureAtlasBuilderStatistics
+{
+    uint32 imageCount;
+    uint32 pageCount;
+
+    uint64 imagePixelCount; // of the images
+    uint64 cellPixelCount; // of the images with their padding and alignment
+    uint64 pagePixelCount; // of the top levels of the pages
+    double occupancy; // of the pages by the images, in [0, 1]
+
+    double packingTime; // s
+    double buildingTime; // s, packing, copying and mipmap generation included
+};
+
+// Part of the skyline of a page, the top of what is placed in [x, x + width)
+struct SkylineNode
+{
+    uint32 x;
+    uint32 y;
+    uint32 width;
+};
+
+// Where the packer puts an image with its padding
+struct TextureAtlasCell
+{
+    uint32 pageIndex;
+    uint32 x;
+    uint32 y;
+    uint32 width;
+    uint32 height;
+};
+
+// An image of an atlas, its texture coordinates reach the edges of its outer pixels
+struct TextureAtlasRegion
+{
+    uint32 pageIndex;
+
+    uint32 x; // pixels, in the page
+    uint32 y; // pixels, in the page
+    uint32 width; // pixels
+    uint32 height; // pixels
+
+    DirectX::XMFLOAT2 minTextureCoordinates;
+    DirectX::XMFLOAT2 maxTextureCoordinates;
+};
+
+// Images go from the tallest to the shortest, then the widest, then in their own order
+struct TextureAtlasImageSize
+{
+    uint32 imageIndex;
+    uint32 width;
+    uint32 height;
+};
+
+inline bool isTextureAtlasImageSizeBefore(const TextureAtlasImageSize& size,
+                                          const TextureAtlasImageSize& otherSize)
+{
+    if (size.height != otherSize.height)
+    {
+        return size.height > otherSize.height;
+    }
+    if (size.width != otherSize.width)
+    {
+        return size.width > otherSize.width;
+    }
+
+    return size.imageIndex < otherSize.imageIndex;
+}
+
+inline uint32 getTextureAtlasAlignedSize(uint32 size, uint32 alignment)
+{
+    return (size + alignment - 1) / alignment * alignment;
+}
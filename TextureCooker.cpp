@@ -0,0 +1,333 @@
+#include "TextureCooker.h"
+
+TextureCooker::TextureCooker()
+    : imageFileParser(), pixelConverter(), mipmapGenerator(), bcEncoder(), bcDecoder(), settings{},
+      statistics{}
+{
+    settings.format = DXGI_FORMAT_BC7_UNORM;
+    settings.isMipmapGenerationEnabled = true;
+    settings.imageFileParserSettings = imageFileParser.getSettings();
+    // The chain is generated after the expansion to RGBA8, from the top level only, and every
+    // level of the source is kept whatever the runtime budget
+    settings.imageFileParserSettings.isMipmapGenerationEnabled = false;
+    settings.imageFileParserSettings.textureBudgetSettings.skippedMipmapLevels = 0;
+    settings.pixelConverterSettings = pixelConverter.getSettings();
+    settings.mipmapGeneratorSettings = mipmapGenerator.getSettings();
+    settings.bcEncoderSettings = bcEncoder.getSettings();
+    settings.bcDecoderSettings = bcDecoder.getSettings();
+}
+
+TextureCookerSettings TextureCooker::getSettings()
+{
+    return settings;
+}
+
+void TextureCooker::setSettings(TextureCookerSettings settings)
+{
+    this->settings = settings;
+}
+
+TextureCookerStatistics TextureCooker::getStatistics()
+{
+    return statistics;
+}
+
+bool TextureCooker::cookFile(std::string inputFilename, std::string outputFilename)
+{
+    statistics = {};
+
+    if (!isBcEncoderFormat(settings.format))
+    {
+        return false;
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    imageFileParser.setSettings(settings.imageFileParserSettings);
+
+    ImageData imageData = {};
+    bool result = imageFileParser.parseFile(inputFilename, imageData);
+    if (!result)
+    {
+        return false;
+    }
+    if (imageData.depth > 1)
+    {
+        return false;
+    }
+
+    result = convertToRgba8(imageData);
+    if (!result)
+    {
+        return false;
+    }
+
+    auto parsingEndTime = std::chrono::steady_clock::now();
+
+    if (settings.isMipmapGenerationEnabled)
+    {
+        // Blocks tagged sRGB are sampled in linear space, so are their levels filtered
+        MipmapGeneratorSettings mipmapGeneratorSettings = settings.mipmapGeneratorSettings;
+        if (mipmapGeneratorSettings.colorSpace == MipmapColorSpace::Undefined
+            && getTextureCookerSrgbFormat(settings.format) == settings.format)
+        {
+            mipmapGeneratorSettings.colorSpace = MipmapColorSpace::Srgb;
+        }
+        mipmapGenerator.setSettings(mipmapGeneratorSettings);
+
+        ImageData mipmappedImageData = {};
+        result = mipmapGenerator.generateMipmaps(imageData, mipmappedImageData);
+        if (!result)
+        {
+            return false;
+        }
+        imageData = std::move(mipmappedImageData);
+
+        statistics.mipmapGeneratorStatistics = mipmapGenerator.getStatistics();
+    }
+
+    auto mipmapGenerationEndTime = std::chrono::steady_clock::now();
+
+    // Sources in sRGB stay in sRGB, their blocks are fitted to the stored values either way
+    DXGI_FORMAT format = settings.format;
+    if (imageData.format == DXGI_FORMAT_R8G8B8A8_UNORM_SRGB)
+    {
+        format = getTextureCookerSrgbFormat(format);
+    }
+
+    bcEncoder.setSettings(settings.bcEncoderSettings);
+
+    ImageData encodedImageData = {};
+    result = bcEncoder.encodeImage(imageData, format, encodedImageData);
+    if (!result)
+    {
+        return false;
+    }
+
+    auto encodingEndTime = std::chrono::steady_clock::now();
+
+    result = writeDdsFile(outputFilename, encodedImageData);
+    if (!result)
+    {
+        return false;
+    }
+
+    auto writingEndTime = std::chrono::steady_clock::now();
+
+    bcDecoder.setSettings(settings.bcDecoderSettings);
+
+    ImageData decodedImageData = {};
+    result = bcDecoder.decodeImage(encodedImageData, decodedImageData);
+    if (!result)
+    {
+        return false;
+    }
+
+    bool isOpaque = format == DXGI_FORMAT_BC1_UNORM || format == DXGI_FORMAT_BC1_UNORM_SRGB;
+    statistics.psnr = measurePsnr(imageData, decodedImageData, isOpaque ? 3 : 4);
+
+    std::chrono::duration<double> parsingTime = parsingEndTime - startTime;
+    std::chrono::duration<double> mipmapGenerationTime = mipmapGenerationEndTime -
+        parsingEndTime;
+    std::chrono::duration<double> encodingTime = encodingEndTime - mipmapGenerationEndTime;
+    std::chrono::duration<double> writingTime = writingEndTime - encodingEndTime;
+    std::chrono::duration<double> cookingTime = writingEndTime - startTime;
+
+    statistics.sourceSize = decodedImageData.data.size();
+    statistics.cookedSize = getFileSize(outputFilename);
+    statistics.parsingTime = parsingTime.count();
+    statistics.mipmapGenerationTime = mipmapGenerationTime.count();
+    statistics.encodingTime = encodingTime.count();
+    statistics.writingTime = writingTime.count();
+    statistics.cookingTime = cookingTime.count();
+
+    statistics.imageFileParserStatistics = imageFileParser.getStatistics();
+    statistics.bcEncoderStatistics = bcEncoder.getStatistics();
+    statistics.bcDecoderStatistics = bcDecoder.getStatistics();
+    statistics.blockThroughput = statistics.bcEncoderStatistics.blockThroughput;
+
+    return true;
+}
+
+bool TextureCooker::convertToRgba8(ImageData& imageData)
+{
+    PixelMasks masks = {};
+    masks.bitCount = 32;
+    masks.redMask = Dds32BitMaskThird8Bit;
+    masks.greenMask = Dds32BitMaskSecond8Bit;
+    masks.blueMask = Dds32BitMaskFirst8Bit;
+
+    DXGI_FORMAT format = DXGI_FORMAT_R8G8B8A8_UNORM;
+    switch (imageData.format)
+    {
+    case DXGI_FORMAT_R8G8B8A8_UNORM:
+    case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+    {
+        return true;
+    }
+    case DXGI_FORMAT_B8G8R8A8_UNORM:
+    {
+        masks.alphaMask = Dds32BitMaskFourth8Bit;
+
+        break;
+    }
+    case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
+    {
+        masks.alphaMask = Dds32BitMaskFourth8Bit;
+        format = DXGI_FORMAT_R8G8B8A8_UNORM_SRGB;
+
+        break;
+    }
+    case DXGI_FORMAT_B8G8R8X8_UNORM:
+    {
+        break;
+    }
+    case DXGI_FORMAT_B8G8R8X8_UNORM_SRGB:
+    {
+        format = DXGI_FORMAT_R8G8B8A8_UNORM_SRGB;
+
+        break;
+    }
+    default:
+    {
+        return false;
+    }
+    }
+
+    // Both layouts have 4 B pixels, so the payload keeps its size and subresources
+    const ImageSubresourceData& lastSubresourceData = imageData.subresourceDataItems.back();
+    uint64 payloadSize = lastSubresourceData.offset + lastSubresourceData.depthPitch;
+
+    std::vector<unsigned char, AlignedAllocator<unsigned char, ImageDataAlignment>> data(
+        payloadSize);
+
+    pixelConverter.setSettings(settings.pixelConverterSettings);
+    bool result = pixelConverter.convertToRgba8(getImagePayload(imageData), masks,
+                                                payloadSize / PixelConverterRgba8PixelSize,
+                                                data.data());
+    if (!result)
+    {
+        return false;
+    }
+
+    imageData.format = format;
+    imageData.data = std::move(data);
+    imageData.mappedFile.reset();
+    imageData.mappedDataOffset = 0;
+
+    return true;
+}
+
+double TextureCooker::measurePsnr(const ImageData& imageData, const ImageData& decodedImageData,
+                                  uint32 channelCount)
+{
+    uint64 squaredError = 0;
+    uint64 sampleCount = 0;
+    for (uint64 i = 0; i < imageData.subresourceDataItems.size(); i++)
+    {
+        uint32 mipmapLevel = static_cast<uint32>(i % imageData.mipmapLevels);
+        uint32 width = getImageMipmapSize(imageData.width, mipmapLevel);
+        uint32 height = getImageMipmapSize(imageData.height, mipmapLevel);
+
+        const ImageSubresourceData& sourceData = imageData.subresourceDataItems[i];
+        const ImageSubresourceData& decodedData = decodedImageData.subresourceDataItems[i];
+        const unsigned char* pixels = getImageSubresourceData(imageData, static_cast<uint32>(i));
+        const unsigned char* decodedPixels = getImageSubresourceData(decodedImageData,
+                                                                     static_cast<uint32>(i));
+        for (uint32 y = 0; y < height; y++)
+        {
+            const unsigned char* row = pixels + static_cast<uint64>(y) * sourceData.rowPitch;
+            const unsigned char* decodedRow = decodedPixels + static_cast<uint64>(y) *
+                decodedData.rowPitch;
+            for (uint32 x = 0; x < width; x++)
+            {
+                for (uint32 j = 0; j < channelCount; j++)
+                {
+                    int32 difference = row[x * BcDecodedPixelSize + j] - decodedRow[x *
+                        BcDecodedPixelSize + j];
+                    squaredError += static_cast<uint64>(difference * difference);
+                }
+            }
+        }
+        sampleCount += static_cast<uint64>(width) * height * channelCount;
+    }
+
+    if (squaredError == 0)
+    {
+        return INFINITY;
+    }
+
+    double meanSquaredError = static_cast<double>(squaredError) / sampleCount;
+
+    return 10.0 * std::log10(255.0 * 255.0 / meanSquaredError);
+}
+
+bool TextureCooker::writeDdsFile(std::string filename, const ImageData& imageData)
+{
+    DdsHeader header = {};
+    header.size = sizeof(DdsHeader);
+    header.flags = static_cast<uint32>(Ddsd::Caps) | static_cast<uint32>(Ddsd::Height)
+        | static_cast<uint32>(Ddsd::Width) | static_cast<uint32>(Ddsd::PixelFormat)
+        | static_cast<uint32>(Ddsd::LinearSize);
+    header.height = imageData.height;
+    header.width = imageData.width;
+    header.pitchOrLinearSize = imageData.subresourceDataItems[0].depthPitch;
+    header.depth = 1;
+    header.mipMapCount = imageData.mipmapLevels;
+    header.caps = static_cast<uint32>(DdsCaps::Texture);
+    if (imageData.mipmapLevels > 1)
+    {
+        header.flags |= static_cast<uint32>(Ddsd::MipmapCount);
+        header.caps |= static_cast<uint32>(DdsCaps::Complex) | static_cast<uint32>(
+            DdsCaps::Mipmap);
+    }
+    if (imageData.isCubemap)
+    {
+        header.caps |= static_cast<uint32>(DdsCaps::Complex);
+        header.caps2 = static_cast<uint32>(DdsCaps2::Cubemap) | DdsCaps2AllFaces;
+    }
+
+    header.pixelFormat.size = sizeof(DdsPixelFormat);
+    header.pixelFormat.flags = static_cast<uint32>(Ddpf::FourCc);
+    header.pixelFormat.fourCc = getDdsLegacyFourCc(imageData.format);
+
+    bool isSingleTexture = imageData.arraySize == 1 || (imageData.isCubemap
+        && imageData.arraySize == 6);
+
+    DdsHeaderDxt10 headerDxt10 = {};
+    bool hasHeaderDxt10 = header.pixelFormat.fourCc == 0 || !isSingleTexture;
+    if (hasHeaderDxt10)
+    {
+        header.pixelFormat.fourCc = DdsMagicNumberDx10.number;
+
+        headerDxt10.dxgiFormat = imageData.format;
+        headerDxt10.resourceDimension = static_cast<uint32>(DdsResourceDimension::Texture2d);
+        headerDxt10.arraySize = imageData.arraySize;
+        if (imageData.isCubemap)
+        {
+            headerDxt10.miscFlag = static_cast<uint32>(DdsResourceMisc::TextureCube);
+            headerDxt10.arraySize /= 6;
+        }
+    }
+
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    file.write(reinterpret_cast<const char*>(DdsMagicNumberDds.chars), DdsMagicNumberSize);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    if (hasHeaderDxt10)
+    {
+        file.write(reinterpret_cast<const char*>(&headerDxt10), sizeof(headerDxt10));
+    }
+    file.write(reinterpret_cast<const char*>(imageData.data.data()),
+               static_cast<std::streamsize>(imageData.data.size()));
+    if (!file)
+    {
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <d3d11.h>
+
+#include <fstream>
+
+#include <cmath>
+#include <cstring>
+
+#include <vector>
+
+#include <string>
+
+#include <chrono>
+
+#include "BcDecoder.h"
+#include "BcEncoder.h"
+#include "ImageFileParser.h"
+#include "MipmapGenerator.h"
+#include "PixelConverter.h"
+
+#include "DdsUtility.h"
+#include "FileParserUtility.h"
+#include "ImageFileParserUtility.h"
+#include "IntUtility.h"
+#include "TextureCookerUtility.h"
+
+// Cooks uncompressed DDS files into BC1, BC3 or BC7 ones offline: the image is expanded to RGBA8,
+// given its mipmap levels by the filter chosen, encoded, and decoded again to measure the PSNR of
+// the result
+class TextureCooker
+{
+    ImageFileParser imageFileParser;
+    PixelConverter pixelConverter;
+    MipmapGenerator mipmapGenerator;
+    BcEncoder bcEncoder;
+    BcDecoder bcDecoder;
+
+    TextureCookerSettings settings;
+
+    TextureCookerStatistics statistics;
+
+public:
+    TextureCooker();
+
+    TextureCookerSettings getSettings();
+    void setSettings(TextureCookerSettings settings);
+
+    TextureCookerStatistics getStatistics();
+
+    bool cookFile(std::string inputFilename, std::string outputFilename);
+
+private:
+    // Swizzles BGRA and BGRX images to RGBA8, which images already in RGBA8 are left as
+    bool convertToRgba8(ImageData& imageData);
+
+    double measurePsnr(const ImageData& imageData, const ImageData& decodedImageData,
+                       uint32 channelCount);
+
+    // With only a DDS header when the format has a FourCC of its own and the image is a texture
+    // or a single cubemap, with the DX10 one after it otherwise
+    bool writeDdsFile(std::string filename, const ImageData& imageData);
+};
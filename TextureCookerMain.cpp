@@ -0,0 +1,175 @@
+#include <cstdio>
+#include <cstdlib>
+
+#include <string>
+
+#include <thread>
+
+#include "TextureCooker.h"
+
+#include "CpuUtility.h"
+#include "IntUtility.h"
+#include "MipmapGeneratorUtility.h"
+#include "TextureCookerUtility.h"
+
+int32 main(int32 argumentCount, char* arguments[])
+{
+    TextureCooker textureCooker;
+    TextureCookerSettings settings = textureCooker.getSettings();
+
+    uint32 threadCount = std::thread::hardware_concurrency();
+    if (threadCount == 0)
+    {
+        threadCount = 1;
+    }
+    bool isSrgb = false;
+
+    std::string inputFilename;
+    std::string outputFilename;
+    for (int32 i = 1; i < argumentCount; i++)
+    {
+        std::string argument = arguments[i];
+        bool hasValue = i + 1 < argumentCount;
+        if (argument == "--format" && hasValue)
+        {
+            std::string format = arguments[++i];
+            if (format == "bc1")
+            {
+                settings.format = DXGI_FORMAT_BC1_UNORM;
+            }
+            else if (format == "bc3")
+            {
+                settings.format = DXGI_FORMAT_BC3_UNORM;
+            }
+            else if (format == "bc7")
+            {
+                settings.format = DXGI_FORMAT_BC7_UNORM;
+            }
+            else
+            {
+                std::printf("%s", TextureCookerUsage);
+
+                return 1;
+            }
+        }
+        else if (argument == "--quality" && hasValue)
+        {
+            std::string quality = arguments[++i];
+            if (quality == "fast")
+            {
+                settings.bcEncoderSettings.quality = BcEncoderQuality::Fast;
+            }
+            else if (quality == "high")
+            {
+                settings.bcEncoderSettings.quality = BcEncoderQuality::High;
+            }
+            else
+            {
+                std::printf("%s", TextureCookerUsage);
+
+                return 1;
+            }
+        }
+        else if (argument == "--filter" && hasValue)
+        {
+            std::string filter = arguments[++i];
+            if (filter == "box")
+            {
+                settings.mipmapGeneratorSettings.filter = MipmapFilter::Box;
+            }
+            else if (filter == "kaiser")
+            {
+                settings.mipmapGeneratorSettings.filter = MipmapFilter::Kaiser;
+            }
+            else if (filter == "lanczos")
+            {
+                settings.mipmapGeneratorSettings.filter = MipmapFilter::Lanczos;
+            }
+            else
+            {
+                std::printf("%s", TextureCookerUsage);
+
+                return 1;
+            }
+        }
+        else if (argument == "--srgb")
+        {
+            isSrgb = true;
+        }
+        else if (argument == "--no-mipmaps")
+        {
+            settings.isMipmapGenerationEnabled = false;
+        }
+        else if (argument == "--threads" && hasValue)
+        {
+            threadCount = static_cast<uint32>(std::strtoul(arguments[++i], nullptr, 10));
+            if (threadCount == 0)
+            {
+                threadCount = 1;
+            }
+        }
+        else if (argument == "--scalar")
+        {
+            settings.pixelConverterSettings.instructionSet = CpuInstructionSet::Scalar;
+            settings.imageFileParserSettings.pixelConverterSettings.instructionSet =
+                CpuInstructionSet::Scalar;
+            settings.mipmapGeneratorSettings.instructionSet = CpuInstructionSet::Scalar;
+            settings.bcEncoderSettings.instructionSet = CpuInstructionSet::Scalar;
+            settings.bcDecoderSettings.instructionSet = CpuInstructionSet::Scalar;
+        }
+        else if (inputFilename.empty())
+        {
+            inputFilename = argument;
+        }
+        else if (outputFilename.empty())
+        {
+            outputFilename = argument;
+        }
+        else
+        {
+            std::printf("%s", TextureCookerUsage);
+
+            return 1;
+        }
+    }
+    if (inputFilename.empty() || outputFilename.empty())
+    {
+        std::printf("%s", TextureCookerUsage);
+
+        return 1;
+    }
+
+    if (isSrgb)
+    {
+        settings.format = getTextureCookerSrgbFormat(settings.format);
+    }
+    settings.mipmapGeneratorSettings.threadCount = threadCount;
+    settings.bcEncoderSettings.threadCount = threadCount;
+    settings.bcDecoderSettings.threadCount = threadCount;
+
+    textureCooker.setSettings(settings);
+    if (!textureCooker.cookFile(inputFilename, outputFilename))
+    {
+        std::printf("Failed to cook %s\n", inputFilename.c_str());
+
+        return 1;
+    }
+
+    TextureCookerStatistics statistics = textureCooker.getStatistics();
+    BcEncoderStatistics bcEncoderStatistics = statistics.bcEncoderStatistics;
+    std::printf("%s -> %s\n", inputFilename.c_str(), outputFilename.c_str());
+    std::printf("  size: %.2f MB -> %.2f MB\n", statistics.sourceSize / (1024.0 * 1024.0),
+                statistics.cookedSize / (1024.0 * 1024.0));
+    std::printf("  blocks: %llu, %s, %u threads\n",
+                static_cast<unsigned long long>(bcEncoderStatistics.blockCount),
+                getCpuInstructionSetName(bcEncoderStatistics.instructionSet),
+                bcEncoderStatistics.threadCount);
+    std::printf("  time: %.3f s (parsing %.3f s, mipmaps %.3f s, encoding %.3f s, writing %.3f s)"
+                "\n", statistics.cookingTime, statistics.parsingTime,
+                statistics.mipmapGenerationTime, statistics.encodingTime, statistics.writingTime);
+    std::printf("  throughput: %.0f blocks/s, mipmaps %.2f GB/s\n", statistics.blockThroughput,
+                statistics.mipmapGeneratorStatistics.throughput);
+    std::printf("  PSNR: %.2f dB\n", statistics.psnr);
+
+    return 0;
+}
@@ -0,0 +1,93 @@
+#pragma once
+#include <d3d11.h>
+
+#include "BcDecoderUtility.h"
+#include "BcEncoderUtility.h"
+#include "DdsUtility.h"
+#include "ImageFileParserUtility.h"
+#include "IntUtility.h"
+#include "MipmapGeneratorUtility.h"
+#include "PixelConverterUtility.h"
+
+constexpr const char* TextureCookerUsage =
+    "Usage: TextureCooker [options] input.dds output.dds\n"
+    "  --format bc1|bc3|bc7         block format, bc7 by default\n"
+    "  --quality fast|high          encoder preset, fast by default\n"
+    "  --srgb                       tag the blocks as sRGB\n"
+    "  --filter box|kaiser|lanczos  mipmap filter, kaiser by default\n"
+    "  --no-mipmaps                 keep the mipmap levels of the input\n"
+    "  --threads N                  worker threads, every core by default\n"
+    "  --scalar                     don't use SIMD instructions\n";
+
+struct TextureCookerSettings
+{
+    DXGI_FORMAT format; // BC1, BC3 or BC7, UNORM or UNORM_SRGB
+    bool isMipmapGenerationEnabled; // the whole chain from the top level, else the source's own
+
+    ImageFileParserSettings imageFileParserSettings;
+    PixelConverterSettings pixelConverterSettings;
+    MipmapGeneratorSettings mipmapGeneratorSettings; // sRGB colors for the _SRGB formats
+    BcEncoderSettings bcEncoderSettings;
+    BcDecoderSettings bcDecoderSettings; // of the decoding PSNR is measured on
+};
+
+struct TextureCookerStatistics
+{
+    uint64 sourceSize; // B, of the RGBA8 payload with every mipmap level
+    uint64 cookedSize; // B, of the file written
+    double parsingTime; // s
+    double mipmapGenerationTime; // s
+    double encodingTime; // s
+    double writingTime; // s
+    double cookingTime; // s, without measuring PSNR
+    double blockThroughput; // blocks/s, encoded
+    double psnr; // dB, of the decoded blocks against the source, RGB only for BC1
+
+    ImageFileParserStatistics imageFileParserStatistics;
+    MipmapGeneratorStatistics mipmapGeneratorStatistics;
+    BcEncoderStatistics bcEncoderStatistics;
+    BcDecoderStatistics bcDecoderStatistics;
+};
+
+// The BC formats files with only a DDS header can have, other formats need the DX10 one
+inline uint32 getDdsLegacyFourCc(DXGI_FORMAT format)
+{
+    switch (format)
+    {
+    case DXGI_FORMAT_BC1_UNORM:
+    {
+        return DdsMagicNumberDxt1.number;
+    }
+    case DXGI_FORMAT_BC3_UNORM:
+    {
+        return DdsMagicNumberDxt5.number;
+    }
+    default:
+    {
+        return 0;
+    }
+    }
+}
+
+inline DXGI_FORMAT getTextureCookerSrgbFormat(DXGI_FORMAT format)
+{
+    switch (format)
+    {
+    case DXGI_FORMAT_BC1_UNORM:
+    {
+        return DXGI_FORMAT_BC1_UNORM_SRGB;
+    }
+    case DXGI_FORMAT_BC3_UNORM:
+    {
+        return DXGI_FORMAT_BC3_UNORM_SRGB;
+    }
+    case DXGI_FORMAT_BC7_UNORM:
+    {
+        return DXGI_FORMAT_BC7_UNORM_SRGB;
+    }
+    default:
+    {
+        return format;
+    }
+    }
+}
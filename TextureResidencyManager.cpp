@@ -0,0 +1,315 @@
+#include "TextureResidencyManager.h"
+
+TextureResidencyManager::TextureResidencyManager() : settings{}, statistics{}
+{
+    settings.budgetSize = 256ull * 1024 * 1024;
+    settings.maxUploadSize = 0;
+}
+
+TextureResidencyManagerSettings TextureResidencyManager::getSettings()
+{
+    return settings;
+}
+
+void TextureResidencyManager::setSettings(TextureResidencyManagerSettings settings)
+{
+    this->settings = settings;
+}
+
+TextureResidencyManagerStatistics TextureResidencyManager::getStatistics()
+{
+    return statistics;
+}
+
+uint32 TextureResidencyManager::getReachableMipmapLevel(const std::vector<uint64>& mipmapSizes)
+{
+    if (mipmapSizes.empty())
+    {
+        return 0;
+    }
+
+    // A texture raised past its resident levels is uploaded whole, so the limit takes it whole too
+    uint32 mipmapLevel = static_cast<uint32>(mipmapSizes.size()) - 1;
+    uint64 textureSize = mipmapSizes[mipmapLevel];
+    while (mipmapLevel > 0)
+    {
+        uint64 raisedTextureSize = textureSize + mipmapSizes[mipmapLevel - 1];
+        if (raisedTextureSize > settings.budgetSize)
+        {
+            break;
+        }
+        if (settings.maxUploadSize != 0 && raisedTextureSize > settings.maxUploadSize)
+        {
+            break;
+        }
+
+        mipmapLevel--;
+        textureSize = raisedTextureSize;
+    }
+
+    return mipmapLevel;
+}
+
+bool TextureResidencyManager::addTexture(const std::vector<uint64>& mipmapSizes,
+                                         uint32 tailMipmapLevel, uint32& textureIndex)
+{
+    if (tailMipmapLevel >= mipmapSizes.size())
+    {
+        return false;
+    }
+
+    TextureResidency residency = {};
+    residency.isUsed = true;
+    residency.mipmapSizes = mipmapSizes;
+    residency.tailMipmapLevel = tailMipmapLevel;
+    residency.requestedMipmapLevel = tailMipmapLevel;
+    residency.mostDetailedMipmapLevel = tailMipmapLevel;
+
+    if (freeTextureIndexes.empty())
+    {
+        textureIndex = static_cast<uint32>(residencies.size());
+        residencies.push_back(residency);
+    }
+    else
+    {
+        textureIndex = freeTextureIndexes.back();
+        freeTextureIndexes.pop_back();
+        residencies[textureIndex] = residency;
+    }
+
+    return true;
+}
+
+void TextureResidencyManager::removeTexture(uint32 textureIndex)
+{
+    if (!isTextureIndexValid(textureIndex))
+    {
+        return;
+    }
+
+    residencies[textureIndex] = {};
+    freeTextureIndexes.push_back(textureIndex);
+}
+
+bool TextureResidencyManager::requestMipmapLevel(uint32 textureIndex, uint32 mipmapLevel)
+{
+    if (!isTextureIndexValid(textureIndex))
+    {
+        return false;
+    }
+
+    TextureResidency& residency = residencies[textureIndex];
+    if (mipmapLevel > residency.tailMipmapLevel)
+    {
+        mipmapLevel = residency.tailMipmapLevel;
+    }
+    residency.requestedMipmapLevel = mipmapLevel;
+
+    return true;
+}
+
+uint32 TextureResidencyManager::getMostDetailedMipmapLevel(uint32 textureIndex)
+{
+    if (!isTextureIndexValid(textureIndex))
+    {
+        return 0;
+    }
+
+    return residencies[textureIndex].mostDetailedMipmapLevel;
+}
+
+bool TextureResidencyManager::update(std::vector<TextureResidencyChange>& changes)
+{
+    statistics = {};
+    changes.clear();
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    uint64 residentSize = 0;
+    uint64 uploadedSize = 0;
+
+    // Tails are resident whatever the budget
+    std::vector<uint32> mostDetailedMipmapLevels(residencies.size(), 0);
+    // A texture whose levels change is created again with every level it keeps, so all of them
+    // are uploaded, not only the new ones
+    std::vector<uint64> residentTextureSizes(residencies.size(), 0); // B
+    std::vector<uint64> uploadedTextureSizes(residencies.size(), 0); // B
+    std::priority_queue<TextureResidencyRequest, std::vector<TextureResidencyRequest>,
+                        bool (*)(const TextureResidencyRequest&, const TextureResidencyRequest&)>
+        requests(
+            [](const TextureResidencyRequest& request, const TextureResidencyRequest& otherRequest)
+            {
+                // The queue gives the last of its order first
+                return isTextureResidencyRequestBefore(otherRequest, request);
+            });
+    for (uint32 i = 0; i < residencies.size(); i++)
+    {
+        const TextureResidency& residency = residencies[i];
+        if (!residency.isUsed)
+        {
+            continue;
+        }
+
+        statistics.textureCount++;
+
+        for (uint32 j = residency.tailMipmapLevel; j < residency.mipmapSizes.size(); j++)
+        {
+            statistics.tailSize += residency.mipmapSizes[j];
+        }
+        for (uint32 j = residency.requestedMipmapLevel; j < residency.mipmapSizes.size(); j++)
+        {
+            statistics.requestedSize += residency.mipmapSizes[j];
+        }
+
+        mostDetailedMipmapLevels[i] = residency.tailMipmapLevel;
+        for (uint32 j = residency.tailMipmapLevel; j < residency.mipmapSizes.size(); j++)
+        {
+            residentTextureSizes[i] += residency.mipmapSizes[j];
+        }
+        if (residency.requestedMipmapLevel < residency.tailMipmapLevel)
+        {
+            TextureResidencyRequest request = {};
+            request.textureIndex = i;
+            request.mipmapLevel = residency.tailMipmapLevel - 1;
+            request.distance = residency.tailMipmapLevel - residency.requestedMipmapLevel;
+            requests.push(request);
+        }
+    }
+    residentSize = statistics.tailSize;
+
+    // Levels toward the requested ones, a texture stopping at the first level that does not fit as
+    // every more detailed one is larger still
+    while (!requests.empty())
+    {
+        TextureResidencyRequest request = requests.top();
+        requests.pop();
+
+        uint32 textureIndex = request.textureIndex;
+        const TextureResidency& residency = residencies[textureIndex];
+        uint64 size = residency.mipmapSizes[request.mipmapLevel];
+        if (residentSize + size > settings.budgetSize)
+        {
+            continue;
+        }
+
+        // The first level past the resident ones uploads the texture whole, the next ones only
+        // themselves
+        uint64 residentTextureSize = residentTextureSizes[textureIndex] + size;
+        uint64 textureUploadedSize = 0;
+        bool isUploaded = request.mipmapLevel < residency.mostDetailedMipmapLevel;
+        if (isUploaded)
+        {
+            textureUploadedSize = residentTextureSize - uploadedTextureSizes[textureIndex];
+            if (settings.maxUploadSize != 0
+                && uploadedSize + textureUploadedSize > settings.maxUploadSize)
+            {
+                continue;
+            }
+        }
+
+        residentSize += size;
+        residentTextureSizes[textureIndex] = residentTextureSize;
+        if (isUploaded)
+        {
+            uploadedSize += textureUploadedSize;
+            uploadedTextureSizes[textureIndex] = residentTextureSize;
+        }
+        mostDetailedMipmapLevels[textureIndex] = request.mipmapLevel;
+
+        if (request.mipmapLevel > residency.requestedMipmapLevel)
+        {
+            request.mipmapLevel--;
+            request.distance--;
+            requests.push(request);
+        }
+    }
+
+    // Levels resident past the requested ones stay while the budget has room, so textures going
+    // back and forth are not uploaded again
+    for (uint32 i = 0; i < residencies.size(); i++)
+    {
+        const TextureResidency& residency = residencies[i];
+        if (!residency.isUsed || mostDetailedMipmapLevels[i] <= residency.mostDetailedMipmapLevel)
+        {
+            continue;
+        }
+
+        uint64 keptSize = 0;
+        for (uint32 j = residency.mostDetailedMipmapLevel; j < mostDetailedMipmapLevels[i]; j++)
+        {
+            keptSize += residency.mipmapSizes[j];
+        }
+        if (residentSize + keptSize <= settings.budgetSize)
+        {
+            residentSize += keptSize;
+            residentTextureSizes[i] += keptSize;
+            mostDetailedMipmapLevels[i] = residency.mostDetailedMipmapLevel;
+
+            continue;
+        }
+
+        // A lowered texture is uploaded again with the levels it keeps. The ones toward its request
+        // are uploaded whatever the limit, the ones kept past them only while the limit has room
+        uploadedSize += residentTextureSizes[i];
+        while (mostDetailedMipmapLevels[i] > residency.mostDetailedMipmapLevel)
+        {
+            uint64 size = residency.mipmapSizes[mostDetailedMipmapLevels[i] - 1];
+            if (residentSize + size > settings.budgetSize)
+            {
+                break;
+            }
+            if (settings.maxUploadSize != 0 && uploadedSize + size > settings.maxUploadSize)
+            {
+                break;
+            }
+
+            residentSize += size;
+            uploadedSize += size;
+            residentTextureSizes[i] += size;
+            mostDetailedMipmapLevels[i]--;
+        }
+    }
+
+    for (uint32 i = 0; i < residencies.size(); i++)
+    {
+        TextureResidency& residency = residencies[i];
+        if (!residency.isUsed || mostDetailedMipmapLevels[i] == residency.mostDetailedMipmapLevel)
+        {
+            continue;
+        }
+
+        if (mostDetailedMipmapLevels[i] < residency.mostDetailedMipmapLevel)
+        {
+            statistics.raisedTextureCount++;
+        }
+        else
+        {
+            for (uint32 j = residency.mostDetailedMipmapLevel; j < mostDetailedMipmapLevels[i]; j++)
+            {
+                statistics.evictedSize += residency.mipmapSizes[j];
+            }
+            statistics.loweredTextureCount++;
+        }
+
+        residency.mostDetailedMipmapLevel = mostDetailedMipmapLevels[i];
+
+        TextureResidencyChange change = {};
+        change.textureIndex = i;
+        change.mostDetailedMipmapLevel = residency.mostDetailedMipmapLevel;
+        changes.push_back(change);
+    }
+
+    statistics.residentSize = residentSize;
+    statistics.uploadedSize = uploadedSize;
+
+    auto endTime = std::chrono::steady_clock::now();
+    std::chrono::duration<double> updateTime = endTime - startTime;
+    statistics.updateTime = updateTime.count();
+
+    return true;
+}
+
+bool TextureResidencyManager::isTextureIndexValid(uint32 textureIndex)
+{
+    return textureIndex < residencies.size() && residencies[textureIndex].isUsed;
+}
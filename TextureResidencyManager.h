@@ -0,0 +1,51 @@
+#pragma once
+#include <queue>
+#include <vector>
+
+#include <chrono>
+
+#include "IntUtility.h"
+#include "TextureResidencyManagerUtility.h"
+
+// Decides how many mipmap levels of every streamed texture are resident from the level last
+// requested for it, without touching the GPU. Tails are always resident, the rest of the budget
+// goes one level at a time to the textures furthest from their requests, and levels resident past
+// a request are kept only while the budget has room for them. A texture whose levels change is
+// created again, so the upload limit is charged with every level it keeps
+class TextureResidencyManager
+{
+    TextureResidencyManagerSettings settings;
+
+    TextureResidencyManagerStatistics statistics;
+
+    std::vector<TextureResidency> residencies;
+    std::vector<uint32> freeTextureIndexes;
+
+public:
+    TextureResidencyManager();
+
+    TextureResidencyManagerSettings getSettings();
+    void setSettings(TextureResidencyManagerSettings settings);
+
+    TextureResidencyManagerStatistics getStatistics();
+
+    // Most detailed level a texture of these level sizes can be raised to, the first one that
+    // with every smaller level is over the budget or the upload limit is never resident
+    uint32 getReachableMipmapLevel(const std::vector<uint64>& mipmapSizes);
+
+    // The texture starts with its tail resident and requested, mipmapSizes having every level
+    bool addTexture(const std::vector<uint64>& mipmapSizes, uint32 tailMipmapLevel,
+                    uint32& textureIndex);
+    void removeTexture(uint32 textureIndex);
+
+    // Levels less detailed than the tail are taken as the tail
+    bool requestMipmapLevel(uint32 textureIndex, uint32 mipmapLevel);
+    uint32 getMostDetailedMipmapLevel(uint32 textureIndex);
+
+    // Gives the textures whose resident levels change, in texture index order, and takes the
+    // changes as done
+    bool update(std::vector<TextureResidencyChange>& changes);
+
+private:
+    bool isTextureIndexValid(uint32 textureIndex);
+};
@@ -0,0 +1,234 @@
+#include "TextureResidencyManagerTests.h"
+
+TextureResidencyManagerTests::TextureResidencyManagerTests() : statistics{}
+{
+}
+
+TestStatistics TextureResidencyManagerTests::getStatistics()
+{
+    return statistics;
+}
+
+void TextureResidencyManagerTests::run()
+{
+    statistics = {};
+
+    testTails();
+    testRaise();
+    testUploadLimit();
+    testSharedUploadLimit();
+    testKeptLevels();
+    testLoweredTexture();
+    testReachableLevel();
+}
+
+void TextureResidencyManagerTests::testTails()
+{
+    TextureResidencyManager residencyManager;
+    initializeManager(1024, 0, 2, residencyManager);
+
+    // Tails are resident from the start, there is nothing to change
+    std::vector<TextureResidencyChange> changes;
+    bool result = residencyManager.update(changes);
+    TextureResidencyManagerStatistics managerStatistics = residencyManager.getStatistics();
+    checkTest(result && changes.empty() && managerStatistics.textureCount == 2
+              && managerStatistics.residentSize == 10 && managerStatistics.tailSize == 10
+              && managerStatistics.uploadedSize == 0, "TextureResidencyManager tails",
+              statistics);
+}
+
+void TextureResidencyManagerTests::testRaise()
+{
+    TextureResidencyManager residencyManager;
+    initializeManager(1024, 0, 1, residencyManager);
+
+    // The texture is created again, with the tail it had
+    residencyManager.requestMipmapLevel(0, 0);
+    std::vector<TextureResidencyChange> changes;
+    residencyManager.update(changes);
+    TextureResidencyManagerStatistics managerStatistics = residencyManager.getStatistics();
+    checkTest(hasChanges(changes, {{0, 0}}) && managerStatistics.residentSize == 85
+              && managerStatistics.uploadedSize == 85 && managerStatistics.raisedTextureCount == 1,
+              "TextureResidencyManager raise", statistics);
+
+    residencyManager.update(changes);
+    managerStatistics = residencyManager.getStatistics();
+    checkTest(changes.empty() && managerStatistics.uploadedSize == 0,
+              "TextureResidencyManager raise done", statistics);
+}
+
+void TextureResidencyManagerTests::testUploadLimit()
+{
+    // Levels 1 and 0 alone would be 80 B, with the levels the texture has they are 85 B
+    TextureResidencyManager residencyManager;
+    initializeManager(1024, 82, 1, residencyManager);
+
+    residencyManager.requestMipmapLevel(0, 0);
+    std::vector<TextureResidencyChange> changes;
+    residencyManager.update(changes);
+    TextureResidencyManagerStatistics managerStatistics = residencyManager.getStatistics();
+    checkTest(hasChanges(changes, {{0, 1}}) && managerStatistics.uploadedSize == 21,
+              "TextureResidencyManager upload limit of a whole texture", statistics);
+
+    // Level 0 is never uploaded alone, the texture with it is over the limit
+    residencyManager.update(changes);
+    managerStatistics = residencyManager.getStatistics();
+    checkTest(changes.empty() && managerStatistics.uploadedSize == 0,
+              "TextureResidencyManager texture over the upload limit", statistics);
+
+    TextureResidencyManagerSettings settings = residencyManager.getSettings();
+    settings.maxUploadSize = 85;
+    residencyManager.setSettings(settings);
+
+    residencyManager.update(changes);
+    managerStatistics = residencyManager.getStatistics();
+    checkTest(hasChanges(changes, {{0, 0}}) && managerStatistics.uploadedSize == 85,
+              "TextureResidencyManager texture at the upload limit", statistics);
+}
+
+void TextureResidencyManagerTests::testSharedUploadLimit()
+{
+    TextureResidencyManager residencyManager;
+    initializeManager(1024, 100, 2, residencyManager);
+
+    // Both get level 1 for 21 B each, level 0 would take either to 85 B
+    residencyManager.requestMipmapLevel(0, 0);
+    residencyManager.requestMipmapLevel(1, 0);
+    std::vector<TextureResidencyChange> changes;
+    residencyManager.update(changes);
+    TextureResidencyManagerStatistics managerStatistics = residencyManager.getStatistics();
+    checkTest(hasChanges(changes, {{0, 1}, {1, 1}}) && managerStatistics.uploadedSize == 42
+              && managerStatistics.residentSize == 42,
+              "TextureResidencyManager upload limit of several textures", statistics);
+
+    // Ties go to the smaller texture index
+    TextureResidencyManagerSettings settings = residencyManager.getSettings();
+    settings.maxUploadSize = 90;
+    residencyManager.setSettings(settings);
+
+    residencyManager.update(changes);
+    managerStatistics = residencyManager.getStatistics();
+    checkTest(hasChanges(changes, {{0, 0}}) && managerStatistics.uploadedSize == 85,
+              "TextureResidencyManager upload limit ties", statistics);
+}
+
+void TextureResidencyManagerTests::testKeptLevels()
+{
+    TextureResidencyManager residencyManager;
+    initializeManager(1024, 0, 1, residencyManager);
+
+    residencyManager.requestMipmapLevel(0, 0);
+    std::vector<TextureResidencyChange> changes;
+    residencyManager.update(changes);
+
+    // Levels past the request stay while the budget has room, nothing is uploaded
+    residencyManager.requestMipmapLevel(0, 2);
+    residencyManager.update(changes);
+    TextureResidencyManagerStatistics managerStatistics = residencyManager.getStatistics();
+    checkTest(changes.empty() && managerStatistics.residentSize == 85
+              && managerStatistics.requestedSize == 5 && managerStatistics.uploadedSize == 0,
+              "TextureResidencyManager levels kept past the request", statistics);
+}
+
+void TextureResidencyManagerTests::testLoweredTexture()
+{
+    TextureResidencyManager residencyManager;
+    initializeManager(1024, 0, 1, residencyManager);
+
+    residencyManager.requestMipmapLevel(0, 0);
+    std::vector<TextureResidencyChange> changes;
+    residencyManager.update(changes);
+    residencyManager.requestMipmapLevel(0, 2);
+
+    // Level 1 still fits in the budget, the texture is created again with it and the tail
+    TextureResidencyManagerSettings settings = residencyManager.getSettings();
+    settings.budgetSize = 30;
+    residencyManager.setSettings(settings);
+
+    residencyManager.update(changes);
+    TextureResidencyManagerStatistics managerStatistics = residencyManager.getStatistics();
+    checkTest(hasChanges(changes, {{0, 1}}) && managerStatistics.residentSize == 21
+              && managerStatistics.uploadedSize == 21 && managerStatistics.evictedSize == 64
+              && managerStatistics.loweredTextureCount == 1,
+              "TextureResidencyManager lowered texture", statistics);
+
+    // The tail is uploaded whatever the limit, level 1 with it would be over
+    initializeManager(1024, 0, 1, residencyManager);
+    residencyManager.requestMipmapLevel(0, 0);
+    residencyManager.update(changes);
+    residencyManager.requestMipmapLevel(0, 2);
+
+    settings.budgetSize = 30;
+    settings.maxUploadSize = 10;
+    residencyManager.setSettings(settings);
+
+    residencyManager.update(changes);
+    managerStatistics = residencyManager.getStatistics();
+    checkTest(hasChanges(changes, {{0, 2}}) && managerStatistics.residentSize == 5
+              && managerStatistics.uploadedSize == 5 && managerStatistics.evictedSize == 80,
+              "TextureResidencyManager lowered texture over the upload limit", statistics);
+}
+
+void TextureResidencyManagerTests::testReachableLevel()
+{
+    const std::vector<uint64> mipmapSizes = {64, 16, 4, 1};
+
+    TextureResidencyManager residencyManager;
+    initializeManager(1024, 0, 0, residencyManager);
+    checkTest(residencyManager.getReachableMipmapLevel(mipmapSizes) == 0,
+              "TextureResidencyManager reachable level within the budget", statistics);
+
+    // Levels 1 and 0 alone would be 80 B, the texture with them is 85 B
+    initializeManager(1024, 82, 0, residencyManager);
+    checkTest(residencyManager.getReachableMipmapLevel(mipmapSizes) == 1,
+              "TextureResidencyManager reachable level within the upload limit", statistics);
+
+    initializeManager(20, 0, 0, residencyManager);
+    checkTest(residencyManager.getReachableMipmapLevel(mipmapSizes) == 2,
+              "TextureResidencyManager reachable level within a small budget", statistics);
+
+    // The smallest level is always reachable, it is part of the tail
+    initializeManager(0, 0, 0, residencyManager);
+    checkTest(residencyManager.getReachableMipmapLevel(mipmapSizes) == 3,
+              "TextureResidencyManager reachable level over the budget", statistics);
+}
+
+void TextureResidencyManagerTests::initializeManager(uint64 budgetSize, uint64 maxUploadSize,
+                                                     uint32 textureCount,
+                                                     TextureResidencyManager& residencyManager)
+{
+    residencyManager = TextureResidencyManager();
+
+    TextureResidencyManagerSettings settings = residencyManager.getSettings();
+    settings.budgetSize = budgetSize;
+    settings.maxUploadSize = maxUploadSize;
+    residencyManager.setSettings(settings);
+
+    const std::vector<uint64> mipmapSizes = {64, 16, 4, 1};
+    for (uint32 i = 0; i < textureCount; i++)
+    {
+        uint32 textureIndex = 0;
+        residencyManager.addTexture(mipmapSizes, 2, textureIndex);
+    }
+}
+
+bool TextureResidencyManagerTests::hasChanges(
+    const std::vector<TextureResidencyChange>& changes,
+    const std::vector<TextureResidencyChange>& expectedChanges)
+{
+    if (changes.size() != expectedChanges.size())
+    {
+        return false;
+    }
+
+    for (uint64 i = 0; i < changes.size(); i++)
+    {
+        if (changes[i].textureIndex != expectedChanges[i].textureIndex
+            || changes[i].mostDetailedMipmapLevel != expectedChanges[i].mostDetailedMipmapLevel)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <vector>
+
+#include "TextureResidencyManager.h"
+
+#include "IntUtility.h"
+#include "TestUtility.h"
+#include "TextureResidencyManagerUtility.h"
+
+// Runs the residency manager through fixed sequences of requests and checks every change and
+// size it gives. The textures have levels of 64, 16, 4 and 1 B and a tail from level 2
+class TextureResidencyManagerTests
+{
+    TestStatistics statistics;
+
+public:
+    TextureResidencyManagerTests();
+
+    TestStatistics getStatistics();
+
+    void run();
+
+private:
+    void testTails();
+    void testRaise();
+    void testUploadLimit();
+    void testSharedUploadLimit();
+    void testKeptLevels();
+    void testLoweredTexture();
+    void testReachableLevel();
+
+    // A manager with the budget and upload limit and textureCount textures
+    void initializeManager(uint64 budgetSize, uint64 maxUploadSize, uint32 textureCount,
+                           TextureResidencyManager& residencyManager);
+    bool hasChanges(const std::vector<TextureResidencyChange>& changes,
+                    const std::vector<TextureResidencyChange>& expectedChanges);
+};
@@ -0,0 +1,66 @@
+#pragma once
+#include <vector>
+
+#include "IntUtility.h"
+
+struct TextureResidencyManagerSettings
+{
+    uint64 budgetSize; // B, of the resident mipmap levels of every texture together
+    // B, of what one update uploads, 0 for no limit. A texture whose levels change is uploaded
+    // again with every level it keeps, the levels a lowered texture has to keep are always uploaded
+    uint64 maxUploadSize;
+};
+
+struct TextureResidencyManagerStatistics
+{
+    uint32 textureCount;
+    uint64 residentSize; // B
+    uint64 requestedSize; // B, of the levels down from the requested ones
+    uint64 tailSize; // B, of the levels always resident
+
+    // Of the last update
+    uint32 raisedTextureCount;
+    uint32 loweredTextureCount;
+    uint64 uploadedSize; // B, of every level kept by the textures whose levels change
+    uint64 evictedSize; // B, of the levels dropped
+    double updateTime; // s
+};
+
+// Levels are indexed like D3D11 ones, 0 being the most detailed, and a texture always has the
+// levels from its most detailed resident one down to the smallest
+struct TextureResidency
+{
+    bool isUsed;
+
+    std::vector<uint64> mipmapSizes; // B, per level of every array slice together
+    uint32 tailMipmapLevel; // most detailed level of the tail, which is always resident
+    uint32 requestedMipmapLevel;
+    uint32 mostDetailedMipmapLevel; // resident
+};
+
+struct TextureResidencyChange
+{
+    uint32 textureIndex;
+    uint32 mostDetailedMipmapLevel; // to be made resident, with every smaller level
+};
+
+// One more detailed level for a texture, granted while the budget lasts
+struct TextureResidencyRequest
+{
+    uint32 textureIndex;
+    uint32 mipmapLevel;
+    uint32 distance; // levels from the requested one, that one included
+};
+
+// Textures furthest from their requested levels come first so they are raised evenly, ties go
+// to the smaller texture index so every update is deterministic
+inline bool isTextureResidencyRequestBefore(const TextureResidencyRequest& request,
+                                            const TextureResidencyRequest& otherRequest)
+{
+    if (request.distance != otherRequest.distance)
+    {
+        return request.distance > otherRequest.distance;
+    }
+
+    return request.textureIndex < otherRequest.textureIndex;
+}
@@ -0,0 +1,203 @@
+#include "TextureStreamer.h"
+
+TextureStreamer::TextureStreamer() : settings{}, statistics{}, residencyManager(), textures(),
+    requestedMipmapLevels()
+{
+    settings.tailSize = TextureStreamerTailSize;
+    settings.residencyManagerSettings = residencyManager.getSettings();
+}
+
+TextureStreamerSettings TextureStreamer::getSettings()
+{
+    return settings;
+}
+
+void TextureStreamer::setSettings(TextureStreamerSettings settings)
+{
+    this->settings = settings;
+
+    residencyManager.setSettings(settings.residencyManagerSettings);
+}
+
+TextureStreamerStatistics TextureStreamer::getStatistics()
+{
+    return statistics;
+}
+
+bool TextureStreamer::addTexture(std::shared_ptr<Texture> texture,
+                                 std::shared_ptr<ImageData> imageData, uint32& textureIndex)
+{
+    if (!texture || !imageData)
+    {
+        return false;
+    }
+
+    std::vector<uint64> mipmapSizes;
+    uint32 tailMipmapLevel = getTailMipmapLevel(*imageData, mipmapSizes);
+    if (mipmapSizes.empty())
+    {
+        return false;
+    }
+
+    // Levels past the one the texture can be raised to are never uploaded, the image it keeps goes
+    // without them. The tail and the whole blocks of its top level are kept
+    uint32 reachableMipmapLevel = residencyManager.getReachableMipmapLevel(mipmapSizes);
+    if (reachableMipmapLevel > tailMipmapLevel)
+    {
+        reachableMipmapLevel = tailMipmapLevel;
+    }
+    if (reachableMipmapLevel > 0)
+    {
+        imageData = std::make_shared<ImageData>(getImageMipmapLevels(*imageData,
+                                                                     reachableMipmapLevel));
+        mipmapSizes.erase(mipmapSizes.begin(), mipmapSizes.begin() + reachableMipmapLevel);
+        tailMipmapLevel -= reachableMipmapLevel;
+    }
+
+    // Textures with every level resident have nothing to stream and do not keep their image
+    bool result = false;
+    if (tailMipmapLevel == 0)
+    {
+        result = texture->initialize(imageData);
+    }
+    else
+    {
+        result = texture->initialize(imageData, tailMipmapLevel);
+    }
+    if (!result)
+    {
+        return false;
+    }
+
+    result = residencyManager.addTexture(mipmapSizes, tailMipmapLevel, textureIndex);
+    if (!result)
+    {
+        texture->release();
+
+        return false;
+    }
+
+    if (textureIndex >= textures.size())
+    {
+        textures.resize(static_cast<uint64>(textureIndex) + 1);
+        requestedMipmapLevels.resize(static_cast<uint64>(textureIndex) + 1,
+                                     TextureStreamerNoRequest);
+    }
+    textures[textureIndex] = texture;
+    requestedMipmapLevels[textureIndex] = TextureStreamerNoRequest;
+
+    return true;
+}
+
+void TextureStreamer::requestMipmapLevel(uint32 textureIndex, uint32 mipmapLevel)
+{
+    if (textureIndex >= textures.size() || !textures[textureIndex])
+    {
+        return;
+    }
+
+    if (mipmapLevel < requestedMipmapLevels[textureIndex])
+    {
+        requestedMipmapLevels[textureIndex] = mipmapLevel;
+    }
+}
+
+bool TextureStreamer::update()
+{
+    statistics = {};
+
+    for (uint32 i = 0; i < textures.size(); i++)
+    {
+        if (!textures[i])
+        {
+            continue;
+        }
+
+        if (textures[i].use_count() == 1)
+        {
+            residencyManager.removeTexture(i);
+            textures[i].reset();
+
+            continue;
+        }
+
+        // Textures nothing drew in the frame are taken down to their tails, the manager keeps
+        // their levels while the budget has room
+        residencyManager.requestMipmapLevel(i, requestedMipmapLevels[i]);
+        requestedMipmapLevels[i] = TextureStreamerNoRequest;
+    }
+
+    std::vector<TextureResidencyChange> changes;
+    bool result = residencyManager.update(changes);
+    if (!result)
+    {
+        return false;
+    }
+
+    for (auto& change : changes)
+    {
+        result = textures[change.textureIndex]->setMostDetailedMipmapLevel(
+            change.mostDetailedMipmapLevel);
+        if (!result)
+        {
+            statistics.failedTextureCount++;
+
+            continue;
+        }
+
+        statistics.recreatedTextureCount++;
+    }
+
+    statistics.residencyManagerStatistics = residencyManager.getStatistics();
+
+    return true;
+}
+
+uint32 TextureStreamer::getTailMipmapLevel(const ImageData& imageData,
+                                           std::vector<uint64>& mipmapSizes)
+{
+    mipmapSizes.assign(imageData.mipmapLevels, 0);
+    uint64 subresourceCount = static_cast<uint64>(imageData.mipmapLevels) * imageData.arraySize;
+    if (subresourceCount == 0 || imageData.subresourceDataItems.size() != subresourceCount)
+    {
+        mipmapSizes.clear();
+
+        return 0;
+    }
+
+    for (uint32 i = 0; i < imageData.arraySize; i++)
+    {
+        for (uint32 j = 0; j < imageData.mipmapLevels; j++)
+        {
+            uint32 subresourceIndex = getImageSubresourceIndex(imageData, j, i);
+            mipmapSizes[j] += imageData.subresourceDataItems[subresourceIndex].depthPitch;
+        }
+    }
+
+    uint32 tailMipmapLevel = imageData.mipmapLevels - 1;
+    uint64 tailSize = mipmapSizes[tailMipmapLevel];
+    while (tailMipmapLevel > 0 && tailSize + mipmapSizes[tailMipmapLevel - 1] <= settings.tailSize)
+    {
+        tailMipmapLevel--;
+        tailSize += mipmapSizes[tailMipmapLevel];
+    }
+
+    // Block-compressed textures are created with a top level of whole blocks only
+    if (getImageFormatBlockSize(imageData.format) != 0)
+    {
+        uint32 blockMipmapLevel = 0;
+        while (blockMipmapLevel + 1 < imageData.mipmapLevels
+               && getImageMipmapSize(imageData.width, blockMipmapLevel + 1) % 4 == 0
+               && getImageMipmapSize(imageData.height, blockMipmapLevel + 1) % 4 == 0)
+        {
+            blockMipmapLevel++;
+        }
+
+        if (tailMipmapLevel > blockMipmapLevel)
+        {
+            tailMipmapLevel = blockMipmapLevel;
+        }
+    }
+
+    return tailMipmapLevel;
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <memory>
+
+#include <vector>
+
+#include "Texture.h"
+#include "TextureResidencyManager.h"
+
+#include "ImageFileParserUtility.h"
+#include "IntUtility.h"
+#include "TextureResidencyManagerUtility.h"
+#include "TextureStreamerUtility.h"
+
+// Creates textures with only their smallest mipmap levels and raises or lowers them once a frame
+// toward the most detailed level drawing asked for, within the budget of the residency manager.
+// A texture is dropped once the streamer holds the last reference to it
+class TextureStreamer
+{
+    TextureStreamerSettings settings;
+
+    TextureStreamerStatistics statistics;
+
+    TextureResidencyManager residencyManager;
+
+    std::vector<std::shared_ptr<Texture>> textures; // per texture index
+    std::vector<uint32> requestedMipmapLevels; // in the current frame, per texture index
+
+public:
+    TextureStreamer();
+
+    TextureStreamerSettings getSettings();
+    void setSettings(TextureStreamerSettings settings);
+
+    TextureStreamerStatistics getStatistics();
+
+    // Initializes the texture with the tail of the image, block-compressed images whose levels
+    // stop being whole blocks are not streamed and get every level. Levels over the budget or the
+    // upload limit with the settings of the time are left out of the texture for good
+    bool addTexture(std::shared_ptr<Texture> texture, std::shared_ptr<ImageData> imageData,
+                    uint32& textureIndex);
+
+    // The most detailed of the levels asked for in a frame is the one requested
+    void requestMipmapLevel(uint32 textureIndex, uint32 mipmapLevel);
+
+    // Called once a frame after drawing, the next frames draw with the new levels
+    bool update();
+
+private:
+    uint32 getTailMipmapLevel(const ImageData& imageData, std::vector<uint64>& mipmapSizes);
+};
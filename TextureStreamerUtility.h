@@ -0,0 +1,30 @@
+#pragma once
+#include "IntUtility.h"
+#include "TextureResidencyManagerUtility.h"
+
+// Of the mipmap levels of a streamed texture that are always resident
+constexpr uint64 TextureStreamerTailSize = 64 * 1024; // B
+
+// Mipmap level of textures nothing asked for in a frame
+constexpr uint32 TextureStreamerNoRequest = UINT32_MAX;
+
+// A streamed texture keeps its image on the CPU for as long as it exists, to upload the levels it
+// is raised to. Images used in place from their DDS files keep only the mapping, whose pages the
+// system can drop and read again. Images converted or given generated mipmap levels keep their
+// allocated payload with the levels from the most detailed one the budget and the upload limit
+// let the texture reach, as much on the CPU as the texture could ever have resident
+
+struct TextureStreamerSettings
+{
+    uint64 tailSize; // B, the smallest levels within it are resident from the start
+
+    TextureResidencyManagerSettings residencyManagerSettings;
+};
+
+struct TextureStreamerStatistics
+{
+    uint32 recreatedTextureCount;
+    uint32 failedTextureCount; // kept their resident levels
+
+    TextureResidencyManagerStatistics residencyManagerStatistics;
+};
@@ -0,0 +1,185 @@
+#include "VertexEncoder.h"
+
+VertexEncoder::VertexEncoder() : statistics{}
+{
+}
+
+VertexEncoderStatistics VertexEncoder::getStatistics()
+{
+    return statistics;
+}
+
+bool VertexEncoder::encodeCompact(const std::vector<Vertex>& vertexes,
+                                  std::vector<CompactVertex>& compactVertexes)
+{
+    statistics = {};
+
+    compactVertexes.resize(vertexes.size());
+    for (uint64 i = 0; i < vertexes.size(); i++)
+    {
+        const Vertex& vertex = vertexes[i];
+
+        CompactVertex& compactVertex = compactVertexes[i];
+        compactVertex.position = vertex.position;
+        compactVertex.textureCoordinates.x = DirectX::PackedVector::XMConvertFloatToHalf(
+            vertex.textureCoordinates.x);
+        compactVertex.textureCoordinates.y = DirectX::PackedVector::XMConvertFloatToHalf(
+            vertex.textureCoordinates.y);
+        compactVertex.normal = encodeOctahedralNormal(vertex.normal);
+
+        addError(vertex, decodeCompact(compactVertex));
+    }
+
+    statistics.vertexCount = vertexes.size();
+    statistics.size = vertexes.size() * sizeof(Vertex);
+    statistics.encodedSize = compactVertexes.size() * sizeof(CompactVertex);
+
+    return true;
+}
+
+bool VertexEncoder::encodeQuantized(const std::vector<Vertex>& vertexes,
+                                    std::vector<QuantizedVertex>& quantizedVertexes,
+                                    VertexDequantization& dequantization)
+{
+    statistics = {};
+
+    if (vertexes.empty())
+    {
+        quantizedVertexes.clear();
+        dequantization = {};
+
+        return true;
+    }
+
+    DirectX::XMVECTOR minPosition = DirectX::XMLoadFloat3(&vertexes[0].position);
+    DirectX::XMVECTOR maxPosition = minPosition;
+    for (const Vertex& vertex : vertexes)
+    {
+        DirectX::XMVECTOR position = DirectX::XMLoadFloat3(&vertex.position);
+
+        minPosition = DirectX::XMVectorMin(minPosition, position);
+        maxPosition = DirectX::XMVectorMax(maxPosition, position);
+    }
+
+    DirectX::XMStoreFloat3(&dequantization.offset, minPosition);
+    DirectX::XMStoreFloat3(&dequantization.scale, DirectX::XMVectorSubtract(
+                               maxPosition, minPosition));
+
+    // Flat axes keep a scale of 1 so the model matrix stays invertible
+    DirectX::XMFLOAT3& scale = dequantization.scale;
+    if (!(scale.x > 0.0f))
+    {
+        scale.x = 1.0f;
+    }
+    if (!(scale.y > 0.0f))
+    {
+        scale.y = 1.0f;
+    }
+    if (!(scale.z > 0.0f))
+    {
+        scale.z = 1.0f;
+    }
+
+    quantizedVertexes.resize(vertexes.size());
+    for (uint64 i = 0; i < vertexes.size(); i++)
+    {
+        const Vertex& vertex = vertexes[i];
+
+        QuantizedVertex& quantizedVertex = quantizedVertexes[i];
+        quantizedVertex.position.x = quantizeUnorm16(
+            (vertex.position.x - dequantization.offset.x) / scale.x);
+        quantizedVertex.position.y = quantizeUnorm16(
+            (vertex.position.y - dequantization.offset.y) / scale.y);
+        quantizedVertex.position.z = quantizeUnorm16(
+            (vertex.position.z - dequantization.offset.z) / scale.z);
+        quantizedVertex.position.w = 0;
+        quantizedVertex.textureCoordinates.x = DirectX::PackedVector::XMConvertFloatToHalf(
+            vertex.textureCoordinates.x);
+        quantizedVertex.textureCoordinates.y = DirectX::PackedVector::XMConvertFloatToHalf(
+            vertex.textureCoordinates.y);
+        quantizedVertex.normal = encodeOctahedralNormal(vertex.normal);
+
+        addError(vertex, decodeQuantized(quantizedVertex, dequantization));
+    }
+
+    statistics.vertexCount = vertexes.size();
+    statistics.size = vertexes.size() * sizeof(Vertex);
+    statistics.encodedSize = quantizedVertexes.size() * sizeof(QuantizedVertex);
+
+    return true;
+}
+
+Vertex VertexEncoder::decodeCompact(const CompactVertex& compactVertex)
+{
+    Vertex vertex = {};
+    vertex.position = compactVertex.position;
+    vertex.textureCoordinates.x = DirectX::PackedVector::XMConvertHalfToFloat(
+        compactVertex.textureCoordinates.x);
+    vertex.textureCoordinates.y = DirectX::PackedVector::XMConvertHalfToFloat(
+        compactVertex.textureCoordinates.y);
+    vertex.normal = decodeOctahedralNormal(compactVertex.normal);
+
+    return vertex;
+}
+
+Vertex VertexEncoder::decodeQuantized(const QuantizedVertex& quantizedVertex,
+                                      const VertexDequantization& dequantization)
+{
+    Vertex vertex = {};
+    vertex.position.x = dequantizeUnorm16(quantizedVertex.position.x) * dequantization.scale.x +
+        dequantization.offset.x;
+    vertex.position.y = dequantizeUnorm16(quantizedVertex.position.y) * dequantization.scale.y +
+        dequantization.offset.y;
+    vertex.position.z = dequantizeUnorm16(quantizedVertex.position.z) * dequantization.scale.z +
+        dequantization.offset.z;
+    vertex.textureCoordinates.x = DirectX::PackedVector::XMConvertHalfToFloat(
+        quantizedVertex.textureCoordinates.x);
+    vertex.textureCoordinates.y = DirectX::PackedVector::XMConvertHalfToFloat(
+        quantizedVertex.textureCoordinates.y);
+    vertex.normal = decodeOctahedralNormal(quantizedVertex.normal);
+
+    return vertex;
+}
+
+void VertexEncoder::addError(const Vertex& vertex, const Vertex& decodedVertex)
+{
+    DirectX::XMVECTOR position = DirectX::XMLoadFloat3(&vertex.position);
+    DirectX::XMVECTOR decodedPosition = DirectX::XMLoadFloat3(&decodedVertex.position);
+
+    float positionError = DirectX::XMVectorGetX(DirectX::XMVector3Length(
+        DirectX::XMVectorSubtract(position, decodedPosition)));
+    if (positionError > statistics.positionError)
+    {
+        statistics.positionError = positionError;
+    }
+
+    float textureCoordinatesError = std::fabs(vertex.textureCoordinates.x -
+        decodedVertex.textureCoordinates.x);
+    float textureCoordinatesErrorY = std::fabs(vertex.textureCoordinates.y -
+        decodedVertex.textureCoordinates.y);
+    if (textureCoordinatesErrorY > textureCoordinatesError)
+    {
+        textureCoordinatesError = textureCoordinatesErrorY;
+    }
+    if (textureCoordinatesError > statistics.textureCoordinatesError)
+    {
+        statistics.textureCoordinatesError = textureCoordinatesError;
+    }
+
+    // Zero normals have no direction to lose
+    DirectX::XMVECTOR normal = DirectX::XMLoadFloat3(&vertex.normal);
+    if (DirectX::XMVector3Equal(normal, DirectX::XMVectorZero()))
+    {
+        return;
+    }
+
+    DirectX::XMVECTOR decodedNormal = DirectX::XMLoadFloat3(&decodedVertex.normal);
+
+    float normalError = DirectX::XMConvertToDegrees(DirectX::XMVectorGetX(
+        DirectX::XMVector3AngleBetweenNormals(DirectX::XMVector3Normalize(normal),
+                                              decodedNormal)));
+    if (normalError > statistics.normalError)
+    {
+        statistics.normalError = normalError;
+    }
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include <DirectXMath.h>
+#include <DirectXPackedVector.h>
+
+#include <cmath>
+
+#include <vector>
+
+#include "Vertex.h"
+
+#include "VertexEncodingUtility.h"
+
+// Converts the parsed vertexes into the smaller vertex formats and measures what the conversion
+// loses by decoding every vertex back
+class VertexEncoder
+{
+    VertexEncoderStatistics statistics;
+
+public:
+    VertexEncoder();
+
+    VertexEncoderStatistics getStatistics();
+
+    bool encodeCompact(const std::vector<Vertex>& vertexes,
+                       std::vector<CompactVertex>& compactVertexes);
+    bool encodeQuantized(const std::vector<Vertex>& vertexes,
+                         std::vector<QuantizedVertex>& quantizedVertexes,
+                         VertexDequantization& dequantization);
+
+    Vertex decodeCompact(const CompactVertex& compactVertex);
+    Vertex decodeQuantized(const QuantizedVertex& quantizedVertex,
+                           const VertexDequantization& dequantization);
+
+private:
+    void addError(const Vertex& vertex, const Vertex& decodedVertex);
+};
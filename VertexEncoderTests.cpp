@@ -0,0 +1,224 @@
+#include "VertexEncoderTests.h"
+
+// Half floats keep 11 significant bits, which is at most this far off in [0, 1]
+constexpr float VertexEncoderTestsHalfError = 1.0f / 2048.0f;
+// Of an octahedral normal in two 16-bit SNORMs. The angle between normals only resolves about
+// 0.02 degrees in floats, which is above the encoding error
+constexpr float VertexEncoderTestsNormalError = 0.05f; // degrees
+
+VertexEncoderTests::VertexEncoderTests() : statistics{}
+{
+}
+
+TestStatistics VertexEncoderTests::getStatistics()
+{
+    return statistics;
+}
+
+void VertexEncoderTests::run()
+{
+    statistics = {};
+
+    testCompactRoundTrip();
+    testQuantizedRoundTrip();
+    testFlatQuantizedRoundTrip();
+    testEmptyQuantized();
+    testOctahedralNormals();
+}
+
+void VertexEncoderTests::testCompactRoundTrip()
+{
+    std::vector<Vertex> vertexes;
+    getVertexes(vertexes);
+
+    VertexEncoder vertexEncoder;
+    std::vector<CompactVertex> compactVertexes;
+    bool result = vertexEncoder.encodeCompact(vertexes, compactVertexes);
+    result = result && compactVertexes.size() == vertexes.size();
+
+    for (uint64 i = 0; i < vertexes.size() && result; i++)
+    {
+        const Vertex& vertex = vertexes[i];
+        Vertex decodedVertex = vertexEncoder.decodeCompact(compactVertexes[i]);
+
+        result = decodedVertex.position.x == vertex.position.x
+            && decodedVertex.position.y == vertex.position.y
+            && decodedVertex.position.z == vertex.position.z
+            && isTextureCoordinatesRoundTrip(vertex, decodedVertex)
+            && getNormalError(vertex.normal, decodedVertex.normal) < VertexEncoderTestsNormalError;
+    }
+
+    VertexEncoderStatistics encoderStatistics = vertexEncoder.getStatistics();
+    result = result && encoderStatistics.vertexCount == vertexes.size()
+        && encoderStatistics.size == vertexes.size() * sizeof(Vertex)
+        && encoderStatistics.encodedSize == vertexes.size() * sizeof(CompactVertex)
+        && encoderStatistics.positionError == 0.0f
+        && encoderStatistics.textureCoordinatesError <= VertexEncoderTestsHalfError
+        && encoderStatistics.normalError < VertexEncoderTestsNormalError;
+
+    checkTest(result, "VertexEncoder compact round trip", statistics);
+}
+
+void VertexEncoderTests::testQuantizedRoundTrip()
+{
+    std::vector<Vertex> vertexes;
+    getVertexes(vertexes);
+
+    VertexEncoder vertexEncoder;
+    std::vector<QuantizedVertex> quantizedVertexes;
+    VertexDequantization dequantization = {};
+    bool result = vertexEncoder.encodeQuantized(vertexes, quantizedVertexes, dequantization);
+    result = result && quantizedVertexes.size() == vertexes.size();
+
+    // The bounds of the box in getVertexes
+    result = result && dequantization.offset.x == -2.0f && dequantization.offset.y == -1.0f
+        && dequantization.offset.z == -0.5f && dequantization.scale.x == 6.0f
+        && dequantization.scale.y == 2.0f && dequantization.scale.z == 1.0f;
+
+    // Half a step of the 16-bit grid on each axis, with margin for the float math
+    float maxPositionError = 0.0f;
+    for (uint64 i = 0; i < vertexes.size() && result; i++)
+    {
+        const Vertex& vertex = vertexes[i];
+        Vertex decodedVertex = vertexEncoder.decodeQuantized(quantizedVertexes[i],
+                                                             dequantization);
+
+        result = std::fabs(decodedVertex.position.x - vertex.position.x) <= 6.0f / 65535.0f *
+            0.51f && std::fabs(decodedVertex.position.y - vertex.position.y) <= 2.0f /
+            65535.0f * 0.51f && std::fabs(decodedVertex.position.z - vertex.position.z) <= 1.0f /
+            65535.0f * 0.51f && isTextureCoordinatesRoundTrip(vertex, decodedVertex)
+            && getNormalError(vertex.normal, decodedVertex.normal) < VertexEncoderTestsNormalError;
+
+        float positionError = DirectX::XMVectorGetX(DirectX::XMVector3Length(
+            DirectX::XMVectorSubtract(DirectX::XMLoadFloat3(&vertex.position),
+                                      DirectX::XMLoadFloat3(&decodedVertex.position))));
+        if (positionError > maxPositionError)
+        {
+            maxPositionError = positionError;
+        }
+    }
+
+    VertexEncoderStatistics encoderStatistics = vertexEncoder.getStatistics();
+    result = result && encoderStatistics.vertexCount == vertexes.size()
+        && encoderStatistics.encodedSize == vertexes.size() * sizeof(QuantizedVertex)
+        && std::fabs(encoderStatistics.positionError - maxPositionError) <= 1e-6f;
+
+    checkTest(result, "VertexEncoder quantized round trip", statistics);
+}
+
+void VertexEncoderTests::testFlatQuantizedRoundTrip()
+{
+    // Every vertex on z = 3, the flat axis keeps a scale of 1 and its exact value
+    std::vector<Vertex> vertexes(3);
+    vertexes[0].position = DirectX::XMFLOAT3(0.0f, 0.0f, 3.0f);
+    vertexes[1].position = DirectX::XMFLOAT3(1.0f, 0.0f, 3.0f);
+    vertexes[2].position = DirectX::XMFLOAT3(0.0f, 1.0f, 3.0f);
+
+    VertexEncoder vertexEncoder;
+    std::vector<QuantizedVertex> quantizedVertexes;
+    VertexDequantization dequantization = {};
+    bool result = vertexEncoder.encodeQuantized(vertexes, quantizedVertexes, dequantization);
+    result = result && dequantization.scale.z == 1.0f && dequantization.offset.z == 3.0f;
+
+    for (uint64 i = 0; i < vertexes.size() && result; i++)
+    {
+        Vertex decodedVertex = vertexEncoder.decodeQuantized(quantizedVertexes[i],
+                                                             dequantization);
+        result = decodedVertex.position.x == vertexes[i].position.x
+            && decodedVertex.position.y == vertexes[i].position.y
+            && decodedVertex.position.z == 3.0f;
+    }
+
+    checkTest(result, "VertexEncoder flat quantized round trip", statistics);
+}
+
+void VertexEncoderTests::testEmptyQuantized()
+{
+    std::vector<Vertex> vertexes;
+
+    VertexEncoder vertexEncoder;
+    std::vector<QuantizedVertex> quantizedVertexes(1);
+    VertexDequantization dequantization = {};
+    dequantization.scale = DirectX::XMFLOAT3(2.0f, 2.0f, 2.0f);
+    bool result = vertexEncoder.encodeQuantized(vertexes, quantizedVertexes, dequantization);
+
+    checkTest(result && quantizedVertexes.empty() && dequantization.scale.x == 0.0f
+              && vertexEncoder.getStatistics().vertexCount == 0,
+              "VertexEncoder empty quantized", statistics);
+}
+
+void VertexEncoderTests::testOctahedralNormals()
+{
+    // Axis normals land on the corners and edges of the octahedron and come back exactly, the
+    // lower half included
+    const DirectX::XMFLOAT3 axisNormals[] = {
+        DirectX::XMFLOAT3(1.0f, 0.0f, 0.0f), DirectX::XMFLOAT3(-1.0f, 0.0f, 0.0f),
+        DirectX::XMFLOAT3(0.0f, 1.0f, 0.0f), DirectX::XMFLOAT3(0.0f, -1.0f, 0.0f),
+        DirectX::XMFLOAT3(0.0f, 0.0f, 1.0f), DirectX::XMFLOAT3(0.0f, 0.0f, -1.0f),
+    };
+    bool result = true;
+    for (const DirectX::XMFLOAT3& normal : axisNormals)
+    {
+        DirectX::XMFLOAT3 decodedNormal = decodeOctahedralNormal(encodeOctahedralNormal(normal));
+        result = result && decodedNormal.x == normal.x && decodedNormal.y == normal.y
+            && decodedNormal.z == normal.z;
+    }
+    checkTest(result, "VertexEncoder octahedral axis normals", statistics);
+
+    // Normals that aren't unit length are encoded by their direction
+    DirectX::XMFLOAT3 normal(0.0f, 0.0f, -5.0f);
+    DirectX::XMFLOAT3 decodedNormal = decodeOctahedralNormal(encodeOctahedralNormal(normal));
+    checkTest(decodedNormal.x == 0.0f && decodedNormal.y == 0.0f && decodedNormal.z == -1.0f,
+              "VertexEncoder octahedral normal direction", statistics);
+
+    // A zero normal has no direction, it is encoded as the center of the octahedron
+    DirectX::PackedVector::XMSHORTN2 encodedNormal = encodeOctahedralNormal(
+        DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f));
+    checkTest(encodedNormal.x == 0 && encodedNormal.y == 0, "VertexEncoder zero normal",
+              statistics);
+}
+
+void VertexEncoderTests::getVertexes(std::vector<Vertex>& vertexes)
+{
+    vertexes.clear();
+
+    // Every octant, the folds of the lower half and the axes
+    const float components[] = { -1.0f, -0.5f, 0.0f, 0.3f, 1.0f };
+    for (float x : components)
+    {
+        for (float y : components)
+        {
+            for (float z : components)
+            {
+                if (x == 0.0f && y == 0.0f && z == 0.0f)
+                {
+                    continue;
+                }
+
+                Vertex vertex = {};
+                vertex.position = DirectX::XMFLOAT3(x * 3.0f + 1.0f, y * 1.0f, z * 0.5f);
+                vertex.textureCoordinates = DirectX::XMFLOAT3((x + 1.0f) * 0.5f,
+                                                              (y + 1.0f) / 2.0f * 0.999f, 0.0f);
+                DirectX::XMStoreFloat3(&vertex.normal, DirectX::XMVector3Normalize(
+                                           DirectX::XMVectorSet(x, y, z, 0.0f)));
+                vertexes.push_back(vertex);
+            }
+        }
+    }
+}
+
+float VertexEncoderTests::getNormalError(const DirectX::XMFLOAT3& normal,
+                                         const DirectX::XMFLOAT3& decodedNormal)
+{
+    return DirectX::XMConvertToDegrees(DirectX::XMVectorGetX(
+        DirectX::XMVector3AngleBetweenNormals(DirectX::XMLoadFloat3(&normal),
+                                              DirectX::XMLoadFloat3(&decodedNormal))));
+}
+
+bool VertexEncoderTests::isTextureCoordinatesRoundTrip(const Vertex& vertex,
+                                                       const Vertex& decodedVertex)
+{
+    return std::fabs(decodedVertex.textureCoordinates.x - vertex.textureCoordinates.x) <=
+        VertexEncoderTestsHalfError && std::fabs(decodedVertex.textureCoordinates.y -
+        vertex.textureCoordinates.y) <= VertexEncoderTestsHalfError;
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <DirectXMath.h>
+#include <DirectXPackedVector.h>
+
+#include <cmath>
+
+#include <vector>
+
+#include "Vertex.h"
+#include "VertexEncoder.h"
+
+#include "IntUtility.h"
+#include "TestUtility.h"
+#include "VertexEncodingUtility.h"
+
+// Encodes vertexes to the compact and quantized formats and decodes them back, checking what
+// every attribute may lose: nothing for compact positions and axis normals, half precision for
+// texture coordinates, half a step of the bounds for quantized positions
+class VertexEncoderTests
+{
+    TestStatistics statistics;
+
+public:
+    VertexEncoderTests();
+
+    TestStatistics getStatistics();
+
+    void run();
+
+private:
+    void testCompactRoundTrip();
+    void testQuantizedRoundTrip();
+    void testFlatQuantizedRoundTrip();
+    void testEmptyQuantized();
+    void testOctahedralNormals();
+
+    // Positions of a box, texture coordinates over [0, 1] and normals in every octant
+    void getVertexes(std::vector<Vertex>& vertexes);
+    // Largest angle between the normals, in degrees, 0 for zero normals decoded as zero
+    float getNormalError(const DirectX::XMFLOAT3& normal, const DirectX::XMFLOAT3& decodedNormal);
+    bool isTextureCoordinatesRoundTrip(const Vertex& vertex, const Vertex& decodedVertex);
+};
@@ -0,0 +1,206 @@
+#pragma once
+#include <d3d11.h>
+#include <DirectXMath.h>
+#include <DirectXPackedVector.h>
+
+#include <cmath>
+
+#include <vector>
+
+#include "Vertex.h"
+
+#include "IntUtility.h"
+
+enum class VertexEncoding : uint8
+{
+    Undefined,
+
+    Full, // Vertex, 36 B
+    Compact, // CompactVertex, 20 B
+    Quantized, // QuantizedVertex, 16 B
+};
+
+struct CompactVertex
+{
+    DirectX::XMFLOAT3 position;
+    DirectX::PackedVector::XMHALF2 textureCoordinates;
+    DirectX::PackedVector::XMSHORTN2 normal; // octahedral
+};
+
+struct QuantizedVertex
+{
+    DirectX::PackedVector::XMUSHORTN4 position; // relative to the bounds of the model, w unused
+    DirectX::PackedVector::XMHALF2 textureCoordinates;
+    DirectX::PackedVector::XMSHORTN2 normal; // octahedral
+};
+
+// position = quantized position * scale + offset, folded into the model matrix when rendering
+struct VertexDequantization
+{
+    DirectX::XMFLOAT3 offset;
+    DirectX::XMFLOAT3 scale;
+};
+
+struct VertexEncoderStatistics
+{
+    uint64 vertexCount;
+    uint64 size; // B
+    uint64 encodedSize; // B
+
+    // Largest round-trip errors
+    float positionError; // model units
+    float textureCoordinatesError;
+    float normalError; // degrees
+};
+
+inline int16 quantizeSnorm16(float value)
+{
+    if (value > 1.0f)
+    {
+        value = 1.0f;
+    }
+    else if (value < -1.0f)
+    {
+        value = -1.0f;
+    }
+
+    return static_cast<int16>(std::lround(value * 32767.0f));
+}
+
+inline float dequantizeSnorm16(int16 value)
+{
+    float result = value / 32767.0f;
+    if (result < -1.0f)
+    {
+        return -1.0f;
+    }
+
+    return result;
+}
+
+inline uint16 quantizeUnorm16(float value)
+{
+    if (value > 1.0f)
+    {
+        value = 1.0f;
+    }
+    else if (!(value > 0.0f))
+    {
+        value = 0.0f;
+    }
+
+    return static_cast<uint16>(std::lround(value * 65535.0f));
+}
+
+inline float dequantizeUnorm16(uint16 value)
+{
+    return value / 65535.0f;
+}
+
+// Projects the unit normal onto the octahedron and unfolds its lower half over the corners
+inline DirectX::PackedVector::XMSHORTN2 encodeOctahedralNormal(DirectX::XMFLOAT3 normal)
+{
+    float length = std::fabs(normal.x) + std::fabs(normal.y) + std::fabs(normal.z);
+    if (length == 0.0f)
+    {
+        return {0, 0};
+    }
+
+    float x = normal.x / length;
+    float y = normal.y / length;
+    if (normal.z < 0.0f)
+    {
+        float foldedX = (1.0f - std::fabs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+        float foldedY = (1.0f - std::fabs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+
+        x = foldedX;
+        y = foldedY;
+    }
+
+    DirectX::PackedVector::XMSHORTN2 encodedNormal = {};
+    encodedNormal.x = quantizeSnorm16(x);
+    encodedNormal.y = quantizeSnorm16(y);
+
+    return encodedNormal;
+}
+
+inline DirectX::XMFLOAT3 decodeOctahedralNormal(DirectX::PackedVector::XMSHORTN2 encodedNormal)
+{
+    float x = dequantizeSnorm16(encodedNormal.x);
+    float y = dequantizeSnorm16(encodedNormal.y);
+    float z = 1.0f - std::fabs(x) - std::fabs(y);
+    if (z < 0.0f)
+    {
+        float unfoldedX = (1.0f - std::fabs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+        float unfoldedY = (1.0f - std::fabs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+
+        x = unfoldedX;
+        y = unfoldedY;
+    }
+
+    float length = std::sqrt(x * x + y * y + z * z);
+
+    return DirectX::XMFLOAT3(x / length, y / length, z / length);
+}
+
+inline uint32 getVertexStride(VertexEncoding vertexEncoding)
+{
+    switch (vertexEncoding)
+    {
+    case VertexEncoding::Compact:
+        return sizeof(CompactVertex);
+    case VertexEncoding::Quantized:
+        return sizeof(QuantizedVertex);
+    default:
+        return sizeof(Vertex);
+    }
+}
+
+inline D3D11_INPUT_ELEMENT_DESC getVertexInputElementDesc(const char* semanticName,
+                                                          DXGI_FORMAT format, uint32 offset)
+{
+    D3D11_INPUT_ELEMENT_DESC inputElementDesc = {};
+    inputElementDesc.SemanticName = semanticName;
+    inputElementDesc.SemanticIndex = 0;
+    inputElementDesc.Format = format;
+    inputElementDesc.InputSlot = 0;
+    inputElementDesc.AlignedByteOffset = offset;
+    inputElementDesc.InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
+    inputElementDesc.InstanceDataStepRate = 0;
+
+    return inputElementDesc;
+}
+
+inline void getVertexInputElementDescs(VertexEncoding vertexEncoding,
+                                       std::vector<D3D11_INPUT_ELEMENT_DESC>& inputElementDescs)
+{
+    inputElementDescs.clear();
+
+    switch (vertexEncoding)
+    {
+    case VertexEncoding::Compact:
+        inputElementDescs.push_back(getVertexInputElementDesc(
+            "POSITION", DXGI_FORMAT_R32G32B32_FLOAT, 0));
+        inputElementDescs.push_back(getVertexInputElementDesc(
+            "TEXCOORD", DXGI_FORMAT_R16G16_FLOAT, 12));
+        inputElementDescs.push_back(getVertexInputElementDesc(
+            "NORMAL", DXGI_FORMAT_R16G16_SNORM, 16));
+        break;
+    case VertexEncoding::Quantized:
+        inputElementDescs.push_back(getVertexInputElementDesc(
+            "POSITION", DXGI_FORMAT_R16G16B16A16_UNORM, 0));
+        inputElementDescs.push_back(getVertexInputElementDesc(
+            "TEXCOORD", DXGI_FORMAT_R16G16_FLOAT, 8));
+        inputElementDescs.push_back(getVertexInputElementDesc(
+            "NORMAL", DXGI_FORMAT_R16G16_SNORM, 12));
+        break;
+    default:
+        inputElementDescs.push_back(getVertexInputElementDesc(
+            "POSITION", DXGI_FORMAT_R32G32B32_FLOAT, 0));
+        inputElementDescs.push_back(getVertexInputElementDesc(
+            "TEXCOORD", DXGI_FORMAT_R32G32_FLOAT, 12));
+        inputElementDescs.push_back(getVertexInputElementDesc(
+            "NORMAL", DXGI_FORMAT_R32G32B32_FLOAT, 24));
+        break;
+    }
+}
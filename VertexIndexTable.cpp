@@ -0,0 +1,114 @@
+#include "VertexIndexTable.h"
+
+const uint64 VertexIndexTable::maxLoadNumerator = 3;
+const uint64 VertexIndexTable::maxLoadDenominator = 4;
+
+VertexIndexTable::VertexIndexTable() : entries()
+{
+    mask = 0;
+
+    size = 0;
+}
+
+uint64 VertexIndexTable::getSize()
+{
+    return size;
+}
+
+const std::vector<VertexIndexTableEntry>& VertexIndexTable::getEntries()
+{
+    return entries;
+}
+
+void VertexIndexTable::reserve(uint64 vertexCount)
+{
+    uint64 capacity = 16;
+    while (capacity * maxLoadNumerator < vertexCount * maxLoadDenominator)
+    {
+        capacity *= 2;
+    }
+
+    if (capacity > entries.size())
+    {
+        rehash(capacity);
+    }
+}
+
+void VertexIndexTable::clear()
+{
+    entries.clear();
+    entries.shrink_to_fit();
+    mask = 0;
+
+    size = 0;
+}
+
+uint32 VertexIndexTable::findOrInsert(const ObjFaceCorner& faceCorner, uint32 vertexIndex,
+                                      bool& isInserted)
+{
+    if ((size + 1) * maxLoadDenominator > entries.size() * maxLoadNumerator)
+    {
+        reserve(size + 1);
+    }
+
+    for (uint64 i = hash(faceCorner) & mask; ; i = (i + 1) & mask)
+    {
+        VertexIndexTableEntry& entry = entries[i];
+        if (entry.faceCorner.positionIndex == 0)
+        {
+            entry.faceCorner = faceCorner;
+            entry.vertexIndex = vertexIndex;
+            size++;
+
+            isInserted = true;
+            return vertexIndex;
+        }
+
+        if (entry.faceCorner.positionIndex == faceCorner.positionIndex
+            && entry.faceCorner.textureCoordinatesIndex == faceCorner.textureCoordinatesIndex
+            && entry.faceCorner.normalIndex == faceCorner.normalIndex)
+        {
+            isInserted = false;
+            return entry.vertexIndex;
+        }
+    }
+}
+
+uint64 VertexIndexTable::hash(const ObjFaceCorner& faceCorner)
+{
+    uint64 key = (static_cast<uint64>(faceCorner.positionIndex) << 32 | faceCorner.
+        textureCoordinatesIndex) ^ static_cast<uint64>(faceCorner.normalIndex) *
+        0x9e3779b97f4a7c15;
+
+    // 64-bit finalizer of MurmurHash3, neighbouring triples end up far apart
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccd;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53;
+    key ^= key >> 33;
+
+    return key;
+}
+
+void VertexIndexTable::rehash(uint64 capacity)
+{
+    std::vector<VertexIndexTableEntry> oldEntries(capacity);
+    oldEntries.swap(entries);
+    mask = capacity - 1;
+
+    for (const auto& oldEntry : oldEntries)
+    {
+        if (oldEntry.faceCorner.positionIndex == 0)
+        {
+            continue;
+        }
+
+        uint64 i = hash(oldEntry.faceCorner) & mask;
+        while (entries[i].faceCorner.positionIndex != 0)
+        {
+            i = (i + 1) & mask;
+        }
+
+        entries[i] = oldEntry;
+    }
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include <vector>
+
+#include "IntUtility.h"
+
+#include "ObjUtility.h"
+
+struct VertexIndexTableEntry
+{
+    ObjFaceCorner faceCorner; // positionIndex is 0 for empty entries
+    uint32 vertexIndex;
+};
+
+// Flat open-addressing map from a face corner's (position, texture coordinates, normal) index
+// triple to the index of the vertex it produced, probed linearly
+class VertexIndexTable
+{
+    static const uint64 maxLoadNumerator;
+    static const uint64 maxLoadDenominator;
+
+    std::vector<VertexIndexTableEntry> entries;
+    uint64 mask;
+
+    uint64 size;
+
+public:
+    VertexIndexTable();
+
+    uint64 getSize();
+    const std::vector<VertexIndexTableEntry>& getEntries(); // in slot order, with empty slots
+
+    // Room for this many unique vertexes without a rehash, an estimate as the table still grows
+    // past it
+    void reserve(uint64 vertexCount);
+    void clear();
+
+    uint32 findOrInsert(const ObjFaceCorner& faceCorner, uint32 vertexIndex, bool& isInserted);
+
+private:
+    static uint64 hash(const ObjFaceCorner& faceCorner);
+
+    void rehash(uint64 capacity);
+};
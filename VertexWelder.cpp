@@ -0,0 +1,258 @@
+#include "VertexWelder.h"
+
+VertexWelder::VertexWelder() : settings{}, statistics{}
+{
+    settings.positionEpsilon = 1e-4f;
+    settings.textureCoordinatesEpsilon = 1e-4f;
+    settings.normalEpsilon = 1e-3f;
+}
+
+VertexWelderSettings VertexWelder::getSettings()
+{
+    return settings;
+}
+
+void VertexWelder::setSettings(VertexWelderSettings settings)
+{
+    this->settings = settings;
+}
+
+VertexWelderStatistics VertexWelder::getStatistics()
+{
+    return statistics;
+}
+
+bool VertexWelder::weld(ModelData& modelData)
+{
+    statistics = {};
+
+    if (!(settings.positionEpsilon > 0.0f))
+    {
+        return false;
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    std::vector<Vertex>& vertexes = modelData.vertexes;
+
+    // Positions without a grid cell, the distance test could not weld them either
+    for (const Vertex& vertex : vertexes)
+    {
+        if (!std::isfinite(vertex.position.x) || !std::isfinite(vertex.position.y)
+            || !std::isfinite(vertex.position.z))
+        {
+            return false;
+        }
+    }
+
+    for (const MeshData& meshData : modelData.meshDataItems)
+    {
+        if (meshData.indexes.size() % 3 != 0)
+        {
+            return false;
+        }
+
+        for (uint32 index : meshData.indexes)
+        {
+            if (index >= vertexes.size())
+            {
+                return false;
+            }
+        }
+
+        statistics.triangleCountBefore += meshData.indexes.size() / 3;
+    }
+
+    statistics.vertexCountBefore = vertexes.size();
+
+    std::vector<uint32> weldedVertexes;
+    getWeldedVertexes(vertexes, weldedVertexes);
+
+    // Meshes left without triangles are removed, there is nothing to draw of them
+    std::vector<MeshData>& meshDataItems = modelData.meshDataItems;
+    uint64 meshCount = 0;
+    for (uint64 i = 0; i < meshDataItems.size(); i++)
+    {
+        MeshData& meshData = meshDataItems[i];
+        for (uint32& index : meshData.indexes)
+        {
+            index = weldedVertexes[index];
+        }
+
+        removeTriangles(meshData.indexes);
+        if (meshData.indexes.empty())
+        {
+            statistics.removedMeshCount++;
+
+            continue;
+        }
+
+        if (meshCount != i)
+        {
+            meshDataItems[meshCount] = std::move(meshData);
+        }
+        meshCount++;
+    }
+    meshDataItems.resize(meshCount);
+
+    // Vertexes are kept in the order of their first use
+    std::vector<uint32> newIndexes(vertexes.size(), UINT32_MAX);
+    std::vector<Vertex> newVertexes;
+    for (MeshData& meshData : modelData.meshDataItems)
+    {
+        for (uint32& index : meshData.indexes)
+        {
+            if (newIndexes[index] == UINT32_MAX)
+            {
+                newIndexes[index] = static_cast<uint32>(newVertexes.size());
+                newVertexes.push_back(vertexes[index]);
+            }
+
+            index = newIndexes[index];
+        }
+    }
+
+    vertexes = std::move(newVertexes);
+
+    statistics.vertexCountAfter = vertexes.size();
+
+    std::chrono::duration<double> weldingTime = std::chrono::steady_clock::now() - startTime;
+    statistics.weldingTime = weldingTime.count();
+
+    return true;
+}
+
+void VertexWelder::getWeldedVertexes(const std::vector<Vertex>& vertexes,
+                                     std::vector<uint32>& weldedVertexes)
+{
+    weldedVertexes.resize(vertexes.size());
+
+    // Every cell holds a list of the vertexes kept in it, chained through nextVertexes
+    std::unordered_map<uint64, uint32> cellFirstVertexes;
+    cellFirstVertexes.reserve(vertexes.size());
+    std::vector<uint32> nextVertexes(vertexes.size(), UINT32_MAX);
+
+    float cellScale = 1.0f / settings.positionEpsilon;
+    for (uint32 i = 0; i < vertexes.size(); i++)
+    {
+        const Vertex& vertex = vertexes[i];
+
+        int64 x = getVertexWelderCellCoordinate(vertex.position.x, cellScale);
+        int64 y = getVertexWelderCellCoordinate(vertex.position.y, cellScale);
+        int64 z = getVertexWelderCellCoordinate(vertex.position.z, cellScale);
+
+        // Anything within positionEpsilon is at most one cell away
+        uint32 weldedVertex = UINT32_MAX;
+        for (int64 j = 0; j < 27 && weldedVertex == UINT32_MAX; j++)
+        {
+            auto cellFirstVertex = cellFirstVertexes.find(getVertexWelderCellKey(
+                x + j % 3 - 1, y + j / 3 % 3 - 1, z + j / 9 - 1));
+            if (cellFirstVertex == cellFirstVertexes.end())
+            {
+                continue;
+            }
+
+            for (uint32 k = cellFirstVertex->second; k != UINT32_MAX; k = nextVertexes[k])
+            {
+                if (canBeWelded(vertex, vertexes[k]))
+                {
+                    weldedVertex = k;
+
+                    break;
+                }
+            }
+        }
+
+        if (weldedVertex != UINT32_MAX)
+        {
+            weldedVertexes[i] = weldedVertex;
+
+            continue;
+        }
+
+        weldedVertexes[i] = i;
+
+        uint32& cellFirstVertex = cellFirstVertexes.emplace(getVertexWelderCellKey(x, y, z),
+                                                            UINT32_MAX).first->second;
+        nextVertexes[i] = cellFirstVertex;
+        cellFirstVertex = i;
+    }
+}
+
+bool VertexWelder::canBeWelded(const Vertex& vertex, const Vertex& weldedVertex)
+{
+    float dx = vertex.position.x - weldedVertex.position.x;
+    float dy = vertex.position.y - weldedVertex.position.y;
+    float dz = vertex.position.z - weldedVertex.position.z;
+    if (dx * dx + dy * dy + dz * dz > settings.positionEpsilon * settings.positionEpsilon)
+    {
+        return false;
+    }
+
+    const DirectX::XMFLOAT3& textureCoordinates = vertex.textureCoordinates;
+    const DirectX::XMFLOAT3& weldedTextureCoordinates = weldedVertex.textureCoordinates;
+    if (std::fabs(textureCoordinates.x - weldedTextureCoordinates.x) >
+        settings.textureCoordinatesEpsilon ||
+        std::fabs(textureCoordinates.y - weldedTextureCoordinates.y) >
+        settings.textureCoordinatesEpsilon ||
+        std::fabs(textureCoordinates.z - weldedTextureCoordinates.z) >
+        settings.textureCoordinatesEpsilon)
+    {
+        return false;
+    }
+
+    const DirectX::XMFLOAT3& normal = vertex.normal;
+    const DirectX::XMFLOAT3& weldedNormal = weldedVertex.normal;
+    if (std::fabs(normal.x - weldedNormal.x) > settings.normalEpsilon ||
+        std::fabs(normal.y - weldedNormal.y) > settings.normalEpsilon ||
+        std::fabs(normal.z - weldedNormal.z) > settings.normalEpsilon)
+    {
+        return false;
+    }
+
+    return true;
+}
+
+void VertexWelder::removeTriangles(std::vector<uint32>& indexes)
+{
+    std::unordered_set<VertexWelderTriangle, VertexWelderTriangleHash> triangles;
+    triangles.reserve(indexes.size() / 3);
+
+    uint64 indexCount = 0;
+    for (uint64 i = 0; i < indexes.size(); i += 3)
+    {
+        uint32 a = indexes[i];
+        uint32 b = indexes[i + 1];
+        uint32 c = indexes[i + 2];
+        if (a == b || b == c || a == c)
+        {
+            statistics.degenerateTriangleCount++;
+
+            continue;
+        }
+
+        VertexWelderTriangle triangle = {{a, b, c}};
+        if (b < a && b < c)
+        {
+            triangle = {{b, c, a}};
+        }
+        else if (c < a && c < b)
+        {
+            triangle = {{c, a, b}};
+        }
+
+        if (!triangles.insert(triangle).second)
+        {
+            statistics.duplicateTriangleCount++;
+
+            continue;
+        }
+
+        indexes[indexCount] = a;
+        indexes[indexCount + 1] = b;
+        indexes[indexCount + 2] = c;
+        indexCount += 3;
+    }
+
+    indexes.resize(indexCount);
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <cmath>
+
+#include <chrono>
+
+#include "Vertex.h"
+
+#include "ModelFileParserUtility.h"
+#include "VertexWelderUtility.h"
+
+// Merges vertexes whose position, UV and normal are within the epsilons of an earlier vertex,
+// found through a uniform grid of positionEpsilon-sized cells. Triangles that welding makes
+// degenerate or duplicate are removed, then meshes left without triangles and unreferenced
+// vertexes
+class VertexWelder
+{
+    VertexWelderSettings settings;
+
+    VertexWelderStatistics statistics;
+
+public:
+    VertexWelder();
+
+    VertexWelderSettings getSettings();
+    void setSettings(VertexWelderSettings settings);
+
+    VertexWelderStatistics getStatistics();
+
+    bool weld(ModelData& modelData);
+
+private:
+    void getWeldedVertexes(const std::vector<Vertex>& vertexes,
+                           std::vector<uint32>& weldedVertexes);
+    bool canBeWelded(const Vertex& vertex, const Vertex& weldedVertex);
+
+    void removeTriangles(std::vector<uint32>& indexes);
+};
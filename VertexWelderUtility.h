@@ -0,0 +1,77 @@
+#pragma once
+#include <functional>
+
+#include <cmath>
+
+#include "IntUtility.h"
+
+// Of the cell coordinates, 2^62 so the neighbouring cells stay within int64
+constexpr float VertexWelderMaxCellCoordinate = 4611686018427387904.0f;
+
+struct VertexWelderSettings
+{
+    float positionEpsilon; // model units, also the size of a grid cell
+    float textureCoordinatesEpsilon; // per component
+    float normalEpsilon; // per component
+};
+
+struct VertexWelderStatistics
+{
+    uint64 vertexCountBefore;
+    uint64 vertexCountAfter; // referenced vertexes only
+
+    uint64 triangleCountBefore;
+    uint64 degenerateTriangleCount; // removed
+    uint64 duplicateTriangleCount; // removed
+    uint64 removedMeshCount; // left without triangles
+
+    double weldingTime; // s
+};
+
+// Triangle rotated so its smallest index comes first, which keeps the winding
+struct VertexWelderTriangle
+{
+    uint32 indexes[3];
+
+    bool operator==(const VertexWelderTriangle& triangle) const
+    {
+        return indexes[0] == triangle.indexes[0] && indexes[1] == triangle.indexes[1] &&
+            indexes[2] == triangle.indexes[2];
+    }
+};
+
+struct VertexWelderTriangleHash
+{
+    uint64 operator()(const VertexWelderTriangle& triangle) const
+    {
+        uint64 hash = triangle.indexes[0];
+        hash = hash * 0x9e3779b97f4a7c15ull ^ triangle.indexes[1];
+        hash = hash * 0x9e3779b97f4a7c15ull ^ triangle.indexes[2];
+
+        return std::hash<uint64>()(hash);
+    }
+};
+
+// Clamped before the cast so any finite position has a cell, positions past the clamp share the
+// outermost cells and are told apart by the distance test
+inline int64 getVertexWelderCellCoordinate(float coordinate, float cellScale)
+{
+    float cellCoordinate = std::floor(coordinate * cellScale);
+    if (cellCoordinate < -VertexWelderMaxCellCoordinate)
+    {
+        cellCoordinate = -VertexWelderMaxCellCoordinate;
+    }
+    else if (cellCoordinate > VertexWelderMaxCellCoordinate)
+    {
+        cellCoordinate = VertexWelderMaxCellCoordinate;
+    }
+
+    return static_cast<int64>(cellCoordinate);
+}
+
+// Packs the cell coordinates, cells that share a key are told apart by the distance test
+inline uint64 getVertexWelderCellKey(int64 x, int64 y, int64 z)
+{
+    return (static_cast<uint64>(x) & 0x1fffff) | (static_cast<uint64>(y) & 0x1fffff) << 21 |
+        (static_cast<uint64>(z) & 0x1fffff) << 42;
+}
@@ -25,7 +25,8 @@ int32 WINAPI WinMain(HINSTANCE applicationInstanceHandle,
 
     std::shared_ptr<Application> application = createSharedPointer<Application>(
         input, timer, fpsCounter);
-    bool result = application->initialize(applicationInstanceHandle, L"GSP", application, showCmd);
+    bool result = application->initialize(applicationInstanceHandle, L"GSP", application, showCmd,
+                                          cmdLine);
 
     if (result)
     {